@@ -12,6 +12,8 @@
 #include "Throughput.h"
 #include <cmath>
 #include <coil/Async.h>
+#include <rtm/ByteData.h>
+#include <cstdint>
 
 #define DEBUG 1
 
@@ -397,6 +399,7 @@ void Throughput::receiveData(const RTC::Time &tm, const CORBA::ULong seq_length)
   static size_t size(0);
   static size_t record_num(0);
   static size_t record_ptr(0);
+  static std::uint64_t copied_bytes(RTC::ByteData::getCopiedBytes());
 
   // data arrived -> getting time
   auto received_time = std::chrono::system_clock::now().time_since_epoch();
@@ -438,19 +441,25 @@ void Throughput::receiveData(const RTC::Time &tm, const CORBA::ULong seq_length)
       stddev = sqrt(variance);
       // Time tm (long, long) = 4byte + 4byte [Mbps]
       throughput = ((((size * m_varsize) + 8) * 8) / mean_latency) / (1024 * 1024);
-
-      // size[byte], min[s], max[s], mean[s], stddev[s], throughpiut[Mbps]
+      // bytes of serialized data copied in this process per sample
+      // (ByteData and the serializer streams, not the serialization)
+      std::uint64_t copied(RTC::ByteData::getCopiedBytes());
+      double copy_per_sample(static_cast<double>(copied - copied_bytes) / record_num);
+      copied_bytes = copied;
+
+      // size[byte], min[s], max[s], mean[s], stddev[s], throughpiut[Mbps],
+      // copy[byte/sample]
       m_fs << size << "\t";
       m_fs << min_latency << "\t" << max_latency << "\t";
       m_fs << mean_latency << "\t" << stddev << "\t";
-      m_fs << throughput << std::endl;
+      m_fs << throughput << "\t" << copy_per_sample << std::endl;
 
 #ifdef DEBUG
       std::cout << "==============================" << std::endl;
       std::cout << size << "\t";
       std::cout << min_latency << "\t" << max_latency << "\t";
       std::cout << mean_latency << "\t" << stddev << "\t";
-      std::cout << throughput << std::endl;
+      std::cout << throughput << "\t" << copy_per_sample << std::endl;
 #endif // DEBUG
       // reset size/index variables
       record_num = 0;
@@ -500,6 +509,7 @@ void Throughput::setConnectorProfile(const RTC::ConnectorInfo &info)
 
   // print header
   m_fs << "size[byte]\tmin[s]\tmax[s]\tmean[s]\tstddev[s]\tthroughpiut[Mbps]";
+  m_fs << "\tcopy[byte/sample]";
   m_fs << std::endl;
   m_record.resize(m_maxsample);
 
@@ -19,6 +19,8 @@
 
 #include <coil/PeriodicTask.h>
 
+#include <thread>
+
 namespace coil
 {
   /*!
@@ -222,6 +224,31 @@ namespace coil
     return m_periodStat.stat;
   }
 
+  /*!
+   * @if jp
+   * @brief 周期超過時の動作を設定する
+   * @else
+   * @brief Set the behaviour when a period is overrun
+   * @endif
+   */
+  void PeriodicTask::setOverrunPolicy(OverrunPolicy policy)
+  {
+    m_overrunPolicy = policy;
+  }
+
+  /*!
+   * @if jp
+   * @brief 周期の締め切りに関する統計を取得
+   * @else
+   * @brief Get the statistics on period deadlines
+   * @endif
+   */
+  PeriodicTaskBase::DeadlineStatistics PeriodicTask::getDeadlineStat()
+  {
+    std::lock_guard<std::mutex> guard(m_deadlineStat.mutex);
+    return m_deadlineStat.stat;
+  }
+
   //----------------------------------------------------------------------
   // protected functions
   //----------------------------------------------------------------------
@@ -234,6 +261,7 @@ namespace coil
    */
   int PeriodicTask::svc()
   {
+    m_deadline = std::chrono::steady_clock::now();
     while (m_alive.value)  // needs lock?
       {
         if (m_periodMeasure) { m_periodTime.tack(); }
@@ -247,6 +275,8 @@ namespace coil
                 {
                   return 0;
                 }
+              // the schedule restarts when the task is resumed
+              m_deadline = std::chrono::steady_clock::now();
             }
         }
         if (m_periodMeasure) { m_periodTime.tick(); }
@@ -277,10 +307,32 @@ namespace coil
    */
   void PeriodicTask::sleep()
   {
-    if (m_period > std::chrono::seconds::zero())
+    if (m_period <= std::chrono::nanoseconds::zero()) { return; }
+
+    m_deadline += m_period;
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds overrun(0);
+    unsigned long long skipped(0);
+
+    if (now >= m_deadline)
       {
-        std::this_thread::sleep_for(m_period - m_execTime.interval());
+        overrun = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          now - m_deadline);
+        if (m_overrunPolicy == OverrunPolicy::CATCHUP)
+          {
+            // run the late period right away, keeping the grid
+            updateDeadlineStat(overrun, overrun, 0);
+            return;
+          }
+        // drop every period whose release time has already passed
+        skipped = static_cast<unsigned long long>(overrun / m_period) + 1;
+        m_deadline += m_period * static_cast<long long>(skipped);
       }
+
+    std::this_thread::sleep_until(m_deadline);
+    auto lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - m_deadline);
+    updateDeadlineStat(lateness, overrun, skipped);
   }
 
   /*!
@@ -319,5 +371,28 @@ namespace coil
     ++m_periodCount;
   }
 
+  /*!
+   * @if jp
+   * @brief 締め切り状態更新
+   * @else
+   * @brief Update for deadline state
+   * @endif
+   */
+  void PeriodicTask::updateDeadlineStat(std::chrono::nanoseconds lateness,
+                                        std::chrono::nanoseconds overrun,
+                                        unsigned long long skipped)
+  {
+    std::lock_guard<std::mutex> guard(m_deadlineStat.mutex);
+    DeadlineStatistics& stat(m_deadlineStat.stat);
+    ++stat.deadlines;
+    stat.lateness.record(lateness);
+    if (overrun > std::chrono::nanoseconds::zero())
+      {
+        ++stat.missed;
+        stat.overrun.record(overrun);
+      }
+    stat.skipped += skipped;
+  }
+
 } // namespace coil
 
@@ -263,6 +263,30 @@ namespace coil
      */
     TimeMeasure::Statistics getPeriodStat() override;
 
+    /*!
+     * @if jp
+     * @brief 周期超過時の動作を設定する
+     *
+     * デフォルトは SKIP。タスク開始前に設定すること。
+     *
+     * @else
+     * @brief Set the behaviour when a period is overrun
+     *
+     * Defaults to SKIP. Set it before the task is activated.
+     *
+     * @endif
+     */
+    void setOverrunPolicy(OverrunPolicy policy) override;
+
+    /*!
+     * @if jp
+     * @brief 周期の締め切りに関する統計を取得
+     * @else
+     * @brief Get the statistics on period deadlines
+     * @endif
+     */
+    DeadlineStatistics getDeadlineStat() override;
+
   protected:
     /*!
      * @if jp
@@ -300,6 +324,17 @@ namespace coil
      */
     virtual void updatePeriodStat();
 
+    /*!
+     * @if jp
+     * @brief 締め切り状態更新
+     * @else
+     * @brief Update for deadline state
+     * @endif
+     */
+    virtual void updateDeadlineStat(std::chrono::nanoseconds lateness,
+                                    std::chrono::nanoseconds overrun,
+                                    unsigned long long skipped);
+
   protected:
     /*!
      * @if jp
@@ -472,6 +507,55 @@ namespace coil
      */
     coil::TimeMeasure m_periodTime;
 
+    /*!
+     * @if jp
+     * @brief 周期超過時の動作
+     * @else
+     * @brief Behaviour on overrun
+     * @endif
+     */
+    OverrunPolicy m_overrunPolicy{OverrunPolicy::SKIP};
+
+    /*!
+     * @if jp
+     * @brief 次の周期の実行予定時刻
+     *
+     * 起床の遅れが蓄積しないよう、周期ごとに前回の予定時刻に周期を
+     * 加算して求める。
+     *
+     * @else
+     * @brief Release time of the current period
+     *
+     * Advanced by the period from the previous release time rather than
+     * from the wake-up time, so that wake-up latency does not
+     * accumulate as drift.
+     *
+     * @endif
+     */
+    std::chrono::steady_clock::time_point m_deadline;
+
+    /*!
+     * @if jp
+     * @brief 締め切り統計管理用構造体
+     * @else
+     * @brief Structure for deadline statistics management
+     * @endif
+     */
+    struct deadline_t
+    {
+      DeadlineStatistics stat;
+      std::mutex mutex;
+    };
+
+    /*!
+     * @if jp
+     * @brief 締め切り統計
+     * @else
+     * @brief Deadline statistics
+     * @endif
+     */
+    deadline_t        m_deadlineStat;
+
   };
 
 } // namespace coil
@@ -22,6 +22,7 @@
 
 #include <coil/TimeMeasure.h>
 #include <coil/Task.h>
+#include <cstdint>
 #include <functional>
 
 namespace coil
@@ -43,6 +44,65 @@ namespace coil
     : public coil::Task
   {
   public:
+    /*!
+     * @if jp
+     *
+     * @brief 周期超過時の動作
+     *
+     * - CATCHUP: 実行予定時刻を周期の格子上に保ち、遅れた周期は待機
+     *            せずに続けて実行する
+     * - SKIP:    遅れた周期の実行を取りやめ、次の格子上の時刻まで待
+     *            機する
+     *
+     * @else
+     *
+     * @brief Behaviour when a period is overrun
+     *
+     * - CATCHUP: Keeps the release times on the period grid and runs
+     *            the late periods back to back without sleeping
+     * - SKIP:    Drops the late periods and sleeps until the next
+     *            release time on the grid
+     *
+     * @endif
+     */
+    enum class OverrunPolicy : uint8_t
+    {
+      CATCHUP,
+      SKIP
+    };
+
+    /*!
+     * @if jp
+     *
+     * @brief 周期の締め切りに関する統計
+     *
+     * - deadlines: 評価した締め切りの数
+     * - missed:    実行が次の締め切りに間に合わなかった数
+     * - skipped:   SKIP により実行を取りやめた周期の数
+     * - lateness:  締め切りからの起床の遅れ
+     * - overrun:   締め切りを過ぎた周期の超過時間
+     *
+     * @else
+     *
+     * @brief Statistics on period deadlines
+     *
+     * - deadlines: Number of deadlines evaluated
+     * - missed:    Number of executions that ran past the next deadline
+     * - skipped:   Number of periods dropped by SKIP
+     * - lateness:  Wake-up latency after the deadline
+     * - overrun:   How far a missed deadline had been passed
+     *
+     * @endif
+     */
+    struct DeadlineStatistics
+    {
+      unsigned long long deadlines{0};
+      unsigned long long missed{0};
+      unsigned long long skipped{0};
+      coil::TimeHistogram lateness;
+      coil::TimeHistogram overrun;
+    };
+
     /*!
      * @if jp
      *
@@ -305,6 +365,45 @@ namespace coil
      */
     virtual coil::TimeMeasure::Statistics getPeriodStat() = 0;
 
+    /*!
+     * @if jp
+     *
+     * @brief 周期超過時の動作を設定する純粋仮想関数
+     *
+     * 周期超過時の動作を設定する純粋仮想関数。
+     *
+     * @param policy 周期超過時の動作
+     *
+     * @else
+     *
+     * @brief Set the behaviour when a period is overrun
+     *
+     * Pure virtual function to set the behaviour when a period is
+     * overrun.
+     *
+     * @param policy Behaviour on overrun
+     *
+     * @endif
+     */
+    virtual void setOverrunPolicy(OverrunPolicy policy) = 0;
+
+    /*!
+     * @if jp
+     *
+     * @brief 周期の締め切りに関する統計を取得する純粋仮想関数
+     *
+     * 周期の締め切りに関する統計を取得する純粋仮想関数。
+     *
+     * @else
+     *
+     * @brief Get the statistics on period deadlines
+     *
+     * Pure virtual function to get the statistics on period deadlines.
+     *
+     * @endif
+     */
+    virtual DeadlineStatistics getDeadlineStat() = 0;
+
   };
 } // namespace coil
 
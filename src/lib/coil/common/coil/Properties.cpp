@@ -20,9 +20,13 @@
 #include <coil/Properties.h>
 #include <coil/stringutil.h>
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifdef __QNX__
@@ -31,6 +35,55 @@ using std::size_t;
 
 namespace coil
 {
+  namespace
+  {
+    // Up to this many children a linear scan is faster than hashing.
+    const size_t index_threshold(8);
+
+    /*!
+     * @if jp
+     * @brief 名前のハッシュ値 (FNV-1a)
+     * @else
+     * @brief Hash of a name (FNV-1a)
+     * @endif
+     */
+    size_t hashName(const char* name, size_t len)
+    {
+      std::uint64_t hash(14695981039346656037ULL);
+      for (size_t i(0); i < len; ++i)
+        {
+          hash ^= static_cast<unsigned char>(name[i]);
+          hash *= 1099511628211ULL;
+        }
+      return static_cast<size_t>(hash);
+    }
+
+    /*!
+     * @if jp
+     * @brief pos 以降で最初のエスケープされていない '.' の位置
+     *
+     * 見つからない場合は key の長さを返す。split() と同じ区切り方。
+     *
+     * @else
+     * @brief The position of the first unescaped '.' from pos
+     *
+     * Returns the length of key if there is none. The same separation
+     * as split().
+     *
+     * @endif
+     */
+    std::string::size_type nextDelimiter(const std::string& key,
+                                         std::string::size_type pos)
+    {
+      while ((pos = key.find('.', pos)) != std::string::npos)
+        {
+          if (!coil::isEscaped(key, pos)) { return pos; }
+          ++pos;
+        }
+      return key.size();
+    }
+  } // namespace
+
   /*!
    * @if jp
    * @brief コンストラクタ(rootノードのみ作成)
@@ -88,20 +141,7 @@ namespace coil
     : name(prop.name), value(prop.value),
       default_value(prop.default_value), set_value(prop.set_value), root(nullptr), m_empty("")
   {
-    std::vector<std::string> keys;
-    keys = prop.propertyNames();
-    for (const auto & key : keys)
-      {
-        const Properties* node(nullptr);
-        if ((node = prop.findNode(key)) != nullptr)
-          {
-            setDefault(key,  node->default_value);
-            if (node->set_value)
-              {
-                setProperty(key, node->value);
-              }
-          }
-      }
+    _copyLeaves(*this, prop);
   }
 
   /*!
@@ -113,27 +153,27 @@ namespace coil
    */
   Properties& Properties::operator=(const Properties& prop)
   {
+    if (this == &prop)
+      {
+        return *this;
+      }
     clear();
-    name = prop.name;
+    if (root != nullptr && name != prop.name)
+      {
+        // keep the index of the parent up to date
+        std::string old_name(std::move(name));
+        name = prop.name;
+        root->renameChild(this, old_name);
+      }
+    else
+      {
+        name = prop.name;
+      }
     value = prop.value;
     default_value = prop.default_value;
     set_value = prop.set_value;
 
-    std::vector<std::string> keys;
-    keys = prop.propertyNames();
-    for (const auto & key : keys)
-      {
-        const Properties* node(prop.findNode(key));
-        if (node != nullptr)
-          {
-            setDefault(key,  node->default_value);
-            if (node->set_value)
-              {
-                setProperty(key, node->value);
-              }
-          }
-      }
-
+    _copyLeaves(*this, prop);
     return *this;
   }
 
@@ -152,7 +192,7 @@ namespace coil
     // delete myself from parent
     if (root != nullptr)
       {
-        root->removeNode(name.c_str());
+        root->detachChild(this);
       }
   }
 
@@ -168,10 +208,8 @@ namespace coil
    */
   const std::string& Properties::getProperty(const std::string& key) const
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-    Properties* node(nullptr);
-    if ((node = _getNode(keys, 0, this)) != nullptr)
+    const Properties* node(findPath(key));
+    if (node != nullptr)
       {
         return (node->set_value) ? node->value : node->default_value;
       }
@@ -214,9 +252,12 @@ namespace coil
    */
   std::string& Properties::operator[](const std::string& key)
   {
-    setProperty(key, getProperty(key));
-    Properties& prop(getNode(key));
-
+    Properties& prop(createPath(key));
+    if (!prop.set_value)
+      {
+        prop.value = prop.default_value;
+        prop.set_value = true;
+      }
     return prop.value;
   }
 
@@ -229,10 +270,8 @@ namespace coil
    */
   const std::string& Properties::getDefault(const std::string& key) const
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-    Properties* node(nullptr);
-    if ((node = _getNode(keys, 0, this)) != nullptr)
+    const Properties* node(findPath(key));
+    if (node != nullptr)
       {
         return node->default_value;
       }
@@ -249,24 +288,10 @@ namespace coil
   std::string Properties::setProperty(const std::string& key,
                                       const std::string& invalue)
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-
-    Properties* curr(this);
-    for (auto & k : keys)
-      {
-        Properties* next(curr->hasKey(k.c_str()));
-        if (next == nullptr)
-          {
-            next = new Properties(k.c_str());
-            next->root = curr;
-            curr->leaf.emplace_back(next);
-          }
-        curr = next;
-      }
-    std::string retval(curr->value);
-    curr->value = invalue;
-    curr->set_value = true;
+    Properties& curr(createPath(key));
+    std::string retval(curr.value);
+    curr.value = invalue;
+    curr.set_value = true;
     return retval;
   }
 
@@ -280,22 +305,7 @@ namespace coil
   std::string Properties::setDefault(const std::string& key,
                                      const std::string& invalue)
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-
-    Properties* curr(this);
-    for (auto & k : keys)
-      {
-        Properties* next(curr->hasKey(k.c_str()));
-        if (next == nullptr)
-          {
-            next = new Properties(k.c_str());
-            next->root = curr;
-            curr->leaf.emplace_back(next);
-          }
-        curr = next;
-      }
-    curr->default_value = invalue;
+    createPath(key).default_value = invalue;
     return invalue;
   }
 
@@ -434,7 +444,7 @@ namespace coil
    */
   size_t Properties::size() const
   {
-    return propertyNames().size();
+    return _countLeaves(*this);
   }
 
   /*!
@@ -446,13 +456,7 @@ namespace coil
    */
   Properties* Properties::findNode(const std::string& key) const
   {
-    if (key.empty())
-      {
-        return nullptr;
-      }
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-    return _getNode(keys, 0, this);
+    return findPath(key);
   }
 
   /*!
@@ -468,13 +472,15 @@ namespace coil
       {
         return *this;
       }
-    Properties* const leafptr(findNode(key));
+    Properties* const leafptr(findPath(key));
     if (leafptr != nullptr)
       {
         return *leafptr;
       }
-    this->createNode(key);
-    return *findNode(key);
+    // a new node, as created by createNode()
+    Properties& node(createPath(key));
+    node.set_value = true;
+    return node;
   }
 
   /*!
@@ -491,11 +497,11 @@ namespace coil
         return false;
       }
 
-    if (findNode(key) != nullptr)
+    if (findPath(key) != nullptr)
       {
         return false;
       }
-    (*this)[key] = "";
+    createPath(key).set_value = true;
     return true;
   }
 
@@ -508,19 +514,12 @@ namespace coil
    */
   Properties* Properties::removeNode(const char* leaf_name)
   {
-    std::vector<Properties*>::iterator it(leaf.begin()), it_end(leaf.end());
-    Properties* prop;
-    while (it != it_end)
+    Properties* prop(findChild(leaf_name, std::strlen(leaf_name)));
+    if (prop != nullptr)
       {
-        if ((*it)->name == leaf_name)
-          {
-            prop = *it;
-            leaf.erase(it);
-            return prop;
-          }
-        ++it;
+        detachChild(prop);
       }
-    return nullptr;
+    return prop;
   }
 
   /*!
@@ -532,14 +531,7 @@ namespace coil
    */
   Properties* Properties::hasKey(const char* key) const
   {
-    for (auto prop : leaf)
-      {
-        if (prop->name == key)
-          {
-            return prop;
-          }
-      }
-    return nullptr;
+    return findChild(key, std::strlen(key));
   }
 
   /*!
@@ -569,9 +561,9 @@ namespace coil
   {
     std::vector<std::string> keys;
     keys = prop.propertyNames();
-    for (size_t i(0), len(static_cast<size_t>(prop.size())); i < len; ++i)
+    for (const auto & key : keys)
       {
-        (*this)[keys[i]] = prop[keys[i]];
+        (*this)[key] = prop[key];
       }
     return (*this);
   }
@@ -662,7 +654,12 @@ namespace coil
                        std::vector<Properties*>::size_type index,
                        const Properties* curr)
   {
-    Properties* next(curr->hasKey(keys[index].c_str()));
+    if (index >= keys.size())
+      {
+        return nullptr;
+      }
+    Properties* next(curr->findChild(keys[index].c_str(),
+                                     keys[index].size()));
 
     if (next == nullptr)
       {
@@ -679,6 +676,296 @@ namespace coil
       }
   }
 
+  /*!
+   * @if jp
+   * @brief 指定した名前の子ノードを検索する
+   * @else
+   * @brief Find the child with the given name
+   * @endif
+   */
+  Properties* Properties::findChild(const char* key, size_t len) const
+  {
+    if (m_index.empty())
+      {
+        for (auto prop : leaf)
+          {
+            if (prop->name.size() == len &&
+                std::memcmp(prop->name.data(), key, len) == 0)
+              {
+                return prop;
+              }
+          }
+        return nullptr;
+      }
+    auto range(m_index.equal_range(hashName(key, len)));
+    for (auto it(range.first); it != range.second; ++it)
+      {
+        Properties* prop(it->second);
+        if (prop->name.size() == len &&
+            std::memcmp(prop->name.data(), key, len) == 0)
+          {
+            return prop;
+          }
+      }
+    return nullptr;
+  }
+
+  /*!
+   * @if jp
+   * @brief 子ノードを末尾に追加する
+   *
+   * 索引は子ノードが index_threshold 個になった時点で作成し、以降は
+   * 常にすべての子ノードを含む。索引を作成できない場合は索引を使用
+   * せずに線形探索する。
+   *
+   * @else
+   * @brief Append a child
+   *
+   * The index is built when there are index_threshold children and
+   * holds all of them from then on. If it cannot be built the children
+   * are scanned linearly instead.
+   *
+   * @endif
+   */
+  Properties* Properties::addChild(const char* key, size_t len)
+  {
+    Properties* child(new Properties());
+    try
+      {
+        child->name.assign(key, len);
+        leaf.emplace_back(child);
+      }
+    catch (...)
+      {
+        delete child;
+        throw;
+      }
+    child->root = this;
+    try
+      {
+        if (!m_index.empty())
+          {
+            m_index.emplace(hashName(key, len), child);
+          }
+        else if (leaf.size() >= index_threshold)
+          {
+            m_index.reserve(leaf.size() * 2);
+            for (auto prop : leaf)
+              {
+                m_index.emplace(hashName(prop->name.data(),
+                                         prop->name.size()), prop);
+              }
+          }
+      }
+    catch (...)
+      {
+        m_index.clear();
+      }
+    return child;
+  }
+
+  /*!
+   * @if jp
+   * @brief 子ノードを leaf と索引から外す
+   *
+   * clear() は末尾から削除するため、末尾から探す。
+   *
+   * @else
+   * @brief Detach the child from leaf and the index
+   *
+   * Searched from the back, where clear() deletes the children.
+   *
+   * @endif
+   */
+  bool Properties::detachChild(const Properties* child)
+  {
+    auto it(leaf.rbegin());
+    while (it != leaf.rend() && *it != child) { ++it; }
+    if (it == leaf.rend())
+      {
+        return false;
+      }
+    leaf.erase(std::next(it).base());
+
+    auto range(m_index.equal_range(hashName(child->name.data(),
+                                            child->name.size())));
+    for (auto idx(range.first); idx != range.second; ++idx)
+      {
+        if (idx->second == child)
+          {
+            m_index.erase(idx);
+            break;
+          }
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 子ノードの索引を名前の変更に合わせて更新する
+   * @else
+   * @brief Update the index for a renamed child
+   * @endif
+   */
+  void Properties::renameChild(Properties* child, const std::string& old_name)
+  {
+    if (m_index.empty())
+      {
+        return;
+      }
+    auto range(m_index.equal_range(hashName(old_name.data(),
+                                            old_name.size())));
+    for (auto idx(range.first); idx != range.second; ++idx)
+      {
+        if (idx->second == child)
+          {
+            m_index.erase(idx);
+            break;
+          }
+      }
+    try
+      {
+        m_index.emplace(hashName(child->name.data(), child->name.size()),
+                        child);
+      }
+    catch (...)
+      {
+        m_index.clear();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief キーのノードを検索する
+   *
+   * split() と同じく '.' で区切った各部分を順に辿るが、部分文字列は
+   * 生成しない。
+   *
+   * @else
+   * @brief Find the node of the key
+   *
+   * Walks the parts separated by '.' as split() does, without creating
+   * substrings.
+   *
+   * @endif
+   */
+  Properties* Properties::findPath(const std::string& key) const
+  {
+    if (key.empty())
+      {
+        return nullptr;
+      }
+    const Properties* curr(this);
+    std::string::size_type begin(0);
+    while (true)
+      {
+        std::string::size_type end(nextDelimiter(key, begin));
+        Properties* next(curr->findChild(key.data() + begin, end - begin));
+        if (next == nullptr || end == key.size())
+          {
+            return next;
+          }
+        curr = next;
+        begin = end + 1;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief キーのノードを、なければ生成して返す
+   *
+   * 空のキーの場合は自身を返す。
+   *
+   * @else
+   * @brief Return the node of the key, creating it if missing
+   *
+   * Returns itself for an empty key.
+   *
+   * @endif
+   */
+  Properties& Properties::createPath(const std::string& key)
+  {
+    Properties* curr(this);
+    if (key.empty())
+      {
+        return *curr;
+      }
+    std::string::size_type begin(0);
+    while (true)
+      {
+        std::string::size_type end(nextDelimiter(key, begin));
+        const char* part(key.data() + begin);
+        Properties* next(curr->findChild(part, end - begin));
+        if (next == nullptr)
+          {
+            next = curr->addChild(part, end - begin);
+          }
+        curr = next;
+        if (end == key.size())
+          {
+            return *curr;
+          }
+        begin = end + 1;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 末端ノードの値とデフォルト値をコピーする
+   *
+   * propertyNames() のキーごとに setDefault() と setProperty() でコ
+   * ピーするのと同じ結果になる。途中のノードの値はコピーされない。
+   *
+   * @else
+   * @brief Copy the values and the default values of the leaf nodes
+   *
+   * The same result as copying each key of propertyNames() with
+   * setDefault() and setProperty(). The values of the nodes on the way
+   * are not copied.
+   *
+   * @endif
+   */
+  void Properties::_copyLeaves(Properties& dst, const Properties& src)
+  {
+    dst.leaf.reserve(dst.leaf.size() + src.leaf.size());
+    for (auto prop : src.leaf)
+      {
+        Properties* node(dst.findChild(prop->name.data(), prop->name.size()));
+        if (node == nullptr)
+          {
+            node = dst.addChild(prop->name.data(), prop->name.size());
+          }
+        if (!prop->leaf.empty())
+          {
+            _copyLeaves(*node, *prop);
+            continue;
+          }
+        node->default_value = prop->default_value;
+        if (prop->set_value)
+          {
+            node->value = prop->value;
+            node->set_value = true;
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 末端ノードの数を数える
+   * @else
+   * @brief Count the leaf nodes
+   * @endif
+   */
+  size_t Properties::_countLeaves(const Properties& curr)
+  {
+    size_t count(0);
+    for (auto prop : curr.leaf)
+      {
+        count += prop->leaf.empty() ? 1 : _countLeaves(*prop);
+      }
+    return count;
+  }
+
   /*!
    * @if jp
    * @brief プロパティの名称リストを取得する
@@ -20,8 +20,10 @@
 #ifndef COIL_PROPERTIES_H
 #define COIL_PROPERTIES_H
 
+#include <cstddef>
 #include <limits>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -67,6 +69,10 @@ namespace coil
    * メソッドを持つ。また、入出力されるファイルは Java の Properties クラスが
    * 出力するものと互換性があるが、Unicode を含むものは扱うことができない。
    *
+   * キーは文字列を分割せずに '.' 区切りのまま辿る。子ノードが多いノード
+   * では名前のハッシュによる索引で子ノードを検索するため、数千のキー
+   * を持つプロパティでも検索の時間はキーの階層の深さにのみ依存する。
+   *
    * @since 0.4.0
    *
    * @else
@@ -94,6 +100,11 @@ namespace coil
    * outputs of Java's Properties class, but Unicode encoded property file
    * is not be supported.
    *
+   * Keys are walked along their '.' separators without splitting the
+   * string. Nodes with many children look them up through an index by
+   * the hash of the name, so that even with thousands of keys a lookup
+   * only depends on the depth of the key.
+   *
    * @endif
    */
   class Properties
@@ -1335,12 +1346,87 @@ namespace coil
     static std::string indent(size_t index);
 
   private:
+    /*!
+     * @if jp
+     * @brief 指定した名前の子ノードを検索する
+     * @else
+     * @brief Find the child with the given name
+     * @endif
+     */
+    Properties* findChild(const char* key, std::size_t len) const;
+
+    /*!
+     * @if jp
+     * @brief 子ノードを末尾に追加する
+     * @else
+     * @brief Append a child
+     * @endif
+     */
+    Properties* addChild(const char* key, std::size_t len);
+
+    /*!
+     * @if jp
+     * @brief 子ノードを leaf と索引から外す
+     * @else
+     * @brief Detach the child from leaf and the index
+     * @endif
+     */
+    bool detachChild(const Properties* child);
+
+    /*!
+     * @if jp
+     * @brief 子ノードの索引を名前の変更に合わせて更新する
+     * @else
+     * @brief Update the index for a renamed child
+     * @endif
+     */
+    void renameChild(Properties* child, const std::string& old_name);
+
+    /*!
+     * @if jp
+     * @brief キーのノードを検索する。空のキーの場合は NULL
+     * @else
+     * @brief Find the node of the key. NULL for an empty key
+     * @endif
+     */
+    Properties* findPath(const std::string& key) const;
+
+    /*!
+     * @if jp
+     * @brief キーのノードを、なければ途中のノードも含めて生成して返す
+     * @else
+     * @brief Return the node of the key, creating it and the nodes on
+     *        the way if missing
+     * @endif
+     */
+    Properties& createPath(const std::string& key);
+
+    /*!
+     * @if jp
+     * @brief 末端ノードの値とデフォルト値をコピーする
+     * @else
+     * @brief Copy the values and the default values of the leaf nodes
+     * @endif
+     */
+    static void _copyLeaves(Properties& dst, const Properties& src);
+
+    /*!
+     * @if jp
+     * @brief 末端ノードの数を数える
+     * @else
+     * @brief Count the leaf nodes
+     * @endif
+     */
+    static size_t _countLeaves(const Properties& curr);
+
     std::string name = "";
     std::string value = "";
     std::string default_value = "";
     bool set_value{false};
     Properties* root{nullptr};
     std::vector<Properties*> leaf;
+    // children by the hash of the name, once there are enough of them
+    std::unordered_multimap<std::size_t, Properties*> m_index;
     const std::string m_empty = "";
 
     /*!
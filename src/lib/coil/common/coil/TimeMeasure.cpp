@@ -18,6 +18,7 @@
  */
 
 #include <coil/TimeMeasure.h>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -163,4 +164,153 @@ namespace coil
     return s;
   }
 
+  constexpr size_t TimeHistogram::bucket_count;
+
+  /*!
+   * @if jp
+   * @brief 時間を記録する
+   * @else
+   * @brief Record a duration
+   * @endif
+   */
+  void TimeHistogram::record(std::chrono::nanoseconds value)
+  {
+    ++m_buckets[bucketIndex(value)];
+    ++m_count;
+    if (value > m_max) { m_max = value; }
+  }
+
+  /*!
+   * @if jp
+   * @brief 別に数えた記録を加える
+   * @else
+   * @brief Add records counted elsewhere
+   * @endif
+   */
+  void TimeHistogram::add(size_t index, unsigned long long count,
+                          std::chrono::nanoseconds max)
+  {
+    if (index >= bucket_count || count == 0) { return; }
+    m_buckets[index] += count;
+    m_count += count;
+    if (max > m_max) { m_max = max; }
+  }
+
+  /*!
+   * @if jp
+   * @brief 時間を記録するビンの番号
+   * @else
+   * @brief Index of the bin a duration is recorded in
+   * @endif
+   */
+  size_t TimeHistogram::bucketIndex(std::chrono::nanoseconds value)
+  {
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(value);
+    size_t index(0);
+    if (usec.count() > 0)
+      {
+        // index = floor(log2(usec)) + 1
+        auto v = static_cast<unsigned long long>(usec.count());
+        while (v != 0 && index < bucket_count - 1)
+          {
+            v >>= 1;
+            ++index;
+          }
+      }
+    return index;
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録を消去する
+   * @else
+   * @brief Clear the records
+   * @endif
+   */
+  void TimeHistogram::reset()
+  {
+    m_buckets.fill(0);
+    m_count = 0;
+    m_max = std::chrono::nanoseconds::zero();
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録した数
+   * @else
+   * @brief Number of records
+   * @endif
+   */
+  unsigned long long TimeHistogram::count() const
+  {
+    return m_count;
+  }
+
+  /*!
+   * @if jp
+   * @brief ビンの記録数
+   * @else
+   * @brief Number of records in a bin
+   * @endif
+   */
+  unsigned long long TimeHistogram::bucket(size_t index) const
+  {
+    return index < bucket_count ? m_buckets[index] : 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ビンの上限 (この値を含まない)
+   * @else
+   * @brief Upper bound of a bin (exclusive)
+   * @endif
+   */
+  std::chrono::nanoseconds TimeHistogram::upperBound(size_t index) const
+  {
+    if (index >= bucket_count - 1) { return m_max; }
+    return std::chrono::microseconds(1ULL << index);
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録された最大値
+   * @else
+   * @brief Largest recorded value
+   * @endif
+   */
+  std::chrono::nanoseconds TimeHistogram::max() const
+  {
+    return m_max;
+  }
+
+  /*!
+   * @if jp
+   * @brief パーセンタイル値
+   * @else
+   * @brief Percentile
+   * @endif
+   */
+  std::chrono::nanoseconds TimeHistogram::percentile(double ratio) const
+  {
+    if (m_count == 0) { return std::chrono::nanoseconds::zero(); }
+    if (ratio < 0.0) { ratio = 0.0; }
+    if (ratio > 1.0) { ratio = 1.0; }
+
+    auto target = static_cast<unsigned long long>(
+      std::ceil(ratio * static_cast<double>(m_count)));
+    if (target == 0) { target = 1; }
+    unsigned long long sum(0);
+    for (size_t i(0); i < bucket_count; ++i)
+      {
+        sum += m_buckets[i];
+        if (sum >= target)
+          {
+            // a bin bound beyond the largest value is less informative
+            // than the value itself
+            return std::min(upperBound(i), m_max);
+          }
+      }
+    return m_max;
+  }
+
 } // namespace coil
@@ -20,7 +20,9 @@
 #ifndef COIL_TIMEMEASURE_H
 #define COIL_TIMEMEASURE_H
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <vector>
 
 namespace coil
@@ -243,5 +245,175 @@ namespace coil
 
     bool m_recurred{false};
   };
+
+  /*!
+   * @if jp
+   *
+   * @class TimeHistogram
+   * @brief 時間のヒストグラム
+   *
+   * 時間を2のべき乗マイクロ秒ごとのビンに集計する。ビン 0 は 1us 未
+   * 満、ビン i (1 <= i < bucket_count - 1) は [2^(i-1)us, 2^i us) を
+   * 数え、最後のビンはそれ以上のすべてを数える。記録は固定長の配列へ
+   * の加算のみで、メモリ確保は行わない。
+   *
+   * @else
+   *
+   * @class TimeHistogram
+   * @brief Histogram of durations
+   *
+   * Counts durations in power-of-two microsecond bins. Bin 0 counts
+   * values below 1us, bin i (1 <= i < bucket_count - 1) counts
+   * [2^(i-1)us, 2^i us) and the last bin counts everything above.
+   * Recording only increments a fixed array and never allocates.
+   *
+   * @endif
+   */
+  class TimeHistogram
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief ビンの数
+     * @else
+     * @brief Number of bins
+     * @endif
+     */
+    static constexpr size_t bucket_count = 32;
+
+    /*!
+     * @if jp
+     * @brief 時間を記録する
+     * @param value 記録する時間。負の値はビン 0 に数える
+     * @else
+     * @brief Record a duration
+     * @param value Duration to record. Negative values go to bin 0
+     * @endif
+     */
+    void record(std::chrono::nanoseconds value);
+
+    /*!
+     * @if jp
+     * @brief 別に数えた記録を加える
+     *
+     * 他のスレッドから読み出すために atomic 変数などで数えた記録を、
+     * このヒストグラムに集める際に使う。
+     *
+     * @param index ビン番号
+     * @param count 記録数
+     * @param max 記録の最大値
+     *
+     * @else
+     * @brief Add records counted elsewhere
+     *
+     * Used to collect records counted, for example, in atomic
+     * variables to be read from other threads.
+     *
+     * @param index Bin index
+     * @param count Number of records
+     * @param max Largest value of the records
+     *
+     * @endif
+     */
+    void add(size_t index, unsigned long long count,
+             std::chrono::nanoseconds max);
+
+    /*!
+     * @if jp
+     * @brief 時間を記録するビンの番号
+     * @param value 時間
+     * @else
+     * @brief Index of the bin a duration is recorded in
+     * @param value Duration
+     * @endif
+     */
+    static size_t bucketIndex(std::chrono::nanoseconds value);
+
+    /*!
+     * @if jp
+     * @brief 記録を消去する
+     * @else
+     * @brief Clear the records
+     * @endif
+     */
+    void reset();
+
+    /*!
+     * @if jp
+     * @brief 記録した数
+     * @else
+     * @brief Number of records
+     * @endif
+     */
+    unsigned long long count() const;
+
+    /*!
+     * @if jp
+     * @brief ビンの記録数
+     * @param index ビン番号
+     * @else
+     * @brief Number of records in a bin
+     * @param index Bin index
+     * @endif
+     */
+    unsigned long long bucket(size_t index) const;
+
+    /*!
+     * @if jp
+     * @brief ビンの上限 (この値を含まない)
+     *
+     * 最後のビンは上限を持たないため、記録された最大値を返す。
+     *
+     * @param index ビン番号
+     *
+     * @else
+     * @brief Upper bound of a bin (exclusive)
+     *
+     * The last bin has no upper bound, so the largest recorded value
+     * is returned for it.
+     *
+     * @param index Bin index
+     *
+     * @endif
+     */
+    std::chrono::nanoseconds upperBound(size_t index) const;
+
+    /*!
+     * @if jp
+     * @brief 記録された最大値
+     * @else
+     * @brief Largest recorded value
+     * @endif
+     */
+    std::chrono::nanoseconds max() const;
+
+    /*!
+     * @if jp
+     * @brief パーセンタイル値
+     *
+     * 指定した割合の記録が収まるビンの上限を返す。精度はビンの幅に
+     * 依存する。
+     *
+     * @param ratio 割合 (0.0 - 1.0)
+     * @return 上限値。記録がない場合は 0
+     *
+     * @else
+     * @brief Percentile
+     *
+     * Returns the upper bound of the bin in which the given ratio of
+     * the records falls. The precision is that of the bin width.
+     *
+     * @param ratio Ratio (0.0 - 1.0)
+     * @return Upper bound, or 0 if nothing has been recorded
+     *
+     * @endif
+     */
+    std::chrono::nanoseconds percentile(double ratio) const;
+
+  private:
+    std::array<unsigned long long, bucket_count> m_buckets{};
+    unsigned long long m_count{0};
+    std::chrono::nanoseconds m_max{0};
+  };
 } // namespace coil
 #endif  // COIL_TIMEMEASURE_H
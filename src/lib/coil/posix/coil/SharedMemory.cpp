@@ -266,7 +266,13 @@ namespace coil
     
     if (created())
     {
+	if (m_shm != nullptr && m_shm != MAP_FAILED)
+	{
+	    munmap(m_shm, static_cast<size_t>(m_memory_size));
+	}
 	::close(m_fd);
+	m_shm = nullptr;
+	m_fd = -1;
     }
     else
     {
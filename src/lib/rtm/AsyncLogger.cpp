@@ -0,0 +1,304 @@
+﻿// -*- C++ -*-
+/*!
+ * @file AsyncLogger.cpp
+ * @brief Asynchronous log output backend
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/AsyncLogger.h>
+#include <rtm/SystemLogger.h>
+
+#include <algorithm>
+
+namespace RTC
+{
+  namespace
+  {
+    // The output thread also polls the queues at this interval, so
+    // producers only have to wake it up when a queue fills up.
+    const std::chrono::milliseconds drain_interval(10);
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  AsyncLogger::AsyncLogger()
+  {
+    init(coil::Properties());
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  AsyncLogger::~AsyncLogger()
+  {
+    stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定を行う
+   * @else
+   * @brief Configure the backend
+   * @endif
+   */
+  void AsyncLogger::init(const coil::Properties& prop)
+  {
+    m_queueProp["length"] = prop.getProperty("queue_length", "1024");
+    std::string policy(coil::normalize(prop.getProperty("full_policy",
+                                                        "drop")));
+    m_queueProp["write.full_policy"] =
+      (policy == "block") ? "block" : "do_nothing";
+    m_queueProp["write.timeout"] = prop.getProperty("timeout", "1.0");
+    m_queueProp["read.empty_policy"] = "do_nothing";
+  }
+
+  /*!
+   * @if jp
+   * @brief 出力スレッドを開始する
+   * @else
+   * @brief Start the output thread
+   * @endif
+   */
+  void AsyncLogger::start(coil::LogStreamBuffer* stream)
+  {
+    if (m_running.exchange(true)) { return; }
+    m_stream = stream;
+    m_notice.level = Logger::RTL_WARN;
+    m_notice.name = "AsyncLogger";
+    m_notice.dateFormat = "%b %d %H:%M:%S";
+    m_notice.stream = stream;
+    m_thread = std::thread([this] { svc(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief 出力スレッドを停止する
+   * @else
+   * @brief Stop the output thread
+   * @endif
+   */
+  void AsyncLogger::stop()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (!m_running.exchange(false)) { return; }
+      m_wake = true;
+    }
+    m_cond.notify_one();
+    if (m_thread.joinable()) { m_thread.join(); }
+    if (m_stream != nullptr) { m_stream->flush(); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 出力スレッドが動作中かどうか
+   * @else
+   * @brief Whether the output thread is running
+   * @endif
+   */
+  bool AsyncLogger::isRunning() const
+  {
+    return m_running.load();
+  }
+
+  /*!
+   * @if jp
+   * @brief 呼び出しスレッドのキューにレコードを投入する
+   * @else
+   * @brief Push a record into the queue of the calling thread
+   * @endif
+   */
+  bool AsyncLogger::push(int level, std::chrono::nanoseconds time,
+                         const std::string& name,
+                         const std::string& dateFormat,
+                         bool msEnable, bool usEnable,
+                         coil::LogStreamBuffer* stream,
+                         const std::string& message)
+  {
+    if (!m_running.load()) { return false; }
+
+    // The scratch record and the queue slots keep their string
+    // capacity, so steady-state logging does not allocate here.
+    Producer* producer(local());
+    Record& record(producer->scratch);
+    record.level = level;
+    record.time = time;
+    record.name = name;
+    record.dateFormat = dateFormat;
+    record.msEnable = msEnable;
+    record.usEnable = usEnable;
+    record.stream = stream;
+    record.message = message;
+
+    if (producer->queue.write(record) != BufferStatus::OK)
+      {
+        ++m_dropped;
+        notify();
+      }
+    else if (producer->queue.readable() * 2 >= producer->queue.length())
+      {
+        notify();
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 破棄したレコードの総数
+   * @else
+   * @brief Total number of discarded records
+   * @endif
+   */
+  unsigned long long AsyncLogger::dropped() const
+  {
+    return m_dropped.load();
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  AsyncLogger::ProducerHolder::~ProducerHolder()
+  {
+    if (producer) { producer->closed = true; }
+  }
+
+  AsyncLogger::Producer* AsyncLogger::local()
+  {
+    thread_local ProducerHolder holder;
+    if (!holder.producer)
+      {
+        auto producer = std::make_shared<Producer>();
+        producer->queue.init(m_queueProp);
+        std::lock_guard<std::mutex> guard(m_producersMutex);
+        m_producers.push_back(producer);
+        holder.producer = std::move(producer);
+      }
+    return holder.producer.get();
+  }
+
+  void AsyncLogger::svc()
+  {
+    while (true)
+      {
+        bool running(m_running.load());
+        size_t count(collect());
+
+        // records of different threads are written in time order
+        m_order.resize(count);
+        for (size_t i(0); i < count; ++i) { m_order[i] = i; }
+        std::stable_sort(m_order.begin(), m_order.end(),
+                         [this](size_t a, size_t b)
+                         {
+                           return m_records[a].time < m_records[b].time;
+                         });
+        for (auto const& i : m_order) { output(m_records[i]); }
+        if (count != 0)
+          {
+            // warnings about dropped records follow the latest date format
+            const Record& last(m_records[m_order.back()]);
+            m_notice.dateFormat = last.dateFormat;
+            m_notice.msEnable = last.msEnable;
+            m_notice.usEnable = last.usEnable;
+          }
+        reportDropped();
+
+        if (!running)
+          {
+            // keep draining until records pushed while stopping are out
+            if (count == 0) { break; }
+            continue;
+          }
+        if (count != 0) { continue; }
+
+        std::unique_lock<std::mutex> guard(m_mutex);
+        m_waiting = true;
+        m_cond.wait_for(guard, drain_interval,
+                        [this] { return m_wake || !m_running.load(); });
+        m_waiting = false;
+        m_wake = false;
+      }
+  }
+
+  size_t AsyncLogger::collect()
+  {
+    size_t count(0);
+    std::lock_guard<std::mutex> guard(m_producersMutex);
+    for (auto it = m_producers.begin(); it != m_producers.end();)
+      {
+        Producer& producer(**it);
+        // check before reading so that nothing is pushed after the
+        // last read of a closed queue
+        bool closed(producer.closed.load());
+        for (size_t n(producer.queue.readable()); n > 0; --n)
+          {
+            if (count == m_records.size()) { m_records.emplace_back(); }
+            if (producer.queue.read(m_records[count]) != BufferStatus::OK)
+              {
+                break;
+              }
+            ++count;
+          }
+        if (closed && producer.queue.empty())
+          {
+            it = m_producers.erase(it);
+          }
+        else
+          {
+            ++it;
+          }
+      }
+    return count;
+  }
+
+  void AsyncLogger::output(const Record& record)
+  {
+    if (record.stream == nullptr) { return; }
+    record.stream->write(record.level, record.name,
+                         Logger::formatDate(record.dateFormat,
+                                            record.msEnable,
+                                            record.usEnable,
+                                            record.time),
+                         record.message);
+  }
+
+  void AsyncLogger::reportDropped()
+  {
+    unsigned long long dropped(m_dropped.load());
+    if (dropped == m_reported) { return; }
+
+    m_notice.message = coil::sprintf("%llu log messages were dropped.",
+                                     dropped - m_reported);
+    m_reported = dropped;
+    m_notice.time =
+      coil::ClockManager::instance().getClock("system").gettime();
+    output(m_notice);
+  }
+
+  void AsyncLogger::notify()
+  {
+    if (!m_waiting.load()) { return; }
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_wake = true;
+    }
+    m_cond.notify_one();
+  }
+} // namespace RTC
@@ -0,0 +1,256 @@
+﻿// -*- C++ -*-
+/*!
+ * @file AsyncLogger.h
+ * @brief Asynchronous log output backend
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_ASYNCLOGGER_H
+#define RTC_ASYNCLOGGER_H
+
+#include <coil/Logger.h>
+#include <coil/Properties.h>
+#include <coil/Singleton.h>
+#include <rtm/SPSCRingBuffer.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class AsyncLogger
+   * @brief 非同期ログ出力バックエンド
+   *
+   * ログを出力するスレッドごとに SPSCRingBuffer のキューを持ち、ログ
+   * レコード (レベル、時刻、ロガー名、日時書式、メッセージ) をロック
+   * なしで投入する。1つの出力スレッドがすべてのキューからレコードを
+   * 回収し、時刻順に並べた上で日時文字列の生成とログストリームへの出
+   * 力を行う。
+   *
+   * キューが満杯の場合の動作は logger.async.full_policy で指定する。
+   *
+   * - drop:  レコードを破棄する (デフォルト)。破棄した数は後で警告とし
+   *          て出力する
+   * - block: logger.async.timeout の間、空きを待つ。タイムアウトした
+   *          場合は破棄する
+   *
+   * 停止中は push() が false を返すため、呼び出し側は同期的に出力す
+   * る。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class AsyncLogger
+   * @brief Asynchronous log output backend
+   *
+   * Each thread that logs owns an SPSCRingBuffer queue into which log
+   * records (level, time, logger name, date format, message) are pushed
+   * without locking. A single output thread collects the records from
+   * all queues, orders them by time, renders the date strings and
+   * writes them to the log streams.
+   *
+   * logger.async.full_policy selects what happens when a queue is full.
+   *
+   * - drop:  Discard the record (default). The number of discarded
+   *          records is reported later as a warning.
+   * - block: Wait up to logger.async.timeout for free space, and
+   *          discard the record on timeout.
+   *
+   * push() returns false while the backend is stopped, in which case
+   * the caller writes synchronously.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class AsyncLogger
+    : public coil::Singleton<AsyncLogger>
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief ログレコード
+     * @else
+     * @brief Log record
+     * @endif
+     */
+    struct Record
+    {
+      int level{0};
+      std::chrono::nanoseconds time{0};
+      std::string name;
+      std::string dateFormat;
+      bool msEnable{false};
+      bool usEnable{false};
+      coil::LogStreamBuffer* stream{nullptr};
+      std::string message;
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    AsyncLogger();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~AsyncLogger();
+
+    /*!
+     * @if jp
+     * @brief 設定を行う
+     *
+     * logger.async 以下のプロパティを与える。queue_length,
+     * full_policy, timeout が有効である。開始前に呼ぶこと。
+     *
+     * @param prop logger.async 以下のプロパティ
+     *
+     * @else
+     * @brief Configure the backend
+     *
+     * Takes the properties under logger.async. queue_length,
+     * full_policy and timeout are recognized. Call it before start().
+     *
+     * @param prop Properties under logger.async
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 出力スレッドを開始する
+     *
+     * @param stream 破棄したレコード数の警告の出力先
+     *
+     * @else
+     * @brief Start the output thread
+     *
+     * @param stream Destination for warnings about discarded records
+     *
+     * @endif
+     */
+    void start(coil::LogStreamBuffer* stream);
+
+    /*!
+     * @if jp
+     * @brief 出力スレッドを停止する
+     *
+     * キューに残っているレコードをすべて出力してから停止する。
+     *
+     * @else
+     * @brief Stop the output thread
+     *
+     * Writes out every record left in the queues before stopping.
+     *
+     * @endif
+     */
+    void stop();
+
+    /*!
+     * @if jp
+     * @brief 出力スレッドが動作中かどうか
+     * @else
+     * @brief Whether the output thread is running
+     * @endif
+     */
+    bool isRunning() const;
+
+    /*!
+     * @if jp
+     * @brief 呼び出しスレッドのキューにレコードを投入する
+     *
+     * @return true: 受け付けた (破棄した場合を含む)
+     *         false: 停止中のため受け付けなかった
+     *
+     * @else
+     * @brief Push a record into the queue of the calling thread
+     *
+     * @return true: accepted, including when discarded
+     *         false: not accepted because the backend is stopped
+     *
+     * @endif
+     */
+    bool push(int level, std::chrono::nanoseconds time,
+              const std::string& name, const std::string& dateFormat,
+              bool msEnable, bool usEnable,
+              coil::LogStreamBuffer* stream, const std::string& message);
+
+    /*!
+     * @if jp
+     * @brief 破棄したレコードの総数
+     * @else
+     * @brief Total number of discarded records
+     * @endif
+     */
+    unsigned long long dropped() const;
+
+  private:
+    using Queue = SPSCRingBuffer<Record>;
+
+    struct Producer
+    {
+      Queue queue;
+      Record scratch;
+      std::atomic<bool> closed{false};
+    };
+
+    struct ProducerHolder
+    {
+      std::shared_ptr<Producer> producer;
+      ~ProducerHolder();
+    };
+
+    Producer* local();
+    void svc();
+    size_t collect();
+    void output(const Record& record);
+    void reportDropped();
+    void notify();
+
+    coil::Properties m_queueProp;
+    std::vector<std::shared_ptr<Producer> > m_producers;
+    std::mutex m_producersMutex;
+
+    std::vector<Record> m_records;
+    std::vector<size_t> m_order;
+    coil::LogStreamBuffer* m_stream{nullptr};
+    Record m_notice;
+
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_waiting{false};
+    std::atomic<unsigned long long> m_dropped{0};
+    unsigned long long m_reported{0};
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_wake{false};
+  };
+} // namespace RTC
+
+#endif // RTC_ASYNCLOGGER_H
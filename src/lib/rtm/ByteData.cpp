@@ -1,8 +1,16 @@
 ﻿#include "ByteData.h"
+#include "ByteDataPool.h"
+#include <atomic>
 #include <cstring>
+#include <utility>
 
 namespace RTC
 {
+    namespace
+    {
+        std::atomic<std::uint64_t> copied_bytes{0};
+    } // namespace
+
     /*!
      * @if jp
      *
@@ -36,10 +44,7 @@ namespace RTC
      *
      * @endif
      */
-    ByteData::~ByteData()
-    {
-        delete[] m_buf;
-    }
+    ByteData::~ByteData() = default;
 
     /*!
      * @if jp
@@ -59,10 +64,35 @@ namespace RTC
      * @endif
      */
     ByteData::ByteData(const ByteData &rhs)
+      : m_buf(rhs.m_buf), m_pool(rhs.m_pool), m_len(rhs.m_len),
+        m_capacity(rhs.m_capacity), m_little_endian(rhs.m_little_endian)
     {
-        m_len = rhs.m_len;
-        m_buf = new unsigned char[m_len];
-        memcpy(m_buf, rhs.m_buf, m_len);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief ムーブコンストラクタ
+     *
+     * @param rhs
+     *
+     *
+     * @else
+     *
+     * @brief Move Constructor
+     *
+     * @param rhs
+     *
+     *
+     * @endif
+     */
+    ByteData::ByteData(ByteData &&rhs) noexcept
+      : m_buf(std::move(rhs.m_buf)), m_pool(std::move(rhs.m_pool)),
+        m_len(rhs.m_len), m_capacity(rhs.m_capacity),
+        m_little_endian(rhs.m_little_endian)
+    {
+        rhs.m_len = 0;
+        rhs.m_capacity = 0;
     }
 
 
@@ -84,9 +114,9 @@ namespace RTC
      */
     ByteData::ByteData(const ByteDataStreamBase &rhs)
     {
-        m_len = rhs.getDataLength();
-        m_buf = new unsigned char[m_len];
-        rhs.readData(m_buf, m_len);
+        allocate(rhs.getDataLength());
+        rhs.readData(m_buf.get(), m_len);
+        countCopy(m_len);
     }
     /*!
      * @if jp
@@ -108,13 +138,38 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteData &rhs)
     {
-        if(m_len != rhs.m_len)
-        {
-            m_len = rhs.m_len;
-            delete[] m_buf;
-            m_buf = new unsigned char[m_len];
-        }
-        memcpy(m_buf, rhs.m_buf, m_len);
+        m_buf = rhs.m_buf;
+        m_len = rhs.m_len;
+        m_capacity = rhs.m_capacity;
+        m_little_endian = rhs.m_little_endian;
+        return *this;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief ムーブ代入演算子
+     *
+     * @param rhs
+     * @return
+     *
+     *
+     * @else
+     *
+     * @brief Move assignment operator
+     *
+     * @param rhs
+     * @return
+     *
+     * @endif
+     */
+    ByteData& ByteData::operator= (ByteData &&rhs) noexcept
+    {
+        m_buf = std::move(rhs.m_buf);
+        m_len = rhs.m_len;
+        m_capacity = rhs.m_capacity;
+        m_little_endian = rhs.m_little_endian;
+        rhs.m_len = 0;
+        rhs.m_capacity = 0;
         return *this;
     }
     /*!
@@ -137,13 +192,9 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteDataStreamBase &rhs)
     {
-        if(m_len != rhs.getDataLength())
-        {
-            m_len = rhs.getDataLength();
-            delete[] m_buf;
-            m_buf = new unsigned char[m_len];
-        }
-        rhs.readData(m_buf, m_len);
+        allocate(rhs.getDataLength());
+        rhs.readData(m_buf.get(), m_len);
+        countCopy(m_len);
         return *this;
     }
     /*!
@@ -164,7 +215,7 @@ namespace RTC
      */
     unsigned char* ByteData::getBuffer() const
     {
-        return m_buf;
+        return m_buf.get();
     }
     /*!
      * @if jp
@@ -216,7 +267,7 @@ namespace RTC
         {
             return;
         }
-        memcpy(data, m_buf, length);
+        memcpy(data, m_buf.get(), length);
     }
 
     /*!
@@ -246,13 +297,9 @@ namespace RTC
             return;
         }
 
-        if(m_len != length)
-        {
-            delete[] m_buf;
-            m_len = length;
-            m_buf = new unsigned char[length];
-        }
-        memcpy(m_buf, data, length);
+        allocate(length);
+        memcpy(m_buf.get(), data, length);
+        countCopy(length);
     }
     /*!
      * @if jp
@@ -294,14 +341,23 @@ namespace RTC
      */
     void ByteData::setDataLength(unsigned long length)
     {
-        if (length <= 0 || m_len == length)
+        if (length <= 0)
         {
             return;
         }
-        delete[] m_buf;
-
-        m_len = length;
-        m_buf = new unsigned char[m_len];
+        if (m_len == length)
+        {
+            if (m_buf.use_count() > 1)
+            {
+                // keep the contents, but stop sharing them
+                std::shared_ptr<unsigned char> shared(m_buf);
+                allocate(length);
+                memcpy(m_buf.get(), shared.get(), length);
+                countCopy(length);
+            }
+            return;
+        }
+        allocate(length);
     }
     /*!
      * @if jp
@@ -324,4 +380,177 @@ namespace RTC
     {
         return m_little_endian;
     }
+    /*!
+     * @if jp
+     *
+     * @brief ByteData のバッファへコピーされた総バイト数を取得
+     *
+     * @return コピーされた総バイト数
+     *
+     *
+     * @else
+     *
+     * @brief Get the total number of bytes copied into ByteData buffers
+     *
+     * @return The total number of copied bytes
+     *
+     * @endif
+     */
+    std::uint64_t ByteData::getCopiedBytes()
+    {
+        return copied_bytes.load(std::memory_order_relaxed);
+    }
+    /*!
+     * @if jp
+     *
+     * @brief 書き込み可能なバッファを確保
+     *
+     * 他の ByteData と共有しておらず容量が足りるバッファがあれば
+     * それを再利用し、それ以外の場合は新しいバッファを確保する。
+     * バッファは縮小しない。メモリプールが設定されていればそこから
+     * 確保する。
+     *
+     * @param length バッファの長さ
+     *
+     *
+     * @else
+     *
+     * @brief Allocate a writable buffer
+     *
+     * The current buffer is reused if it is large enough and is not
+     * shared with other ByteData. Otherwise a new buffer is allocated.
+     * The buffer never shrinks. It is taken from the memory pool if
+     * one is set.
+     *
+     * @param length The length of the buffer
+     *
+     * @endif
+     */
+    void ByteData::allocate(unsigned long length)
+    {
+        if (length <= m_capacity && m_buf.use_count() == 1)
+        {
+            m_len = length;
+            return;
+        }
+        m_len = length;
+        if (length == 0)
+        {
+            m_buf.reset();
+            m_capacity = 0;
+            return;
+        }
+        if (m_pool)
+        {
+            m_buf = m_pool->allocate(length, m_capacity);
+            return;
+        }
+        m_buf.reset(new unsigned char[length],
+                    std::default_delete<unsigned char[]>());
+        m_capacity = length;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief コピーしたバイト数を加算
+     *
+     * @param length コピーしたバイト数
+     *
+     *
+     * @else
+     *
+     * @brief Add the number of copied bytes
+     *
+     * @param length The number of copied bytes
+     *
+     * @endif
+     */
+    void ByteData::countCopy(unsigned long length)
+    {
+        copied_bytes.fetch_add(length, std::memory_order_relaxed);
+    }
+    /*!
+     * @if jp
+     *
+     * @brief バッファを確保するメモリプールを設定
+     *
+     * 以降に確保するバッファに適用される。nullptr の場合はヒープか
+     * ら確保する。
+     *
+     * @param pool メモリプール
+     *
+     * @else
+     *
+     * @brief Set the memory pool to allocate buffers from
+     *
+     * Applies to the buffers allocated afterwards. With nullptr they
+     * are allocated from the heap.
+     *
+     * @param pool The memory pool
+     *
+     * @endif
+     */
+    void ByteData::setPool(const std::shared_ptr<ByteDataPool>& pool)
+    {
+        m_pool = pool;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief バッファを確保するメモリプールを取得
+     *
+     * @return メモリプール
+     *
+     * @else
+     *
+     * @brief Get the memory pool to allocate buffers from
+     *
+     * @return The memory pool
+     *
+     * @endif
+     */
+    const std::shared_ptr<ByteDataPool>& ByteData::getPool() const
+    {
+        return m_pool;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief バッファの一部を共有する ByteData を取得
+     *
+     * 返される ByteData は offset から length バイトを指し、このオ
+     * ブジェクトとバッファを共有する。
+     *
+     * @param offset 先頭からのオフセット
+     * @param length データの長さ
+     * @return バッファの一部を指す ByteData
+     *
+     * @else
+     *
+     * @brief Get a ByteData sharing a part of the buffer
+     *
+     * The returned ByteData refers to length bytes from offset and
+     * shares the buffer with this object.
+     *
+     * @param offset The offset from the beginning
+     * @param length The data length
+     * @return ByteData referring to the part of the buffer
+     *
+     * @endif
+     */
+    ByteData ByteData::slice(unsigned long offset, unsigned long length) const
+    {
+        ByteData ret;
+        ret.m_pool = m_pool;
+        if (offset + length <= m_len)
+        {
+            // aliasing constructor: shares the owner, points into it
+            ret.m_buf = std::shared_ptr<unsigned char>(m_buf,
+                                                       m_buf.get() + offset);
+            ret.m_len = length;
+            ret.m_capacity = length;
+        }
+        ret.m_little_endian = m_little_endian;
+        return ret;
+    }
 } // namespace RTC
@@ -3,15 +3,26 @@
 
 
 #include "ByteDataStreamBase.h"
+#include <cstdint>
+#include <memory>
 
 namespace RTC
 {
+    class ByteDataPool;
+
     /*!
      * @if jp
      * @class ByteData
      * @brief シリアライズ後のバイト列を操作するクラス
      * 
-     *
+     * バッファは参照カウントで共有され、コピーや代入ではバイト列の
+     * 複製は行わない。writeData() や setDataLength() でバッファを
+     * 変更する場合、他の ByteData と共有されていれば新しいバッファを
+     * 確保してから変更する(コピーオンライト)。getBuffer() で得た
+     * ポインタに書き込む場合は、事前に setDataLength() を呼ぶこと。
+     * setPool() でメモリプールを設定すると、新しいバッファはそこから
+     * 確保される。メモリプールはコピーコンストラクタでは引き継がれ、
+     * 代入では引き継がれない。
      *
      * @param
      *
@@ -21,6 +32,14 @@ namespace RTC
      * @class ByteData
      * @brief
      *
+     * The buffer is reference counted and shared, so copying or
+     * assigning a ByteData does not duplicate the bytes.
+     * writeData() and setDataLength() allocate a new buffer before
+     * modifying it if it is shared with another ByteData
+     * (copy-on-write). Call setDataLength() before writing through the
+     * pointer returned by getBuffer(). When a memory pool is set by
+     * setPool(), new buffers are allocated from it. The memory pool is
+     * inherited by the copy constructor but not by assignment.
      *
      * @since 2.0.0
      *
@@ -77,6 +96,24 @@ namespace RTC
          * @endif
          */
         ByteData(const ByteData &rhs);
+        /*!
+         * @if jp
+         *
+         * @brief ムーブコンストラクタ
+         *
+         * @param rhs
+         *
+         *
+         * @else
+         *
+         * @brief Move Constructor
+         *
+         * @param rhs
+         *
+         *
+         * @endif
+         */
+        ByteData(ByteData &&rhs) noexcept;
         /*!
          * @if jp
          *
@@ -113,6 +150,25 @@ namespace RTC
          * @endif
          */
         ByteData& operator= (const ByteData &rhs);
+        /*!
+         * @if jp
+         *
+         * @brief ムーブ代入演算子
+         *
+         * @param rhs
+         * @return
+         *
+         *
+         * @else
+         *
+         * @brief Move assignment operator
+         *
+         * @param rhs
+         * @return
+         *
+         * @endif
+         */
+        ByteData& operator= (ByteData &&rhs) noexcept;
         /*!
          * @if jp
          *
@@ -262,9 +318,123 @@ namespace RTC
          * @endif
          */
         bool getEndian();
+        /*!
+         * @if jp
+         *
+         * @brief ByteData のバッファへコピーされた総バイト数を取得
+         *
+         * プロセス内の全 ByteData がバイト列を複製した累積バイト数を返す。
+         * サンプルあたりのコピー量の計測に用いる。
+         *
+         * @return コピーされた総バイト数
+         *
+         *
+         * @else
+         *
+         * @brief Get the total number of bytes copied into ByteData buffers
+         *
+         * Return the accumulated number of bytes duplicated by all
+         * ByteData objects in this process. This is used to measure
+         * the amount of copying per sample.
+         *
+         * @return The total number of copied bytes
+         *
+         * @endif
+         */
+        static std::uint64_t getCopiedBytes();
+        /*!
+         * @if jp
+         *
+         * @brief コピーしたバイト数を加算
+         *
+         * ByteData 以外でペイロードを複製する箇所 (シリアライザのスト
+         * リーム等) が getCopiedBytes() の計測に含めるために呼ぶ。
+         *
+         * @param length コピーしたバイト数
+         *
+         * @else
+         *
+         * @brief Add to the number of copied bytes
+         *
+         * Called by the places that duplicate a payload outside
+         * ByteData (serializer streams etc.) so that the copy is
+         * included in getCopiedBytes().
+         *
+         * @param length The number of copied bytes
+         *
+         * @endif
+         */
+        static void countCopy(unsigned long length);
+        /*!
+         * @if jp
+         *
+         * @brief バッファの一部を共有する ByteData を取得
+         *
+         * 返される ByteData は offset から length バイトを指し、このオ
+         * ブジェクトとバッファを共有する。
+         *
+         * @param offset 先頭からのオフセット
+         * @param length データの長さ
+         * @return バッファの一部を指す ByteData
+         *
+         * @else
+         *
+         * @brief Get a ByteData sharing a part of the buffer
+         *
+         * The returned ByteData refers to length bytes from offset and
+         * shares the buffer with this object.
+         *
+         * @param offset The offset from the beginning
+         * @param length The data length
+         * @return ByteData referring to the part of the buffer
+         *
+         * @endif
+         */
+        ByteData slice(unsigned long offset, unsigned long length) const;
+        /*!
+         * @if jp
+         *
+         * @brief バッファを確保するメモリプールを設定
+         *
+         * 以降に確保するバッファに適用される。nullptr の場合はヒープか
+         * ら確保する。
+         *
+         * @param pool メモリプール
+         *
+         * @else
+         *
+         * @brief Set the memory pool to allocate buffers from
+         *
+         * Applies to the buffers allocated afterwards. With nullptr they
+         * are allocated from the heap.
+         *
+         * @param pool The memory pool
+         *
+         * @endif
+         */
+        void setPool(const std::shared_ptr<ByteDataPool>& pool);
+        /*!
+         * @if jp
+         *
+         * @brief バッファを確保するメモリプールを取得
+         *
+         * @return メモリプール
+         *
+         * @else
+         *
+         * @brief Get the memory pool to allocate buffers from
+         *
+         * @return The memory pool
+         *
+         * @endif
+         */
+        const std::shared_ptr<ByteDataPool>& getPool() const;
     private:
-        unsigned char* m_buf{nullptr};
+        void allocate(unsigned long length);
+        std::shared_ptr<unsigned char> m_buf;
+        std::shared_ptr<ByteDataPool> m_pool;
         unsigned long m_len{0};
+        unsigned long m_capacity{0};
         bool m_little_endian{true};
     };
 
@@ -0,0 +1,278 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ByteDataPool.cpp
+ * @brief Size-class memory pool for ByteData buffers
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ByteDataPool.h>
+#include <coil/stringutil.h>
+
+#include <new>
+
+namespace RTC
+{
+  namespace
+  {
+    // the smallest class; a shared_ptr control block fits in it
+    const std::size_t min_shift(6);
+    const std::size_t min_size(std::size_t(1) << min_shift);
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief shared_ptr の制御ブロックをプールから確保するアロケータ
+   *
+   * 制御ブロックの解放はデリータの呼び出しより後になるため、プール
+   * への参照はアロケータが保持する。
+   *
+   * @else
+   * @brief Allocator taking the shared_ptr control block from the pool
+   *
+   * The control block is released after the deleter is called, so the
+   * allocator holds the reference to the pool.
+   *
+   * @endif
+   */
+  template <class T>
+  class ByteDataPool::ControlAllocator
+  {
+  public:
+    using value_type = T;
+    explicit ControlAllocator(std::shared_ptr<ByteDataPool> pool)
+      : m_pool(std::move(pool)) {}
+    template <class U>
+    ControlAllocator(const ControlAllocator<U>& rhs) : m_pool(rhs.m_pool) {}
+
+    T* allocate(std::size_t n)
+    {
+      // deallocate() only knows n, so the class must match exactly
+      std::size_t size;
+      return static_cast<T*>(m_pool->allocateBlock(n * sizeof(T), size,
+                                                   false));
+    }
+    void deallocate(T* p, std::size_t n)
+    {
+      m_pool->deallocateBlock(p, n * sizeof(T));
+    }
+    template <class U>
+    bool operator==(const ControlAllocator<U>& rhs) const
+    {
+      return m_pool == rhs.m_pool;
+    }
+    template <class U>
+    bool operator!=(const ControlAllocator<U>& rhs) const
+    {
+      return m_pool != rhs.m_pool;
+    }
+
+    std::shared_ptr<ByteDataPool> m_pool;
+  };
+
+  /*!
+   * @if jp
+   * @brief バッファをプールに戻すデリータ
+   * @else
+   * @brief Deleter returning the buffer to the pool
+   * @endif
+   */
+  class ByteDataPool::Deleter
+  {
+  public:
+    Deleter(ByteDataPool* pool, std::size_t size)
+      : m_pool(pool), m_size(size) {}
+    void operator()(unsigned char* p) const
+    {
+      m_pool->deallocateBlock(p, m_size);
+    }
+  private:
+    ByteDataPool* m_pool;
+    std::size_t m_size;
+  };
+
+  ByteDataPool::ByteDataPool(std::size_t max_cached_bytes)
+    : m_maxCachedBytes(max_cached_bytes)
+  {
+  }
+
+  ByteDataPool::~ByteDataPool()
+  {
+    trim();
+  }
+
+  std::shared_ptr<ByteDataPool>
+  ByteDataPool::create(const coil::Properties& prop)
+  {
+    if (!coil::toBool(prop["memory_pool"], "YES", "NO", true))
+      {
+        return nullptr;
+      }
+    std::size_t max_cached_bytes(0);
+    coil::stringTo(max_cached_bytes,
+                   prop["memory_pool.max_cached_size"].c_str());
+    return std::make_shared<ByteDataPool>(max_cached_bytes);
+  }
+
+  std::shared_ptr<unsigned char>
+  ByteDataPool::allocate(unsigned long length, unsigned long& capacity)
+  {
+    std::size_t size;
+    unsigned char* block(static_cast<unsigned char*>(allocateBlock(length,
+                                                                   size,
+                                                                   true)));
+    capacity = static_cast<unsigned long>(size);
+    try
+      {
+        return std::shared_ptr<unsigned char>(
+          block, Deleter(this, size),
+          ControlAllocator<unsigned char>(shared_from_this()));
+      }
+    catch (...)
+      {
+        deallocateBlock(block, size);
+        throw;
+      }
+  }
+
+  void ByteDataPool::trim()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto & list : m_free)
+      {
+        m_stats.releases += list.size();
+        for (auto & block : list)
+          {
+            ::operator delete(block);
+          }
+        list.clear();
+      }
+    m_stats.cachedBytes = 0;
+  }
+
+  ByteDataPool::Statistics ByteDataPool::getStatistics() const
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_stats;
+  }
+
+  /*!
+   * @if jp
+   * @brief サイズクラスの番号と大きさを求める
+   *
+   * (2^n, 2^(n+1)] の区間を4等分し、length を含む区間の上端をクラス
+   * の大きさとする。切り上げによる無駄は最大で25%。
+   *
+   * @else
+   * @brief Get the index and the size of the size class
+   *
+   * The interval (2^n, 2^(n+1)] is divided into four and the upper end
+   * of the part containing length is the size of the class. At most 25%
+   * is wasted by rounding up.
+   *
+   * @endif
+   */
+  std::size_t ByteDataPool::sizeClass(std::size_t length, std::size_t& size)
+  {
+    if (length <= min_size)
+      {
+        size = min_size;
+        return 0;
+      }
+    std::size_t shift(min_shift);
+    while (((length - 1) >> (shift + 1)) != 0) { ++shift; }
+    std::size_t base(std::size_t(1) << shift);
+    std::size_t step(base / 4);
+    std::size_t sub((length - 1 - base) / step);
+    size = base + (sub + 1) * step;
+    return (shift - min_shift) * 4 + sub + 1;
+  }
+
+  std::size_t ByteDataPool::classSize(std::size_t index)
+  {
+    if (index == 0) { return min_size; }
+    std::size_t base(std::size_t(1) << (min_shift + (index - 1) / 4));
+    return base + ((index - 1) % 4 + 1) * (base / 4);
+  }
+
+  void* ByteDataPool::allocateBlock(std::size_t length, std::size_t& size,
+                                    bool larger)
+  {
+    std::size_t index(sizeClass(length, size));
+    std::size_t last(larger ? index + 4 : index);
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      // A block of up to one doubling larger is taken as well, so
+      // that varying sizes do not keep the free lists of neighbouring
+      // classes growing separately.
+      for (std::size_t i(index); i < m_free.size() && i <= last; ++i)
+        {
+          if (m_free[i].empty()) { continue; }
+          void* block(m_free[i].back());
+          m_free[i].pop_back();
+          size = classSize(i);
+          m_stats.cachedBytes -= size;
+          ++m_stats.reuses;
+          addUsed(size);
+          return block;
+        }
+      ++m_stats.allocations;
+      addUsed(size);
+    }
+    try
+      {
+        return ::operator new(size);
+      }
+    catch (...)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stats.usedBytes -= size;
+        --m_stats.allocations;
+        throw;
+      }
+  }
+
+  void ByteDataPool::addUsed(std::size_t size)
+  {
+    m_stats.usedBytes += size;
+    if (m_stats.usedBytes > m_stats.peakUsedBytes)
+      {
+        m_stats.peakUsedBytes = m_stats.usedBytes;
+      }
+  }
+
+  void ByteDataPool::deallocateBlock(void* block, std::size_t length)
+  {
+    std::size_t size;
+    std::size_t index(sizeClass(length, size));
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stats.usedBytes -= size;
+      if (m_maxCachedBytes == 0 ||
+          m_stats.cachedBytes + size <= m_maxCachedBytes)
+        {
+          try
+            {
+              if (index >= m_free.size()) { m_free.resize(index + 1); }
+              m_free[index].push_back(block);
+              m_stats.cachedBytes += size;
+              return;
+            }
+          catch (...)
+            {
+              // no memory to keep it; give it back below
+            }
+        }
+      ++m_stats.releases;
+    }
+    ::operator delete(block);
+  }
+} // namespace RTC
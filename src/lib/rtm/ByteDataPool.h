@@ -0,0 +1,206 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ByteDataPool.h
+ * @brief Size-class memory pool for ByteData buffers
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_BYTEDATAPOOL_H
+#define RTC_BYTEDATAPOOL_H
+
+#include <coil/Properties.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class ByteDataPool
+   * @brief ByteData のバッファ用メモリプール
+   *
+   * 要求された長さをサイズクラス (2のべき乗の区間を4分割した大きさ)
+   * に切り上げて確保し、解放されたブロックはクラスごとのフリーリスト
+   * に保持して再利用する。空きがなければ2倍までの大きさのクラスの
+   * ブロックも使用する。保持されるブロックは同時に使用された最大量
+   * (ハイウォーターマーク) を超えないため、データサイズが変動しても
+   * 定常状態ではヒープ確保が発生しない。shared_ptr の制御ブロックも
+   * 同じプールから確保する。
+   *
+   * ByteData::setPool() で設定して使用する。ブロックはプールへの参照
+   * を保持するため、プールは最後のブロックが解放されるまで破棄されな
+   * い。std::make_shared で生成すること。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class ByteDataPool
+   * @brief Memory pool for ByteData buffers
+   *
+   * A requested length is rounded up to a size class (a power of two
+   * interval divided into four) and freed blocks are kept on per class
+   * free lists for reuse. Blocks of classes up to twice as large are
+   * also used when a class has none free. The kept blocks never exceed
+   * the largest amount used at once (the high-water mark), so even with
+   * varying data sizes there are no heap allocations in the steady
+   * state. The control blocks of shared_ptr are allocated from the same
+   * pool.
+   *
+   * Used by setting it with ByteData::setPool(). Blocks hold a
+   * reference to the pool, so it is not destroyed until the last block
+   * is released. Create it with std::make_shared.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class ByteDataPool : public std::enable_shared_from_this<ByteDataPool>
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 統計情報
+     * @else
+     * @brief Statistics
+     * @endif
+     */
+    struct Statistics
+    {
+      //! heap allocations
+      std::uint64_t allocations{0};
+      //! allocations served from the free lists
+      std::uint64_t reuses{0};
+      //! blocks returned to the heap
+      std::uint64_t releases{0};
+      //! bytes of the blocks in use
+      std::size_t usedBytes{0};
+      //! bytes of the blocks kept on the free lists
+      std::size_t cachedBytes{0};
+      //! largest usedBytes so far
+      std::size_t peakUsedBytes{0};
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * @param max_cached_bytes フリーリストに保持する最大バイト数。0
+     *                         の場合は制限しない
+     *
+     * @else
+     * @brief Constructor
+     *
+     * @param max_cached_bytes Maximum bytes kept on the free lists.
+     *                         0 means no limit
+     *
+     * @endif
+     */
+    explicit ByteDataPool(std::size_t max_cached_bytes = 0);
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~ByteDataPool();
+
+    /*!
+     * @if jp
+     * @brief コネクタのバッファ設定からメモリプールを生成する
+     *
+     * - memory_pool: YES/NO (デフォルト YES)
+     * - memory_pool.max_cached_size: フリーリストに保持する最大バイト
+     *   数 (デフォルト 0: 制限なし)
+     *
+     * @param prop buffer 以下のプロパティ
+     * @return メモリプール。無効の場合は nullptr
+     *
+     * @else
+     * @brief Create a memory pool from the buffer settings of a connector
+     *
+     * - memory_pool: YES/NO (default YES)
+     * - memory_pool.max_cached_size: Maximum bytes kept on the free
+     *   lists (default 0: no limit)
+     *
+     * @param prop The properties under buffer
+     * @return The memory pool. nullptr if disabled
+     *
+     * @endif
+     */
+    static std::shared_ptr<ByteDataPool> create(const coil::Properties& prop);
+
+    ByteDataPool(const ByteDataPool&) = delete;
+    ByteDataPool& operator=(const ByteDataPool&) = delete;
+
+    /*!
+     * @if jp
+     * @brief バッファを確保する
+     *
+     * @param length 必要な長さ
+     * @param capacity 確保したブロックの大きさ
+     * @return バッファ。最後の参照がなくなるとプールに戻る
+     *
+     * @else
+     * @brief Allocate a buffer
+     *
+     * @param length The required length
+     * @param capacity The size of the allocated block
+     * @return The buffer. Returned to the pool when the last reference
+     *         goes away
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> allocate(unsigned long length,
+                                            unsigned long& capacity);
+
+    /*!
+     * @if jp
+     * @brief フリーリストのブロックをすべてヒープに返す
+     * @else
+     * @brief Return all blocks on the free lists to the heap
+     * @endif
+     */
+    void trim();
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     * @else
+     * @brief Get the statistics
+     * @endif
+     */
+    Statistics getStatistics() const;
+
+  private:
+    template <class T> class ControlAllocator;
+    class Deleter;
+
+    static std::size_t sizeClass(std::size_t length, std::size_t& size);
+    static std::size_t classSize(std::size_t index);
+    void* allocateBlock(std::size_t length, std::size_t& size, bool larger);
+    void addUsed(std::size_t size);
+    void deallocateBlock(void* block, std::size_t length);
+
+    mutable std::mutex m_mutex;
+    std::vector<std::vector<void*> > m_free;
+    std::size_t m_maxCachedBytes;
+    Statistics m_stats;
+  };
+} // namespace RTC
+
+#endif // RTC_BYTEDATAPOOL_H
@@ -19,6 +19,7 @@
 
 
 #include <rtm/ByteDataStreamBase.h>
+#include <rtm/ByteData.h>
 
 namespace RTC
 {
@@ -92,5 +93,23 @@ namespace RTC
 
     }
 
+    /*!
+     * @if jp
+     * @brief ByteData のバッファを参照してデータを設定
+     *
+     * @param data データ
+     *
+     * @else
+     * @brief Set the data referring to the buffer of ByteData
+     *
+     * @param data The data
+     *
+     * @endif
+     */
+    void ByteDataStreamBase::shareData(const ByteData& data)
+    {
+        writeData(data.getBuffer(), data.getDataLength());
+    }
+
 
 } // namespace RTC
@@ -40,6 +40,8 @@
  */
 namespace RTC
 {
+  class ByteData;
+
 /*!
    * @if jp
    * @class ByteDataStreamBase
@@ -171,6 +173,28 @@ namespace RTC
       * @endif
       */
      virtual void isLittleEndian(bool little_endian);
+     /*!
+      * @if jp
+      * @brief ByteData のバッファを参照してデータを設定
+      *
+      * 次に writeData() 等でデータを設定するまで data のバッファを参照
+      * したまま復号に使用し、バイト列を複製しない。既定の実装は
+      * writeData() でコピーする。
+      *
+      * @param data データ
+      *
+      * @else
+      * @brief Set the data referring to the buffer of ByteData
+      *
+      * The buffer of data is referred to for decoding, without
+      * duplicating the bytes, until the data is next set by writeData()
+      * etc. The default implementation copies it with writeData().
+      *
+      * @param data The data
+      *
+      * @endif
+      */
+     virtual void shareData(const ByteData& data);
   };
 
   /*!
@@ -52,6 +52,10 @@ namespace RTC
 #elif defined(ORB_IS_TAO)
         m_cdr.reset();
 #else
+#ifdef ORB_IS_OMNIORB
+        m_view.reset();
+        m_shared = ByteData();
+#endif
         m_cdr.rewindPtrs();
         m_cdr.setByteSwapFlag(little_endian);
 #endif
@@ -64,6 +68,12 @@ namespace RTC
 #elif defined(ORB_IS_TAO)
         return static_cast<unsigned long>(m_cdr.total_length());
 #else
+#ifdef ORB_IS_OMNIORB
+        if (m_view)
+        {
+            return m_shared.getDataLength();
+        }
+#endif
         return m_cdr.bufSize();
 #endif
     }
@@ -75,6 +85,12 @@ namespace RTC
 #elif defined(ORB_IS_TAO)
         return (unsigned char*)m_cdr.begin();
 #else
+#ifdef ORB_IS_OMNIORB
+        if (m_view)
+        {
+            return m_shared.getBuffer();
+        }
+#endif
         return static_cast<unsigned char*>(m_cdr.bufPtr());
 #endif
     }
@@ -100,8 +116,13 @@ namespace RTC
 #elif defined(ORB_IS_RTORB)
         m_cdr.put_octet_array(reinterpret_cast<char*>(const_cast<unsigned char*>(buffer)), length);
 #else
+#ifdef ORB_IS_OMNIORB
+        m_view.reset();
+        m_shared = ByteData();
+#endif
         m_cdr.put_octet_array(buffer, length);
 #endif
+        ByteData::countCopy(length);
     }
 
     void CORBA_CdrMemoryStream::readCdrData(unsigned char* buffer, unsigned long length) const
@@ -119,9 +140,31 @@ namespace RTC
             buf += len;
         }
 #else
+#ifdef ORB_IS_OMNIORB
+        if (m_view)
+        {
+            m_shared.readData(buffer, length);
+            return;
+        }
+#endif
         memcpy(buffer, m_cdr.bufPtr(), length);
 #endif
     }
 
+    void CORBA_CdrMemoryStream::shareCdrData(const ByteData& data)
+    {
+#ifdef ORB_IS_OMNIORB
+        if (data.getDataLength() != 0)
+        {
+            m_shared = data;
+            m_view.reset(new cdrMemoryStream(m_shared.getBuffer(),
+                                             m_shared.getDataLength()));
+            m_view->setByteSwapFlag(m_endian);
+            return;
+        }
+#endif
+        writeCdrData(data.getBuffer(), data.getDataLength());
+    }
+
 
 } // namespace RTC
@@ -23,6 +23,10 @@
 #include <rtm/RTC.h>
 #include <rtm/idl/DataPort_OpenRTMSkel.h>
 #include <rtm/ByteDataStreamBase.h>
+#include <rtm/ByteData.h>
+#ifdef ORB_IS_OMNIORB
+#include <memory>
+#endif
 
 
 
@@ -131,6 +135,10 @@ namespace RTC
 #else
             try
             {
+#ifdef ORB_IS_OMNIORB
+                m_view.reset();
+                m_shared = ByteData();
+#endif
                 m_cdr.rewindPtrs();
                 m_cdr.setByteSwapFlag(m_endian);
                 data >>= m_cdr;
@@ -189,6 +197,13 @@ namespace RTC
 #else
             try
             {
+#ifdef ORB_IS_OMNIORB
+                if (m_view)
+                {
+                    data <<= *m_view;
+                    return true;
+                }
+#endif
                 data <<= m_cdr;
                 return true;
             }
@@ -322,6 +337,37 @@ namespace RTC
          */
         void readCdrData(unsigned char* buffer, unsigned long length) const;
 
+        /*!
+         * @if jp
+         *
+         * @brief ByteData のバッファを参照してデータを設定する
+         *
+         * omniORB では data のバッファを直接読む入力ストリームを作り、
+         * 次に書き込みやエンディアンの設定が行われるまで
+         * deserializeCDR() はそれを使用する。バッファのアラインメン
+         * トが CDR の要求を満たさない場合は omniORB 内部でコピーされ
+         * る。その他の ORB では writeCdrData() でコピーする。
+         *
+         * @param data データ
+         *
+         *
+         * @else
+         *
+         * @brief Set the data referring to the buffer of ByteData
+         *
+         * With omniORB an input stream reading the buffer of data
+         * directly is created, and deserializeCDR() uses it until the
+         * next write or endian setting. If the buffer is not aligned as
+         * CDR requires, omniORB copies it internally. With other ORBs
+         * the data is copied by writeCdrData().
+         *
+         * @param data The data
+         *
+         *
+         * @endif
+         */
+        void shareCdrData(const ByteData& data);
+
         /*!
          * @if jp
          * @brief コピーコンストラクタ
@@ -336,6 +382,7 @@ namespace RTC
          * @endif
          */
         CORBA_CdrMemoryStream(const CORBA_CdrMemoryStream &rhs)
+          : m_endian(rhs.m_endian)
         {
 #ifdef ORB_IS_ORBEXPRESS
             m_cdr.copy(rhs.m_cdr);
@@ -346,6 +393,12 @@ namespace RTC
         }
 #else
             m_cdr = rhs.m_cdr;
+#ifdef ORB_IS_OMNIORB
+            if (rhs.m_view)
+            {
+                shareCdrData(rhs.m_shared);
+            }
+#endif
 #endif
         }
 
@@ -378,6 +431,15 @@ namespace RTC
             return *this;
 #else
             m_cdr = rhs.m_cdr;
+#ifdef ORB_IS_OMNIORB
+            m_view.reset();
+            m_shared = ByteData();
+            if (rhs.m_view)
+            {
+                m_endian = rhs.m_endian;
+                shareCdrData(rhs.m_shared);
+            }
+#endif
             return *this;
 #endif
         }
@@ -391,6 +453,11 @@ namespace RTC
         cdrMemoryStream m_cdr;
 #endif
         bool m_endian{true};
+#ifdef ORB_IS_OMNIORB
+        // shareCdrData() で設定した受信データとその入力ストリーム
+        ByteData m_shared;
+        std::unique_ptr<cdrMemoryStream> m_view;
+#endif
     };
     /*!
      * @if jp
@@ -484,6 +551,27 @@ namespace RTC
         {
             m_cdr.writeCdrData(buffer, length);
         }
+        /*!
+         * @if jp
+         *
+         * @brief ByteData のバッファを参照してデータを設定
+         *
+         * @param data データ
+         *
+         *
+         * @else
+         *
+         * @brief Set the data referring to the buffer of ByteData
+         *
+         * @param data The data
+         *
+         *
+         * @endif
+         */
+        void shareData(const ByteData& data) override
+        {
+            m_cdr.shareCdrData(data);
+        }
 
         /*!
          * @if jp
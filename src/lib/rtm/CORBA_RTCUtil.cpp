@@ -19,7 +19,11 @@
 
 #include <rtm/CORBA_RTCUtil.h>
 #include <rtm/NamingManager.h>
+#include <rtm/ExecutionContextBase.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
 #include <utility>
 
 namespace CORBA_RTCUtil
@@ -249,6 +253,97 @@ namespace CORBA_RTCUtil
     if (CORBA::is_nil(ec)) { return RTC::BAD_PARAMETER; }
     return ec->reset_component(rtc);
   }
+
+  namespace
+  {
+    RTC::ExecutionContextBase* local_ec(RTC::ExecutionContext_ptr ec)
+    {
+#ifndef ORB_IS_RTORB
+      try
+        {
+          PortableServer::POA_var poa = ::RTC::Manager::instance().getPOA();
+          return dynamic_cast<RTC::ExecutionContextBase*>
+            (poa->reference_to_servant(ec));
+        }
+      catch (...)
+        {
+          // a remote EC
+        }
+#endif
+      return nullptr;
+    }
+
+    std::vector<RTC::ReturnCode_t>
+    change_states(RTC::RTCList& rtcs, RTC::UniqueId ec_id, bool activation)
+    {
+      std::vector<RTC::ReturnCode_t> ret(rtcs.length(), RTC::BAD_PARAMETER);
+      // the indexes of the RTCs for each local EC
+      std::vector<std::pair<RTC::ExecutionContextBase*,
+                            std::vector<CORBA::ULong> > > local;
+      for (CORBA::ULong i(0); i < rtcs.length(); ++i)
+        {
+          if (CORBA::is_nil(rtcs[i])) { continue; }
+          RTC::ExecutionContext_var ec = get_actual_ec(rtcs[i], ec_id);
+          if (CORBA::is_nil(ec)) { continue; }
+          RTC::ExecutionContextBase* base(local_ec(ec.in()));
+          if (base == nullptr)
+            {
+              ret[i] = activation ? ec->activate_component(rtcs[i])
+                                  : ec->deactivate_component(rtcs[i]);
+              continue;
+            }
+          auto it = std::find_if(local.begin(), local.end(),
+            [base](const std::pair<RTC::ExecutionContextBase*,
+                                   std::vector<CORBA::ULong> >& e)
+            { return e.first == base; });
+          if (it == local.end())
+            {
+              local.emplace_back(base, std::vector<CORBA::ULong>());
+              it = local.end() - 1;
+            }
+          it->second.emplace_back(i);
+        }
+      for (auto & ec : local)
+        {
+          std::vector<RTC::LightweightRTObject_ptr> comps;
+          for (auto i : ec.second) { comps.emplace_back(rtcs[i]); }
+          std::vector<RTC::ReturnCode_t> rets =
+            activation ? ec.first->activateComponents(comps)
+                       : ec.first->deactivateComponents(comps);
+          for (size_t j(0); j < rets.size(); ++j)
+            {
+              ret[ec.second[j]] = rets[j];
+            }
+        }
+      return ret;
+    }
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief 複数のRTCを指定した実行コンテキストでアクティベーションする
+   * @else
+   * @brief Activate RTCs in the specified execution context
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t> activate_components(RTC::RTCList& rtcs,
+                                                     RTC::UniqueId ec_id)
+  {
+    return change_states(rtcs, ec_id, true);
+  }
+
+  /*!
+   * @if jp
+   * @brief 複数のRTCを指定した実行コンテキストで非アクティベーションする
+   * @else
+   * @brief Deactivate RTCs in the specified execution context
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t> deactivate_components(RTC::RTCList& rtcs,
+                                                       RTC::UniqueId ec_id)
+  {
+    return change_states(rtcs, ec_id, false);
+  }
   /*!
    * @if jp
    * @brief 対象のRTコンポーネントの指定した実行コンテキストでの状態を取得
@@ -1173,19 +1268,17 @@ namespace CORBA_RTCUtil
                                   const RTC::PortService_ptr port,
                                   RTC::PortServiceList& target_ports)
   {
-    RTC::ReturnCode_t ret(RTC::RTC_OK);
-    for (CORBA::ULong i(0); i < target_ports.length(); ++i)
-      {
-        if (target_ports[i]->_is_equivalent(port)) { continue; }
-        if (CORBA_RTCUtil::already_connected(port, target_ports[i]))
-          { continue; }
-        if (RTC::RTC_OK !=
-            CORBA_RTCUtil::connect(name, prop, port, target_ports[i]))
-          {
-            ret = RTC::RTC_ERROR;
-          }
-      }
-    return ret;
+    PortCache cache;
+    return cache.connect_multi(name, prop, port, target_ports);
+  }
+
+  RTC::ReturnCode_t connect_multi(const std::string& name,
+                                  const coil::Properties& prop,
+                                  const RTC::PortService_ptr port,
+                                  RTC::PortServiceList* target_ports)
+  {
+    if (target_ports == nullptr) { return RTC::BAD_PARAMETER; }
+    return connect_multi(name, prop, port, *target_ports);
   }
   /*!
    * @if jp
@@ -1276,6 +1369,397 @@ namespace CORBA_RTCUtil
     // Connect
     return connect(name, prop, port0, port1);
   }
+
+  namespace
+  {
+    // the maximum passed to _hash()
+    const CORBA::ULong hash_max(0x7fffffff);
+    const size_t no_port(static_cast<size_t>(-1));
+
+    bool connectedTo(const RTC::ConnectorProfileList& conprof,
+                     const RTC::PortService_ptr otherport)
+    {
+      for (CORBA::ULong i(0); i < conprof.length(); ++i)
+        {
+          for (CORBA::ULong j(0); j < conprof[i].ports.length(); ++j)
+            {
+              if (conprof[i].ports[j]->_is_equivalent(otherport))
+                {
+                  return true;
+                }
+            }
+        }
+      return false;
+    }
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief 監視している RTC のポートの接続・切断でキャッシュを無効にする
+   *        リスナ
+   *
+   * RTC から削除されるまで PortCache より長く残ることがあるため、世代
+   * カウンタを共有する。
+   *
+   * @else
+   * @brief Listener invalidating the cache when a port of a watched RTC
+   *        is connected or disconnected
+   *
+   * It may outlive the PortCache until removed from the RTC, so the
+   * generation counter is shared.
+   *
+   * @endif
+   */
+  class PortCache::Invalidator
+    : public RTC::PortConnectRetListener
+  {
+  public:
+    explicit Invalidator(std::shared_ptr<std::atomic<unsigned long> > generation)
+      : m_generation(std::move(generation)) {}
+    void operator()(const char* /*portname*/,
+                    RTC::ConnectorProfile& /*profile*/,
+                    RTC::ReturnCode_t /*ret*/) override
+    {
+      ++(*m_generation);
+    }
+  private:
+    std::shared_ptr<std::atomic<unsigned long> > m_generation;
+  };
+
+  PortCache::PortCache()
+    : m_generation(std::make_shared<std::atomic<unsigned long> >(0))
+  {
+  }
+
+  PortCache::~PortCache()
+  {
+    for (auto & watch : m_watched)
+      {
+        watch.rtc->removePortConnectRetListener(watch.type, watch.listener);
+      }
+  }
+
+  void PortCache::watch(RTC::RTObject_impl* rtc)
+  {
+    if (rtc == nullptr) { return; }
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto type : {RTC::ON_CONNECTED, RTC::ON_DISCONNECTED})
+      {
+        Invalidator* listener(new Invalidator(m_generation));
+        rtc->addPortConnectRetListener(type, listener, true);
+        m_watched.push_back({rtc, type, listener});
+      }
+  }
+
+  RTC::PortService_ptr PortCache::get_port_by_name(RTC::RTObject_ptr rtc,
+                                                   const std::string& name)
+  {
+    if (CORBA::is_nil(rtc)) { return RTC::PortService::_nil(); }
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      const RtcEntry& entry(m_rtcs[findRtc(rtc)]);
+      if (entry.listed)
+        {
+          for (auto index : entry.ports)
+            {
+              if (m_ports[index].name == name)
+                {
+                  return RTC::PortService::_duplicate(m_ports[index].port.in());
+                }
+            }
+          return RTC::PortService::_nil();
+        }
+    }
+
+    // the remote calls are made without the lock
+    RTC::PortServiceList_var ports = rtc->get_ports();
+    coil::vstring names;
+    for (CORBA::ULong p(0); p < ports->length(); ++p)
+      {
+        RTC::PortProfile_var pp = ports[p]->get_port_profile();
+        names.emplace_back(pp->name);
+      }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    RtcEntry& entry(m_rtcs[findRtc(rtc)]);
+    entry.ports.clear();
+    RTC::PortService_ptr found(RTC::PortService::_nil());
+    for (CORBA::ULong p(0); p < ports->length(); ++p)
+      {
+        size_t index(findPort(ports[p]));
+        m_ports[index].name = names[p];
+        m_ports[index].named = true;
+        entry.ports.emplace_back(index);
+        if (CORBA::is_nil(found) && names[p] == name)
+          {
+            found = m_ports[index].port.in();
+          }
+      }
+    entry.listed = true;
+    return RTC::PortService::_duplicate(found);
+  }
+
+  std::string PortCache::get_port_name(RTC::PortService_ptr port)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      const PortEntry& entry(m_ports[findPort(port)]);
+      if (entry.named) { return entry.name; }
+    }
+    RTC::PortProfile_var prof = port->get_port_profile();
+    std::string name(prof->name);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    PortEntry& entry(m_ports[findPort(port)]);
+    entry.name = name;
+    entry.named = true;
+    return name;
+  }
+
+  bool PortCache::already_connected(RTC::PortService_ptr localport,
+                                    RTC::PortService_ptr otherport)
+  {
+    if (localport->_is_equivalent(otherport))
+      {
+        return false;
+      }
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      const PortEntry& entry(m_ports[findPort(localport)]);
+      if (hasConnectors(entry))
+        {
+          return connectedTo(entry.connectors.in(), otherport);
+        }
+    }
+    // a change while fetching leaves the snapshot stale
+    unsigned long generation(m_generation->load());
+    RTC::ConnectorProfileList_var conprof;
+    conprof = localport->get_connector_profiles();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    PortEntry& entry(m_ports[findPort(localport)]);
+    entry.connectors = conprof._retn();
+    entry.generation = generation;
+    entry.fetched = true;
+    return connectedTo(entry.connectors.in(), otherport);
+  }
+
+  RTC::ReturnCode_t PortCache::connect_multi(const std::string& name,
+                                             const coil::Properties& prop,
+                                             RTC::PortService_ptr port,
+                                             RTC::PortServiceList& target_ports,
+                                             size_t jobs)
+  {
+    std::vector<Connection> connections;
+    for (CORBA::ULong i(0); i < target_ports.length(); ++i)
+      {
+        if (target_ports[i]->_is_equivalent(port)) { continue; }
+        if (already_connected(port, target_ports[i])) { continue; }
+        connections.emplace_back();
+        Connection& connection(connections.back());
+        connection.name = name;
+        connection.prop = prop;
+        connection.port0 = RTC::PortService::_duplicate(port);
+        connection.port1 = RTC::PortService::_duplicate(target_ports[i]);
+      }
+    return connect_all(connections, jobs);
+  }
+
+  RTC::ReturnCode_t PortCache::connect_all(std::vector<Connection>& connections,
+                                           size_t jobs)
+  {
+    std::vector<std::pair<size_t, size_t> > ports(connections.size());
+    std::vector<size_t> pending;
+    std::vector<bool> busy;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      for (size_t i(0); i < connections.size(); ++i)
+        {
+          Connection& connection(connections[i]);
+          if (CORBA::is_nil(connection.port0))
+            {
+              connection.result = RTC::BAD_PARAMETER;
+              continue;
+            }
+          ports[i].first = findPort(connection.port0.in());
+          ports[i].second = CORBA::is_nil(connection.port1) ? no_port
+            : findPort(connection.port1.in());
+          // the same port on both ends, as connect() rejects
+          if (ports[i].first == ports[i].second)
+            {
+              connection.result = RTC::BAD_PARAMETER;
+              continue;
+            }
+          pending.emplace_back(i);
+        }
+      busy.resize(m_ports.size(), false);
+    }
+
+    std::condition_variable cond;
+    auto isBusy = [&](size_t index)
+      {
+        return index != no_port && busy[index];
+      };
+    auto setBusy = [&](size_t index, bool value)
+      {
+        if (index != no_port) { busy[index] = value; }
+      };
+    auto worker = [&]()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!pending.empty())
+          {
+            auto it = std::find_if(pending.begin(), pending.end(),
+                                   [&](size_t i)
+                                   {
+                                     return !isBusy(ports[i].first) &&
+                                       !isBusy(ports[i].second);
+                                   });
+            if (it == pending.end())
+              {
+                cond.wait(lock);
+                continue;
+              }
+            size_t i(*it);
+            pending.erase(it);
+            setBusy(ports[i].first, true);
+            setBusy(ports[i].second, true);
+            lock.unlock();
+
+            Connection& connection(connections[i]);
+            try
+              {
+                RTC::ConnectorProfile_var cprof;
+                cprof = create_connector(connection.name, connection.prop,
+                                         connection.port0.in(),
+                                         connection.port1.in());
+                connection.result = connection.port0->connect(cprof);
+              }
+            catch (...)
+              {
+                connection.result = RTC::RTC_ERROR;
+              }
+
+            lock.lock();
+            setBusy(ports[i].first, false);
+            setBusy(ports[i].second, false);
+            invalidatePort(ports[i].first);
+            invalidatePort(ports[i].second);
+            cond.notify_all();
+          }
+      };
+
+    if (jobs == 0) { jobs = std::thread::hardware_concurrency(); }
+    jobs = std::max<size_t>(1, std::min(jobs, pending.size()));
+    std::vector<std::thread> threads;
+    for (size_t i(1); i < jobs; ++i)
+      {
+        try
+          {
+            threads.emplace_back(worker);
+          }
+        catch (...)
+          {
+            break;  // the rest are made by fewer threads
+          }
+      }
+    worker();
+    for (auto & thread : threads)
+      {
+        thread.join();
+      }
+
+    for (const auto & connection : connections)
+      {
+        if (connection.result != RTC::RTC_OK) { return RTC::RTC_ERROR; }
+      }
+    return RTC::RTC_OK;
+  }
+
+  void PortCache::invalidate(RTC::RTObject_ptr rtc)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    RtcEntry& entry(m_rtcs[findRtc(rtc)]);
+    for (auto index : entry.ports)
+      {
+        invalidatePort(index);
+      }
+    entry.ports.clear();
+    entry.listed = false;
+  }
+
+  void PortCache::invalidate(RTC::PortService_ptr port)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    invalidatePort(findPort(port));
+  }
+
+  void PortCache::clear()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_ports.clear();
+    m_portIndex.clear();
+    m_rtcs.clear();
+    m_rtcIndex.clear();
+  }
+
+  /*!
+   * @if jp
+   * @brief ポートのエントリを検索し、なければ追加する
+   *
+   * _hash() と _is_equivalent() はリモート呼び出しを行わない。
+   *
+   * @else
+   * @brief Find the entry of the port, adding it if missing
+   *
+   * _hash() and _is_equivalent() make no remote calls.
+   *
+   * @endif
+   */
+  size_t PortCache::findPort(RTC::PortService_ptr port)
+  {
+    CORBA::ULong hash(port->_hash(hash_max));
+    auto range(m_portIndex.equal_range(hash));
+    for (auto it(range.first); it != range.second; ++it)
+      {
+        if (m_ports[it->second].port->_is_equivalent(port))
+          {
+            return it->second;
+          }
+      }
+    m_ports.emplace_back();
+    m_ports.back().port = RTC::PortService::_duplicate(port);
+    m_portIndex.emplace(hash, m_ports.size() - 1);
+    return m_ports.size() - 1;
+  }
+
+  size_t PortCache::findRtc(RTC::RTObject_ptr rtc)
+  {
+    CORBA::ULong hash(rtc->_hash(hash_max));
+    auto range(m_rtcIndex.equal_range(hash));
+    for (auto it(range.first); it != range.second; ++it)
+      {
+        if (m_rtcs[it->second].rtc->_is_equivalent(rtc))
+          {
+            return it->second;
+          }
+      }
+    m_rtcs.emplace_back();
+    m_rtcs.back().rtc = RTC::RTObject::_duplicate(rtc);
+    m_rtcIndex.emplace(hash, m_rtcs.size() - 1);
+    return m_rtcs.size() - 1;
+  }
+
+  bool PortCache::hasConnectors(const PortEntry& entry) const
+  {
+    return entry.fetched && entry.generation == m_generation->load();
+  }
+
+  void PortCache::invalidatePort(size_t index)
+  {
+    // clear() may have run during connect_all()
+    if (index < m_ports.size()) { m_ports[index].fetched = false; }
+  }
   /*!
    * @if jp
    * @brief 対象のRTコンポーネントの指定した名前のコンフィギュレーションセットをkey-valueで取得
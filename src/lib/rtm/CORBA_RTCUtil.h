@@ -23,7 +23,13 @@
 #include <rtm/CORBA_SeqUtil.h>
 #include <rtm/RTObject.h>
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 namespace CORBA_RTCUtil
@@ -71,6 +77,7 @@ namespace CORBA_RTCUtil
    * disconnect_by_connector_name()
    * disconnect_by_connector_id()
    * disconnect_by_port_name()
+   * PortCache
    *
    * - コンフィギュレーション系
    * get_configuration()
@@ -274,6 +281,61 @@ namespace CORBA_RTCUtil
    */
   RTC::ReturnCode_t reset(RTC::RTObject_ptr rtc, RTC::UniqueId ec_id = 0);
 
+  /*!
+   * @if jp
+   * @brief 複数のRTCを指定した実行コンテキストでアクティベーションする
+   *
+   * 同じプロセス内の実行コンテキストに属するRTCは実行コンテキストごと
+   * にまとめ、すべての状態遷移を要求してから1度だけ完了を待つ。それ以
+   * 外のRTCは activate() と同様に1つずつアクティベーションする。
+   *
+   * @param rtcs 対象のRTコンポーネントのリスト
+   * @param ec_id 実行コンテキストのID
+   * @return rtcs と同じ順序のリターンコード。RTC、ECのオブジェクトリファ
+   * レンスがnilの場合はBAD_PARAMETER
+   * @else
+   * @brief Activate RTCs in the specified execution context
+   *
+   * The RTCs of execution contexts in this process are grouped by the
+   * execution context, and all their transitions are requested before
+   * waiting once. The other RTCs are activated one by one as activate()
+   * does.
+   *
+   * @param rtcs The target RT-Components
+   * @param ec_id The ID of the execution context
+   * @return The return codes in the order of rtcs. BAD_PARAMETER if the
+   * reference of the RTC or the EC is nil
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t> activate_components(RTC::RTCList& rtcs,
+                                                     RTC::UniqueId ec_id = 0);
+
+  /*!
+   * @if jp
+   * @brief 複数のRTCを指定した実行コンテキストで非アクティベーションする
+   *
+   * activate_components() と同様に、同じプロセス内の実行コンテキスト
+   * に属するRTCはまとめて非アクティベーションする。
+   *
+   * @param rtcs 対象のRTコンポーネントのリスト
+   * @param ec_id 実行コンテキストのID
+   * @return rtcs と同じ順序のリターンコード。RTC、ECのオブジェクトリファ
+   * レンスがnilの場合はBAD_PARAMETER
+   * @else
+   * @brief Deactivate RTCs in the specified execution context
+   *
+   * As activate_components(), the RTCs of execution contexts in this
+   * process are deactivated together.
+   *
+   * @param rtcs The target RT-Components
+   * @param ec_id The ID of the execution context
+   * @return The return codes in the order of rtcs. BAD_PARAMETER if the
+   * reference of the RTC or the EC is nil
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t> deactivate_components(RTC::RTCList& rtcs,
+                                                       RTC::UniqueId ec_id = 0);
+
 
 
   /*!
@@ -819,6 +881,10 @@ namespace CORBA_RTCUtil
     const coil::Properties& prop,
     RTC::PortService_ptr port,
     RTC::PortServiceList* target_ports);
+  RTC::ReturnCode_t connect_multi(const std::string& name,
+    const coil::Properties& prop,
+    RTC::PortService_ptr port,
+    RTC::PortServiceList& target_ports);
   /*!
    * @if jp
    * @brief ポートを名前から検索
@@ -897,6 +963,290 @@ namespace CORBA_RTCUtil
                                     RTC::RTObject_ptr rtc1,
                                     const std::string& portName1);
 
+  /*!
+   * @if jp
+   * @class PortCache
+   * @brief 一連の接続処理のためのポート情報のキャッシュ
+   *
+   * RTC のポートリスト、ポート名、ポートのコネクタプロファイルのスナッ
+   * プショットを保持し、同じ RTC やポートについての get_ports(),
+   * get_port_profile(), get_connector_profiles() のリモート呼び出しを
+   * 1回にする。多数のポートを接続する間だけ生成して使用する。
+   *
+   * コネクタプロファイルは、このキャッシュで接続したポート、invalidate()
+   * したポート、および watch() したローカルの RTC のポートで接続・切断
+   * (ON_CONNECTED, ON_DISCONNECTED) があった場合に取得し直す。ポート
+   * の追加・削除は invalidate(RTObject_ptr) で反映する。
+   *
+   * connect_all() はすべての接続を並行して行う。同じポートを含む接続
+   * は PortBase::notify_connect() で直列化され、互いに逆向きの接続が
+   * 同時に行われるとデッドロックしうるため、同じポートを含む接続は同
+   * 時には行わない。
+   *
+   * watch() した RTC はこのオブジェクトより後に破棄されなければなら
+   * ない。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class PortCache
+   * @brief Cache of port information for a series of connections
+   *
+   * Keeps snapshots of the port lists of RTCs, the port names and the
+   * connector profiles of ports, so that get_ports(),
+   * get_port_profile() and get_connector_profiles() are called remotely
+   * once per RTC or port. Create it for the time a number of ports are
+   * connected.
+   *
+   * The connector profiles are fetched again for ports connected through
+   * this cache, ports passed to invalidate(), and when a port of a local
+   * RTC passed to watch() is connected or disconnected (ON_CONNECTED,
+   * ON_DISCONNECTED). Ports added to or removed from an RTC are
+   * reflected by invalidate(RTObject_ptr).
+   *
+   * connect_all() makes the connections concurrently. Connections of
+   * the same port are serialized by PortBase::notify_connect() anyway,
+   * and two connections in opposite directions made at once could
+   * deadlock, so connections sharing a port are never made at the same
+   * time.
+   *
+   * RTCs passed to watch() must be destroyed after this object.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class PortCache
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief connect_all() で行う接続
+     * @else
+     * @brief A connection made by connect_all()
+     * @endif
+     */
+    struct Connection
+    {
+      //! connector name
+      std::string name;
+      //! connector properties
+      coil::Properties prop;
+      //! the port connect() is called on
+      RTC::PortService_var port0;
+      //! the other port, or nil
+      RTC::PortService_var port1;
+      //! the result of connect()
+      RTC::ReturnCode_t result{RTC::RTC_OK};
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    PortCache();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * watch() で登録したリスナを削除する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Removes the listeners registered by watch().
+     *
+     * @endif
+     */
+    ~PortCache();
+
+    PortCache(const PortCache&) = delete;
+    PortCache& operator=(const PortCache&) = delete;
+
+    /*!
+     * @if jp
+     * @brief ローカルの RTC のポートの接続・切断を監視する
+     * @param rtc RTコンポーネント
+     * @else
+     * @brief Watch the connections and disconnections of a local RTC
+     * @param rtc The RT-component
+     * @endif
+     */
+    void watch(RTC::RTObject_impl* rtc);
+
+    /*!
+     * @if jp
+     * @brief 対象のRTCから指定した名前のポートを取得
+     * @param rtc RTコンポーネント
+     * @param name ポート名
+     * @return ポート。見つからない場合は nil
+     * @else
+     * @brief Get the port of the given name from the RTC
+     * @param rtc The RT-component
+     * @param name The port name
+     * @return The port. nil if not found
+     * @endif
+     */
+    RTC::PortService_ptr get_port_by_name(RTC::RTObject_ptr rtc,
+                                          const std::string& name);
+
+    /*!
+     * @if jp
+     * @brief ポート名を取得
+     * @param port ポート
+     * @return ポート名
+     * @else
+     * @brief Get the port name
+     * @param port The port
+     * @return The port name
+     * @endif
+     */
+    std::string get_port_name(RTC::PortService_ptr port);
+
+    /*!
+     * @if jp
+     * @brief 指定したポート同士が接続されているかを判定
+     * @param localport 対象のポート1
+     * @param otherport 対象のポート2
+     * @return True: 接続済み、False: 未接続
+     * @else
+     * @brief Check whether the ports are connected
+     * @param localport The port 1
+     * @param otherport The port 2
+     * @return True: connected, False: not connected
+     * @endif
+     */
+    bool already_connected(RTC::PortService_ptr localport,
+                           RTC::PortService_ptr otherport);
+
+    /*!
+     * @if jp
+     * @brief 指定したポートと指定したリスト内のポート全てと接続する
+     *
+     * 接続済みのポートは除き、残りを connect_all() で接続する。
+     *
+     * @param name コネクタ名
+     * @param prop 設定
+     * @param port 対象のポート
+     * @param target_ports 対象のポートのリスト
+     * @param jobs 同時に行う接続の最大数。0 の場合はハードウェアスレッド数
+     * @return 全ての接続が成功した場合は RTC_OK、それ以外は RTC_ERROR
+     * @else
+     * @brief Connect the port to all the ports in the list
+     *
+     * The ports already connected are skipped and the rest are
+     * connected by connect_all().
+     *
+     * @param name The connector name
+     * @param prop The connector properties
+     * @param port The port
+     * @param target_ports The ports to connect to
+     * @param jobs Maximum number of connections made at once. 0 means
+     *             the number of hardware threads
+     * @return RTC_OK if all succeeded, RTC_ERROR otherwise
+     * @endif
+     */
+    RTC::ReturnCode_t connect_multi(const std::string& name,
+                                    const coil::Properties& prop,
+                                    RTC::PortService_ptr port,
+                                    RTC::PortServiceList& target_ports,
+                                    size_t jobs = 0);
+
+    /*!
+     * @if jp
+     * @brief 複数の接続を並行して行う
+     *
+     * 各接続の結果は Connection::result に格納する。結果は connect()
+     * と同じ。
+     *
+     * @param connections 接続のリスト
+     * @param jobs 同時に行う接続の最大数。0 の場合はハードウェアスレッド数
+     * @return 全ての接続が成功した場合は RTC_OK、それ以外は RTC_ERROR
+     * @else
+     * @brief Make connections concurrently
+     *
+     * The result of each connection, the same as of connect(), is
+     * stored in Connection::result.
+     *
+     * @param connections The connections
+     * @param jobs Maximum number of connections made at once. 0 means
+     *             the number of hardware threads
+     * @return RTC_OK if all succeeded, RTC_ERROR otherwise
+     * @endif
+     */
+    RTC::ReturnCode_t connect_all(std::vector<Connection>& connections,
+                                  size_t jobs = 0);
+
+    /*!
+     * @if jp
+     * @brief RTC のポートリストを破棄する
+     * @else
+     * @brief Drop the port list of the RTC
+     * @endif
+     */
+    void invalidate(RTC::RTObject_ptr rtc);
+
+    /*!
+     * @if jp
+     * @brief ポートのコネクタプロファイルを破棄する
+     * @else
+     * @brief Drop the connector profiles of the port
+     * @endif
+     */
+    void invalidate(RTC::PortService_ptr port);
+
+    /*!
+     * @if jp
+     * @brief キャッシュをすべて破棄する
+     * @else
+     * @brief Drop the whole cache
+     * @endif
+     */
+    void clear();
+
+  private:
+    class Invalidator;
+    struct PortEntry
+    {
+      RTC::PortService_var port;
+      std::string name;
+      bool named{false};
+      bool fetched{false};
+      RTC::ConnectorProfileList_var connectors;
+      unsigned long generation{0};
+    };
+    struct RtcEntry
+    {
+      RTC::RTObject_var rtc;
+      std::vector<size_t> ports;
+      bool listed{false};
+    };
+
+    size_t findPort(RTC::PortService_ptr port);
+    size_t findRtc(RTC::RTObject_ptr rtc);
+    bool hasConnectors(const PortEntry& entry) const;
+    void invalidatePort(size_t index);
+
+    std::mutex m_mutex;
+    std::deque<PortEntry> m_ports;
+    std::unordered_multimap<CORBA::ULong, size_t> m_portIndex;
+    std::deque<RtcEntry> m_rtcs;
+    std::unordered_multimap<CORBA::ULong, size_t> m_rtcIndex;
+    // bumped by the listeners of the watched RTCs
+    std::shared_ptr<std::atomic<unsigned long> > m_generation;
+    struct Watch
+    {
+      RTC::RTObject_impl* rtc;
+      RTC::PortConnectRetListenerType type;
+      RTC::PortConnectRetListener* listener;
+    };
+    std::vector<Watch> m_watched;
+  };
+
   /*!
    * @if jp
    * @brief 対象RTCの指定した名前のコンフィギュレーションセットをkey-valueで取得
@@ -0,0 +1,189 @@
+﻿// -*- C++ -*-
+/*!
+ * @file CdrBatch.cpp
+ * @brief Framing of several serialized samples into one transfer
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/CdrBatch.h>
+
+#include <cstring>
+
+namespace RTC
+{
+  namespace
+  {
+    const unsigned char batch_magic[8] = {'R', 'T', 'C', 'B',
+                                          'A', 'T', 'C', 'H'};
+    const unsigned long magic_length = sizeof(batch_magic);
+    const unsigned long word_length = 4;
+
+    void putWord(unsigned char* buffer, std::uint32_t value)
+    {
+      buffer[0] = static_cast<unsigned char>(value & 0xff);
+      buffer[1] = static_cast<unsigned char>((value >> 8) & 0xff);
+      buffer[2] = static_cast<unsigned char>((value >> 16) & 0xff);
+      buffer[3] = static_cast<unsigned char>((value >> 24) & 0xff);
+    }
+
+    std::uint32_t getWord(const unsigned char* buffer)
+    {
+      return static_cast<std::uint32_t>(buffer[0])
+        | (static_cast<std::uint32_t>(buffer[1]) << 8)
+        | (static_cast<std::uint32_t>(buffer[2]) << 16)
+        | (static_cast<std::uint32_t>(buffer[3]) << 24);
+    }
+
+    bool hasHeader(const unsigned char* buffer, unsigned long length)
+    {
+      return buffer != nullptr && length >= magic_length + word_length
+        && std::memcmp(buffer, batch_magic, magic_length) == 0;
+    }
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  CdrBatch::Reader::Reader(const unsigned char* buffer, unsigned long length)
+    : m_buffer(buffer), m_length(length), m_pos(headerLength()),
+      m_count(0), m_index(0), m_valid(false)
+  {
+    if (!hasHeader(buffer, length)) { return; }
+    m_count = getWord(buffer + magic_length);
+
+    // Walk the length fields once so that next() never reads past the
+    // end of a truncated or corrupted frame. The samples must fill the
+    // frame exactly.
+    unsigned long pos(m_pos);
+    for (std::uint32_t i(0); i < m_count; ++i)
+      {
+        if (m_length - pos < word_length) { return; }
+        unsigned long len(getWord(m_buffer + pos));
+        pos += word_length;
+        if (m_length - pos < len) { return; }
+        pos += len;
+      }
+    m_valid = (pos == m_length);
+  }
+
+  /*!
+   * @if jp
+   * @brief フレームの形式が正しいかどうか
+   * @else
+   * @brief Whether the frame is well formed
+   * @endif
+   */
+  bool CdrBatch::Reader::isValid() const
+  {
+    return m_valid;
+  }
+
+  /*!
+   * @if jp
+   * @brief フレームに含まれるサンプル数
+   * @else
+   * @brief Number of samples in the frame
+   * @endif
+   */
+  std::uint32_t CdrBatch::Reader::count() const
+  {
+    return m_valid ? m_count : 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief 次のサンプルを取り出す
+   * @else
+   * @brief Get the next sample
+   * @endif
+   */
+  bool CdrBatch::Reader::next(const unsigned char*& data,
+                              unsigned long& length)
+  {
+    if (!m_valid || m_index >= m_count) { return false; }
+    length = getWord(m_buffer + m_pos);
+    m_pos += word_length;
+    data = m_buffer + m_pos;
+    m_pos += length;
+    ++m_index;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief ヘッダの長さ
+   * @else
+   * @brief Length of the frame header
+   * @endif
+   */
+  unsigned long CdrBatch::headerLength()
+  {
+    return magic_length + word_length;
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプル1つあたりのフレーム上の付加長
+   * @else
+   * @brief Framing overhead per sample
+   * @endif
+   */
+  unsigned long CdrBatch::sampleOverhead()
+  {
+    return word_length;
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプル列をフレーム化した場合の長さ
+   * @else
+   * @brief Length of the frame for the given samples
+   * @endif
+   */
+  unsigned long CdrBatch::length(const std::vector<ByteData*>& samples)
+  {
+    unsigned long len(headerLength());
+    for (auto const& sample : samples)
+      {
+        len += sampleOverhead() + sample->getDataLength();
+      }
+    return len;
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプル列をフレーム化する
+   * @else
+   * @brief Frame the samples
+   * @endif
+   */
+  void CdrBatch::pack(const std::vector<ByteData*>& samples,
+                      unsigned char* buffer)
+  {
+    std::memcpy(buffer, batch_magic, magic_length);
+    putWord(buffer + magic_length,
+            static_cast<std::uint32_t>(samples.size()));
+    unsigned char* pos(buffer + headerLength());
+    for (auto const& sample : samples)
+      {
+        unsigned long len(sample->getDataLength());
+        putWord(pos, static_cast<std::uint32_t>(len));
+        pos += word_length;
+        sample->readData(pos, len);
+        pos += len;
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,197 @@
+﻿// -*- C++ -*-
+/*!
+ * @file CdrBatch.h
+ * @brief Framing of several serialized samples into one transfer
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CDRBATCH_H
+#define RTC_CDRBATCH_H
+
+#include <rtm/ByteData.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class CdrBatch
+   * @brief 複数のシリアライズ済みサンプルを1つの転送単位にまとめる
+   *
+   * push_policy=all の Publisher がバッファ内の複数サンプルを1回の
+   * InPortCdrBatch::put_many() で送る場合や、OutPortCdrBatch::get_many()
+   * で受け取る場合のフレーム形式を扱う。フレームは以下の形式とする。
+   *
+   * - マジック "RTCBATCH" (8バイト)
+   * - サンプル数 (uint32, リトルエンディアン)
+   * - 各サンプルについて、長さ (uint32, リトルエンディアン) とバイト列
+   *
+   * 各サンプルのバイト列はシリアライズ済みのデータをそのまま格納する
+   * ため、サンプル自身のエンディアンは接続のエンディアン設定に従う。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class CdrBatch
+   * @brief Frames several serialized samples into one transfer
+   *
+   * Handles the frame format used by push_policy=all publishers to send
+   * several buffered samples with a single InPortCdrBatch::put_many(),
+   * and by OutPortCdrBatch::get_many(). A frame consists of
+   *
+   * - the magic "RTCBATCH" (8 bytes)
+   * - the number of samples (uint32, little endian)
+   * - for each sample, its length (uint32, little endian) and its bytes
+   *
+   * Sample bytes are stored as serialized, so the samples themselves
+   * keep the endian configured for the connection.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class CdrBatch
+  {
+  public:
+    /*!
+     * @if jp
+     * @class Reader
+     * @brief フレームから各サンプルを順に取り出す
+     *
+     * 取り出したサンプルはフレームのバッファを参照するため、フレーム
+     * より長く保持してはならない。
+     *
+     * @else
+     * @class Reader
+     * @brief Iterates over the samples of a frame
+     *
+     * Returned samples point into the frame buffer and must not
+     * outlive it.
+     *
+     * @endif
+     */
+    class Reader
+    {
+    public:
+      /*!
+       * @if jp
+       * @brief コンストラクタ
+       * @param buffer フレームの先頭
+       * @param length フレームの長さ
+       * @else
+       * @brief Constructor
+       * @param buffer Start of the frame
+       * @param length Length of the frame
+       * @endif
+       */
+      Reader(const unsigned char* buffer, unsigned long length);
+
+      /*!
+       * @if jp
+       * @brief フレームの形式が正しいかどうか
+       *
+       * ヘッダとすべてのサンプルがフレームの長さにちょうど収まる場合
+       * に true を返す。
+       *
+       * @else
+       * @brief Whether the frame is well formed
+       *
+       * Returns true if the header and all samples exactly fill the
+       * frame.
+       *
+       * @endif
+       */
+      bool isValid() const;
+
+      /*!
+       * @if jp
+       * @brief フレームに含まれるサンプル数
+       * @else
+       * @brief Number of samples in the frame
+       * @endif
+       */
+      std::uint32_t count() const;
+
+      /*!
+       * @if jp
+       * @brief 次のサンプルを取り出す
+       * @param data サンプルの先頭
+       * @param length サンプルの長さ
+       * @return true: 取り出した, false: サンプルが残っていない
+       * @else
+       * @brief Get the next sample
+       * @param data Start of the sample
+       * @param length Length of the sample
+       * @return true: got a sample, false: no samples left
+       * @endif
+       */
+      bool next(const unsigned char*& data, unsigned long& length);
+
+    private:
+      const unsigned char* m_buffer;
+      unsigned long m_length;
+      unsigned long m_pos;
+      std::uint32_t m_count;
+      std::uint32_t m_index;
+      bool m_valid;
+    };
+
+    /*!
+     * @if jp
+     * @brief ヘッダの長さ
+     * @else
+     * @brief Length of the frame header
+     * @endif
+     */
+    static unsigned long headerLength();
+
+    /*!
+     * @if jp
+     * @brief サンプル1つあたりのフレーム上の付加長
+     * @else
+     * @brief Framing overhead per sample
+     * @endif
+     */
+    static unsigned long sampleOverhead();
+
+    /*!
+     * @if jp
+     * @brief サンプル列をフレーム化した場合の長さ
+     * @else
+     * @brief Length of the frame for the given samples
+     * @endif
+     */
+    static unsigned long length(const std::vector<ByteData*>& samples);
+
+    /*!
+     * @if jp
+     * @brief サンプル列をフレーム化する
+     *
+     * @param samples サンプル列
+     * @param buffer 書き込み先。length(samples) バイト以上の領域が必要
+     *
+     * @else
+     * @brief Frame the samples
+     *
+     * @param samples Samples to frame
+     * @param buffer Destination of at least length(samples) bytes
+     *
+     * @endif
+     */
+    static void pack(const std::vector<ByteData*>& samples,
+                     unsigned char* buffer);
+  };
+} // namespace RTC
+
+#endif // RTC_CDRBATCH_H
@@ -0,0 +1,28 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  CdrMPSCRingBuffer.cpp
+ * @brief Lock-free MPSC RingBuffer for CDR
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/CdrMPSCRingBuffer.h>
+
+extern "C"
+{
+  void CdrMPSCRingBufferInit()
+  {
+    RTC::CdrBufferFactory::instance().
+      addFactory("mpsc_ring",
+                 coil::Creator<RTC::CdrBufferBase, RTC::CdrMPSCRingBuffer>,
+                 coil::Destructor<RTC::CdrBufferBase, RTC::CdrMPSCRingBuffer>);
+  }
+}
@@ -0,0 +1,33 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  CdrMPSCRingBuffer.h
+ * @brief Lock-free MPSC RingBuffer for CDR
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CDRMPSCRINGBUFFER_H
+#define RTC_CDRMPSCRINGBUFFER_H
+
+#include <rtm/MPSCRingBuffer.h>
+#include <rtm/CdrBufferBase.h>
+#include <rtm/ByteData.h>
+
+namespace RTC
+{
+  using CdrMPSCRingBuffer = MPSCRingBuffer<ByteData>;
+} // namespace RTC
+
+extern "C"
+{
+  void CdrMPSCRingBufferInit();
+}
+#endif  // RTC_CDRMPSCRINGBUFFER_H
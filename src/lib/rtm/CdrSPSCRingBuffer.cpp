@@ -0,0 +1,28 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  CdrSPSCRingBuffer.cpp
+ * @brief Lock-free SPSC RingBuffer for CDR
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/CdrSPSCRingBuffer.h>
+
+extern "C"
+{
+  void CdrSPSCRingBufferInit()
+  {
+    RTC::CdrBufferFactory::instance().
+      addFactory("spsc_ring",
+                 coil::Creator<RTC::CdrBufferBase, RTC::CdrSPSCRingBuffer>,
+                 coil::Destructor<RTC::CdrBufferBase, RTC::CdrSPSCRingBuffer>);
+  }
+}
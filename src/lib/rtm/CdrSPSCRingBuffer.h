@@ -0,0 +1,33 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  CdrSPSCRingBuffer.h
+ * @brief Lock-free SPSC RingBuffer for CDR
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CDRSPSCRINGBUFFER_H
+#define RTC_CDRSPSCRINGBUFFER_H
+
+#include <rtm/SPSCRingBuffer.h>
+#include <rtm/CdrBufferBase.h>
+#include <rtm/ByteData.h>
+
+namespace RTC
+{
+  using CdrSPSCRingBuffer = SPSCRingBuffer<ByteData>;
+} // namespace RTC
+
+extern "C"
+{
+  void CdrSPSCRingBufferInit();
+}
+#endif  // RTC_CDRSPSCRINGBUFFER_H
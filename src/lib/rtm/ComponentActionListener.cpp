@@ -18,6 +18,8 @@
 
 #include <rtm/ComponentActionListener.h>
 
+#include <thread>
+
 namespace RTC
 {
 
@@ -75,14 +77,16 @@ namespace RTC
 
   PreComponentActionListenerHolder::~PreComponentActionListenerHolder()
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & listener : m_listeners)
+    std::vector<Entry>* listeners(m_listeners.load());
+    if (listeners == nullptr) { return; }
+    for (auto & listener : *listeners)
       {
         if (listener.second)
           {
             delete listener.first;
           }
       }
+    delete listeners;
   }
 
 
@@ -91,7 +95,12 @@ namespace RTC
               bool autoclean)
   {
     std::lock_guard<std::mutex> guard(m_mutex);
-    m_listeners.emplace_back(listener, autoclean);
+    std::vector<Entry>* current(m_listeners.load());
+    std::vector<Entry>* listeners(current == nullptr ?
+                                  new std::vector<Entry>() :
+                                  new std::vector<Entry>(*current));
+    listeners->emplace_back(listener, autoclean);
+    delete update(listeners);
   }
 
 
@@ -99,17 +108,28 @@ namespace RTC
   removeListener(PreComponentActionListener* listener)
   {
     std::lock_guard<std::mutex> guard(m_mutex);
-    std::vector<Entry>::iterator it(m_listeners.begin());
+    std::vector<Entry>* current(m_listeners.load());
+    if (current == nullptr) { return; }
+    std::vector<Entry>::iterator it(current->begin());
 
-    for (; it != m_listeners.end(); ++it)
+    for (; it != current->end(); ++it)
       {
         if (it->first == listener)
           {
-            if (it->second)
+            Entry entry(*it);
+            std::vector<Entry>* listeners(nullptr);
+            if (current->size() > 1)
               {
-                delete it->first;
+                listeners = new std::vector<Entry>(*current);
+                listeners->erase(listeners->begin() +
+                                 (it - current->begin()));
+              }
+            // no notify() refers to the listener after update()
+            delete update(listeners);
+            if (entry.second)
+              {
+                delete entry.first;
               }
-            m_listeners.erase(it);
             return;
           }
       }
@@ -117,13 +137,54 @@ namespace RTC
   }
 
 
-  void PreComponentActionListenerHolder::notify(UniqueId ec_id)
+  void PreComponentActionListenerHolder::notifyListeners(UniqueId ec_id)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & listener : m_listeners)
+    std::atomic<int>* readers(nullptr);
+    for (;;)
       {
-        listener.first->operator()(ec_id);
+        unsigned int epoch(m_epoch.load());
+        readers = &m_readers[epoch & 1];
+        readers->fetch_add(1);
+        if (m_epoch.load() == epoch) { break; }
+        readers->fetch_sub(1);
+      }
+    std::vector<Entry>* listeners(m_listeners.load());
+    if (listeners != nullptr)
+      {
+        for (auto & listener : *listeners)
+          {
+            listener.first->operator()(ec_id);
+          }
+      }
+    readers->fetch_sub(1, std::memory_order_release);
+  }
+
+  /*!
+   * @if jp
+   * @brief リスナのリストを置き換え、以前のリストを返す
+   *
+   * 以前のリストを参照している notify() がなくなるまで待つ。
+   *
+   * @else
+   * @brief Replace the listener list and return the previous one
+   *
+   * Waits until no notify() refers to the previous list.
+   *
+   * @endif
+   */
+  std::vector<PreComponentActionListenerHolder::Entry>*
+  PreComponentActionListenerHolder::update(std::vector<Entry>* listeners)
+  {
+    std::vector<Entry>* previous(m_listeners.exchange(listeners));
+    // notify() calls started after this see the new epoch and count
+    // themselves on the other counter, so the wait always ends even if
+    // notify() is called back to back.
+    unsigned int epoch(m_epoch.fetch_add(1));
+    while (m_readers[epoch & 1].load() != 0)
+      {
+        std::this_thread::yield();
       }
+    return previous;
   }
 
   //============================================================
@@ -139,14 +200,16 @@ namespace RTC
 
   PostComponentActionListenerHolder::~PostComponentActionListenerHolder()
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & listener : m_listeners)
+    std::vector<Entry>* listeners(m_listeners.load());
+    if (listeners == nullptr) { return; }
+    for (auto & listener : *listeners)
       {
         if (listener.second)
           {
             delete listener.first;
           }
       }
+    delete listeners;
   }
 
 
@@ -154,7 +217,12 @@ namespace RTC
   addListener(PostComponentActionListener* listener, bool autoclean)
   {
     std::lock_guard<std::mutex> guard(m_mutex);
-    m_listeners.emplace_back(listener, autoclean);
+    std::vector<Entry>* current(m_listeners.load());
+    std::vector<Entry>* listeners(current == nullptr ?
+                                  new std::vector<Entry>() :
+                                  new std::vector<Entry>(*current));
+    listeners->emplace_back(listener, autoclean);
+    delete update(listeners);
   }
 
 
@@ -162,16 +230,28 @@ namespace RTC
   removeListener(PostComponentActionListener* listener)
   {
     std::lock_guard<std::mutex> guard(m_mutex);
-    std::vector<Entry>::iterator it(m_listeners.begin());
-    for (; it != m_listeners.end(); ++it)
+    std::vector<Entry>* current(m_listeners.load());
+    if (current == nullptr) { return; }
+    std::vector<Entry>::iterator it(current->begin());
+
+    for (; it != current->end(); ++it)
       {
-        if ((*it).first == listener)
+        if (it->first == listener)
           {
-            if ((*it).second)
+            Entry entry(*it);
+            std::vector<Entry>* listeners(nullptr);
+            if (current->size() > 1)
               {
-                delete (*it).first;
+                listeners = new std::vector<Entry>(*current);
+                listeners->erase(listeners->begin() +
+                                 (it - current->begin()));
+              }
+            // no notify() refers to the listener after update()
+            delete update(listeners);
+            if (entry.second)
+              {
+                delete entry.first;
               }
-            m_listeners.erase(it);
             return;
           }
       }
@@ -179,14 +259,46 @@ namespace RTC
   }
 
 
-  void PostComponentActionListenerHolder::notify(UniqueId ec_id,
-                                                 ReturnCode_t ret)
+  void PostComponentActionListenerHolder::notifyListeners(UniqueId ec_id,
+                                                          ReturnCode_t ret)
   {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (auto & listener : m_listeners)
+    std::atomic<int>* readers(nullptr);
+    for (;;)
+      {
+        unsigned int epoch(m_epoch.load());
+        readers = &m_readers[epoch & 1];
+        readers->fetch_add(1);
+        if (m_epoch.load() == epoch) { break; }
+        readers->fetch_sub(1);
+      }
+    std::vector<Entry>* listeners(m_listeners.load());
+    if (listeners != nullptr)
+      {
+        for (auto & listener : *listeners)
+          {
+            listener.first->operator()(ec_id, ret);
+          }
+      }
+    readers->fetch_sub(1, std::memory_order_release);
+  }
+
+  /*!
+   * @if jp
+   * @brief リスナのリストを置き換え、以前のリストを返す
+   * @else
+   * @brief Replace the listener list and return the previous one
+   * @endif
+   */
+  std::vector<PostComponentActionListenerHolder::Entry>*
+  PostComponentActionListenerHolder::update(std::vector<Entry>* listeners)
+  {
+    std::vector<Entry>* previous(m_listeners.exchange(listeners));
+    unsigned int epoch(m_epoch.fetch_add(1));
+    while (m_readers[epoch & 1].load() != 0)
       {
-        listener.first->operator()(ec_id, ret);
+        std::this_thread::yield();
       }
+    return previous;
   }
 
 
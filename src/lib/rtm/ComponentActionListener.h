@@ -19,6 +19,7 @@
 #ifndef RTC_COMPONENTACTIONLISTENER_H
 #define RTC_COMPONENTACTIONLISTENER_H
 
+#include <atomic>
 #include <mutex>
 
 #include <rtm/RTC.h>
@@ -593,6 +594,12 @@ namespace RTC
    *
    * 複数の PreComponentActionListener を保持し管理するクラス。
    *
+   * notify() は実行周期ごとに呼ばれるため、リスナのリストはコピーオ
+   * ンライトで更新し、notify() はロックを取らない。リスナが登録され
+   * ていない場合は1回のアトミックな読み出しのみで戻る。
+   * removeListener() は実行中の notify() の完了を待ってからリスナを
+   * 削除するため、リスナのコールバック内から呼んではならない。
+   *
    * @else
    * @class PreComponentActionListenerHolder
    * @brief PreComponentActionListener holder class
@@ -600,6 +607,13 @@ namespace RTC
    * This class manages one ore more instances of
    * PreComponentActionListener class.
    *
+   * Since notify() is called every execution cycle, the listener list
+   * is updated copy-on-write and notify() takes no lock. With no
+   * listener registered it returns after a single atomic load.
+   * removeListener() waits for running notify() calls to complete
+   * before deleting the listener, so it must not be called from a
+   * listener callback.
+   *
    * @endif
    */
   class PreComponentActionListenerHolder
@@ -683,10 +697,24 @@ namespace RTC
      * @param ec_id 
      * @endif
      */
-    void notify(UniqueId ec_id);
+    inline void notify(UniqueId ec_id)
+    {
+      if (m_listeners.load(std::memory_order_acquire) != nullptr)
+        {
+          notifyListeners(ec_id);
+        }
+    }
 
   private:
-    std::vector<Entry> m_listeners;
+    void notifyListeners(UniqueId ec_id);
+    std::vector<Entry>* update(std::vector<Entry>* listeners);
+
+    // nullptr while no listener is registered
+    std::atomic<std::vector<Entry>*> m_listeners{nullptr};
+    // notify() calls in progress, counted per parity of m_epoch
+    std::atomic<int> m_readers[2]{};
+    std::atomic<unsigned int> m_epoch{0};
+    // serializes addListener() and removeListener()
     std::mutex m_mutex;
   };
 
@@ -698,6 +726,9 @@ namespace RTC
    *
    * 複数の PostComponentActionListener を保持し管理するクラス。
    *
+   * リストの更新と notify() の関係は PreComponentActionListenerHolder
+   * と同じ。
+   *
    * @else
    * @class PostComponentActionListenerHolder
    * @brief PostComponentActionListener holder class
@@ -705,6 +736,9 @@ namespace RTC
    * This class manages one ore more instances of
    * PostComponentActionListener class.
    *
+   * The list is updated and notified as in
+   * PreComponentActionListenerHolder.
+   *
    * @endif
    */
   class PostComponentActionListenerHolder
@@ -789,10 +823,24 @@ namespace RTC
      * @param ret 
      * @endif
      */
-    void notify(UniqueId ec_id, ReturnCode_t ret);
+    inline void notify(UniqueId ec_id, ReturnCode_t ret)
+    {
+      if (m_listeners.load(std::memory_order_acquire) != nullptr)
+        {
+          notifyListeners(ec_id, ret);
+        }
+    }
 
   private:
-    std::vector<Entry> m_listeners;
+    void notifyListeners(UniqueId ec_id, ReturnCode_t ret);
+    std::vector<Entry>* update(std::vector<Entry>* listeners);
+
+    // nullptr while no listener is registered
+    std::atomic<std::vector<Entry>*> m_listeners{nullptr};
+    // notify() calls in progress, counted per parity of m_epoch
+    std::atomic<int> m_readers[2]{};
+    std::atomic<unsigned int> m_epoch{0};
+    // serializes addListener() and removeListener()
     std::mutex m_mutex;
   };
 
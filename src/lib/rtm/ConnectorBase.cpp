@@ -21,6 +21,28 @@
 
 namespace RTC
 {
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  ConnectorSettings::ConnectorSettings(const coil::Properties& prop)
+  {
+    coil::vstring endian(coil::split(coil::normalize(
+      prop.getProperty("serializer.cdr.endian", "little")), ","));
+    littleEndian = endian.empty() || endian[0] != "big";
+
+    std::string type(prop.getProperty("marshaling_type", "corba"));
+    inMarshalingType = coil::eraseBothEndsBlank(
+      prop.getProperty("in.marshaling_type", type));
+    outMarshalingType = coil::eraseBothEndsBlank(
+      prop.getProperty("out.marshaling_type", type));
+    timestampPolicy = prop.getProperty("timestamp_policy");
+    fsmEventName = prop.getProperty("fsm_event_name");
+  }
+
   /*!
    * @if jp
    *
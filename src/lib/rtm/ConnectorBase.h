@@ -34,6 +34,71 @@
 
 namespace RTC
 {
+  /*!
+   * @if jp
+   * @class ConnectorSettings クラス
+   * @brief 接続プロパティの解析済みの値
+   *
+   * データの送受信ごとに参照される接続プロパティを、接続時に一度だけ
+   * 解析して保持する。coil::Properties の文字列キーによる検索と文字
+   * 列の正規化をデータごとに行わないために使用する。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class ConnectorSettings class
+   * @brief Parsed values of the connector properties
+   *
+   * Holds the connector properties referred to for every sample,
+   * parsed once when the connection is made, so that no string keyed
+   * lookup in coil::Properties and no normalization of strings is done
+   * per sample.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class ConnectorSettings
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * 各値をプロパティが空の場合のデフォルト値とする。
+     *
+     * @else
+     * @brief Constructor
+     *
+     * Each value is the default for empty properties.
+     *
+     * @endif
+     */
+    ConnectorSettings() = default;
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param prop 接続プロパティ
+     * @else
+     * @brief Constructor
+     * @param prop Connector properties
+     * @endif
+     */
+    explicit ConnectorSettings(const coil::Properties& prop);
+
+    //! serializer.cdr.endian (the first of the list)
+    bool littleEndian{true};
+    //! in.marshaling_type, or marshaling_type
+    std::string inMarshalingType{"corba"};
+    //! out.marshaling_type, or marshaling_type
+    std::string outMarshalingType{"corba"};
+    //! timestamp_policy
+    std::string timestampPolicy;
+    //! fsm_event_name
+    std::string fsmEventName;
+  };
+
   /*!
    * @if jp
    * @class ConnectorInfo クラス
@@ -78,6 +143,7 @@ namespace RTC
                   coil::vstring ports_, const coil::Properties& properties_)
       : name(name_), id(id_)
       , ports(std::move(ports_)), properties(properties_)
+      , m_settings(properties_)
     {
     }
     /*!
@@ -163,6 +229,28 @@ namespace RTC
      * @endif
      */
     coil::Properties properties;
+
+    /*!
+     * @if jp
+     * @brief 解析済みの接続プロパティを取得する
+     *
+     * データごとの処理では properties の代わりにこれを使用する。値は
+     * 構築時の properties から作られ、その後 properties を変更しても
+     * 変わらない。
+     *
+     * @else
+     * @brief Get the parsed connector properties
+     *
+     * Per-sample code uses this instead of properties. The values are
+     * made from properties at construction and do not follow later
+     * changes of properties.
+     *
+     * @endif
+     */
+    const ConnectorSettings& settings() const { return m_settings; }
+
+  private:
+    ConnectorSettings m_settings;
   };
 
   using ConnectorInfoList = std::vector<ConnectorInfo>;
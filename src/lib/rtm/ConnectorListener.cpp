@@ -43,6 +43,18 @@ namespace RTC
    */
   ConnectorDataListener::~ConnectorDataListener() = default;
 
+  /*!
+   * @if jp
+   * @brief コールバックの要否判定
+   * @else
+   * @brief Check whether the callback is needed
+   * @endif
+   */
+  bool ConnectorDataListener::isEnabled(const ConnectorInfo& /*info*/)
+  {
+    return true;
+  }
+
   /*!
    * @if jp
    * @class ConnectorListener クラス
@@ -59,10 +71,7 @@ namespace RTC
    * @class ConnectorDataListener holder class
    * @endif
    */
-  ConnectorDataListenerHolder::ConnectorDataListenerHolder()
-  {
-      delete m_cdr;
-  }
+  ConnectorDataListenerHolder::ConnectorDataListenerHolder() = default;
 
 
   ConnectorDataListenerHolder::~ConnectorDataListenerHolder()
@@ -75,6 +84,7 @@ namespace RTC
             delete listener.first;
           }
       }
+    delete m_cdr;
   }
 
 
@@ -120,6 +130,10 @@ namespace RTC
     ConnectorListenerHolder::ReturnCode ret(NO_CHANGE);
     for (auto & listener : m_listeners)
       {
+        if (!listener.first->isEnabled(info))
+          {
+            continue;
+          }
         ret = ret | listener.first->operator()(info, cdrdata, marshalingtype);
       }
     return ret;
@@ -127,18 +141,12 @@ namespace RTC
 
   ConnectorListenerHolder::ReturnCode ConnectorDataListenerHolder::notifyIn(ConnectorInfo& info, ByteData& data)
   {
-      std::string type = info.properties.getProperty("marshaling_type", "corba");
-      std::string marshaling_type{ coil::eraseBothEndsBlank(
-        info.properties.getProperty("in.marshaling_type", type)) };
-      return notify(info, data, marshaling_type);
+      return notify(info, data, info.settings().inMarshalingType);
   }
 
   ConnectorListenerHolder::ReturnCode ConnectorDataListenerHolder::notifyOut(ConnectorInfo& info, ByteData& data)
   {
-      std::string type = info.properties.getProperty("marshaling_type", "corba");
-      std::string marshaling_type{ coil::eraseBothEndsBlank(
-        info.properties.getProperty("out.marshaling_type", type)) };
-      return notify(info, data, marshaling_type);
+      return notify(info, data, info.settings().outMarshalingType);
   }
 
   /*!
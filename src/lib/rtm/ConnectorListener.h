@@ -481,6 +481,35 @@ namespace RTC
      */
     virtual ReturnCode operator()(ConnectorInfo& info,
                             ByteData& data, const std::string& marshalingtype) = 0;
+
+    /*!
+     * @if jp
+     *
+     * @brief コールバックの要否判定
+     *
+     * データのデシリアライズを行う前にコネクタ情報のみを用いて、
+     * このリスナを呼び出す必要があるかを判定する。false を返した場合、
+     * このイベントではリスナは呼び出されず、データの変換も行われない。
+     * デフォルトでは常に true を返す。
+     *
+     * @param info ConnectorInfo
+     * @return 呼び出しが必要な場合 true
+     *
+     * @else
+     *
+     * @brief Check whether the callback is needed
+     *
+     * Decide from the connector information alone, before any data is
+     * deserialized, whether this listener has to be invoked. If false
+     * is returned, the listener is skipped for this event and no data
+     * conversion takes place. Returns true by default.
+     *
+     * @param info ConnectorInfo
+     * @return true if the listener has to be invoked
+     *
+     * @endif
+     */
+    virtual bool isEnabled(const ConnectorInfo& info);
   };
 
   /*!
@@ -562,10 +591,16 @@ namespace RTC
     ReturnCode operator()(ConnectorInfo& info,
                                   ByteData& cdrdata, const std::string& marshalingtype) override
     {
+      if (!isEnabled(info))
+      {
+        return NO_CHANGE;
+      }
+
       DataType data;
 
       if(m_cdr == nullptr || m_marshalingtype != marshalingtype)
       {
+        delete m_cdr;
         m_cdr = createSerializer<DataType>(marshalingtype);
         m_marshalingtype = marshalingtype;
       }
@@ -579,35 +614,16 @@ namespace RTC
 
       
       // endian type check
-      std::string endian_type{coil::normalize(
-        info.properties.getProperty("serializer.cdr.endian", "little"))};
-      std::vector<std::string> endian(coil::split(endian_type, ","));
-
-      if (endian[0] == "little")
-      {
-          cdr->isLittleEndian(true);
-      }
-      else if (endian[0] == "big")
-      {
-          cdr->isLittleEndian(false);
-      }
+      cdr->isLittleEndian(info.settings().littleEndian);
 
-
-      cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
+      cdr->shareData(cdrdata);
 
       cdr->deserialize(data);
 
       ReturnCode ret = this->operator()(info, data);
       if (ret == DATA_CHANGED || ret == BOTH_CHANGED)
       {
-          if (endian[0] == "little")
-          {
-              cdr->isLittleEndian(true);
-          }
-          else if (endian[0] == "big")
-          {
-              cdr->isLittleEndian(false);
-          }
+          cdr->isLittleEndian(info.settings().littleEndian);
 
           cdr->serialize(data);
           cdrdata.setDataLength(cdr->getDataLength());
@@ -1107,10 +1123,7 @@ namespace RTC
     template <class DataType>
     ReturnCode notifyIn(ConnectorInfo& info, DataType& typeddata)
     {
-        std::string type = info.properties.getProperty("marshaling_type", "corba");
-        std::string marshaling_type{coil::eraseBothEndsBlank(
-          info.properties.getProperty("in.marshaling_type", type))};
-        return notify(info, typeddata, marshaling_type);
+        return notify(info, typeddata, info.settings().inMarshalingType);
     }
 
     /*!
@@ -1136,10 +1149,7 @@ namespace RTC
     template <class DataType>
     ReturnCode notifyOut(ConnectorInfo& info, DataType& typeddata)
     {
-        std::string type = info.properties.getProperty("marshaling_type", "corba");
-        std::string marshaling_type{coil::eraseBothEndsBlank(
-          info.properties.getProperty("out.marshaling_type", type))};
-        return notify(info, typeddata, marshaling_type);
+        return notify(info, typeddata, info.settings().outMarshalingType);
     }
     /*!
      * @if jp
@@ -1175,51 +1185,93 @@ namespace RTC
         return ret;
       }
 
-      std::string endian_type{coil::normalize(
-        info.properties.getProperty("serializer.cdr.endian", "little"))};
-      std::vector<std::string> endian(coil::split(endian_type, ","));
-
+      // serialized only when a ByteData listener really needs it
+      ByteData tmp;
+      bool serialized(false);
       for (auto & listener : m_listeners)
         {
+          if (!listener.first->isEnabled(info))
+            {
+              continue;
+            }
           ConnectorDataListenerT<DataType>* datalistener(nullptr);
           datalistener =
           dynamic_cast<ConnectorDataListenerT<DataType>*>(listener.first);
           if (datalistener != nullptr)
             {
-              ret = ret | datalistener->operator()(info, typeddata);
+              ReturnCode listener_ret(datalistener->operator()(info, typeddata));
+              if (listener_ret == DATA_CHANGED || listener_ret == BOTH_CHANGED)
+                {
+                  serialized = false;
+                }
+              ret = ret | listener_ret;
             }
           else
             {
-              if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
-              {
-                  m_cdr = createSerializer<DataType>(marshalingtype);
-                  m_marshalingtype = marshalingtype;
-              }
-              ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
-
-              if (!cdr)
-              {
-                  return NO_CHANGE;
-              }
-
-              if (endian[0] == "little")
-              {
-                  cdr->isLittleEndian(true);
-              }
-              else if (endian[0] == "big")
-              {
-                  cdr->isLittleEndian(false);
-              }
-              cdr->serialize(typeddata);
-              ByteData tmp = *cdr;
+              if (!serialized)
+                {
+                  ::RTC::ByteDataStream<DataType> *cdr =
+                    getSerializer<DataType>(info, marshalingtype);
+                  if (!cdr)
+                    {
+                      return ret;
+                    }
+                  cdr->serialize(typeddata);
+                  tmp = *cdr;
+                  serialized = true;
+                }
               ret = ret | listener.first->operator()(info, tmp, marshalingtype);
-
             }
         }
       return ret;
     }
 
   protected:
+    /*!
+     * @if jp
+     *
+     * @brief シリアライザの取得
+     *
+     * マーシャリング方式に対応するシリアライザを取得し、コネクタの
+     * エンディアン設定を反映する。
+     *
+     * @param info ConnectorInfo
+     * @param marshalingtype シリアライザの種類
+     * @return シリアライザ。存在しない場合は nullptr
+     *
+     * @else
+     *
+     * @brief Get the serializer
+     *
+     * Get the serializer for the marshaling type and apply the endian
+     * setting of the connector.
+     *
+     * @param info ConnectorInfo
+     * @param marshalingtype
+     * @return The serializer, or nullptr if not available
+     *
+     * @endif
+     */
+    template <class DataType>
+    ::RTC::ByteDataStream<DataType>* getSerializer(ConnectorInfo& info,
+                                                   const std::string& marshalingtype)
+    {
+      if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
+        {
+          delete m_cdr;
+          m_cdr = createSerializer<DataType>(marshalingtype);
+          m_marshalingtype = marshalingtype;
+        }
+      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+      if (!cdr)
+        {
+          return nullptr;
+        }
+      // endian type check
+      cdr->isLittleEndian(info.settings().littleEndian);
+      return cdr;
+    }
+
     std::vector<Entry> m_listeners;
     std::mutex m_mutex;
     ByteDataStreamBase* m_cdr{ nullptr };
@@ -1927,60 +1979,47 @@ namespace RTC
       {
           std::lock_guard<std::mutex> guard(m_mutex);
           ConnectorListenerHolder::ReturnCode ret(NO_CHANGE);
-          bool endian = true;
 
           if(m_listeners.empty())
           {
             return ret;
           }
 
-          DataType data;
-
-          if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
-          {
-              m_cdr = createSerializer<DataType>(marshalingtype);
-              m_marshalingtype = marshalingtype;
-          }
-          ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
-
-
-          if (!cdr)
-          {
-              return NO_CHANGE;
-          }
-
-
-          // endian type check
-          std::string endian_type{ coil::normalize(
-            info.properties.getProperty("serializer.cdr.endian", "little")) };
-          std::vector<std::string> endian_str(coil::split(endian_type, ","));
-
-          if (endian_str[0] == "little")
-          {
-              endian = true;
-          }
-          else if (endian_str[0] == "big")
-          {
-              endian = false;
-          }
-
-          cdr->isLittleEndian(endian);
-          cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
-          cdr->deserialize(data);
-
+          // The data is deserialized only when the first enabled typed
+          // listener is found, and the result is shared by all typed
+          // listeners of this event.
+          ::RTC::ByteDataStream<DataType> *cdr(nullptr);
+          bool decoded(false);
 
           for (auto & listener : m_listeners)
           {
+              if (!listener.first->isEnabled(info))
+              {
+                  continue;
+              }
               ConnectorDataListenerT<DataType>* datalistener(nullptr);
               datalistener =
                   dynamic_cast<ConnectorDataListenerT<DataType>*>(listener.first);
               if (datalistener != nullptr)
               {
-                  ConnectorListenerHolder::ReturnCode linstener_ret(datalistener->operator()(info, data));
+                  if (!decoded)
+                  {
+                      if (cdr == nullptr)
+                      {
+                          cdr = getSerializer<DataType>(info, marshalingtype);
+                          if (!cdr)
+                          {
+                              return ret;
+                          }
+                      }
+                      cdr->shareData(cdrdata);
+                      cdr->deserialize(m_data);
+                      decoded = true;
+                  }
+                  ConnectorListenerHolder::ReturnCode linstener_ret(datalistener->operator()(info, m_data));
                   if (linstener_ret == DATA_CHANGED || linstener_ret == BOTH_CHANGED)
                   {
-                      cdr->isLittleEndian(endian);
-                      cdr->serialize(data);
+                      cdr->serialize(m_data);
                       cdrdata.setDataLength(cdr->getDataLength());
                       cdr->readData(cdrdata.getBuffer(), cdrdata.getDataLength());
                   }
@@ -1991,9 +2030,7 @@ namespace RTC
                   ConnectorListenerHolder::ReturnCode linstener_ret(listener.first->operator()(info, cdrdata, marshalingtype));
                   if (linstener_ret == DATA_CHANGED || linstener_ret == BOTH_CHANGED)
                   {
-                      cdr->isLittleEndian(endian);
-                      cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
-                      cdr->deserialize(data);
+                      decoded = false;
                   }
                   ret = ret | linstener_ret;
               }
@@ -2025,10 +2062,7 @@ namespace RTC
        */
       ReturnCode notifyIn(ConnectorInfo& info, ByteData& data) override
       {
-          std::string type = info.properties.getProperty("marshaling_type", "corba");
-          std::string marshaling_type{ coil::eraseBothEndsBlank(
-            info.properties.getProperty("in.marshaling_type", type)) };
-          return notify(info, data, marshaling_type);
+          return notify(info, data, info.settings().inMarshalingType);
       }
 
       /*!
@@ -2053,12 +2087,18 @@ namespace RTC
        */
       ReturnCode notifyOut(ConnectorInfo& info, ByteData& data) override
       {
-          std::string type = info.properties.getProperty("marshaling_type", "corba");
-          std::string marshaling_type{ coil::eraseBothEndsBlank(
-            info.properties.getProperty("out.marshaling_type", type)) };
-          return notify(info, data, marshaling_type);
+          return notify(info, data, info.settings().outMarshalingType);
       }
 
+  private:
+      /*!
+       * @if jp
+       * @brief デシリアライズ済みデータ
+       * @else
+       * @brief Deserialized data
+       * @endif
+       */
+      DataType m_data;
   };
 
   /*!
@@ -2358,7 +2398,7 @@ namespace RTC
      * The ConnectorDataListenerType listener is stored.
      * @endif
      */
-    std::array<ConnectorDataListenerHolder, CONNECTOR_DATA_LISTENER_NUM> connectorData_;
+    std::array<ConnectorDataListenerHolderT<DataType>, CONNECTOR_DATA_LISTENER_NUM> connectorData_;
     /*!
      * @if jp
      * @brief ConnectorListenerTypeリスナ配列
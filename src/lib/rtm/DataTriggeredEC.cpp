@@ -0,0 +1,589 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DataTriggeredEC.cpp
+ * @brief ExecutionContext driven by data arrival on InPorts
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/DataTriggeredEC.h>
+#include <rtm/ECFactory.h>
+#include <rtm/RTObject.h>
+#include <rtm/RTObjectStateMachine.h>
+#include <rtm/InPortBase.h>
+#include <coil/stringutil.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief InPort へのデータの到着を EC に通知するリスナ
+   * @else
+   * @brief Listener notifying the EC of data arriving at an InPort
+   * @endif
+   */
+  class DataTriggeredEC::DataArrivalListener
+    : public ConnectorDataListener
+  {
+  public:
+    explicit DataArrivalListener(std::shared_ptr<Trigger> trigger)
+      : m_trigger(std::move(trigger)) {}
+    ~DataArrivalListener() override = default;
+
+    ReturnCode operator()(ConnectorInfo& /*info*/, ByteData& /*data*/,
+                          const std::string& /*marshalingtype*/) override
+    {
+      m_trigger->notify();
+      return NO_CHANGE;
+    }
+
+  private:
+    std::shared_ptr<Trigger> m_trigger;
+  };
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  DataTriggeredEC::DataTriggeredEC()
+    : ExecutionContextBase("data_triggered_ec"),
+      m_trigger(std::make_shared<Trigger>())
+  {
+    RTC_TRACE(("DataTriggeredEC()"));
+
+    // getting my reference
+    setObjRef(this->_this());
+
+    // profile initialization
+    setKind(RTC::EVENT_DRIVEN);
+    setRate(DEFAULT_EXECUTION_RATE);
+
+    RTC_DEBUG(("Actual period: %lld [nsec]", m_profile.getPeriod().count()));
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  DataTriggeredEC::~DataTriggeredEC()
+  {
+    RTC_TRACE(("~DataTriggeredEC()"));
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      m_svc = false;
+    }
+    m_trigger->notify();
+    wait();
+  }
+
+  void DataTriggeredEC::init(coil::Properties& props)
+  {
+    RTC_TRACE(("init()"));
+    ExecutionContextBase::init(props);
+
+    for (auto& port : coil::split(props.getProperty("trigger.ports"), ",",
+                                  true))
+      {
+        m_ports.emplace_back(coil::eraseBothEndsBlank(port));
+      }
+    std::string event(coil::normalize(props.getProperty("trigger.event",
+                                                        "on_buffer_write")));
+    if (event == "on_received")
+      {
+        m_event = ON_RECEIVED;
+      }
+    else if (event != "on_buffer_write")
+      {
+        RTC_WARN(("Unknown trigger.event: %s. ON_BUFFER_WRITE is used.",
+                  event.c_str()));
+      }
+    coil::stringTo(m_minInterval,
+                   props.getProperty("trigger.min_interval", "0").c_str());
+    coil::stringTo(m_timeout,
+                   props.getProperty("trigger.timeout", "0").c_str());
+    RTC_DEBUG(("event: %s, min_interval: %lld [ns], timeout: %lld [ns]",
+               ConnectorDataListener::toString(m_event),
+               m_minInterval.count(), m_timeout.count()));
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントをバインドする
+   * @else
+   * @brief Bind the component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::bindComponent(RTC::RTObject_impl* rtc)
+  {
+    RTC::ReturnCode_t ret = ExecutionContextBase::bindComponent(rtc);
+    if (ret == RTC::RTC_OK)
+      {
+        // InPorts are created in onInitialize(), after the binding
+        m_owner = rtc;
+      }
+    return ret;
+  }
+
+  /*------------------------------------------------------------
+   * Start activity
+   * ACE_Task class method over ride.
+   *------------------------------------------------------------*/
+  /*!
+   * @if jp
+   * @brief ExecutionContext用アクティビティスレッドを生成する
+   * @else
+   * @brief Generate internal activity thread for ExecutionContext
+   * @endif
+   */
+  int DataTriggeredEC::open(void * /*args*/)
+  {
+    RTC_TRACE(("open()"));
+    activate();
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief 各 Component の処理を呼び出す。
+   * @else
+   * @brief Invoke each component's operation
+   * @endif
+   */
+  int DataTriggeredEC::svc()
+  {
+    RTC_TRACE(("svc()"));
+    Trigger& trigger(*m_trigger);
+    auto last = std::chrono::steady_clock::now();
+    do
+      {
+        {
+          std::unique_lock<std::mutex> guard(trigger.mutex_);
+          if (m_timeout.count() > 0)
+            {
+              if (!trigger.cond_.wait_until(guard, last + m_timeout,
+                                            [&] { return trigger.ticked_; }))
+                {
+                  RTC_PARANOID(("No data arrived. Timeout tick."));
+                }
+            }
+          else
+            {
+              trigger.cond_.wait(guard, [&] { return trigger.ticked_; });
+            }
+        }
+        if (m_minInterval.count() > 0)
+          {
+            // data arriving in the meantime joins this execution
+            std::this_thread::sleep_until(last + m_minInterval);
+          }
+        {
+          std::lock_guard<std::mutex> guard(trigger.mutex_);
+          trigger.ticked_ = false;
+          trigger.running_ = true;
+        }
+        last = std::chrono::steady_clock::now();
+        ExecutionContextBase::invokeWorkerPreDo();
+        ExecutionContextBase::invokeWorkerDo();
+        ExecutionContextBase::invokeWorkerPostDo();
+        {
+          std::lock_guard<std::mutex> guard(trigger.mutex_);
+          trigger.running_ = false;
+        }
+      } while (threadRunning());
+
+    RTC_DEBUG(("Thread terminated."));
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext 用のスレッド実行関数
+   * @else
+   * @brief Thread execution function for ExecutionContext
+   * @endif
+   */
+  int DataTriggeredEC::close(unsigned long  /*flags*/)
+  {
+    RTC_TRACE(("close()"));
+    // At this point, this component have to be finished.
+    // Current state and Next state should be RTC_EXITING.
+    return 0;
+  }
+
+  //============================================================
+  // ExecutionContextService
+  //============================================================
+  /*!
+   * @if jp
+   * @brief ExecutionContext 実行状態確認関数
+   * @else
+   * @brief Check for ExecutionContext running state
+   * @endif
+   */
+  CORBA::Boolean DataTriggeredEC::is_running()
+  {
+    return ExecutionContextBase::isRunning();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行を開始
+   * @else
+   * @brief Start the ExecutionContext
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::start()
+  {
+    return ExecutionContextBase::start();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行を停止
+   * @else
+   * @brief Stop the ExecutionContext
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::stop()
+  {
+    return ExecutionContextBase::stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行周期(Hz)を取得する
+   * @else
+   * @brief Get execution rate(Hz) of ExecutionContext
+   * @endif
+   */
+  CORBA::Double DataTriggeredEC::get_rate()
+  {
+    return ExecutionContextBase::getRate();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext の実行周期(Hz)を設定する
+   * @else
+   * @brief Set execution rate(Hz) of ExecutionContext
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::set_rate(CORBA::Double rate)
+  {
+    return ExecutionContextBase::setRate(rate);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントを追加する
+   * @else
+   * @brief Add an RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t
+  DataTriggeredEC::add_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::addComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントをコンポーネントリストから削除する
+   * @else
+   * @brief Remove the RT-Component from participant list
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  remove_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::removeComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントをアクティブ化する
+   * @else
+   * @brief Activate an RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  activate_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::activateComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントを非アクティブ化する
+   * @else
+   * @brief Deactivate an RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  deactivate_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::deactivateComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントをリセットする
+   * @else
+   * @brief Reset the RT-Component
+   * @endif
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  reset_component(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::resetComponent(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief RTコンポーネントの状態を取得する
+   * @else
+   * @brief Get RT-Component's state
+   * @endif
+   */
+  RTC::LifeCycleState DataTriggeredEC::
+  get_component_state(RTC::LightweightRTObject_ptr comp)
+  {
+    return ExecutionContextBase::getComponentState(comp);
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionKind を取得する
+   * @else
+   * @brief Get the ExecutionKind
+   * @endif
+   */
+  RTC::ExecutionKind DataTriggeredEC::get_kind()
+  {
+    return ExecutionContextBase::getKind();
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContextProfile を取得する
+   * @else
+   * @brief Get the ExecutionContextProfile
+   * @endif
+   */
+  RTC::ExecutionContextProfile* DataTriggeredEC::get_profile()
+  {
+    return ExecutionContextBase::getProfile();
+  }
+
+  //============================================================
+  // protected functions
+  //============================================================
+  /*!
+   * @brief onStarted() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::onStarted()
+  {
+    attachListeners();
+    // change EC thread state
+    std::lock_guard<std::mutex> guard(m_svcmutex);
+    if (!m_svc)
+      { // If start() is called first time, start the worker thread.
+        m_svc = true;
+        this->open(nullptr);
+      }
+    return RTC::RTC_OK;
+  }
+
+  // template virtual functions adding/removing component
+  /*!
+   * @brief onAddedComponent() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onAddedComponent(RTC::LightweightRTObject_ptr  /*rtobj*/)
+  {
+    std::lock_guard<std::mutex> guard(m_trigger->mutex_);
+    if (!m_trigger->running_)
+      {
+        ExecutionContextBase::m_worker.updateComponentList();
+      }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onRemovedComponent() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onRemovedComponent(RTC::LightweightRTObject_ptr  /*rtobj*/)
+  {
+    std::lock_guard<std::mutex> guard(m_trigger->mutex_);
+    if (!m_trigger->running_)
+      {
+        ExecutionContextBase::m_worker.updateComponentList();
+      }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onWaitingActivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onWaitingActivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onWaitingActivated(count = %d)", count));
+    RTC_PARANOID(("curr: %s, next: %s",
+                  getStateString(comp->getStates().curr),
+                  getStateString(comp->getStates().next)));
+    // the worker thread makes the transition
+    m_trigger->notify();
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onActivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onActivated(RTC_impl::RTObjectStateMachine*  /*comp*/, long int count)
+  {
+    RTC_TRACE(("onActivated(count = %d)", count));
+    // count = -1; Asynch mode. onWaitingActivated() is not called.
+    if (count < 0) { m_trigger->notify(); }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onWaitingDeactivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onWaitingDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onWaitingDeactivated(count = %d)", count));
+    RTC_PARANOID(("curr: %s, next: %s",
+                  getStateString(comp->getStates().curr),
+                  getStateString(comp->getStates().next)));
+    m_trigger->notify();
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onDeactivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onDeactivated(RTC_impl::RTObjectStateMachine*  /*comp*/, long int count)
+  {
+    RTC_TRACE(("onDeactivated(count = %d)", count));
+    if (count < 0) { m_trigger->notify(); }
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onWaitingReset() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onWaitingReset(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC_TRACE(("onWaitingReset(count = %d)", count));
+    RTC_PARANOID(("curr: %s, next: %s",
+                  getStateString(comp->getStates().curr),
+                  getStateString(comp->getStates().next)));
+    m_trigger->notify();
+    return RTC::RTC_OK;
+  }
+
+  /*!
+   * @brief onReset() template function
+   */
+  RTC::ReturnCode_t DataTriggeredEC::
+  onReset(RTC_impl::RTObjectStateMachine*  /*comp*/, long int count)
+  {
+    RTC_TRACE(("onReset(count = %d)", count));
+    if (count < 0) { m_trigger->notify(); }
+    return RTC::RTC_OK;
+  }
+
+  //============================================================
+  // private functions
+  //============================================================
+  /*!
+   * @if jp
+   * @brief オーナー RTC の InPort にリスナを登録する
+   * @else
+   * @brief Register the listeners to the InPorts of the owner RTC
+   * @endif
+   */
+  void DataTriggeredEC::attachListeners()
+  {
+    if (m_attached || m_owner == nullptr) { return; }
+    m_attached = true;
+    for (auto inport : m_owner->getInPorts())
+      {
+        if (!isTriggerPort(inport->getName())) { continue; }
+        RTC_DEBUG(("Triggered by %s of %s", inport->getName(),
+                   ConnectorDataListener::toString(m_event)));
+        // owned by the port
+        inport->addConnectorDataListener(m_event,
+                                         new DataArrivalListener(m_trigger));
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行のきっかけとする InPort か判定する
+   *
+   * trigger.ports の名前はインスタンス名を付けても付けなくてもよい。
+   *
+   * @else
+   * @brief Check whether the InPort triggers the execution
+   *
+   * The names in trigger.ports may be given with or without the
+   * instance name.
+   *
+   * @endif
+   */
+  bool DataTriggeredEC::isTriggerPort(const std::string& name) const
+  {
+    if (m_ports.empty()) { return true; }
+    std::string::size_type pos(name.find('.'));
+    std::string local(pos == std::string::npos ? name : name.substr(pos + 1));
+    return std::any_of(m_ports.begin(), m_ports.end(),
+                       [&](const std::string& port) {
+                         return port == name || port == local;
+                       });
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void DataTriggeredECInit(RTC::Manager*  /*manager*/)
+  {
+    RTC::ExecutionContextFactory::
+      instance().addFactory("DataTriggeredEC",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC::DataTriggeredEC>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC::DataTriggeredEC>);
+  }
+}
@@ -0,0 +1,404 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DataTriggeredEC.h
+ * @brief ExecutionContext driven by data arrival on InPorts
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DATATRIGGEREDEC_H
+#define RTC_DATATRIGGEREDEC_H
+
+#include <rtm/RTC.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <coil/Task.h>
+
+#include <rtm/ExecutionContextBase.h>
+#include <rtm/ConnectorListener.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class DataTriggeredEC
+   * @brief データの到着で駆動される ExecutionContext
+   *
+   * オーナー RTC の InPort にデータが書き込まれると、そのコネクタの
+   * ON_BUFFER_WRITE (または ON_RECEIVED) リスナから EC のスレッドを
+   * 起こし、参加している RTC の on_execute を1回実行する。実行前に
+   * 届いた複数のデータは1回の実行にまとめられる。周期実行の EC のよ
+   * うに isNew() をポーリングする必要がなく、データが来るまで CPU を
+   * 使わず、到着から実行までに周期分の遅延も生じない。
+   *
+   * プロパティ:
+   * - trigger.ports: 実行のきっかけとする InPort 名のカンマ区切り
+   *   リスト。空の場合はすべての InPort (デフォルト: 空)
+   * - trigger.event: ON_BUFFER_WRITE, ON_RECEIVED (デフォルト:
+   *   ON_BUFFER_WRITE)
+   * - trigger.min_interval: 実行開始の最小間隔 [s]。この間に届いた
+   *   データは次の実行にまとめられる (デフォルト: 0)
+   * - trigger.timeout: データが届かない場合にこの時間 [s] で実行する。
+   *   0 の場合はデータが届くまで実行しない (デフォルト: 0)
+   *
+   * リスナは EC の開始時に、オーナー RTC のその時点の InPort に登録
+   * する。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class DataTriggeredEC
+   * @brief ExecutionContext driven by data arrival
+   *
+   * When data is written to an InPort of the owner RTC, the
+   * ON_BUFFER_WRITE (or ON_RECEIVED) listener of the connector wakes
+   * the EC thread, which runs on_execute of the participating RTCs
+   * once. Data arriving before the execution starts is coalesced into
+   * a single execution. Unlike a periodic EC there is no polling of
+   * isNew(): no CPU is used until data arrives, and there is no delay
+   * of up to one period between arrival and execution.
+   *
+   * Properties:
+   * - trigger.ports: Comma separated list of the InPort names that
+   *   trigger the execution. Empty means all InPorts (default: empty)
+   * - trigger.event: ON_BUFFER_WRITE, ON_RECEIVED (default:
+   *   ON_BUFFER_WRITE)
+   * - trigger.min_interval: Minimum interval between the starts of
+   *   executions [s]. Data arriving in the meantime is coalesced into
+   *   the next execution (default: 0)
+   * - trigger.timeout: Execute after this time [s] without data. 0
+   *   means no execution until data arrives (default: 0)
+   *
+   * The listeners are registered when the EC starts, to the InPorts
+   * the owner RTC has at that time.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class DataTriggeredEC
+    : public virtual POA_RTC::ExecutionContextService,
+      public virtual PortableServer::RefCountServantBase,
+      public RTC::ExecutionContextBase,
+      public coil::Task
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    DataTriggeredEC();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~DataTriggeredEC() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextの初期化を行う
+     * @else
+     * @brief Initialize the ExecutionContext
+     * @endif
+     */
+    void init(coil::Properties& props) override;
+
+    /*!
+     * @if jp
+     * @brief コンポーネントをバインドする
+     *
+     * バインドした RTC の InPort をデータ到着の監視対象とする。
+     *
+     * @else
+     * @brief Bind the component
+     *
+     * The InPorts of the bound RTC are watched for data arrival.
+     *
+     * @endif
+     */
+    RTC::ReturnCode_t bindComponent(RTC::RTObject_impl* rtc) override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext用アクティビティスレッドを生成する
+     * @else
+     * @brief Generate internal activity thread for ExecutionContext
+     * @endif
+     */
+    int open(void *args) override;
+
+    /*!
+     * @if jp
+     * @brief 各 Component の処理を呼び出す。
+     *
+     * データの到着、状態遷移の要求またはタイムアウトを待ち、
+     * ExecutionContext に attach されている各 Component の処理を呼び
+     * 出す。
+     *
+     * @else
+     * @brief Invoke each component's operation
+     *
+     * Waits for data arrival, a state transition request or the
+     * timeout, and invokes the operations of the components attached to
+     * the ExecutionContext.
+     *
+     * @endif
+     */
+    int svc() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext 用のスレッド実行関数
+     * @else
+     * @brief Thread execution function for ExecutionContext
+     * @endif
+     */
+    int close(unsigned long flags) override;
+
+    //============================================================
+    // ExecutionContextService
+    //============================================================
+    /*!
+     * @if jp
+     * @brief ExecutionContext 実行状態確認関数
+     * @else
+     * @brief Check for ExecutionContext running state
+     * @endif
+     */
+    CORBA::Boolean is_running() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext の実行を開始
+     * @else
+     * @brief Start the ExecutionContext
+     * @endif
+     */
+    RTC::ReturnCode_t start() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext の実行を停止
+     * @else
+     * @brief Stop the ExecutionContext
+     * @endif
+     */
+    RTC::ReturnCode_t stop() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext の実行周期(Hz)を取得する
+     * @else
+     * @brief Get execution rate(Hz) of ExecutionContext
+     * @endif
+     */
+    CORBA::Double get_rate() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext の実行周期(Hz)を設定する
+     *
+     * 実行周期は状態遷移を待つ間隔にのみ使用する。
+     *
+     * @else
+     * @brief Set execution rate(Hz) of ExecutionContext
+     *
+     * The rate is only used as the interval to wait for state
+     * transitions.
+     *
+     * @endif
+     */
+    RTC::ReturnCode_t  set_rate(CORBA::Double rate) override;
+
+    /*!
+     * @if jp
+     * @brief RTコンポーネントをアクティブ化する
+     * @else
+     * @brief Activate an RT-component
+     * @endif
+     */
+    RTC::ReturnCode_t
+    activate_component(RTC::LightweightRTObject_ptr comp) override;
+
+    /*!
+     * @if jp
+     * @brief RTコンポーネントを非アクティブ化する
+     * @else
+     * @brief Deactivate an RT-component
+     * @endif
+     */
+    RTC::ReturnCode_t
+    deactivate_component(RTC::LightweightRTObject_ptr comp) override;
+
+    /*!
+     * @if jp
+     * @brief RTコンポーネントをリセットする
+     * @else
+     * @brief Reset the RT-component
+     * @endif
+     */
+    RTC::ReturnCode_t
+    reset_component(RTC::LightweightRTObject_ptr comp) override;
+
+    /*!
+     * @if jp
+     * @brief RTコンポーネントの状態を取得する
+     * @else
+     * @brief Get RT-component's state
+     * @endif
+     */
+    RTC::LifeCycleState
+    get_component_state(RTC::LightweightRTObject_ptr comp) override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionKind を取得する
+     * @else
+     * @brief Get the ExecutionKind
+     * @endif
+     */
+    RTC::ExecutionKind get_kind() override;
+
+    /*!
+     * @if jp
+     * @brief RTコンポーネントを追加する
+     * @else
+     * @brief Add an RT-component
+     * @endif
+     */
+    RTC::ReturnCode_t add_component(RTC::LightweightRTObject_ptr comp) override;
+
+    /*!
+     * @if jp
+     * @brief RTコンポーネントを参加者リストから削除する
+     * @else
+     * @brief Remove the RT-Component from participant list
+     * @endif
+     */
+    RTC::ReturnCode_t
+    remove_component(RTC::LightweightRTObject_ptr comp) override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextProfile を取得する
+     * @else
+     * @brief Get the ExecutionContextProfile
+     * @endif
+     */
+    RTC::ExecutionContextProfile* get_profile() override;
+
+  protected:
+    // template virtual functions related to start/stop
+    RTC::ReturnCode_t onStarted() override;
+
+    // template virtual functions adding/removing component
+    RTC::ReturnCode_t
+    onAddedComponent(RTC::LightweightRTObject_ptr rtobj) override;
+    RTC::ReturnCode_t
+    onRemovedComponent(RTC::LightweightRTObject_ptr rtobj) override;
+
+    // template virtual functions related to activation/deactivation/reset
+    RTC::ReturnCode_t
+    onWaitingActivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onActivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onWaitingDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onWaitingReset(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+    RTC::ReturnCode_t
+    onReset(RTC_impl::RTObjectStateMachine* comp, long int count) override;
+
+  private:
+    /*!
+     * @if jp
+     * @brief worker 用状態変数クラス
+     *
+     * InPort に登録したリスナは EC より後に破棄されることがあるため、
+     * リスナと共有する。
+     *
+     * @else
+     * @brief Condition variable class for worker
+     *
+     * Shared with the listeners registered to the InPorts, which may
+     * be destroyed after the EC.
+     *
+     * @endif
+     */
+    struct Trigger
+    {
+      Trigger() {}
+      void notify()
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        // a pending trigger already covers this data
+        if (!ticked_)
+          {
+            ticked_ = true;
+            cond_.notify_one();
+          }
+      }
+      std::mutex mutex_;
+      std::condition_variable cond_;
+      bool ticked_{false};
+      bool running_{false};
+    };
+    class DataArrivalListener;
+
+    bool threadRunning()
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      return m_svc;
+    }
+    void attachListeners();
+    bool isTriggerPort(const std::string& name) const;
+
+    RTC::Logger rtclog{"data_triggered_ec"};
+    bool m_svc{false};
+    std::mutex m_svcmutex;
+    std::shared_ptr<Trigger> m_trigger;
+
+    RTC::RTObject_impl* m_owner{nullptr};
+    bool m_attached{false};
+    std::vector<std::string> m_ports;
+    ConnectorDataListenerType m_event{ON_BUFFER_WRITE};
+    std::chrono::nanoseconds m_minInterval{0};
+    std::chrono::nanoseconds m_timeout{0};
+  };  // class DataTriggeredEC
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void DataTriggeredECInit(RTC::Manager* manager);
+}
+
+#endif  // RTC_DATATRIGGEREDEC_H
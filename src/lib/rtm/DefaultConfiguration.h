@@ -57,6 +57,7 @@ namespace RTC {
     "logger.date_format",                    "%b %d %H:%M:%S.%Q",
     "logger.log_level",                      "INFO",
     "logger.stream_lock",                    "NO",
+    "logger.async.enable",                   "NO",
     "logger.master_logger",                  "",
 	"logger.escape_sequence_enable",         "NO",
     "module.conf_path",                      "",
@@ -94,6 +95,12 @@ namespace RTC {
     "manager.shutdown_auto",                 "YES",
     "manager.auto_shutdown_duration",        "10.0",
     "manager.termination_waittime",          "0.5",
+    "manager.slave_pool.size",               "0",
+    "manager.slave_pool.languages",          "C++",
+    "manager.slave_pool.idle_timeout",       "600.0",
+    "manager.slave_query.timeout",           "3.0",
+    "manager.slave_query.cache_ttl",         "1.0",
+    "manager.slave_query.jobs",              "0",
     "manager.name",                          "manager",
     "manager.components.naming_policy",      "process_unique",
     "manager.command",                       "rtcd",
@@ -131,9 +138,13 @@ namespace RTC {
     "manager.modules.Java.suffixes",         "class",
     "manager.modules.Java.load_paths",       "",
     "manager.modules.search_auto",       "YES",
+    "manager.modules.profile_cache.enable", "YES",
+    "manager.modules.profile_cache.file", "",
+    "manager.modules.profile_jobs",      "0",
     "manager.preload.modules",       "",
     "manager.components.precreate",       "",
     "manager.components.preconnect",       "",
+    "manager.components.preconnect_jobs",  "0",
     "manager.components.preactivation",       "",
     "manager.local_service.enabled_services","ALL",
     "sdo.service.provider.enabled_services",  "ALL",
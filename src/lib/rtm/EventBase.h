@@ -18,10 +18,14 @@
 #ifndef RTC_EVENTBASE_H
 #define RTC_EVENTBASE_H
 
-
+#include <cstddef>
+#include <mutex>
+#include <vector>
 
 namespace RTC
 {
+  template <class P0> class EventPool;
+
   class EventBinderBase0
   {
   public:
@@ -43,13 +47,17 @@ namespace RTC
       EventBase() = default;
       virtual ~EventBase() = default;
       virtual void operator()()=0;
+      // Called by Machine::run_event() when the event has been handled.
+      virtual void release() { delete this; }
   };
 
   class Event0 : public EventBase
   {
   public:
-      Event0(EventBinderBase0 *eb):
-          m_eb(eb)
+      // A shared event has no data; the binder queues the same object
+      // for every event and it is never deleted on release.
+      Event0(EventBinderBase0 *eb, bool shared = false):
+          m_eb(eb), m_shared(shared)
       {
       }
       ~Event0() override = default;
@@ -57,8 +65,13 @@ namespace RTC
       {
           m_eb->run();
       }
+      void release() override
+      {
+          if (!m_shared) { delete this; }
+      }
   private:
       EventBinderBase0 *m_eb;
+      bool m_shared;
   };
 
   template <class P0>
@@ -74,9 +87,96 @@ namespace RTC
       {
           m_eb->run(m_data);
       }
+      void release() override
+      {
+          if (m_pool == nullptr) { delete this; }
+          else { m_pool->put(this); }
+      }
   private:
+      friend class EventPool<P0>;
+      Event1(EventBinderBase1<P0> *eb, EventPool<P0> *pool):
+          m_eb(eb), m_pool(pool)
+      {
+      }
       EventBinderBase1<P0> *m_eb;
       P0 m_data;
+      EventPool<P0> *m_pool{nullptr};
+  };
+
+  /*!
+   * @if jp
+   * @class EventPool
+   * @brief Event1 のプール
+   *
+   * イベントのデータを受け取るたびに Event1 を new/delete せず、処理
+   * の済んだイベントを再利用する。データは代入でコピーされるため、
+   * シーケンスなどのバッファも確保済みのものが使われる。プールが空の
+   * 場合はイベントを新たに確保し、解放時にプールに加える。プールは
+   * イベントより後に破棄されなければならない。
+   *
+   * @else
+   * @class EventPool
+   * @brief Pool of Event1
+   *
+   * Handled events are reused instead of new/delete of an Event1 for
+   * each received data. The data is copied by assignment, so the
+   * buffers of sequences and so on that are already allocated are
+   * reused too. When the pool is empty a new event is allocated, and
+   * it joins the pool when released. The pool must outlive its events.
+   *
+   * @endif
+   */
+  template <class P0>
+  class EventPool
+  {
+  public:
+      EventPool(EventBinderBase1<P0> *eb, size_t size):
+          m_eb(eb)
+      {
+          m_free.reserve(size);
+          for (size_t i(0); i < size; ++i)
+            {
+              m_free.push_back(new Event1<P0>(m_eb, this));
+            }
+      }
+      ~EventPool()
+      {
+          for (auto & event : m_free) { delete event; }
+      }
+      EventPool(const EventPool&) = delete;
+      EventPool& operator=(const EventPool&) = delete;
+
+      Event1<P0>* get(const P0 &data)
+      {
+          Event1<P0>* event(nullptr);
+          {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (!m_free.empty())
+              {
+                event = m_free.back();
+                m_free.pop_back();
+              }
+          }
+          if (event == nullptr) { event = new Event1<P0>(m_eb, this); }
+          event->m_data = data;
+          return event;
+      }
+      void put(Event1<P0>* event)
+      {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          try
+            {
+              m_free.push_back(event);
+            }
+          catch (...)
+            {
+              delete event;
+            }
+      }
+  private:
+      EventBinderBase1<P0> *m_eb;
+      std::mutex m_mutex;
+      std::vector<Event1<P0>*> m_free;
   };
 
 
@@ -50,17 +50,24 @@ namespace RTC
                  const char* event_name,
                  R (TOP::*handler)(),
                  RingBuffer<EventBase*> &buffer)
-      : m_fsm(fsm), m_eventName(event_name), m_handler(handler), m_buffer(buffer) {}
+      : m_fsm(fsm), m_eventName(event_name), m_handler(handler), m_buffer(buffer),
+        m_event(this, true) {}
 
     ~EventBinder0() override = default;
 
+    bool isEnabled(const ConnectorInfo& info) override
+    {
+      return info.settings().fsmEventName == m_eventName ||
+        info.name == m_eventName;
+    }
+
     ReturnCode operator()(ConnectorInfo& info,
                                   ByteData&  /*data*/, const std::string& /*marshalingtype*/) override
     {
-      if (info.properties["fsm_event_name"] == m_eventName ||
-          info.name == m_eventName)
+      if (isEnabled(info))
         {
-            m_buffer.write(new Event0(this));
+            // the event has no data, so the one object is queued for all
+            m_buffer.write(&m_event);
           return NO_CHANGE;
         }
       return NO_CHANGE;
@@ -68,14 +75,14 @@ namespace RTC
 
     void run() override
     {
-        
-        m_fsm.dispatch(Macho::Event(m_handler));
+        m_fsm.dispatch(m_handler);
     }
 
     FSM& m_fsm;
     std::string m_eventName;
     R (TOP::*m_handler)();
     RingBuffer<EventBase*> &m_buffer;
+    Event0 m_event;
 
   };
 
@@ -89,16 +96,27 @@ namespace RTC
                  const char* event_name,
                  R (TOP::*handler)(P0),
                  RingBuffer<EventBase*> &buffer)
-      : m_fsm(fsm), m_eventName(event_name), m_handler(handler), m_buffer(buffer) {}
+      : m_fsm(fsm), m_eventName(event_name), m_handler(handler), m_buffer(buffer),
+        m_pool(this, buffer.length()) {}
 
     ~EventBinder1() override = default;
 
+    // The data of the other events is not deserialized for this binder.
+    bool isEnabled(const ConnectorInfo& info) override
+    {
+      return info.settings().fsmEventName == m_eventName ||
+        info.name == m_eventName;
+    }
+
     ReturnCode operator()(ConnectorInfo& info, P0& data) override
     {
-      if (info.properties["fsm_event_name"] == m_eventName ||
-          info.name == m_eventName)
+      if (isEnabled(info))
         {
-            m_buffer.write(new Event1<P0>(this, data));
+            Event1<P0>* event(m_pool.get(data));
+            if (m_buffer.write(event) != BufferStatus::OK)
+              {
+                event->release();
+              }
           return NO_CHANGE;
         }
       return NO_CHANGE;
@@ -106,13 +124,14 @@ namespace RTC
 
     void run(P0& data) override
     {
-        m_fsm.dispatch(Macho::Event(m_handler, data));
+        m_fsm.dispatch(m_handler, data);
     }
 
     FSM& m_fsm;
     std::string m_eventName;
     R (TOP::*m_handler)(P0);
     RingBuffer<EventBase*> &m_buffer;
+    EventPool<P0> m_pool;
   };
 
   class EventConnListener
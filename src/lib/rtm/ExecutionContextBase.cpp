@@ -20,6 +20,9 @@
 #include <rtm/ExecutionContextBase.h>
 #include <rtm/RTObject.h>
 #include <cinttypes>
+#ifndef NO_EC_PROFILE
+#include <fstream>
+#endif
 
 namespace RTC
 {
@@ -61,6 +64,10 @@ namespace RTC
 
     // getting rate
     setExecutionRate(props);
+#ifndef NO_EC_PROFILE
+    m_worker.setPeriod(getPeriod());
+    m_statisticsFile = props.getProperty("statistics_file");
+#endif
 
     // getting sync/async mode flag
     bool transitionMode;
@@ -202,6 +209,12 @@ namespace RTC
         RTC_ERROR(("Invoking on_shutdown() for each RTC failed."));
         return ret;
       }
+#ifndef NO_EC_PROFILE
+    if (!m_statisticsFile.empty())
+      {
+        dumpStatistics(m_statisticsFile);
+      }
+#endif
     return ret;
   }
 
@@ -240,6 +253,9 @@ namespace RTC
         RTC_ERROR(("Setting execution rate failed. %f", rate));
         return ret;
       }
+#ifndef NO_EC_PROFILE
+    m_worker.setPeriod(getPeriod());
+#endif
     ret = m_worker.rateChanged();
     if (ret != RTC::RTC_OK)
       {
@@ -410,7 +426,8 @@ namespace RTC
             RTC_ERROR(("onWaitingActivated failed."));
             return ret;
           }
-        std::this_thread::sleep_for(getPeriod());
+        // woken up as soon as the worker applies the transition
+        rtobj->waitForStateChange(RTC::INACTIVE_STATE, getPeriod());
         auto delta = std::chrono::steady_clock::now() - starttime;
         RTC_DEBUG(("Waiting to be ACTIVE state. %f [s] slept (%d/%d)",
                    std::chrono::duration<double>(delta).count(), count, cycle));
@@ -509,7 +526,7 @@ namespace RTC
             RTC_ERROR(("onWaitingDeactivated failed."));
             return ret;
           }
-        std::this_thread::sleep_for(getPeriod());
+        rtobj->waitForStateChange(RTC::ACTIVE_STATE, getPeriod());
         auto delta = std::chrono::steady_clock::now() - starttime;
         RTC_DEBUG(("Waiting to be INACTIVE state. Sleeping %f [s] (%d/%d)",
                    std::chrono::duration<double>(delta).count(), count, cycle));
@@ -607,7 +624,7 @@ namespace RTC
             RTC_ERROR(("onWaitingReset failed."));
             return ret;
           }
-        std::this_thread::sleep_for(getPeriod());
+        rtobj->waitForStateChange(RTC::ERROR_STATE, getPeriod());
         std::chrono::duration<double> delta = std::chrono::steady_clock::now() - starttime;
         RTC_DEBUG(("Waiting to be INACTIVE state. Sleeping %f [s] (%d/%d)",
                    delta.count(), count, cycle));
@@ -634,6 +651,90 @@ namespace RTC
     return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief 複数のRTコンポーネントをアクティブ化する
+   * @else
+   * @brief Activate RT-components
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t> ExecutionContextBase::
+  activateComponents(const std::vector<RTC::LightweightRTObject_ptr>& comps)
+  {
+    RTC_TRACE(("activateComponents()"));
+    std::vector<RTC::ReturnCode_t> ret(comps.size(), RTC::RTC_OK);
+    std::vector<RTC_impl::RTObjectStateMachine*> rtobjs(comps.size(), nullptr);
+    // Requesting all the transitions before waiting for any of them
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        ret[i] = onActivating(comps[i]);  // Template
+        if (ret[i] != RTC::RTC_OK)
+          {
+            RTC_ERROR(("onActivating() failed."));
+            continue;
+          }
+        ret[i] = m_worker.activateComponent(comps[i], rtobjs[i]);
+      }
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        if (ret[i] != RTC::RTC_OK) { continue; }
+        if (!m_syncActivation)  // Asynchronous activation mode
+          {
+            ret[i] = onActivated(rtobjs[i], -1);
+            if (ret[i] != RTC::RTC_OK)
+              {
+                RTC_ERROR(("onActivated() failed."));
+              }
+            continue;
+          }
+        // The worker has applied the rest together with the first one,
+        // so that they return without waiting.
+        ret[i] = waitForActivated(rtobjs[i]);
+      }
+    return ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief 複数のRTコンポーネントを非アクティブ化する
+   * @else
+   * @brief Deactivate RT-components
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t> ExecutionContextBase::
+  deactivateComponents(const std::vector<RTC::LightweightRTObject_ptr>& comps)
+  {
+    RTC_TRACE(("deactivateComponents()"));
+    std::vector<RTC::ReturnCode_t> ret(comps.size(), RTC::RTC_OK);
+    std::vector<RTC_impl::RTObjectStateMachine*> rtobjs(comps.size(), nullptr);
+    // Requesting all the transitions before waiting for any of them
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        ret[i] = onDeactivating(comps[i]);  // Template
+        if (ret[i] != RTC::RTC_OK)
+          {
+            RTC_ERROR(("onDeactivatingComponent() failed."));
+            continue;
+          }
+        ret[i] = m_worker.deactivateComponent(comps[i], rtobjs[i]);
+      }
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        if (ret[i] != RTC::RTC_OK) { continue; }
+        if (!m_syncDeactivation)
+          {
+            ret[i] = onDeactivated(rtobjs[i], -1);
+            if (ret[i] != RTC::RTC_OK)
+              {
+                RTC_ERROR(("onDeactivated() failed."));
+              }
+            continue;
+          }
+        ret[i] = waitForDeactivated(rtobjs[i]);
+      }
+    return ret;
+  }
+
   /*!
    * @if jp
    * @brief RTコンポーネントの状態を取得する
@@ -737,9 +838,52 @@ namespace RTC
     coil::Properties props;
     NVUtil::copyToProperties(props, prof->properties);
     RTC_DEBUG_STR((props));
+#ifndef NO_EC_PROFILE
+    coil::Properties stat;
+    m_worker.getStatistics(stat.getNode("statistics"));
+    SDOPackage::NVList nv;
+    NVUtil::copyFromProperties(nv, stat);
+    NVUtil::append(prof->properties, nv);
+#endif
     return onGetProfile(prof);
   }
 
+#ifndef NO_EC_PROFILE
+  /*!
+   * @if jp
+   * @brief 実行統計をファイルに書き出す
+   * @else
+   * @brief Dump the execution statistics to a file
+   * @endif
+   */
+  bool ExecutionContextBase::dumpStatistics(const std::string& filename)
+  {
+    RTC_TRACE(("dumpStatistics(%s)", filename.c_str()));
+    std::ofstream ofs(filename.c_str());
+    if (!ofs)
+      {
+        RTC_ERROR(("Cannot open statistics file: %s", filename.c_str()));
+        return false;
+      }
+    ofs << "rate: " << getRate() << std::endl;
+    m_worker.dumpStatistics(ofs);
+    return static_cast<bool>(ofs);
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行統計をクリアする
+   * @else
+   * @brief Clear the execution statistics
+   * @endif
+   */
+  void ExecutionContextBase::resetStatistics()
+  {
+    RTC_TRACE(("resetStatistics()"));
+    m_worker.resetStatistics();
+  }
+#endif
+
   //============================================================
   // Delegated functions to ExecutionContextProfile
   //============================================================
@@ -743,6 +743,62 @@ namespace RTC
      */
     RTC::ReturnCode_t resetComponent(RTC::LightweightRTObject_ptr comp);
 
+    /*!
+     * @if jp
+     * @brief 複数のRTコンポーネントをアクティブ化する
+     *
+     * すべてのRTコンポーネントの状態遷移を要求してから完了を待つため、
+     * 遷移はワーカーの同じ周期で行われ、待ち時間は1つの場合と変わらな
+     * い。
+     *
+     * @param comps アクティブ化対象RTコンポーネントのリスト
+     *
+     * @return comps と同じ順序の ReturnCode_t 型のリターンコード
+     *
+     * @else
+     *
+     * @brief Activate RT-components
+     *
+     * The transitions of all the RTCs are requested before waiting for
+     * any of them, so the worker applies them in the same cycle and the
+     * wait is no longer than that for a single RTC.
+     *
+     * @param comps The target RT-Components for activation
+     *
+     * @return The return codes of ReturnCode_t type in the order of comps
+     *
+     * @endif
+     */
+    std::vector<RTC::ReturnCode_t>
+    activateComponents(const std::vector<RTC::LightweightRTObject_ptr>& comps);
+
+    /*!
+     * @if jp
+     * @brief 複数のRTコンポーネントを非アクティブ化する
+     *
+     * activateComponents() と同様に、すべての状態遷移を要求してから完
+     * 了を待つ。
+     *
+     * @param comps 非アクティブ化対象RTコンポーネントのリスト
+     *
+     * @return comps と同じ順序の ReturnCode_t 型のリターンコード
+     *
+     * @else
+     *
+     * @brief Deactivate RT-components
+     *
+     * As activateComponents(), all the transitions are requested before
+     * waiting for them.
+     *
+     * @param comps The target RT-Components for deactivation
+     *
+     * @return The return codes of ReturnCode_t type in the order of comps
+     *
+     * @endif
+     */
+    std::vector<RTC::ReturnCode_t>
+    deactivateComponents(const std::vector<RTC::LightweightRTObject_ptr>& comps);
+
     /*!
      * @if jp
      * @brief RTコンポーネントの状態を取得する
@@ -817,6 +873,53 @@ namespace RTC
      */
     RTC::ExecutionContextProfile* getProfile();
 
+#ifndef NO_EC_PROFILE
+    /*!
+     * @if jp
+     * @brief 実行統計をファイルに書き出す
+     *
+     * EC 全体と参加している各 RTC の実行時間、ジッタのヒストグラムと
+     * 周期超過回数を書き出す。同じ統計の要約は getProfile() の
+     * properties にも statistics.* として含まれる。
+     *
+     * プロパティ statistics_file が設定されている場合、stop() のたびに
+     * この関数が呼ばれる。RTC の終了処理でも EC は停止されるため、終
+     * 了時の統計も書き出される。それ以外の時点で書き出す場合はこの関
+     * 数を直接呼ぶ。
+     *
+     * @param filename 出力ファイル名
+     * @return 書き出しに成功した場合 true
+     *
+     * @else
+     * @brief Dump the execution statistics to a file
+     *
+     * Writes the execution time and jitter histograms and the overrun
+     * counts of the whole EC and of each participating RTC. A summary
+     * of the same statistics is also included in the properties of
+     * getProfile() as statistics.*.
+     *
+     * If the statistics_file property is set, this function is called
+     * on every stop(). The EC is also stopped when the RTC is
+     * finalized, so the final statistics are written as well. Call
+     * this function directly to write them at any other time.
+     *
+     * @param filename Output file name
+     * @return true if the file has been written
+     *
+     * @endif
+     */
+    bool dumpStatistics(const std::string& filename);
+
+    /*!
+     * @if jp
+     * @brief 実行統計をクリアする
+     * @else
+     * @brief Clear the execution statistics
+     * @endif
+     */
+    void resetStatistics();
+#endif
+
     //============================================================
     // Delegated functions to ExecutionContextProfile
     //============================================================
@@ -1054,6 +1157,15 @@ namespace RTC
     void invokeWorkerPreDo()  { m_worker.invokeWorkerPreDo(); }
     void invokeWorkerDo()     { m_worker.invokeWorkerDo(); }
     void invokeWorkerPostDo() { m_worker.invokeWorkerPostDo(); }
+    void invokeWorkerDo(const RTC_impl::ExecutionContextWorker::Dispatcher&
+                        dispatch)
+    {
+      m_worker.invokeWorkerDo(dispatch);
+    }
+    void invokeWorkerDo(RTC_impl::RTObjectStateMachine* comp)
+    {
+      m_worker.invokeWorkerDo(comp);
+    }
 
 
   protected:
@@ -1199,6 +1311,9 @@ namespace RTC
     bool m_syncActivation;
     bool m_syncDeactivation;
     bool m_syncReset;
+#ifndef NO_EC_PROFILE
+    std::string m_statisticsFile;
+#endif
   };  // class ExecutionContextBase
 
   using ExecutionContextFactory = coil::GlobalFactory<ExecutionContextBase>;
@@ -19,6 +19,7 @@
 #include <rtm/RTObject.h>
 #include <rtm/RTObjectStateMachine.h>
 #include <rtm/ExecutionContextWorker.h>
+#include <coil/stringutil.h>
 
 #include <algorithm>
 #include <iostream>
@@ -100,6 +101,14 @@ namespace RTC_impl
         comp->onStartup();
       }
     RTC_DEBUG(("%d components started.", m_comps.size()));
+#ifndef NO_EC_PROFILE
+    // the stopped interval is not a jitter
+    m_statistics.restart();
+    for (auto & comp : m_comps)
+      {
+        comp->getStatistics().restart();
+      }
+#endif
     // change EC thread state
     m_running = true;
 
@@ -462,17 +471,9 @@ namespace RTC_impl
   {
     RTC_PARANOID(("invokeWorker()"));
     // m_comps never changes its size here
-    for (auto & comp : m_comps) { 
-        comp->workerPreDo();  
-    }
-    for (auto & comp : m_comps) { 
-        comp->workerDo();     
-    }
-    for (auto & comp : m_comps) { 
-        comp->workerPostDo(); 
-    }
-    std::lock_guard<std::mutex> guard(m_mutex);
-    updateComponentList();
+    invokeWorkerPreDo();
+    invokeWorkerDo();
+    invokeWorkerPostDo();
   }
 
   void ExecutionContextWorker::invokeWorkerPreDo()
@@ -488,9 +489,49 @@ namespace RTC_impl
   {
     RTC_PARANOID(("invokeWorkerDo()"));
     // m_comps never changes its size here
+#ifndef NO_EC_PROFILE
+    std::chrono::nanoseconds period(m_period.load(std::memory_order_relaxed));
+    auto cycle = std::chrono::steady_clock::now();
+    auto begin = cycle;
+    for (auto & comp : m_comps) {
+        comp->workerDo();
+        auto end = std::chrono::steady_clock::now();
+        comp->getStatistics().record(begin, end, period);
+        begin = end;
+    }
+    m_statistics.record(cycle, begin, period);
+#else
     for (auto & comp : m_comps) { 
         comp->workerDo();     
     }
+#endif
+  }
+
+  void ExecutionContextWorker::invokeWorkerDo(const Dispatcher& dispatch)
+  {
+    RTC_PARANOID(("invokeWorkerDo(dispatch)"));
+    // m_comps never changes its size here
+#ifndef NO_EC_PROFILE
+    std::chrono::nanoseconds period(m_period.load(std::memory_order_relaxed));
+    auto begin = std::chrono::steady_clock::now();
+    dispatch(m_comps);
+    m_statistics.record(begin, std::chrono::steady_clock::now(), period);
+#else
+    dispatch(m_comps);
+#endif
+  }
+
+  void ExecutionContextWorker::invokeWorkerDo(RTObjectStateMachine* comp)
+  {
+#ifndef NO_EC_PROFILE
+    std::chrono::nanoseconds period(m_period.load(std::memory_order_relaxed));
+    auto begin = std::chrono::steady_clock::now();
+    comp->workerDo();
+    comp->getStatistics().record(begin, std::chrono::steady_clock::now(),
+                                 period);
+#else
+    comp->workerDo();
+#endif
   }
 
   void ExecutionContextWorker::invokeWorkerPostDo()
@@ -505,5 +546,50 @@ namespace RTC_impl
     updateComponentList();
   }
 
+#ifndef NO_EC_PROFILE
+  void ExecutionContextWorker::setPeriod(std::chrono::nanoseconds period)
+  {
+    m_period.store(period.count(), std::memory_order_relaxed);
+  }
+
+  void ExecutionContextWorker::resetStatistics()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_statistics.reset();
+    for (auto & comp : m_comps)
+      {
+        comp->getStatistics().reset();
+      }
+  }
+
+  void ExecutionContextWorker::getStatistics(coil::Properties& prop) const
+  {
+    ExecutionStatistics::toProperties(m_statistics.snapshot(), prop);
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        std::string name(m_comps[i]->getInstanceName());
+        if (name.empty()) { name = "rtc" + coil::otos(i); }
+        ExecutionStatistics::
+          toProperties(m_comps[i]->getStatistics().snapshot(),
+                       prop.getNode("components." + name));
+      }
+  }
+
+  void ExecutionContextWorker::dumpStatistics(std::ostream& os) const
+  {
+    ExecutionStatistics::dump(os, "execution_context",
+                              m_statistics.snapshot());
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        std::string name(m_comps[i]->getInstanceName());
+        if (name.empty()) { name = "rtc" + coil::otos(i); }
+        ExecutionStatistics::dump(os, name,
+                                  m_comps[i]->getStatistics().snapshot());
+      }
+  }
+#endif
+
 } // namespace RTC_impl
 
@@ -20,9 +20,15 @@
 #define RTC_EXECUTIONCONTEXTWORKER_H
 
 #include <condition_variable>
+#include <functional>
 
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/SystemLogger.h>
+#ifndef NO_EC_PROFILE
+#include <rtm/ExecutionStatistics.h>
+#include <atomic>
+#include <cstdint>
+#endif
 #include <vector>
 
 #define NUM_OF_LIFECYCLESTATE 4
@@ -545,6 +551,98 @@ namespace RTC_impl
     void invokeWorkerDo();
     void invokeWorkerPostDo();
 
+    /*!
+     * @if jp
+     * @brief workerDo の呼び出しを委譲する
+     *
+     * 参加者リストを dispatch に渡し、各 RTC の workerDo の呼び出し
+     * 順序やスレッドを呼び出し側に任せる。dispatch は各 RTC について
+     * invokeWorkerDo(RTObjectStateMachine*) をちょうど1回呼び、全て
+     * の呼び出しが完了してから戻らなければならない。
+     *
+     * @param dispatch 参加者リストを受け取る関数
+     *
+     * @else
+     * @brief Delegate the invocation of workerDo
+     *
+     * Passes the participant list to dispatch, which decides the order
+     * and the threads of each RTC's workerDo. dispatch must call
+     * invokeWorkerDo(RTObjectStateMachine*) exactly once for each RTC
+     * and return only after all calls have completed.
+     *
+     * @param dispatch Function receiving the participant list
+     *
+     * @endif
+     */
+    using Dispatcher =
+      std::function<void(const std::vector<RTObjectStateMachine*>&)>;
+    void invokeWorkerDo(const Dispatcher& dispatch);
+
+    /*!
+     * @if jp
+     * @brief 1つの RTC の workerDo を呼び出す
+     *
+     * 異なる RTC については、複数のスレッドから同時に呼び出してよい。
+     *
+     * @else
+     * @brief Invoke workerDo of one RTC
+     *
+     * May be called from several threads at once for different RTCs.
+     *
+     * @endif
+     */
+    void invokeWorkerDo(RTObjectStateMachine* comp);
+
+#ifndef NO_EC_PROFILE
+    /*!
+     * @if jp
+     * @brief 周期超過とジッタの判定に使う周期を設定する
+     * @else
+     * @brief Set the period used to detect overruns and jitter
+     * @endif
+     */
+    void setPeriod(std::chrono::nanoseconds period);
+
+    /*!
+     * @if jp
+     * @brief 実行統計をクリアする
+     * @else
+     * @brief Clear the execution statistics
+     * @endif
+     */
+    void resetStatistics();
+
+    /*!
+     * @if jp
+     * @brief 実行統計の要約をプロパティに書き出す
+     *
+     * EC 全体の値をそのまま、各 RTC の値を components.<インスタン
+     * ス名> 以下に設定する。
+     *
+     * @param prop 書き出し先
+     *
+     * @else
+     * @brief Write a summary of the execution statistics into properties
+     *
+     * The values of the whole EC are set at the top level and those of
+     * each RTC under components.<instance name>.
+     *
+     * @param prop Destination
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& prop) const;
+
+    /*!
+     * @if jp
+     * @brief 実行統計のヒストグラムをストリームに書き出す
+     * @else
+     * @brief Dump the histograms of the execution statistics to a stream
+     * @endif
+     */
+    void dumpStatistics(std::ostream& os) const;
+#endif
+
     /*!
      * @if jp
      * @brief コンポーネントリストの更新
@@ -594,6 +692,18 @@ namespace RTC_impl
     mutable std::mutex m_removedMutex;
     using CompItr = std::vector<RTC_impl::RTObjectStateMachine*>::iterator;
 
+#ifndef NO_EC_PROFILE
+    /*!
+     * @if jp
+     * @brief 実行統計
+     * @else
+     * @brief Execution statistics
+     * @endif
+     */
+    std::atomic<std::int64_t> m_period{0};
+    ExecutionStatistics m_statistics;
+#endif
+
   };  // class PeriodicExecutionContext
 } // namespace RTC_impl
 
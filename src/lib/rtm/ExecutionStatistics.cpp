@@ -0,0 +1,140 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ExecutionStatistics.cpp
+ * @brief Execution time and jitter statistics of ExecutionContext
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ExecutionStatistics.h>
+#include <coil/stringutil.h>
+
+namespace RTC_impl
+{
+  namespace
+  {
+    std::string toSeconds(std::chrono::nanoseconds value)
+    {
+      return coil::otos(std::chrono::duration<double>(value).count());
+    }
+
+    void dumpHistogram(std::ostream& os, const char* name,
+                       const coil::TimeHistogram& hist)
+    {
+      os << "  " << name << ": count=" << hist.count()
+         << " max=" << toSeconds(hist.max()) << std::endl;
+      for (size_t i(0); i < coil::TimeHistogram::bucket_count; ++i)
+        {
+          if (hist.bucket(i) == 0) { continue; }
+          os << "    <" << toSeconds(hist.upperBound(i))
+             << "\t" << hist.bucket(i) << std::endl;
+        }
+    }
+  } // namespace
+
+  void ExecutionStatistics::Histogram::record(std::chrono::nanoseconds value)
+  {
+    buckets[coil::TimeHistogram::bucketIndex(value)]
+      .fetch_add(1, std::memory_order_relaxed);
+    std::int64_t ns(value.count());
+    // only one thread records, so no compare-exchange is needed
+    if (ns > max.load(std::memory_order_relaxed))
+      {
+        max.store(ns, std::memory_order_relaxed);
+      }
+  }
+
+  void ExecutionStatistics::Histogram::reset()
+  {
+    for (auto & bucket : buckets)
+      {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    max.store(0, std::memory_order_relaxed);
+  }
+
+  void ExecutionStatistics::Histogram::copyTo(coil::TimeHistogram& hist) const
+  {
+    std::chrono::nanoseconds maxval(max.load(std::memory_order_relaxed));
+    for (size_t i(0); i < buckets.size(); ++i)
+      {
+        hist.add(i, buckets[i].load(std::memory_order_relaxed), maxval);
+      }
+  }
+
+  void ExecutionStatistics::record(std::chrono::steady_clock::time_point begin,
+                                   std::chrono::steady_clock::time_point end,
+                                   std::chrono::nanoseconds period)
+  {
+    auto exec = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+    m_exec.record(exec);
+    if (period > std::chrono::nanoseconds::zero())
+      {
+        if (exec > period)
+          {
+            m_overruns.fetch_add(1, std::memory_order_relaxed);
+          }
+        if (m_hasLast.load(std::memory_order_relaxed))
+          {
+            auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - m_last);
+            auto jitter = interval - period;
+            m_jitter.record(jitter < std::chrono::nanoseconds::zero()
+                            ? -jitter : jitter);
+          }
+      }
+    m_last = begin;
+    m_hasLast.store(true, std::memory_order_relaxed);
+  }
+
+  void ExecutionStatistics::restart()
+  {
+    m_hasLast.store(false, std::memory_order_relaxed);
+  }
+
+  void ExecutionStatistics::reset()
+  {
+    m_overruns.store(0, std::memory_order_relaxed);
+    m_exec.reset();
+    m_jitter.reset();
+    m_hasLast.store(false, std::memory_order_relaxed);
+  }
+
+  ExecutionStatistics::Snapshot ExecutionStatistics::snapshot() const
+  {
+    Snapshot stat;
+    stat.overruns = m_overruns.load(std::memory_order_relaxed);
+    m_exec.copyTo(stat.exec);
+    m_jitter.copyTo(stat.jitter);
+    return stat;
+  }
+
+  void ExecutionStatistics::toProperties(const Snapshot& stat,
+                                         coil::Properties& prop)
+  {
+    prop["count"] = coil::otos(stat.exec.count());
+    prop["overruns"] = coil::otos(stat.overruns);
+    prop["exec_time.max"] = toSeconds(stat.exec.max());
+    prop["exec_time.p50"] = toSeconds(stat.exec.percentile(0.5));
+    prop["exec_time.p90"] = toSeconds(stat.exec.percentile(0.9));
+    prop["exec_time.p99"] = toSeconds(stat.exec.percentile(0.99));
+    prop["jitter.max"] = toSeconds(stat.jitter.max());
+    prop["jitter.p50"] = toSeconds(stat.jitter.percentile(0.5));
+    prop["jitter.p99"] = toSeconds(stat.jitter.percentile(0.99));
+  }
+
+  void ExecutionStatistics::dump(std::ostream& os, const std::string& name,
+                                 const Snapshot& stat)
+  {
+    os << name << ": overruns=" << stat.overruns << std::endl;
+    dumpHistogram(os, "exec_time", stat.exec);
+    dumpHistogram(os, "jitter", stat.jitter);
+  }
+} // namespace RTC_impl
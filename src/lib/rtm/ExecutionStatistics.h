@@ -0,0 +1,218 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ExecutionStatistics.h
+ * @brief Execution time and jitter statistics of ExecutionContext
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_EXECUTIONSTATISTICS_H
+#define RTC_EXECUTIONSTATISTICS_H
+
+#include <coil/Properties.h>
+#include <coil/TimeMeasure.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace RTC_impl
+{
+  /*!
+   * @if jp
+   * @class ExecutionStatistics
+   * @brief 実行時間とジッタの統計
+   *
+   * ExecutionContext の1周期、または1つの RTC の worker_do の実行時
+   * 間、開始時刻のジッタ、周期超過回数を集計する。ジッタは連続する2
+   * 回の開始時刻の間隔と周期の差の絶対値である。
+   *
+   * 記録は ExecutionContext のスレッドから、読み出しは CORBA のスレッ
+   * ドから行われる。周期ごとの記録がロックを取らないよう、集計値は
+   * coil::TimeHistogram と同じビンごとの atomic 変数に数え、読み出し
+   * 時に coil::TimeHistogram にまとめる。記録時にメモリ確保は行わな
+   * い。読み出し中の記録は一部だけが含まれることがある。
+   *
+   * NO_EC_PROFILE を定義してビルドした場合、ExecutionContext はこの
+   * クラスを使用しない。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class ExecutionStatistics
+   * @brief Execution time and jitter statistics
+   *
+   * Collects the execution time, start time jitter and overrun count
+   * of one ExecutionContext cycle or of one RTC's worker_do. Jitter is
+   * the absolute difference between the interval of two consecutive
+   * starts and the period.
+   *
+   * Recording happens on the ExecutionContext's thread and reading on
+   * CORBA threads. So that recording every period takes no lock,
+   * values are counted in atomic variables per bin of
+   * coil::TimeHistogram and are collected into coil::TimeHistogram
+   * when read. Recording does not allocate. A record made while
+   * reading may be partly included.
+   *
+   * When built with NO_EC_PROFILE, ExecutionContext does not use this
+   * class.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class ExecutionStatistics
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 集計値
+     * @else
+     * @brief Collected values
+     * @endif
+     */
+    struct Snapshot
+    {
+      unsigned long long overruns{0};
+      coil::TimeHistogram exec;
+      coil::TimeHistogram jitter;
+    };
+
+    /*!
+     * @if jp
+     * @brief 1回の実行を記録する
+     *
+     * @param begin 実行開始時刻
+     * @param end 実行終了時刻
+     * @param period 周期。0 の場合、周期超過とジッタは記録しない
+     *
+     * 同時に記録できるのは1つのスレッドのみである。
+     *
+     * @else
+     * @brief Record one execution
+     *
+     * @param begin Start time of the execution
+     * @param end End time of the execution
+     * @param period Period. Overrun and jitter are not recorded if 0
+     *
+     * Only one thread may record at a time.
+     *
+     * @endif
+     */
+    void record(std::chrono::steady_clock::time_point begin,
+                std::chrono::steady_clock::time_point end,
+                std::chrono::nanoseconds period);
+
+    /*!
+     * @if jp
+     * @brief 前回の開始時刻を破棄する
+     *
+     * ExecutionContext の再開時に呼び、停止期間をジッタとして記録しな
+     * いようにする。
+     *
+     * @else
+     * @brief Forget the previous start time
+     *
+     * Called when the ExecutionContext restarts so that the stopped
+     * interval is not recorded as jitter.
+     *
+     * @endif
+     */
+    void restart();
+
+    /*!
+     * @if jp
+     * @brief 集計値をクリアする
+     * @else
+     * @brief Clear the collected values
+     * @endif
+     */
+    void reset();
+
+    /*!
+     * @if jp
+     * @brief 集計値のコピーを取得する
+     * @else
+     * @brief Get a copy of the collected values
+     * @endif
+     */
+    Snapshot snapshot() const;
+
+    /*!
+     * @if jp
+     * @brief 集計値の要約をプロパティに書き出す
+     *
+     * count, overruns, exec_time.{max,p50,p90,p99},
+     * jitter.{max,p50,p99} を秒単位で設定する。パーセンタイルはビン
+     * の上限値である。
+     *
+     * @param stat 集計値
+     * @param prop 書き出し先
+     *
+     * @else
+     * @brief Write a summary of the values into properties
+     *
+     * Sets count, overruns, exec_time.{max,p50,p90,p99} and
+     * jitter.{max,p50,p99} in seconds. Percentiles are bin upper
+     * bounds.
+     *
+     * @param stat Collected values
+     * @param prop Destination
+     *
+     * @endif
+     */
+    static void toProperties(const Snapshot& stat, coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief ヒストグラム全体をストリームに書き出す
+     *
+     * @param os 出力先
+     * @param name 見出し
+     * @param stat 集計値
+     *
+     * @else
+     * @brief Dump the whole histograms to a stream
+     *
+     * @param os Output stream
+     * @param name Heading
+     * @param stat Collected values
+     *
+     * @endif
+     */
+    static void dump(std::ostream& os, const std::string& name,
+                     const Snapshot& stat);
+
+  private:
+    struct Histogram
+    {
+      std::array<std::atomic<unsigned long long>,
+                 coil::TimeHistogram::bucket_count> buckets{};
+      std::atomic<std::int64_t> max{0};
+
+      void record(std::chrono::nanoseconds value);
+      void reset();
+      void copyTo(coil::TimeHistogram& hist) const;
+    };
+
+    std::atomic<unsigned long long> m_overruns{0};
+    Histogram m_exec;
+    Histogram m_jitter;
+    // m_last is used only by the recording thread
+    std::chrono::steady_clock::time_point m_last;
+    std::atomic<bool> m_hasLast{false};
+  };
+} // namespace RTC_impl
+
+#endif // RTC_EXECUTIONSTATISTICS_H
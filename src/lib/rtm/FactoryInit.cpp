@@ -21,6 +21,8 @@
 
 // Buffers
 #include <rtm/CdrRingBuffer.h>
+#include <rtm/CdrSPSCRingBuffer.h>
+#include <rtm/CdrMPSCRingBuffer.h>
 
 // Threads
 #include <rtm/DefaultPeriodicTask.h>
@@ -44,6 +46,8 @@
 #include <rtm/InPortSHMConsumer.h>
 #include <rtm/OutPortSHMProvider.h>
 #include <rtm/OutPortSHMConsumer.h>
+#include <rtm/InPortSHMRingProvider.h>
+#include <rtm/InPortSHMRingConsumer.h>
 #endif
 #include <rtm/InPortDSProvider.h>
 #include <rtm/InPortDSConsumer.h>
@@ -72,6 +76,8 @@ namespace RTM
 
     // Buffers
     CdrRingBufferInit();
+    CdrSPSCRingBufferInit();
+    CdrMPSCRingBufferInit();
 
     // Threads
     DefaultPeriodicTaskInit();
@@ -95,6 +101,8 @@ namespace RTM
     InPortSHMConsumerInit();
     OutPortSHMProviderInit();
     OutPortSHMConsumerInit();
+    InPortSHMRingProviderInit();
+    InPortSHMRingConsumerInit();
 #endif
     InPortDSProviderInit();
     InPortDSConsumerInit();
@@ -32,6 +32,7 @@
 #include <rtm/Timestamp.h>
 #include <rtm/DirectInPortBase.h>
 #include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/NativeSerializer.h>
 #include <rtm/DataTypeUtil.h>
 
 
@@ -128,6 +129,7 @@ namespace RTC
       m_directport = this;
 
       CdrMemoryStreamInit<DataType>();
+      NativeSerializerInit<DataType>();
 
       std::string serializer_types{coil::eraseBlank(coil::flatten(
         getSerializerList<DataType>()))};
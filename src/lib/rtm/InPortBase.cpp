@@ -118,10 +118,26 @@ namespace RTC
     RTC_PARANOID(("updated properties:"));
     RTC_DEBUG_STR((m_properties));
 
+    int num(-1);
+    if (!coil::stringTo(num,
+               m_properties.getProperty("connection_limit", "-1").c_str()))
+      {
+        RTC_ERROR(("invalid connection_limit value: %s",
+                   m_properties.getProperty("connection_limit").c_str()));
+      }
+
     if (m_singlebuffer)
       {
-        RTC_DEBUG(("single buffer mode."));
-        m_thebuffer = CdrBufferFactory::instance().createObject("ring_buffer");
+        // The providers of all connectors write into the single buffer
+        // from their own ORB threads. Unless only one connection is
+        // allowed, use the multi-producer buffer for it.
+        std::string type(m_properties.getProperty("buffer_type"));
+        if (type.empty())
+          {
+            type = (num == 1) ? "ring_buffer" : "mpsc_ring";
+          }
+        RTC_DEBUG(("single buffer mode. buffer type: %s", type.c_str()));
+        m_thebuffer = CdrBufferFactory::instance().createObject(type);
         if (m_thebuffer == nullptr)
           {
             RTC_ERROR(("default buffer creation failed"));
@@ -134,14 +150,6 @@ namespace RTC
 
     initProviders();
     initConsumers();
-    int num(-1);
-    if (!coil::stringTo(num,
-               m_properties.getProperty("connection_limit", "-1").c_str()))
-      {
-        RTC_ERROR(("invalid connection_limit value: %s",
-                   m_properties.getProperty("connection_limit").c_str()));
-      }
-
     setConnectionLimit(num);
   }
 
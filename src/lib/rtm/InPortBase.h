@@ -853,8 +853,18 @@ namespace RTC
     /*!
      * @if jp
      * @brief バッファ
+     *
+     * シングルバッファモードで全コネクタが共有するバッファ。
+     * buffer_type が指定されていない場合、connection_limit が 1 なら
+     * ring_buffer、それ以外は mpsc_ring を使用する。
+     *
      * @else
      * @brief Buffer
+     *
+     * Buffer shared by all connectors in single buffer mode. Unless
+     * buffer_type is given, ring_buffer is used if connection_limit is 1
+     * and mpsc_ring otherwise.
+     *
      * @endif
      */
     CdrBufferBase* m_thebuffer;
@@ -33,7 +33,8 @@ namespace RTC
                                    ConnectorListenersBase* listeners,
                                    CdrBufferBase* buffer)
     : rtclog("InPortConnector"), m_profile(info),
-	m_listeners(listeners), m_buffer(buffer), m_littleEndian(true), m_outPortListeners(nullptr), m_directOutPort(nullptr), m_marshaling_type("corba"), m_cdr(nullptr)
+	m_listeners(listeners), m_buffer(buffer), m_littleEndian(true), m_outPortListeners(nullptr), m_directOutPort(nullptr), m_marshaling_type("corba"), m_cdr(nullptr),
+        m_pool(ByteDataPool::create(info.properties.getNode("buffer")))
   {
   }
 
@@ -124,6 +125,18 @@ namespace RTC
     return m_buffer;
   }
 
+  /*!
+   * @if jp
+   * @brief バッファ用のメモリプールを取得する
+   * @else
+   * @brief Get the memory pool for buffers
+   * @endif
+   */
+  const std::shared_ptr<ByteDataPool>& InPortConnector::getMemoryPool() const
+  {
+    return m_pool;
+  }
+
   /*!
    * @if jp
    * @brief endianタイプ設定
@@ -169,6 +182,18 @@ namespace RTC
 	  }
   }
 
+  /*!
+   * @if jp
+   * @brief 読み出し可能なデータをすべて読み出す
+   * @else
+   * @brief Read all the readable data
+   * @endif
+   */
+  DataPortStatus InPortConnector::readAll(std::vector<ByteData>& /*data*/)
+  {
+    return DataPortStatus::PRECONDITION_NOT_MET;
+  }
+
   BufferStatus InPortConnector::write(ByteData & /*cdr*/)
   {
       return BufferStatus::OK;
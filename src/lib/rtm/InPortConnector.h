@@ -25,7 +25,9 @@
 #include <rtm/DirectOutPortBase.h>
 #include <rtm/PortBase.h>
 #include <rtm/ByteData.h>
+#include <rtm/ByteDataPool.h>
 
+#include <vector>
 
 namespace RTC
 {
@@ -176,6 +178,30 @@ namespace RTC
      */
     CdrBufferBase* getBuffer() override;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプールを取得する
+     *
+     * コネクタのデータのバッファを確保するメモリプールを返す。
+     * getStatistics() で確保の回数を確認できる。バッファ設定の
+     * memory_pool が NO の場合は nullptr。
+     *
+     * @return メモリプール
+     *
+     * @else
+     * @brief Get the memory pool for buffers
+     *
+     * Returns the memory pool allocating the buffers of the data of
+     * this connector. The number of allocations can be checked with
+     * getStatistics(). nullptr if memory_pool of the buffer settings is
+     * NO.
+     *
+     * @return The memory pool
+     *
+     * @endif
+     */
+    const std::shared_ptr<ByteDataPool>& getMemoryPool() const;
+
     /*!
      * @if jp
      * @brief read 関数
@@ -220,18 +246,11 @@ namespace RTC
     template<class DataType>
     DataPortStatus read(DataType& data)
     {
-      if(m_cdr == nullptr)
-      {
-        m_cdr = createSerializer<DataType>(m_marshaling_type);
-      }
-      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
-        
+      ::RTC::ByteDataStream<DataType> *cdr = serializer<DataType>();
         if (!cdr)
         {
-            RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
             return DataPortStatus::PORT_ERROR;
         }
-        cdr->isLittleEndian(isLittleEndian());
         DataPortStatus ret = read((ByteDataStreamBase*)cdr);
         if (ret == DataPortStatus::PORT_OK)
         {
@@ -240,6 +259,138 @@ namespace RTC
         return ret;
     }
 
+    /*!
+     * @if jp
+     * @brief 読み出し可能なデータをすべて読み出す
+     *
+     * 接続先から読み出せるデータを1回の呼び出しでまとめて読み出し、
+     * data の末尾に追加する。この操作に対応しないコネクタは
+     * PRECONDITION_NOT_MET を返す。
+     *
+     * @param data 読み出したデータを追加する配列
+     * @return PORT_OK: 1個以上読み出した, BUFFER_EMPTY: データがない,
+     *         PRECONDITION_NOT_MET: 未対応
+     *
+     * @else
+     * @brief Read all the readable data
+     *
+     * The data readable from the peer are read with a single call and
+     * appended to data. Connectors not supporting this operation return
+     * PRECONDITION_NOT_MET.
+     *
+     * @param data The array to which the read data are appended
+     * @return PORT_OK: One or more data read, BUFFER_EMPTY: No data,
+     *         PRECONDITION_NOT_MET: Not supported
+     *
+     * @endif
+     */
+    virtual DataPortStatus readAll(std::vector<ByteData>& data);
+
+    /*!
+     * @if jp
+     * @brief 読み出し可能なデータをすべて読み出す
+     *
+     * readAll(std::vector<ByteData>&) で読み出したデータを DataType に
+     * 変換して data の末尾に追加する。コネクタが未対応の場合は read()
+     * で1個読み出す。
+     *
+     * @param data 読み出したデータを追加する配列
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Read all the readable data
+     *
+     * The data read with readAll(std::vector<ByteData>&) are converted
+     * to DataType and appended to data. If the connector does not
+     * support it, one datum is read with read().
+     *
+     * @param data The array to which the read data are appended
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    template<class DataType>
+    DataPortStatus readAll(std::vector<DataType>& data)
+    {
+      std::vector<ByteData> samples;
+      DataPortStatus ret = readAll(samples);
+      if (ret == DataPortStatus::PRECONDITION_NOT_MET)
+        {
+          DataType value;
+          ret = read(value);
+          if (ret == DataPortStatus::PORT_OK)
+            {
+              data.push_back(value);
+            }
+          return ret;
+        }
+      if (ret != DataPortStatus::PORT_OK)
+        {
+          return ret;
+        }
+      ::RTC::ByteDataStream<DataType>* cdr = serializer<DataType>();
+      if (!cdr)
+        {
+          return DataPortStatus::PORT_ERROR;
+        }
+      data.reserve(data.size() + samples.size());
+      for (auto& sample : samples)
+        {
+          DataType value;
+          cdr->shareData(sample);
+          cdr->deserialize(value);
+          data.push_back(value);
+        }
+      return ret;
+    }
+
+    /*!
+     * @if jp
+     * @brief 最新のデータを読み出す
+     *
+     * readAll(std::vector<ByteData>&) で読み出せるデータをすべて読み
+     * 出し、最後のデータのみを DataType に変換する。古いデータは変換
+     * せずに捨てる。コネクタが未対応の場合は read() で1個読み出す。
+     *
+     * @param data データを格納する変数
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Read the latest data
+     *
+     * All the data readable with readAll(std::vector<ByteData>&) are
+     * read and only the last one is converted to DataType. The older
+     * data are discarded without conversion. If the connector does not
+     * support it, one datum is read with read().
+     *
+     * @param data The variable to store the data
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    template<class DataType>
+    DataPortStatus readLatest(DataType& data)
+    {
+      std::vector<ByteData> samples;
+      DataPortStatus ret = readAll(samples);
+      if (ret == DataPortStatus::PRECONDITION_NOT_MET)
+        {
+          return read(data);
+        }
+      if (ret != DataPortStatus::PORT_OK || samples.empty())
+        {
+          return ret;
+        }
+      ::RTC::ByteDataStream<DataType>* cdr = serializer<DataType>();
+      if (!cdr)
+        {
+          return DataPortStatus::PORT_ERROR;
+        }
+      cdr->shareData(samples.back());
+      cdr->deserialize(data);
+      return ret;
+    }
+
     /*!
      * @if jp
      * @brief endianタイプ設定
@@ -373,6 +524,30 @@ namespace RTC
     virtual void unsubscribeInterface(const coil::Properties& prop);
 
   protected:
+    /*!
+     * @if jp
+     * @brief DataType のシリアライザを取得する
+     * @else
+     * @brief Get the serializer of DataType
+     * @endif
+     */
+    template<class DataType>
+    ::RTC::ByteDataStream<DataType>* serializer()
+    {
+      if(m_cdr == nullptr)
+      {
+        m_cdr = createSerializer<DataType>(m_marshaling_type);
+      }
+      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+      if (!cdr)
+      {
+        RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
+        return nullptr;
+      }
+      cdr->isLittleEndian(isLittleEndian());
+      return cdr;
+    }
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -448,6 +623,15 @@ namespace RTC
      */
     ByteDataStreamBase* m_cdr;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプール
+     * @else
+     * @brief Memory pool for buffers
+     * @endif
+     */
+    std::shared_ptr<ByteDataPool> m_pool;
+
   };
 } // namespace RTC
 
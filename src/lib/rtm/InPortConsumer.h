@@ -24,6 +24,8 @@
 #include <rtm/DataPortStatus.h>
 #include <rtm/ByteData.h>
 
+#include <vector>
+
 namespace coil
 {
   class Properties;
@@ -145,6 +147,64 @@ namespace RTC
      */
 	virtual DataPortStatus put(ByteData& data) = 0;
 
+    /*!
+     * @if jp
+     * @brief 複数サンプルの一括送信に対応しているかどうか
+     *
+     * 接続先が putBatch() によるフレーム化されたデータを受け付ける場合
+     * に true を返す。デフォルトでは false を返す。
+     *
+     * @return true: 対応している, false: 対応していない
+     *
+     * @else
+     * @brief Whether sending several samples at once is supported
+     *
+     * Returns true if the destination accepts framed data sent by
+     * putBatch(). Returns false by default.
+     *
+     * @return true: supported, false: not supported
+     *
+     * @endif
+     */
+    virtual bool batchSupported() const { return false; }
+
+    /*!
+     * @if jp
+     * @brief 接続先への複数サンプルの一括送信
+     *
+     * サンプル列を CdrBatch の形式でフレーム化し、1回の呼び出しで接続
+     * 先のポートへ送信する。リターンコードは put() と同じだが、フレー
+     * ム全体に対する結果を表す。失敗した場合も、それより前のサンプル
+     * は接続先に格納されていることがあり、その数を count に返す。デフォ
+     * ルトでは PRECONDITION_NOT_MET を返す。
+     *
+     * @param data 送信するデータ列
+     * @param count 接続先が格納したサンプル数
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send several samples to the destination port at once
+     *
+     * Frames the samples in the CdrBatch format and sends them to the
+     * destination port with a single call. The return codes are those
+     * of put() but apply to the frame as a whole. Even on failure the
+     * samples before the failing one may have been stored by the
+     * destination; their number is returned in count. Returns
+     * PRECONDITION_NOT_MET by default.
+     *
+     * @param data Samples to send
+     * @param count Number of samples stored by the destination
+     * @return Return code
+     *
+     * @endif
+     */
+    virtual DataPortStatus
+    putBatch(const std::vector<ByteData*>& /*data*/, size_t& count)
+    {
+      count = 0;
+      return DataPortStatus::PRECONDITION_NOT_MET;
+    }
+
     /*!
      * @if jp
      * @brief InterfaceProfile情報を公開する
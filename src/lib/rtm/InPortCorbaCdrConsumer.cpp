@@ -19,6 +19,7 @@
 
 #include <rtm/NVUtil.h>
 #include <rtm/InPortCorbaCdrConsumer.h>
+#include <rtm/CdrBatch.h>
 
 namespace RTC
 {
@@ -89,6 +90,55 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief 複数サンプルの一括送信に対応しているかどうか
+   * @else
+   * @brief Whether sending several samples at once is supported
+   * @endif
+   */
+  bool InPortCorbaCdrConsumer::batchSupported() const
+  {
+    return !CORBA::is_nil(m_batchRef.in());
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先への複数サンプルの一括送信
+   * @else
+   * @brief Send several samples to the destination port at once
+   * @endif
+   */
+  DataPortStatus InPortCorbaCdrConsumer::
+  putBatch(const std::vector<ByteData*>& data, size_t& count)
+  {
+    RTC_PARANOID(("putBatch(%d)", static_cast<int>(data.size())));
+    count = 0;
+    if (CORBA::is_nil(m_batchRef.in()))
+      {
+        return DataPortStatus::PRECONDITION_NOT_MET;
+      }
+
+    CORBA::ULong len = static_cast<CORBA::ULong>(CdrBatch::length(data));
+    m_data.length(len);
+#ifndef ORB_IS_RTORB
+    CdrBatch::pack(data, static_cast<unsigned char*>(m_data.get_buffer()));
+#else // ORB_IS_RTORB
+    CdrBatch::pack(data, reinterpret_cast<unsigned char*>(&m_data[0]));
+#endif  // ORB_IS_RTORB
+    try
+      {
+        CORBA::ULong stored(0);
+        ::OpenRTM::PortStatus ret(m_batchRef->put_many(m_data, stored));
+        count = stored;
+        return convertReturnCode(ret);
+      }
+    catch (...)
+      {
+        return DataPortStatus::CONNECTION_LOST;
+      }
+  }
+
   /*!
    * @if jp
    * @brief InterfaceProfile情報を公開する
@@ -115,11 +165,21 @@ namespace RTC
     RTC_TRACE(("subscribeInterface()"));
     RTC_DEBUG_STR((NVUtil::toString(properties)));
 
+    m_batchRef = ::OpenRTM::InPortCdrBatch::_nil();
+
     // getting InPort's ref from IOR string
-    if (subscribeFromIor(properties)) { return true; }
+    if (subscribeFromIor(properties))
+      {
+        subscribeBatch(properties);
+        return true;
+      }
 
     // getting InPort's ref from Object reference
-    if (subscribeFromRef(properties)) { return true; }
+    if (subscribeFromRef(properties))
+      {
+        subscribeBatch(properties);
+        return true;
+      }
 
     return false;
   }
@@ -137,6 +197,7 @@ namespace RTC
     RTC_TRACE(("unsubscribeInterface()"));
     RTC_DEBUG_STR((NVUtil::toString(properties)));
 
+    m_batchRef = ::OpenRTM::InPortCdrBatch::_nil();
     if (unsubscribeFromIor(properties)) { return; }
     unsubscribeFromRef(properties);
   }
@@ -144,6 +205,34 @@ namespace RTC
   //----------------------------------------------------------------------
   // private functions
 
+  /*!
+   * @if jp
+   * @brief 一括送信用リファレンスの取得
+   * @else
+   * @brief Get the reference for sending in batches
+   * @endif
+   */
+  void InPortCorbaCdrConsumer::
+  subscribeBatch(const SDOPackage::NVList& properties)
+  {
+    // put_many() is used only if the provider advertises it
+    if (NVUtil::find_index(properties,
+                           "dataport.corba_cdr.inport_batch") < 0)
+      {
+        return;
+      }
+    try
+      {
+        m_batchRef = ::OpenRTM::InPortCdrBatch::_narrow(_ptr());
+      }
+    catch (...)
+      {
+        m_batchRef = ::OpenRTM::InPortCdrBatch::_nil();
+      }
+    RTC_DEBUG(("put_many() %s",
+               CORBA::is_nil(m_batchRef.in()) ? "unavailable" : "available"));
+  }
+
   /*!
    * @if jp
    * @brief IOR文字列からオブジェクト参照を取得する
@@ -155,6 +155,49 @@ namespace RTC
      */
 	DataPortStatus put(ByteData& data) override;
 
+    /*!
+     * @if jp
+     * @brief 複数サンプルの一括送信に対応しているかどうか
+     *
+     * 接続先の InPort が "dataport.corba_cdr.inport_batch" を公開して
+     * いる場合に true を返す。
+     *
+     * @else
+     * @brief Whether sending several samples at once is supported
+     *
+     * Returns true if the destination InPort published
+     * "dataport.corba_cdr.inport_batch".
+     *
+     * @endif
+     */
+    bool batchSupported() const override;
+
+    /*!
+     * @if jp
+     * @brief 接続先への複数サンプルの一括送信
+     *
+     * サンプル列をフレーム化して1つの CdrData に格納し、
+     * OpenRTM::InPortCdrBatch::put_many() を1回呼び出して送信する。
+     *
+     * @param data 送信するデータ列
+     * @param count 接続先が格納したサンプル数
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send several samples to the destination port at once
+     *
+     * Frames the samples into one CdrData and sends it with a single
+     * call of OpenRTM::InPortCdrBatch::put_many().
+     *
+     * @param data Samples to send
+     * @param count Number of samples stored by the destination
+     * @return Return code
+     *
+     * @endif
+     */
+    DataPortStatus putBatch(const std::vector<ByteData*>& data,
+                            size_t& count) override;
+
     /*!
      * @if jp
      * @brief InterfaceProfile情報を公開する
@@ -284,6 +327,29 @@ namespace RTC
      */
     bool unsubscribeFromRef(const SDOPackage::NVList& properties);
 
+    /*!
+     * @if jp
+     * @brief 一括送信用リファレンスの取得
+     *
+     * 接続先が dataport.corba_cdr.inport_batch を公開している場合、
+     * 購読したリファレンスを OpenRTM::InPortCdrBatch に narrow して保
+     * 持する。取得できない場合は put() のみを使用する。
+     *
+     * @param properties 購読時のプロパティ
+     *
+     * @else
+     * @brief Get the reference for sending in batches
+     *
+     * If the provider advertises dataport.corba_cdr.inport_batch, the
+     * subscribed reference is narrowed to OpenRTM::InPortCdrBatch and
+     * kept. Otherwise only put() is used.
+     *
+     * @param properties Properties of the subscription
+     *
+     * @endif
+     */
+    void subscribeBatch(const SDOPackage::NVList& properties);
+
   private:
     /*!
      * @if jp
@@ -297,6 +363,7 @@ namespace RTC
     mutable Logger rtclog;
     coil::Properties m_properties;
     ::OpenRTM::CdrData m_data;
+    ::OpenRTM::InPortCdrBatch_var m_batchRef;
   };
 } // namespace RTC
 
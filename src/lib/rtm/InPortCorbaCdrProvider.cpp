@@ -18,6 +18,7 @@
  */
 
 #include <rtm/InPortCorbaCdrProvider.h>
+#include <rtm/CdrBatch.h>
 
 namespace RTC
 {
@@ -49,6 +50,10 @@ namespace RTC
     CORBA_SeqUtil::
       push_back(m_properties,
                 NVUtil::newNV("dataport.corba_cdr.inport_ref", m_objref));
+    // implements InPortCdrBatch (see put_many())
+    CORBA_SeqUtil::
+      push_back(m_properties,
+                NVUtil::newNV("dataport.corba_cdr.inport_batch", "YES"));
   }
 
   /*!
@@ -135,6 +140,10 @@ namespace RTC
   void InPortCorbaCdrProvider::setConnector(InPortConnector* connector)
   {
     m_connector = connector;
+    if (m_connector != nullptr)
+      {
+        m_received.setPool(m_connector->getMemoryPool());
+      }
   }
 
   /*!
@@ -149,30 +158,107 @@ namespace RTC
   {
     RTC_PARANOID(("InPortCorbaCdrProvider::put()"));
 
+    receive(data);
+
     if (m_connector == nullptr)
       {
-#ifndef ORB_IS_RTORB
-        m_cdr.writeData(const_cast<unsigned char*>(data.get_buffer()), static_cast<CORBA::ULong>(data.length()));
-#else
-        m_cdr.writeData(reinterpret_cast<unsigned char*>(&data[0]), static_cast<CORBA::ULong>(data.length()));
-#endif
+        m_cdr = m_received;
+        onReceiverError(m_cdr);
+        return ::OpenRTM::PORT_ERROR;
+      }
+
+    RTC_PARANOID(("received data size: %d", m_received.getDataLength()));
+    return writeSample(m_received);
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファに複数のデータを書き込む
+   * @else
+   * @brief Write several data into the buffer
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  InPortCorbaCdrProvider::put_many(const ::OpenRTM::CdrData& data,
+                                   ::CORBA::ULong_out count)
+  {
+    RTC_PARANOID(("InPortCorbaCdrProvider::put_many()"));
+    count = 0;
+
+    receive(data);
+
+    if (m_connector == nullptr)
+      {
+        m_cdr = m_received;
+        onReceiverError(m_cdr);
+        return ::OpenRTM::PORT_ERROR;
+      }
 
+    const unsigned char* buffer(m_received.getBuffer());
+    unsigned long length(m_received.getDataLength());
+    CdrBatch::Reader reader(buffer, length);
+    if (!reader.isValid())
+      {
+        RTC_ERROR(("put_many: malformed frame of %d bytes", length));
+        m_cdr = m_received;
         onReceiverError(m_cdr);
         return ::OpenRTM::PORT_ERROR;
       }
 
-    RTC_PARANOID(("received data size: %d", data.length()));
-    
+    // Each sample is written to the buffer and notified as if it had
+    // arrived by itself.
+    RTC_PARANOID(("received batch: %d samples", reader.count()));
+    const unsigned char* sample(nullptr);
+    unsigned long sample_length(0);
+    while (reader.next(sample, sample_length))
+      {
+        ::OpenRTM::PortStatus
+          ret(writeSample(m_received.slice(static_cast<unsigned long>(sample - buffer),
+                                           sample_length)));
+        if (ret != ::OpenRTM::PORT_OK) { return ret; }
+        ++count;
+      }
+    return ::OpenRTM::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信したデータを m_received に設定する
+   * @else
+   * @brief Set the received data to m_received
+   * @endif
+   */
+  void InPortCorbaCdrProvider::receive(const ::OpenRTM::CdrData& data)
+  {
+    unsigned long length(static_cast<CORBA::ULong>(data.length()));
+#ifndef ORB_IS_RTORB
+    const unsigned char* buffer(data.get_buffer());
+#else
+    const unsigned char* buffer(reinterpret_cast<const unsigned char*>(&data[0]));
+#endif
+    // The in-argument is left untouched, since on a collocated call it
+    // is the sender's own sequence. It is copied once into a block of
+    // the connector's memory pool, which reuses the allocation of a
+    // same sized sample no longer buffered.
+    m_received.writeData(buffer, length);
+  }
+
+  /*!
+   * @if jp
+   * @brief 1サンプルをバッファに書き込む
+   * @else
+   * @brief Write a sample into the buffer
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  InPortCorbaCdrProvider::writeSample(const ByteData& sample)
+  {
     // set endian type
     bool endian_type = m_connector->isLittleEndian();
     RTC_TRACE(("connector endian: %s", endian_type ? "little":"big"));
 
+    m_cdr = sample;
     m_cdr.isLittleEndian(endian_type);
-#ifndef ORB_IS_RTORB
-    m_cdr.writeData(const_cast<unsigned char*>(data.get_buffer()), static_cast<CORBA::ULong>(data.length()));
-#else
-    m_cdr.writeData(reinterpret_cast<unsigned char*>(&data[0]), static_cast<CORBA::ULong>(data.length()));
-#endif
     RTC_PARANOID(("converted CDR data size: %d", m_cdr.getDataLength()));
 
     onReceived(m_cdr);
@@ -39,6 +39,8 @@ namespace RTC
    *
    * データ転送に CORBA の OpenRTM::InPortCdr インターフェースを利用し
    * た、push 型データフロー型を実現する InPort プロバイダクラス。
+   * OpenRTM::InPortCdrBatch の put_many() により、複数のデータを1回
+   * で受け取ることもできる。
    *
    * @since 0.4.0
    *
@@ -48,7 +50,8 @@ namespace RTC
    *
    * The InPort provider class which uses the OpenRTM::InPortCdr
    * interface in CORBA for data transfer and realizes a push-type
-   * dataflow.
+   * dataflow. Several data can also be received at once with
+   * put_many() of OpenRTM::InPortCdrBatch.
    *
    * @since 0.4.0
    *
@@ -56,7 +59,7 @@ namespace RTC
    */
   class InPortCorbaCdrProvider
     : public InPortProvider,
-      public virtual POA_OpenRTM::InPortCdr,
+      public virtual POA_OpenRTM::InPortCdrBatch,
       public virtual PortableServer::RefCountServantBase
   {
   public:
@@ -242,7 +245,78 @@ namespace RTC
      */
     ::OpenRTM::PortStatus put(const ::OpenRTM::CdrData& data) override;
 
+    /*!
+     * @if jp
+     * @brief [CORBA interface] バッファに複数のデータを書き込む
+     *
+     * CdrBatch でフレーム化されたデータに含まれる各サンプルを、それ
+     * ぞれ put() で受け取った場合と同様に順に書き込む。書き込みに失敗
+     * した時点で止め、そのステータスを返す。フレームの形式が正しくな
+     * い場合は PORT_ERROR を返す。
+     *
+     * @param data フレーム化された書込対象データ
+     * @param count バッファに格納したサンプル数
+     *
+     * @else
+     * @brief [CORBA interface] Write several data into the buffer
+     *
+     * Writes each sample of the data framed by CdrBatch in order, as if
+     * each had been received by put(). Writing stops at the first
+     * failure and its status is returned. PORT_ERROR is returned if the
+     * frame is malformed.
+     *
+     * @param data The framed data for writing
+     * @param count The number of samples stored in the buffer
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus put_many(const ::OpenRTM::CdrData& data,
+                                   ::CORBA::ULong_out count) override;
+
   private:
+    /*!
+     * @if jp
+     * @brief 受信したデータを m_received に設定する
+     *
+     * 引数のシーケンスは変更せず、コネクタのメモリプールから確保した
+     * バッファに1回だけコピーする。コロケーション呼び出しでは引数は送
+     * 信側のシーケンスそのものであるため、バッファを引き取ってはなら
+     * ない。
+     *
+     * @param data 受信したデータ
+     *
+     * @else
+     * @brief Set the received data to m_received
+     *
+     * The argument sequence is left untouched and is copied once into
+     * a buffer from the connector's memory pool. On a collocated call
+     * the argument is the sender's own sequence, so its buffer must not
+     * be taken over.
+     *
+     * @param data The received data
+     *
+     * @endif
+     */
+    void receive(const ::OpenRTM::CdrData& data);
+
+    /*!
+     * @if jp
+     * @brief 1サンプルをバッファに書き込む
+     *
+     * コネクタのエンディアンを設定してバッファに書き込み、対応する
+     * リスナへ通知する。sample のバッファは共有され、コピーされない。
+     *
+     * @else
+     * @brief Write a sample into the buffer
+     *
+     * Sets the connector's endian, writes the sample into the buffer
+     * and notifies the corresponding listeners. The buffer of sample is
+     * shared, not copied.
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus writeSample(const ByteData& sample);
+
     /*!
      * @if jp
      * @brief リターンコード変換
@@ -370,6 +444,8 @@ namespace RTC
     ConnectorInfo m_profile;
     InPortConnector* m_connector{nullptr};
     ByteData m_cdr;
+    // the whole put() payload; batched samples are slices of it
+    ByteData m_received;
 
   };  // class InPortCorbaCdrProvider
 } // namespace RTC
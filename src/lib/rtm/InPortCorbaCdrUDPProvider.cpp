@@ -136,6 +136,10 @@ namespace RTC
   void InPortCorbaCdrUDPProvider::setConnector(InPortConnector* connector)
   {
     m_connector = connector;
+    if (m_connector != nullptr)
+      {
+        m_cdr.setPool(m_connector->getMemoryPool());
+      }
   }
 
   /*!
@@ -133,6 +133,10 @@ namespace RTC
   void InPortDSProvider::setConnector(InPortConnector* connector)
   {
     m_connector = connector;
+    if (m_connector != nullptr)
+      {
+        m_cdr.setPool(m_connector->getMemoryPool());
+      }
   }
 
   /*!
@@ -21,6 +21,8 @@
 #include <rtm/OutPortConsumer.h>
 #include <rtm/ConnectorListener.h>
 
+#include <coil/stringutil.h>
+
 #include <string>
 
 namespace RTC
@@ -48,12 +50,12 @@ namespace RTC
         throw std::bad_alloc();
       }
     m_buffer->init(info.properties.getNode("buffer"));
+    m_data.setPool(m_pool);
     m_consumer->setBuffer(m_buffer);
     m_consumer->setListener(info, m_listeners);
 
-    std::string type{info.properties.getProperty("marshaling_type", "corba")};
-    m_marshaling_type = coil::eraseBothEndsBlank(
-      info.properties.getProperty("in.marshaling_type", type));
+    m_marshaling_type = m_profile.settings().inMarshalingType;
+    setBatchPolicy(info.properties);
 
     onConnect();
   }
@@ -88,10 +90,29 @@ namespace RTC
       }
     
     DataPortStatus ret = m_consumer->get(m_data);
-    data->writeData(m_data.getBuffer(), m_data.getDataLength());
+    data->shareData(m_data);
     return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief 読み出し可能なデータをすべて読み出す
+   * @else
+   * @brief Read all the readable data
+   * @endif
+   */
+  DataPortStatus
+  InPortPullConnector::readAll(std::vector<ByteData>& data)
+  {
+    RTC_TRACE(("InPortPullConnector::readAll()"));
+    if (m_consumer == nullptr)
+      {
+        return DataPortStatus::PORT_ERROR;
+      }
+    return m_consumer->getMany(data, m_maxBatchCount, m_maxBatchBytes,
+                               m_timeout);
+  }
+
   /*!
    * @if jp
    * @brief 接続解除関数
@@ -152,6 +173,53 @@ namespace RTC
     m_listeners->notify(ON_DISCONNECT, m_profile);
   }
 
+  /*!
+   * @if jp
+   * @brief readAll() の読み出し量と待ち時間を設定する
+   * @else
+   * @brief Set the amount and the waiting time of readAll()
+   * @endif
+   */
+  void InPortPullConnector::setBatchPolicy(const coil::Properties& prop)
+  {
+    // max_batch_count default: 0 (no limit)
+    std::string count_str(prop.getProperty("pull.max_batch_count", "0"));
+    RTC_DEBUG(("max_batch_count: %s", count_str.c_str()));
+
+    long int count(0);
+    if (!coil::stringTo(count, count_str.c_str()) || count < 0)
+      {
+        RTC_ERROR(("invalid max_batch_count value: %s", count_str.c_str()));
+        count = 0;
+      }
+    m_maxBatchCount = static_cast<size_t>(count);
+
+    // max_batch_bytes default: 65536
+    std::string bytes_str(prop.getProperty("pull.max_batch_bytes", "65536"));
+    RTC_DEBUG(("max_batch_bytes: %s", bytes_str.c_str()));
+
+    long int bytes(65536);
+    if (!coil::stringTo(bytes, bytes_str.c_str()) || bytes < 1)
+      {
+        RTC_ERROR(("invalid max_batch_bytes value: %s", bytes_str.c_str()));
+        bytes = 65536;
+      }
+    m_maxBatchBytes = static_cast<size_t>(bytes);
+
+    // timeout default: 0.0 (no long-poll)
+    std::string timeout_str(prop.getProperty("pull.timeout", "0.0"));
+    RTC_DEBUG(("timeout: %s", timeout_str.c_str()));
+
+    double timeout(0.0);
+    if (!coil::stringTo(timeout, timeout_str.c_str()) || timeout < 0.0)
+      {
+        RTC_ERROR(("invalid timeout value: %s", timeout_str.c_str()));
+        timeout = 0.0;
+      }
+    m_timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(timeout));
+  }
+
   void InPortPullConnector::unsubscribeInterface(const coil::Properties& prop)
   {
       if (m_consumer != nullptr)
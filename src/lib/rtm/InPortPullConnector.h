@@ -25,6 +25,9 @@
 #include <rtm/PublisherBase.h>
 #include <rtm/DataPortStatus.h>
 
+#include <chrono>
+#include <vector>
+
 namespace RTC
 {
   class OutPortConsumer;
@@ -184,6 +187,45 @@ namespace RTC
      */
     DataPortStatus read(ByteDataStreamBase* data) override;
 
+    /*!
+     * @if jp
+     * @brief 読み出し可能なデータをすべて読み出す
+     *
+     * OutPortConsumer::getMany() で OutPort 側のバッファのデータを
+     * まとめて読み出す。1回に読み出す量と待ち時間は以下のプロパティ
+     * で設定する。
+     *
+     * - pull.max_batch_count: 1回に読み出す最大データ数。0 の場合は
+     *   制限しない (デフォルト: 0)
+     * - pull.max_batch_bytes: 1回に読み出す最大バイト数。最初の1個は
+     *   常に読み出す (デフォルト: 65536)
+     * - pull.timeout: OutPort 側のバッファが空の場合にデータの到着を
+     *   待つ時間 [s]。0 の場合は待たない (デフォルト: 0)
+     *
+     * @param data 読み出したデータを追加する配列
+     * @return PORT_OK, BUFFER_EMPTY, CONNECTION_LOST, PORT_ERROR 等
+     *
+     * @else
+     * @brief Read all the readable data
+     *
+     * The data in the buffer of the OutPort are read together with
+     * OutPortConsumer::getMany(). The amount read at once and the
+     * waiting time are set with the following properties.
+     *
+     * - pull.max_batch_count: Maximum number of data read at once. 0
+     *   means no limit (default: 0)
+     * - pull.max_batch_bytes: Maximum bytes read at once. The first
+     *   datum is always read (default: 65536)
+     * - pull.timeout: Time [s] to wait for data when the buffer of the
+     *   OutPort is empty. 0 means no waiting (default: 0)
+     *
+     * @param data The array to which the read data are appended
+     * @return PORT_OK, BUFFER_EMPTY, CONNECTION_LOST, PORT_ERROR etc.
+     *
+     * @endif
+     */
+    DataPortStatus readAll(std::vector<ByteData>& data) override;
+
     /*!
      * @if jp
      * @brief 接続解除関数
@@ -285,6 +327,15 @@ namespace RTC
      */
     void onDisconnect();
 
+    /*!
+     * @if jp
+     * @brief readAll() の読み出し量と待ち時間を設定する
+     * @else
+     * @brief Set the amount and the waiting time of readAll()
+     * @endif
+     */
+    void setBatchPolicy(const coil::Properties& prop);
+
   private:
     /*!
      * @if jp
@@ -304,6 +355,9 @@ namespace RTC
      */
     ConnectorListenersBase* m_listeners;
     ByteData m_data;
+    size_t m_maxBatchCount{0};
+    size_t m_maxBatchBytes{65536};
+    std::chrono::nanoseconds m_timeout{0};
   };
 } // namespace RTC
 
@@ -49,6 +49,11 @@ namespace RTC
     if (m_buffer == nullptr || m_provider == nullptr) { throw std::bad_alloc(); }
 
     m_buffer->init(info.properties.getNode("buffer"));
+    m_mpscBuffer = dynamic_cast<CdrMPSCRingBuffer*>(m_buffer);
+    if (m_mpscBuffer != nullptr)
+      {
+        m_producer = m_mpscBuffer->addProducer(m_profile.id);
+      }
     m_provider->init(info.properties);
     m_provider->setBuffer(m_buffer);
     m_provider->setListener(info, m_listeners);
@@ -58,9 +63,7 @@ namespace RTC
         m_sync_readwrite = true;
     }
 
-    std::string type{info.properties.getProperty("marshaling_type", "corba")};
-    m_marshaling_type = coil::eraseBothEndsBlank(
-      info.properties.getProperty("in.marshaling_type", type));
+    m_marshaling_type = m_profile.settings().inMarshalingType;
 
     onConnect();
   }
@@ -123,7 +126,7 @@ namespace RTC
     }
     
     BufferStatus ret = m_buffer->read(m_data);
-    data->writeData(m_data.getBuffer(), m_data.getDataLength());
+    data->shareData(m_data);
 
     if (m_sync_readwrite)
     {
@@ -174,6 +177,14 @@ namespace RTC
   DataPortStatus InPortPushConnector::disconnect()
   {
     RTC_TRACE(("disconnect()"));
+    if (m_pool && m_provider != nullptr)
+      {
+        ByteDataPool::Statistics stats(m_pool->getStatistics());
+        RTC_DEBUG(("memory pool: allocated %llu, reused %llu, peak %llu bytes",
+                   static_cast<unsigned long long>(stats.allocations),
+                   static_cast<unsigned long long>(stats.reuses),
+                   static_cast<unsigned long long>(stats.peakUsedBytes)));
+      }
     // delete provider
     if (m_provider != nullptr)
       {
@@ -182,6 +193,18 @@ namespace RTC
       }
     m_provider = nullptr;
 
+    if (m_producer != nullptr)
+      {
+        RTC_DEBUG(("written %llu, read %llu, lost %llu, rejected %llu",
+                   static_cast<unsigned long long>(m_producer->written),
+                   static_cast<unsigned long long>(m_producer->read),
+                   static_cast<unsigned long long>(m_producer->lost),
+                   static_cast<unsigned long long>(m_producer->rejected)));
+        m_mpscBuffer->removeProducer(m_producer);
+        m_producer = nullptr;
+      }
+    m_mpscBuffer = nullptr;
+
     // delete buffer
     if (m_buffer != nullptr && m_deleteBuffer)
       {
@@ -247,7 +270,9 @@ namespace RTC
 
       
 
-      BufferStatus ret = m_buffer->write(cdr);
+      BufferStatus ret = m_producer != nullptr
+        ? m_mpscBuffer->write(cdr, m_producer)
+        : m_buffer->write(cdr);
 
       if (m_sync_readwrite)
       {
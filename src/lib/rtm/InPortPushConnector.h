@@ -22,6 +22,7 @@
 
 #include <rtm/InPortConnector.h>
 #include <rtm/InPortConsumer.h>
+#include <rtm/CdrMPSCRingBuffer.h>
 #include <rtm/PublisherBase.h>
 
 namespace RTC
@@ -309,6 +310,24 @@ namespace RTC
 
     bool m_deleteBuffer;
 
+    /*!
+     * @if jp
+     * @brief バッファが mpsc_ring の場合の書き込み側のハンドル
+     *
+     * シングルバッファモードで複数のコネクタが1つのバッファを共有する
+     * 場合に、コネクタごとの書き込み・損失数を記録するために使用する。
+     *
+     * @else
+     * @brief Writer handle when the buffer is an mpsc_ring
+     *
+     * Used to count writes and losses per connector when several
+     * connectors share one buffer in single buffer mode.
+     *
+     * @endif
+     */
+    CdrMPSCRingBuffer* m_mpscBuffer{nullptr};
+    CdrMPSCRingBuffer::Producer* m_producer{nullptr};
+
     bool m_sync_readwrite;
 
     struct WorkerThreadCtrl
@@ -98,6 +98,10 @@ namespace RTC
   void InPortSHMProvider::setConnector(InPortConnector* connector)
   {
 	  m_connector = connector;
+	  if (m_connector != nullptr)
+	    {
+	      m_cdr.setPool(m_connector->getMemoryPool());
+	    }
   }
 
 
@@ -179,7 +179,7 @@ namespace RTC
      */
     ::OpenRTM::PortStatus put() override;
     
-  private:
+  protected:
 
     ::OpenRTM::PortStatus
     convertReturn(BufferStatus status,
@@ -226,7 +226,7 @@ namespace RTC
       m_listeners->notifyIn(ON_RECEIVER_ERROR, m_profile, data);
     }
 
-  private:
+  protected:
     CdrBufferBase* m_buffer{nullptr};
 	::OpenRTM::PortSharedMemory_var  m_objref;
     ConnectorListenersBase* m_listeners;
@@ -0,0 +1,172 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  InPortSHMRingConsumer.cpp
+ * @brief InPortSHMRingConsumer class
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/InPortSHMRingConsumer.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  InPortSHMRingConsumer::InPortSHMRingConsumer() = default;
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  InPortSHMRingConsumer::~InPortSHMRingConsumer()
+  {
+    RTC_PARANOID(("~InPortSHMRingConsumer()"));
+    closeRing();
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void InPortSHMRingConsumer::init(coil::Properties& prop)
+  {
+    InPortSHMConsumer::init(prop);
+
+    std::uint32_t count(0);
+    if (coil::stringTo(count,
+                       m_properties.getProperty("shem_ring.slot_count").c_str())
+        && count > 0)
+      {
+        m_slot_count = count;
+      }
+    std::string size(m_properties.getProperty("shem_ring.slot_size"));
+    if (!size.empty())
+      {
+        int value(m_shmem.string_to_MemorySize(size));
+        if (value > 0)
+          {
+            m_slot_size = static_cast<std::uint64_t>(value);
+          }
+      }
+    RTC_DEBUG(("shared_memory_ring: slot_count = %u, slot_size = %llu",
+               m_slot_count, static_cast<unsigned long long>(m_slot_size)));
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先へのデータ送信
+   * @else
+   * @brief Send data to the destination port
+   * @endif
+   */
+  DataPortStatus InPortSHMRingConsumer::put(ByteData& data)
+  {
+    RTC_PARANOID(("put()"));
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_ring.isOpen())
+      {
+        if (m_ring.create(m_shm_address, m_slot_count, m_slot_size) != 0)
+          {
+            RTC_ERROR(("creating shared memory ring %s failed",
+                       m_shm_address.c_str()));
+            return DataPortStatus::PORT_ERROR;
+          }
+        try
+          {
+            // the only CORBA round trip: the provider maps the ring
+            _ptr()->setEndian(m_endian);
+            _ptr()->open_memory(m_ring.getMemorySize(),
+                                m_shm_address.c_str());
+          }
+        catch (...)
+          {
+            m_ring.close(true);
+            return DataPortStatus::CONNECTION_LOST;
+          }
+      }
+
+    switch (m_ring.write(data))
+      {
+      case BufferStatus::OK:
+        return DataPortStatus::PORT_OK;
+      case BufferStatus::FULL:
+        return DataPortStatus::SEND_FULL;
+      default:
+        return DataPortStatus::PORT_ERROR;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief データ受信通知からの登録解除
+   * @else
+   * @brief Unsubscribe the data receive notification
+   * @endif
+   */
+  void InPortSHMRingConsumer::
+  unsubscribeInterface(const SDOPackage::NVList& properties)
+  {
+    closeRing();
+    InPortSHMConsumer::unsubscribeInterface(properties);
+  }
+
+  void InPortSHMRingConsumer::closeRing()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_ring.isOpen())
+      {
+        return;
+      }
+    if (!CORBA::is_nil(_ptr()))
+      {
+        try
+          {
+            _ptr()->close_memory(false);
+          }
+        catch (...)
+          {
+          }
+      }
+    m_ring.close(true);
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void InPortSHMRingConsumerInit(void)
+  {
+    RTC::InPortConsumerFactory& factory(RTC::InPortConsumerFactory::instance());
+    factory.addFactory("shared_memory_ring",
+                       ::coil::Creator< ::RTC::InPortConsumer,
+                       ::RTC::InPortSHMRingConsumer>,
+                       ::coil::Destructor< ::RTC::InPortConsumer,
+                                           ::RTC::InPortSHMRingConsumer>);
+  }
+}
@@ -0,0 +1,176 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  InPortSHMRingConsumer.h
+ * @brief InPortSHMRingConsumer class
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_INPORTSHMRINGCONSUMER_H
+#define RTC_INPORTSHMRINGCONSUMER_H
+
+#include <rtm/InPortSHMConsumer.h>
+#include <rtm/SharedMemoryRing.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class InPortSHMRingConsumer
+   * @brief InPortSHMRingConsumer クラス
+   *
+   * インターフェース型 shared_memory_ring の入力ポートコンシューマ。
+   *
+   * 最初の put() で SharedMemoryRing を作成し、CORBA の open_memory()
+   * でプロバイダに一度だけ通知する。以降のデータはリングのスロットに
+   * 書き込むだけで、サンプルごとの CORBA 呼び出しは行わない。
+   *
+   * コネクタプロファイルの以下のプロパティでリングを設定する。
+   *
+   * - shem_ring.slot_count: スロット数 (デフォルト 16)
+   * - shem_ring.slot_size: スロット長。1M, 64k のように指定できる
+   *   (デフォルト 64k)。これを超えるデータは帯域外領域で送られる。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class InPortSHMRingConsumer
+   * @brief InPortSHMRingConsumer class
+   *
+   * InPort consumer of the shared_memory_ring interface type.
+   *
+   * The first put() creates a SharedMemoryRing and announces it to the
+   * provider once through CORBA open_memory(). After that, data is only
+   * written to a ring slot, with no CORBA invocation per sample.
+   *
+   * The ring is configured by these connector profile properties.
+   *
+   * - shem_ring.slot_count: Number of slots (default 16)
+   * - shem_ring.slot_size: Slot size, which accepts 1M, 64k and so on
+   *   (default 64k). Larger samples are sent out of band.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class InPortSHMRingConsumer
+    : public InPortSHMConsumer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    InPortSHMRingConsumer();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * リングを閉じ、共有メモリを unlink する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Closes the ring and unlinks the shared memory.
+     *
+     * @endif
+     */
+    ~InPortSHMRingConsumer() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     *
+     * @param prop 設定情報
+     *
+     * @else
+     * @brief Initializing configuration
+     *
+     * @param prop Configuration information
+     *
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief 接続先へのデータ送信
+     *
+     * データをリングの空きスロットに書き込む。空きスロットがない場合
+     * は SEND_FULL を返す。
+     *
+     * @param data 送信するデータ
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send data to the destination port
+     *
+     * Writes data to a free slot of the ring. SEND_FULL is returned if
+     * no slot is free.
+     *
+     * @param data The data that will be sent
+     * @return Return code
+     *
+     * @endif
+     */
+    DataPortStatus put(ByteData& data) override;
+
+    /*!
+     * @if jp
+     * @brief データ受信通知からの登録解除
+     *
+     * リングを閉じてから登録を解除する。
+     *
+     * @param properties 登録解除用プロパティ
+     *
+     * @else
+     * @brief Unsubscribe the data receive notification
+     *
+     * Closes the ring and then unsubscribes.
+     *
+     * @param properties Properties for unsubscription
+     *
+     * @endif
+     */
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override;
+
+  private:
+    void closeRing();
+
+    SharedMemoryRing m_ring;
+    std::uint32_t m_slot_count{SHAREDMEMORYRING_DEFAULT_SLOT_COUNT};
+    std::uint64_t m_slot_size{SHAREDMEMORYRING_DEFAULT_SLOT_SIZE};
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * InPortSHMRingConsumer のファクトリを登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This initialization function registers InPortSHMRingConsumer's factory.
+   *
+   * @endif
+   */
+  void InPortSHMRingConsumerInit(void);
+}
+
+#endif // RTC_INPORTSHMRINGCONSUMER_H
@@ -0,0 +1,149 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  InPortSHMRingProvider.cpp
+ * @brief InPortSHMRingProvider class
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/InPortSHMRingProvider.h>
+
+#define SHAREDMEMORYRING_RECEIVE_TIMEOUT std::chrono::milliseconds(100)
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  InPortSHMRingProvider::InPortSHMRingProvider()
+  {
+    // PortProfile setting
+    setInterfaceType("shared_memory_ring");
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  InPortSHMRingProvider::~InPortSHMRingProvider()
+  {
+    std::lock_guard<std::mutex> guard(m_ringMutex);
+    stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief [CORBA interface] リングをマップし受信を開始する
+   * @else
+   * @brief [CORBA interface] Map the ring and start receiving
+   * @endif
+   */
+  void InPortSHMRingProvider::open_memory(::CORBA::ULongLong memory_size,
+                                          const char *shm_address)
+  {
+    RTC_TRACE(("open_memory(%s)", shm_address));
+    std::lock_guard<std::mutex> guard(m_ringMutex);
+    stop();
+    if (m_ring.open(shm_address, memory_size) != 0)
+      {
+        RTC_ERROR(("opening shared memory ring %s failed", shm_address));
+        return;
+      }
+    m_running = true;
+    m_thread = std::thread([this] { receive(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief [CORBA interface] 受信を停止しリングを閉じる
+   * @else
+   * @brief [CORBA interface] Stop receiving and close the ring
+   * @endif
+   */
+  void InPortSHMRingProvider::close_memory(::CORBA::Boolean /*unlink*/)
+  {
+    RTC_TRACE(("close_memory()"));
+    std::lock_guard<std::mutex> guard(m_ringMutex);
+    stop();
+  }
+
+  /*!
+   * @if jp
+   * @brief [CORBA interface] 何もしない
+   * @else
+   * @brief [CORBA interface] Do nothing
+   * @endif
+   */
+  ::OpenRTM::PortStatus InPortSHMRingProvider::put()
+  {
+    return ::OpenRTM::PORT_OK;
+  }
+
+  void InPortSHMRingProvider::stop()
+  {
+    m_running = false;
+    m_ring.wakeup();
+    if (m_thread.joinable())
+      {
+        m_thread.join();
+      }
+    m_ring.close();
+  }
+
+  void InPortSHMRingProvider::receive()
+  {
+    while (m_running)
+      {
+        if (m_ring.read(m_cdr, SHAREDMEMORYRING_RECEIVE_TIMEOUT)
+            != BufferStatus::OK)
+          {
+            continue;
+          }
+        if (m_connector == nullptr)
+          {
+            continue;
+          }
+        RTC_PARANOID(("received data size: %d", m_cdr.getDataLength()));
+        m_cdr.isLittleEndian(m_connector->isLittleEndian());
+
+        onReceived(m_cdr);
+        BufferStatus ret = m_connector->write(m_cdr);
+        convertReturn(ret, m_cdr);
+      }
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void InPortSHMRingProviderInit(void)
+  {
+    RTC::InPortProviderFactory& factory(RTC::InPortProviderFactory::instance());
+    factory.addFactory("shared_memory_ring",
+                       ::coil::Creator< ::RTC::InPortProvider,
+                                        ::RTC::InPortSHMRingProvider>,
+                       ::coil::Destructor< ::RTC::InPortProvider,
+                                           ::RTC::InPortSHMRingProvider>);
+  }
+}
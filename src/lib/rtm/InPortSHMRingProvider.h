@@ -0,0 +1,161 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  InPortSHMRingProvider.h
+ * @brief InPortSHMRingProvider class
+ * @date  $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_INPORTSHMRINGPROVIDER_H
+#define RTC_INPORTSHMRINGPROVIDER_H
+
+#include <rtm/InPortSHMProvider.h>
+#include <rtm/SharedMemoryRing.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class InPortSHMRingProvider
+   * @brief InPortSHMRingProvider クラス
+   *
+   * インターフェース型 shared_memory_ring の入力ポートプロバイダ。
+   *
+   * コンシューマから open_memory() でリングが通知されるとそれをマップ
+   * し、受信スレッドを起動する。受信スレッドはリングにデータが書き込
+   * まれるまで待機し、読み出したデータをコネクタに書き込む。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class InPortSHMRingProvider
+   * @brief InPortSHMRingProvider class
+   *
+   * InPort provider of the shared_memory_ring interface type.
+   *
+   * When the consumer announces its ring by open_memory(), the provider
+   * maps it and starts a receiver thread. The thread waits for data in
+   * the ring and writes each sample to the connector.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class InPortSHMRingProvider
+    : public InPortSHMProvider
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    InPortSHMRingProvider();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * 受信スレッドを停止し、リングを閉じる。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Stops the receiver thread and closes the ring.
+     *
+     * @endif
+     */
+    ~InPortSHMRingProvider() override;
+
+    /*!
+     * @if jp
+     * @brief [CORBA interface] リングをマップし受信を開始する
+     *
+     * @param memory_size 共有メモリのサイズ
+     * @param shm_address 空間名
+     *
+     * @else
+     * @brief [CORBA interface] Map the ring and start receiving
+     *
+     * @param memory_size Size of the shared memory
+     * @param shm_address Name of the shared memory
+     *
+     * @endif
+     */
+    void open_memory(::CORBA::ULongLong memory_size,
+                     const char *shm_address) override;
+
+    /*!
+     * @if jp
+     * @brief [CORBA interface] 受信を停止しリングを閉じる
+     *
+     * @param unlink 使用しない (リングの unlink はコンシューマが行う)
+     *
+     * @else
+     * @brief [CORBA interface] Stop receiving and close the ring
+     *
+     * @param unlink Unused, the consumer unlinks the ring
+     *
+     * @endif
+     */
+    void close_memory(::CORBA::Boolean unlink = false) override;
+
+    /*!
+     * @if jp
+     * @brief [CORBA interface] 何もしない
+     *
+     * データはリング経由で受信するため、この操作は使用されない。
+     *
+     * @else
+     * @brief [CORBA interface] Do nothing
+     *
+     * Data arrives through the ring, so this operation is not used.
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus put() override;
+
+  private:
+    void stop();
+    void receive();
+
+    SharedMemoryRing m_ring;
+    std::mutex m_ringMutex;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * InPortSHMRingProvider のファクトリを登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This initialization function registers InPortSHMRingProvider's factory.
+   *
+   * @endif
+   */
+  void InPortSHMRingProviderInit();
+}
+
+#endif // RTC_INPORTSHMRINGPROVIDER_H
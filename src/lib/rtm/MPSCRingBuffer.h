@@ -0,0 +1,1356 @@
+﻿// -*- C++ -*-
+/*!
+ * @file MPSCRingBuffer.h
+ * @brief Multi-producer/single-consumer lock-free ring buffer
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_MPSCRINGBUFFER_H
+#define RTC_MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <coil/stringutil.h>
+
+#include <rtm/BufferBase.h>
+#include <rtm/BufferStatus.h>
+
+#include <string>
+#include <vector>
+
+#define MPSCRINGBUFFER_DEFAULT_LENGTH 8
+#define MPSCRINGBUFFER_CACHELINE_SIZE 64
+
+/*!
+ * @if jp
+ * @namespace RTC
+ *
+ * @brief RTコンポーネント
+ *
+ * @else
+ *
+ * @namespace RTC
+ *
+ * @brief RT-Component
+ *
+ * @endif
+ */
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class MPSCRingBuffer
+   * @brief 複数書き込み/単一読み出し用ロックフリーリングバッファ
+   *
+   * 複数のスレッドから同時に書き込まれ、1つのスレッドから読み出され
+   * るリングバッファ。InPortBase のシングルバッファモードで、複数の
+   * コネクタのプロバイダが ORB のスレッドから1つのバッファに書き込む
+   * 場合に使用する。
+   *
+   * 各要素はシーケンス番号を持ち、書き込み側は書き込み位置を CAS で
+   * 確保してから要素を書き込み、シーケンス番号を更新して公開する。読
+   * み出し側は公開済みの要素のみを読み出す。通常の書き込み・読み出し
+   * ではミューテックスを一切取得しない。
+   *
+   * バッファポリシー (overwrite, do_nothing, block, readback) および
+   * タイムアウトの意味は RingBuffer と同じである。overwrite ポリシー
+   * でバッファフルの場合、書き込み側は最も古い要素を自ら取り出して破
+   * 棄してから書き込む。
+   *
+   * addProducer() で登録した書き込み側ごとに、書き込み数、上書きによ
+   * り失われた数、バッファフル・タイムアウトで拒否された数、読み出さ
+   * れた数を記録する。これにより、特定の書き込み側のデータばかりが失
+   * われていないかを確認できる。
+   *
+   * wptr(), put(), advanceWptr() は書き込み側が1つの場合のみ使用でき
+   * る。advanceRptr() に負の値は指定できない。
+   *
+   * length は最初の init() でのみ設定する。シングルバッファモードで
+   * は接続ごとに init() が呼ばれ、その時点で他の書き込み側が書き込み
+   * 中である可能性があるためである。ポリシーは init() のたびに更新す
+   * る。
+   *
+   * @param DataType バッファに格納するデータ型
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class MPSCRingBuffer
+   * @brief Lock-free multi-producer/single-consumer ring buffer
+   *
+   * Ring buffer written by several threads at once and read by one
+   * thread. It is used by InPortBase in single buffer mode, where the
+   * providers of several connectors write into one buffer from ORB
+   * threads.
+   *
+   * Each slot carries a sequence number. A writer claims a position
+   * with a CAS, stores the element and publishes it by updating the
+   * sequence number. The reader takes only published elements. Ordinary
+   * writes and reads never take a mutex.
+   *
+   * The buffer policies (overwrite, do_nothing, block, readback) and
+   * timeouts have the same meaning as in RingBuffer. When the buffer is
+   * full under the overwrite policy, the writer takes the oldest element
+   * out and drops it before writing.
+   *
+   * For every writer registered with addProducer(), the number of
+   * writes, of elements lost by overwriting, of writes rejected by full
+   * buffer or timeout and of elements read are counted, so that one can
+   * tell whether the data of a particular writer is being lost.
+   *
+   * wptr(), put() and advanceWptr() may be used only with a single
+   * writer. advanceRptr() does not accept a negative value.
+   *
+   * length is applied by the first init() only, because in single
+   * buffer mode init() is called for every connection while other
+   * writers may be writing. The policies are updated by every init().
+   *
+   * @param DataType Data type to store in the buffer
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  template <class DataType>
+  class MPSCRingBuffer
+    : public BufferBase<DataType>
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 書き込み側
+     *
+     * addProducer() が返すハンドル。カウンタは書き込み側と読み出し
+     * 側が更新する。
+     *
+     * @else
+     * @brief Writer
+     *
+     * Handle returned by addProducer(). The counters are updated by the
+     * writer and the reader.
+     *
+     * @endif
+     */
+    class Producer
+    {
+    public:
+      std::string name;
+      std::atomic<std::uint64_t> written{0};
+      std::atomic<std::uint64_t> lost{0};
+      std::atomic<std::uint64_t> rejected{0};
+      std::atomic<std::uint64_t> read{0};
+      std::atomic<std::uint64_t> lastRead{0};
+      bool active{false};
+    };
+
+    /*!
+     * @if jp
+     * @brief 書き込み側の統計
+     *
+     * - written: 書き込んだ要素数。最後に書き込んだ要素のシーケンス番
+     *   号でもある
+     * - lost: 書き込んだ要素のうち上書きにより失われた数
+     * - rejected: バッファフルまたはタイムアウトで書き込めなかった数
+     * - read: 書き込んだ要素のうち読み出された数
+     * - lastRead: 最後に読み出された要素のシーケンス番号
+     *
+     * @else
+     * @brief Statistics of a writer
+     *
+     * - written: Number of elements written. This is also the sequence
+     *   number of the last written element
+     * - lost: Number of written elements lost by overwriting
+     * - rejected: Number of writes failed by full buffer or timeout
+     * - read: Number of written elements that have been read
+     * - lastRead: Sequence number of the element read last
+     *
+     * @endif
+     */
+    struct ProducerStatus
+    {
+      std::string name;
+      std::uint64_t written;
+      std::uint64_t lost;
+      std::uint64_t rejected;
+      std::uint64_t read;
+      std::uint64_t lastRead;
+    };
+
+    /*!
+     * @if jp
+     *
+     * @brief コンストラクタ
+     *
+     * 指定されたバッファ長でバッファを初期化する。
+     *
+     * @param length バッファ長
+     *
+     * @else
+     *
+     * @brief Constructor
+     *
+     * Initialize the buffer by specified buffer length.
+     *
+     * @param length Buffer length
+     *
+     * @endif
+     */
+    explicit MPSCRingBuffer(long int length = MPSCRINGBUFFER_DEFAULT_LENGTH)
+      : m_length(length > 0 ? static_cast<size_t>(length) : 1),
+        m_slotCount(slotCount(m_length)),
+        m_slots(new Slot[m_slotCount])
+    {
+      this->reset();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 仮想デストラクタ
+     *
+     * @else
+     *
+     * @brief Virtual destractor
+     *
+     * @endif
+     */
+    ~MPSCRingBuffer() override;
+
+    /*!
+     * @if jp
+     * @brief バッファの設定
+     *
+     * coil::Properties で与えられるプロパティにより、バッファの設定を
+     * 初期化する。使用できるオプションは RingBuffer と同じく、
+     * length, write.full_policy, write.timeout, read.empty_policy,
+     * read.timeout である。length は最初の呼び出しでのみ設定する。
+     *
+     * @else
+     * @brief Set the buffer
+     *
+     * Initialize the buffer by the given coil::Properties. Available
+     * options are the same as RingBuffer: length, write.full_policy,
+     * write.timeout, read.empty_policy and read.timeout. length is
+     * applied by the first call only.
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop) override
+    {
+      if (!m_initialized)
+        {
+          initLength(prop);
+          m_initialized = true;
+        }
+      initWritePolicy(prop);
+      initReadPolicy(prop);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファ長を取得する
+     *
+     * @return バッファ長
+     *
+     * @else
+     *
+     * @brief Get the buffer length
+     *
+     * @return Buffer length
+     *
+     * @endif
+     */
+    size_t length() const override
+    {
+      return m_length;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファの長さをセットする
+     *
+     * バッファ長を設定し、書き込み・読み出し位置をリセットする。
+     * 読み書き中のスレッドが存在しない状態で呼び出すこと。
+     *
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Set the buffer length
+     *
+     * Set the buffer length and reset the read/write positions. This
+     * must not be called while the buffer is in use.
+     *
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus length(size_t n) override
+    {
+      if (n == 0)
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      m_slots.reset(new Slot[slotCount(n)]);
+      m_length = n;
+      m_slotCount = slotCount(n);
+      this->reset();
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファの状態をリセットする
+     *
+     * バッファの読み出し位置と書き込み位置をリセットする。
+     *
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Reset the buffer status
+     *
+     * Reset the read and write positions of the buffer.
+     *
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus reset() override
+    {
+      for (size_t i(0); i < m_slotCount; ++i)
+        {
+          m_slots[i].sequence.store(i);
+          m_slots[i].producer = nullptr;
+        }
+      m_head.store(0);
+      m_tail.store(0);
+      m_hasLast = false;
+      return BufferStatus::OK;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     *
+     * @brief バッファの現在の書込み要素のポインタ
+     *
+     * 書き込み側が1つの場合のみ使用できる。
+     *
+     * @param  n 書込みポインタ + n の位置のポインタ
+     * @return 書込み位置のポインタ
+     *
+     * @else
+     *
+     * @brief Get the writing pointer
+     *
+     * This may be used only with a single writer.
+     *
+     * @param  n Writing pointer + n
+     * @return Pointer to the writing position
+     *
+     * @endif
+     */
+    DataType* wptr(long int n = 0) override
+    {
+      return &m_slots[index(m_head.load(std::memory_order_relaxed), n)].data;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 書込みポインタを進める
+     *
+     * wptr() または put() で書き込んだ n 個の要素を公開する。書き込み
+     * 側が1つの場合のみ使用できる。
+     *
+     * @param  n 書込みポインタ + n の位置のポインタ
+     * @param  unlock_enable trueの場合にバッファエンプティのブロックを解除する
+     * @return OK:            正常終了
+     *         PRECONDITION_NOT_MET: n が範囲外
+     *
+     * @else
+     *
+     * @brief Forward the writing pointer
+     *
+     * Publish n elements written by wptr() or put(). This may be used
+     * only with a single writer.
+     *
+     * @param  n Writing pointer + n
+     * @param  unlock_enable Wake up a reader blocked on empty if true
+     * @return OK:            Successful
+     *         PRECONDITION_NOT_MET: n is out of range
+     *
+     * @endif
+     */
+    BufferStatus advanceWptr(long int n = 1, bool unlock_enable = true) override
+    {
+      if (n < 0 || static_cast<size_t>(n) > writable())
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      std::uint64_t head(m_head.load(std::memory_order_relaxed));
+      for (long int i(0); i < n; ++i)
+        {
+          Slot& slot(m_slots[index(head, i)]);
+          slot.producer = nullptr;
+          slot.sequence.store(head + static_cast<std::uint64_t>(i) + 1,
+                              std::memory_order_release);
+        }
+      m_head.store(head + static_cast<std::uint64_t>(n));
+      if (unlock_enable && n > 0)
+        {
+          wakeup(m_empty);
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファにデータを書き込む
+     *
+     * バッファにデータを書き込む。書き込みポインタの位置は変更されない。
+     * 書き込み側が1つの場合のみ使用できる。
+     *
+     * @param value 書き込み対象データ
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Write data into the buffer
+     *
+     * Write data into the buffer without moving the writing pointer.
+     * This may be used only with a single writer.
+     *
+     * @param value Target data to write.
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus put(const DataType& value) override
+    {
+      *wptr() = value;
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書き込む
+     *
+     * 引数で与えられたデータをバッファに書き込む。バッファフル時の動作
+     * は RingBuffer::write() と同じである。書き込み側の統計は記録しな
+     * い。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (default -1: 無効)
+     * @return OK            正常終了
+     *         FULL          バッファがフル状態
+     *         TIMEOUT              書込みがタイムアウトした
+     *         PRECONDITION_NOT_MET 設定異常
+     *
+     * @else
+     *
+     * @brief Write data into the buffer
+     *
+     * Write the given data into the buffer. The behavior on a full
+     * buffer is the same as RingBuffer::write(). No writer statistics
+     * are recorded.
+     *
+     * @param value Target data for writing
+     * @param timeout Timeout in nsec (default -1: disabled)
+     * @return OK            Successful
+     *         FULL          The buffer is full
+     *         TIMEOUT              Writing timed out
+     *         PRECONDITION_NOT_MET Invalid configuration
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& value,
+                       std::chrono::nanoseconds timeout
+                       = std::chrono::nanoseconds(-1)) override
+    {
+      return write(value, nullptr, timeout);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 書き込み側を指定してバッファに書き込む
+     *
+     * write(value, timeout) と同じく書き込み、producer の統計を更新す
+     * る。
+     *
+     * @param value 書き込み対象データ
+     * @param producer addProducer() で登録した書き込み側。nullptr 可
+     * @param timeout タイムアウト時間 nsec (default -1: 無効)
+     * @return write(value, timeout) と同じ
+     *
+     * @else
+     *
+     * @brief Write data into the buffer on behalf of a writer
+     *
+     * Same as write(value, timeout), and updates the statistics of
+     * producer.
+     *
+     * @param value Target data for writing
+     * @param producer Writer registered by addProducer(). May be nullptr
+     * @param timeout Timeout in nsec (default -1: disabled)
+     * @return Same as write(value, timeout)
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& value, Producer* producer,
+                       std::chrono::nanoseconds timeout
+                       = std::chrono::nanoseconds(-1))
+    {
+      std::uint64_t pos;
+      if (!claim(pos))
+        {
+          WritePolicy policy(m_writePolicy.load(std::memory_order_relaxed));
+          if (timeout >= std::chrono::seconds::zero())  // block mode
+            {
+              policy = WritePolicy::BLOCK;
+            }
+
+          if (policy == WritePolicy::OVERWRITE)
+            {
+              // drop the oldest element ourselves until a slot is free
+              do
+                {
+                  drop();
+                }
+              while (!claim(pos));
+            }
+          else if (policy == WritePolicy::DO_NOTHING)
+            {
+              if (producer != nullptr) { ++producer->rejected; }
+              return BufferStatus::FULL;
+            }
+          else  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = std::chrono::nanoseconds(
+                    m_wtimeout.load(std::memory_order_relaxed));
+                }
+              auto deadline = std::chrono::steady_clock::now() + timeout;
+              while (!claim(pos))
+                {
+                  auto rest = deadline - std::chrono::steady_clock::now();
+                  if (rest <= std::chrono::steady_clock::duration::zero() ||
+                      !park(m_full, rest, [this] { return !full(); }))
+                    {
+                      if (producer != nullptr) { ++producer->rejected; }
+                      return BufferStatus::TIMEOUT;
+                    }
+                }
+            }
+        }
+
+      Slot& slot(m_slots[index(pos, 0)]);
+      slot.data = value;
+      slot.producer = producer;
+      if (producer != nullptr)
+        {
+          slot.number = ++producer->written;
+        }
+      slot.sequence.store(pos + 1, std::memory_order_release);
+      wakeup(m_empty);
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書込み可能な要素数
+     *
+     * @return 書き込み可能な要素数
+     *
+     * @else
+     *
+     * @brief Get a writable number
+     *
+     * @return Writable number
+     *
+     * @endif
+     */
+    size_t writable() const override
+    {
+      return m_length - fillCount();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファfullチェック
+     *
+     * @return fullチェック結果(true:バッファfull，false:バッファ空きあり)
+     *
+     * @else
+     *
+     * @brief Check on whether the buffer is full.
+     *
+     * @return True if the buffer is full, else false.
+     *
+     * @endif
+     */
+    bool full() const override
+    {
+      return fillCount() >= m_length;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     *
+     * @brief バッファの現在の読み出し要素のポインタ
+     *
+     * @param  n 読み出しポインタ + n の位置のポインタ
+     * @return 読み出し位置のポインタ
+     *
+     * @else
+     *
+     * @brief Get the reading pointer
+     *
+     * @param  n Reading pointer + n
+     * @return Pointer to the reading position
+     *
+     * @endif
+     */
+    DataType* rptr(long int n = 0) override
+    {
+      return &m_slots[index(m_tail.load(), n)].data;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 読み出しポインタを進める
+     *
+     * 公開済みの要素を n 個読み捨てる。負の値は指定できない。
+     *
+     * @param  n 読み出しポインタ + n の位置のポインタ
+     * @param  unlock_enable trueの場合にバッファフルのブロックを解除する
+     * @return OK: 正常終了
+     *         PRECONDITION_NOT_MET: n が範囲外
+     *
+     * @else
+     *
+     * @brief Forward the reading pointer
+     *
+     * Discard n published elements. A negative value is not accepted.
+     *
+     * @param  n Reading pointer + n
+     * @param  unlock_enable Wake up a writer blocked on full if true
+     * @return OK: Successful
+     *         PRECONDITION_NOT_MET: n is out of range
+     *
+     * @endif
+     */
+    BufferStatus advanceRptr(long int n = 1, bool unlock_enable = true) override
+    {
+      if (n < 0 || static_cast<size_t>(n) > readable())
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      for (long int i(0); i < n; ++i)
+        {
+          std::uint64_t pos;
+          if (!take(pos)) { return BufferStatus::PRECONDITION_NOT_MET; }
+          Slot& slot(m_slots[index(pos, 0)]);
+          countRead(slot);
+          release(slot, pos);
+        }
+      if (unlock_enable && n > 0)
+        {
+          wakeup(m_full);
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファからデータを読み出す
+     *
+     * バッファからデータを読みだす。読み出しポインタの位置は変更されない。
+     *
+     * @param value 読み出しデータ
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Read data from the buffer
+     *
+     * Read data from the buffer without moving the reading pointer.
+     *
+     * @param value Read data
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus get(DataType& value) override
+    {
+      value = *rptr();
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファからデータを読み出す
+     *
+     * @return 読み出しデータ
+     *
+     * @else
+     *
+     * @brief Reading data from the buffer
+     *
+     * @return Read data
+     *
+     * @endif
+     */
+    DataType& get() override
+    {
+      return *rptr();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファから読み出す
+     *
+     * バッファに格納されたデータを読み出す。バッファ空時の動作は
+     * RingBuffer::read() と同じである。readback ポリシーでは最後に読
+     * み出したデータを返す。
+     *
+     * @param value 読み出し対象データ
+     * @param timeout タイムアウト時間 (default -1: 無効)
+     * @return OK            正常終了
+     *         EMPTY         バッファが空状態
+     *         TIMEOUT              読み出しがタイムアウトした
+     *         PRECONDITION_NOT_MET 設定異常
+     *
+     * @else
+     *
+     * @brief Readout data from the buffer
+     *
+     * Read the data stored in the buffer. The behavior on an empty
+     * buffer is the same as RingBuffer::read(). Under the readback
+     * policy the data read last is returned.
+     *
+     * @param value Readout data
+     * @param timeout Timeout (default -1: disabled)
+     * @return OK            Successful
+     *         EMPTY         The buffer is empty
+     *         TIMEOUT              Reading timed out
+     *         PRECONDITION_NOT_MET Invalid configuration
+     *
+     * @endif
+     */
+    BufferStatus read(DataType& value,
+                      std::chrono::nanoseconds timeout
+                      = std::chrono::nanoseconds(-1)) override
+    {
+      ReadPolicy policy(m_readPolicy.load(std::memory_order_relaxed));
+      std::uint64_t pos;
+      if (!take(pos))
+        {
+          if (timeout >= std::chrono::seconds::zero()) // block mode
+            {
+              policy = ReadPolicy::BLOCK;
+            }
+
+          if (policy == ReadPolicy::READBACK)
+            {
+              if (!m_hasLast)
+                {
+                  return BufferStatus::EMPTY;
+                }
+              value = m_last;
+              return BufferStatus::OK;
+            }
+          else if (policy == ReadPolicy::DO_NOTHING)
+            {
+              return BufferStatus::EMPTY;
+            }
+          else  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = std::chrono::nanoseconds(
+                    m_rtimeout.load(std::memory_order_relaxed));
+                }
+              auto deadline = std::chrono::steady_clock::now() + timeout;
+              while (!take(pos))
+                {
+                  auto rest = deadline - std::chrono::steady_clock::now();
+                  if (rest <= std::chrono::steady_clock::duration::zero() ||
+                      !park(m_empty, rest, [this] { return !empty(); }))
+                    {
+                      return BufferStatus::TIMEOUT;
+                    }
+                  // a writer has claimed the slot but not published it yet
+                  std::this_thread::yield();
+                }
+            }
+        }
+
+      Slot& slot(m_slots[index(pos, 0)]);
+      value = std::move(slot.data);
+      countRead(slot);
+      release(slot, pos);
+      wakeup(m_full);
+
+      if (policy == ReadPolicy::READBACK)
+        {
+          m_last = value;
+          m_hasLast = true;
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファから読み出し可能な要素数
+     *
+     * 書き込み中の要素も含むため、直後の read() が EMPTY を返すことが
+     * ある。
+     *
+     * @return 読み出し可能な要素数
+     *
+     * @else
+     *
+     * @brief Get a readable number
+     *
+     * This includes elements being written, so a following read() may
+     * still return EMPTY.
+     *
+     * @return Readable number
+     *
+     * @endif
+     */
+    size_t readable() const override
+    {
+      return fillCount();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファemptyチェック
+     *
+     * @return emptyチェック結果(true:バッファempty，false:バッファデータあり)
+     *
+     * @else
+     *
+     * @brief Check on whether the buffer is empty.
+     *
+     * @return True if the buffer is empty, else false.
+     *
+     * @endif
+     */
+    bool empty() const override
+    {
+      return fillCount() == 0;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     *
+     * @brief 書き込み側を登録する
+     *
+     * 返されたハンドルは removeProducer() まで有効である。
+     *
+     * @param name 書き込み側の名前 (コネクタID等)
+     * @return 書き込み側のハンドル
+     *
+     * @else
+     *
+     * @brief Register a writer
+     *
+     * The returned handle is valid until removeProducer().
+     *
+     * @param name Name of the writer (connector ID etc.)
+     * @return Handle of the writer
+     *
+     * @endif
+     */
+    Producer* addProducer(const std::string& name)
+    {
+      std::lock_guard<std::mutex> guard(m_producerMutex);
+      Producer* producer(nullptr);
+      for (auto& p : m_producers)
+        {
+          if (!p->active) { producer = p.get(); break; }
+        }
+      if (producer == nullptr)
+        {
+          m_producers.emplace_back(new Producer());
+          producer = m_producers.back().get();
+        }
+      producer->name = name;
+      producer->written = 0;
+      producer->lost = 0;
+      producer->rejected = 0;
+      producer->read = 0;
+      producer->lastRead = 0;
+      producer->active = true;
+      return producer;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 書き込み側の登録を解除する
+     *
+     * ハンドルの領域はバッファが破棄されるまで保持され、次に登録され
+     * る書き込み側に再利用される。
+     *
+     * @param producer 書き込み側のハンドル
+     *
+     * @else
+     *
+     * @brief Unregister a writer
+     *
+     * The storage of the handle is kept until the buffer is destroyed
+     * and is reused by the writer registered next.
+     *
+     * @param producer Handle of the writer
+     *
+     * @endif
+     */
+    void removeProducer(Producer* producer)
+    {
+      std::lock_guard<std::mutex> guard(m_producerMutex);
+      producer->active = false;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 登録されている書き込み側の統計を取得する
+     *
+     * @return 書き込み側の統計のリスト
+     *
+     * @else
+     *
+     * @brief Get the statistics of the registered writers
+     *
+     * @return List of writer statistics
+     *
+     * @endif
+     */
+    std::vector<ProducerStatus> producers() const
+    {
+      std::lock_guard<std::mutex> guard(m_producerMutex);
+      std::vector<ProducerStatus> ret;
+      for (auto& p : m_producers)
+        {
+          if (!p->active) { continue; }
+          ret.push_back({p->name, p->written.load(), p->lost.load(),
+                         p->rejected.load(), p->read.load(),
+                         p->lastRead.load()});
+        }
+      return ret;
+    }
+
+  private:
+    enum class WritePolicy { OVERWRITE, DO_NOTHING, BLOCK };
+    enum class ReadPolicy { READBACK, DO_NOTHING, BLOCK };
+
+    /*!
+     * @if jp
+     * @brief バッファの要素
+     *
+     * sequence が位置 pos と等しければ書き込み可能、pos + 1 であれば
+     * 読み出し可能である。読み出し後は pos + 要素数 (m_slotCount) とな
+     * り、次の周回の書き込みを待つ。取り出されて解放前の要素は
+     * pos + 1 のままであり、要素数が2以上であるため次の周回の書き込み
+     * 位置とは一致しない。
+     *
+     * @else
+     * @brief Slot of the buffer
+     *
+     * The slot is writable when sequence equals its position pos, and
+     * readable when it is pos + 1. After reading it becomes pos +
+     * m_slotCount and waits for the write of the next round. A slot
+     * taken but not yet released keeps pos + 1, which never equals the
+     * position of the next round because there are at least two slots.
+     *
+     * @endif
+     */
+    struct Slot
+    {
+      std::atomic<std::uint64_t> sequence{0};
+      Producer* producer{nullptr};
+      std::uint64_t number{0};
+      DataType data;
+    };
+
+    /*!
+     * @if jp
+     * @brief 待機用条件変数構造体
+     *
+     * waiting は待機しているスレッド数で、相手側は 0 でない場合のみ
+     * ミューテックスを取得して通知する。
+     *
+     * @else
+     * @brief struct for parking blocked threads
+     *
+     * waiting is the number of parked threads, so that the other side
+     * takes the mutex and notifies only when it is not zero.
+     *
+     * @endif
+     */
+    struct condition
+    {
+      condition() {}
+      std::condition_variable cond;
+      std::mutex mutex;
+      std::atomic<int> waiting{0};
+    };
+
+    /*!
+     * @if jp
+     * @brief バッファ長 length に対する内部の要素数
+     *
+     * 長さ 1 でも要素を2つ確保する。要素が1つでは「pos - 1 に公開済み」
+     * または「pos - 1 を取り出し中」と「pos に書き込み可能」を
+     * sequence で区別できない。格納できる要素数は length のままとする。
+     *
+     * @else
+     * @brief Number of internal slots for the buffer length length
+     *
+     * Two slots are allocated even for length 1. With a single slot,
+     * "published at pos - 1" or "pos - 1 being taken out" could not be
+     * told from "writable for pos" by the sequence. At most length
+     * elements are still stored.
+     *
+     * @endif
+     */
+    static inline size_t slotCount(size_t length)
+    {
+      return length > 1 ? length : 2;
+    }
+
+    inline size_t index(std::uint64_t pos, long int n) const
+    {
+      std::uint64_t len(m_slotCount);
+      if (n < 0)
+        {
+          pos += len - static_cast<std::uint64_t>(-n) % len;
+        }
+      else
+        {
+          pos += static_cast<std::uint64_t>(n);
+        }
+      return static_cast<size_t>(pos % len);
+    }
+
+    inline size_t fillCount() const
+    {
+      std::uint64_t tail(m_tail.load());
+      std::uint64_t head(m_head.load());
+      return head > tail ? static_cast<size_t>(head - tail) : 0;
+    }
+
+    /*!
+     * @if jp
+     * @brief 書き込み位置を確保する。バッファフルの場合 false
+     * @else
+     * @brief Claim a write position. false if the buffer is full
+     * @endif
+     */
+    bool claim(std::uint64_t& pos)
+    {
+      pos = m_head.load(std::memory_order_relaxed);
+      for (;;)
+        {
+          std::uint64_t seq(m_slots[index(pos, 0)].sequence.
+                            load(std::memory_order_acquire));
+          if (seq == pos)
+            {
+              // the slot is free, but with length 1 there is a spare
+              // slot and the element count has to be checked as well
+              if (pos - m_tail.load() >= m_length)
+                {
+                  return false;
+                }
+              if (m_head.compare_exchange_weak(pos, pos + 1))
+                {
+                  return true;
+                }
+            }
+          else if (seq < pos)
+            {
+              return false;
+            }
+          else
+            {
+              pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * @if jp
+     * @brief 公開済みの最も古い要素の位置を確保する。空の場合 false
+     * @else
+     * @brief Claim the oldest published element. false if empty
+     * @endif
+     */
+    bool take(std::uint64_t& pos)
+    {
+      pos = m_tail.load(std::memory_order_relaxed);
+      for (;;)
+        {
+          std::uint64_t seq(m_slots[index(pos, 0)].sequence.
+                            load(std::memory_order_acquire));
+          if (seq == pos + 1)
+            {
+              if (m_tail.compare_exchange_weak(pos, pos + 1))
+                {
+                  return true;
+                }
+            }
+          else if (seq < pos + 1)
+            {
+              return false;
+            }
+          else
+            {
+              pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline void release(Slot& slot, std::uint64_t pos)
+    {
+      slot.producer = nullptr;
+      slot.sequence.store(pos + m_slotCount, std::memory_order_release);
+    }
+
+    inline void countRead(Slot& slot)
+    {
+      if (slot.producer != nullptr)
+        {
+          ++slot.producer->read;
+          slot.producer->lastRead.store(slot.number);
+        }
+    }
+
+    /*!
+     * @if jp
+     * @brief overwrite ポリシーで最も古い要素を破棄する
+     * @else
+     * @brief Drop the oldest element under the overwrite policy
+     * @endif
+     */
+    void drop()
+    {
+      std::uint64_t pos;
+      if (!take(pos))
+        {
+          // another writer is still filling the oldest slot
+          std::this_thread::yield();
+          return;
+        }
+      Slot& slot(m_slots[index(pos, 0)]);
+      if (slot.producer != nullptr)
+        {
+          ++slot.producer->lost;
+        }
+      slot.data = DataType();
+      release(slot, pos);
+    }
+
+    template <class Predicate, class Rep, class Period>
+    bool park(condition& cond, std::chrono::duration<Rep, Period> timeout,
+              Predicate ready)
+    {
+      std::unique_lock<std::mutex> guard(cond.mutex);
+      // seq_cst increment pairs with the seq_cst position update of the
+      // other side, so that either it sees the waiter or we see the data
+      ++cond.waiting;
+      bool ret(cond.cond.wait_for(guard, timeout, ready));
+      --cond.waiting;
+      return ret;
+    }
+
+    static inline void wakeup(condition& cond)
+    {
+      if (cond.waiting.load() != 0)
+        {
+          std::lock_guard<std::mutex> guard(cond.mutex);
+          cond.cond.notify_all();
+        }
+    }
+
+    inline void initLength(const coil::Properties& prop)
+    {
+      if (!prop["length"].empty())
+        {
+          size_t n;
+          if (coil::stringTo(n, prop["length"].c_str()))
+            {
+              if (n > 0)
+                {
+                  this->length(n);
+                }
+            }
+        }
+    }
+
+    inline void initWritePolicy(const coil::Properties& prop)
+    {
+      std::string policy(coil::normalize(prop["write.full_policy"]));
+      if (policy == "overwrite")
+        {
+          m_writePolicy = WritePolicy::OVERWRITE;
+        }
+      else if (policy == "do_nothing")
+        {
+          m_writePolicy = WritePolicy::DO_NOTHING;
+        }
+      else if (policy == "block")
+        {
+          m_writePolicy = WritePolicy::BLOCK;
+
+          std::chrono::nanoseconds tm;
+          if (coil::stringTo(tm, prop["write.timeout"].c_str())
+              && !(tm < std::chrono::seconds::zero()))
+            {
+              m_wtimeout = tm.count();
+            }
+        }
+    }
+
+    inline void initReadPolicy(const coil::Properties& prop)
+    {
+      std::string policy(coil::normalize(prop["read.empty_policy"]));
+      if (policy == "readback")
+        {
+          m_readPolicy = ReadPolicy::READBACK;
+        }
+      else if (policy == "do_nothing")
+        {
+          m_readPolicy = ReadPolicy::DO_NOTHING;
+        }
+      else if (policy == "block")
+        {
+          m_readPolicy = ReadPolicy::BLOCK;
+
+          std::chrono::nanoseconds tm;
+          if (coil::stringTo(tm, prop["read.timeout"].c_str())
+              && !(tm < std::chrono::seconds::zero()))
+            {
+              m_rtimeout = tm.count();
+            }
+        }
+    }
+
+  private:
+    /*!
+     * @if jp
+     * @brief ポリシーとタイムアウト
+     *
+     * 他の書き込み側が書き込み中に init() で更新されるためアトミック
+     * とする。
+     *
+     * @else
+     * @brief Policies and timeouts
+     *
+     * Atomic because init() may update them while other writers are
+     * writing.
+     *
+     * @endif
+     */
+    std::atomic<WritePolicy> m_writePolicy{WritePolicy::OVERWRITE};
+    std::atomic<ReadPolicy> m_readPolicy{ReadPolicy::READBACK};
+    std::atomic<std::chrono::nanoseconds::rep> m_wtimeout{1000000000};
+    std::atomic<std::chrono::nanoseconds::rep> m_rtimeout{1000000000};
+    bool m_initialized{false};
+
+    size_t m_length;
+    size_t m_slotCount;
+    std::unique_ptr<Slot[]> m_slots;
+
+    /*!
+     * @if jp
+     * @brief 書き込み位置 (書き込み側が CAS で更新する)
+     *
+     * 書き込み位置と読み出し位置は偽共有を避けるため別のキャッシュライン
+     * に配置する。
+     *
+     * @else
+     * @brief Write position, updated by the writers with a CAS
+     *
+     * The write and read positions live on separate cache lines to avoid
+     * false sharing.
+     *
+     * @endif
+     */
+    char m_pad0[MPSCRINGBUFFER_CACHELINE_SIZE];
+    std::atomic<std::uint64_t> m_head{0};
+    char m_pad1[MPSCRINGBUFFER_CACHELINE_SIZE - sizeof(std::uint64_t)];
+
+    /*!
+     * @if jp
+     * @brief 読み出し位置
+     *
+     * 読み出し側、および overwrite ポリシーの書き込み側が更新する。
+     *
+     * @else
+     * @brief Read position
+     *
+     * Updated by the reader, and by the writers under the overwrite
+     * policy.
+     *
+     * @endif
+     */
+    std::atomic<std::uint64_t> m_tail{0};
+    char m_pad2[MPSCRINGBUFFER_CACHELINE_SIZE - sizeof(std::uint64_t)];
+
+    /*!
+     * @if jp
+     * @brief readback ポリシーで返す最後に読み出したデータ
+     * @else
+     * @brief Data read last, returned under the readback policy
+     * @endif
+     */
+    DataType m_last;
+    bool m_hasLast{false};
+
+    condition m_empty;
+    condition m_full;
+
+    mutable std::mutex m_producerMutex;
+    std::vector<std::unique_ptr<Producer> > m_producers;
+  };
+
+  template <class T> MPSCRingBuffer<T>::~MPSCRingBuffer() = default; // no-inline because of its size.
+} // namespace RTC
+
+#endif  // RTC_MPSCRINGBUFFER_H
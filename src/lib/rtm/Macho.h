@@ -1037,6 +1037,25 @@ namespace Macho {
 	};
 
 
+	// Event calling a function object on the top state. The function object
+	// is owned by the caller: used by Machine::dispatch to dispatch an event
+	// without allocating it.
+	template<class TOP, class F>
+	class _EventCall : public IEvent<TOP> {
+	public:
+		_EventCall(const F & call)
+			: myCall(call)
+		{}
+
+	protected:
+		void dispatch(_StateInstance & instance) override {
+			myCall(static_cast<TOP &>(instance.specification()));
+		}
+
+		const F & myCall;
+	};
+
+
 	// Event creating functions using type inference
 	template<class TOP, class R, class P1, class P2, class P3, class P4, class P5, class P6>
 	inline IEvent<TOP> * Event(R (TOP::*handler)(P1, P2, P3, P4, P5, P6), const P1 & p1, const P2 & p2, const P3 & p3, const P4 & p4, const P5 & p5, const P6 & p6) {
@@ -1742,6 +1761,17 @@ namespace Macho {
 			rattleOn();
 		}
 
+		// Dispatch an event to machine without allocating an event object:
+		// same as dispatch(Event(handler, params...)). The parameters are
+		// passed to the handler directly instead of being copied into the
+		// event first.
+		template<class R, class... P>
+		void dispatch(R (TOP::*handler)(P...), const P &... params) {
+			auto call = [&](TOP & behaviour) { (behaviour.*handler)(params...); };
+			_EventCall<TOP, decltype(call)> event(call);
+			dispatch(&event, false);
+		}
+
 		// Allow (const) access to top state's box (for state data extraction).
 		const typename TOP::Box & box() const {
 			assert(myCurrentState);
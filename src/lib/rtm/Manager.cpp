@@ -29,6 +29,8 @@
 #include <rtm/OpenHRPExecutionContext.h>
 #include <rtm/PeriodicECSharedComposite.h>
 #include <rtm/MultilayerCompositeEC.h>
+#include <rtm/ParallelPeriodicEC.h>
+#include <rtm/DataTriggeredEC.h>
 #include <rtm/RTCUtil.h>
 #include <rtm/ManagerServant.h>
 #include <coil/Properties.h>
@@ -42,6 +44,7 @@
 #include <rtm/SdoServiceConsumerBase.h>
 #include <rtm/LocalServiceAdmin.h>
 #include <rtm/SystemLogger.h>
+#include <rtm/AsyncLogger.h>
 #include <rtm/LogstreamBase.h>
 #include <rtm/NumberingPolicyBase.h>
 
@@ -119,11 +122,21 @@ namespace RTC
             manager->initManager(argc, argv);
             manager->initFactories();
             manager->initLogger();
-            manager->initORB();
-            manager->initNaming();
+            // Only factory profiles are read in profile_only mode
+            // (rtcprof), so CORBA related parts are not initialized.
+            bool profile_only(coil::toBool(
+                manager->m_config["manager.profile_only"], "YES", "NO", false));
+            if (!profile_only)
+              {
+                manager->initORB();
+                manager->initNaming();
+              }
             manager->initExecContext();
             manager->initComposite();
-            manager->initManagerServant();
+            if (!profile_only)
+              {
+                manager->initManagerServant();
+              }
           }
       }
     return manager;
@@ -1425,6 +1438,16 @@ std::vector<coil::Properties> Manager::getLoadableModules()
     // Initialize other logstreams
     initLogstreamOthers();
 
+    // Asynchronous output: formatting and stream writes move to one
+    // output thread, so the stream lock is not needed.
+    coil::Properties& asyncprop(m_config.getNode("logger.async"));
+    if (coil::toBool(asyncprop["enable"], "YES", "NO", false))
+      {
+        RTC::Logger::disableLock();
+        AsyncLogger::instance().init(asyncprop);
+        AsyncLogger::instance().start(&m_logStreamBuf);
+      }
+
     RTC_INFO(("%s", m_config["openrtm.version"].c_str()));
     RTC_INFO(("Copyright (C) 2003-2017"));
     RTC_INFO(("  Noriaki Ando"));
@@ -1445,6 +1468,7 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   void Manager::shutdownLogger()
   {
     RTC_TRACE(("Manager::shutdownLogger()"));
+    AsyncLogger::instance().stop();
     rtclog.flush();
 
     for (auto & m_logfile : m_logfiles)
@@ -1873,6 +1897,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
     OpenHRPExecutionContextInit(this);
     SimulatorExecutionContextInit(this);
     MultilayerCompositeECInit(this);
+    ParallelPeriodicECInit(this);
+    DataTriggeredECInit(this);
 #ifdef RTM_OS_VXWORKS
     VxWorksRTExecutionContextInit(this);
 #ifndef __RTP__
@@ -2555,6 +2581,22 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   {
     RTC_TRACE(("Connection pre-connection: %s",
                m_config["manager.components.preconnect"].c_str()));
+    // The ports are resolved first, with each RTC's port list fetched
+    // once, and then connected concurrently.
+    CORBA_RTCUtil::PortCache cache;
+    std::vector<CORBA_RTCUtil::PortCache::Connection> connections;
+    auto addConnection = [&](const std::string& name,
+                             const coil::Properties& prop,
+                             RTC::PortService_ptr port0,
+                             RTC::PortService_ptr port1)
+      {
+        connections.emplace_back();
+        CORBA_RTCUtil::PortCache::Connection& connection(connections.back());
+        connection.name = name;
+        connection.prop = prop;
+        connection.port0 = RTC::PortService::_duplicate(port0);
+        connection.port1 = RTC::PortService::_duplicate(port1);
+      };
     for (auto&& connector : coil::split(m_config["manager.components.preconnect"], ","))
       {
         connector = coil::eraseBothEndsBlank(std::move(connector));
@@ -2624,7 +2666,7 @@ std::vector<coil::Properties> Manager::getLoadableModules()
             port0_name = tmp_port0_name.back();
           }
 
-        RTC::PortService_var port0_var = CORBA_RTCUtil::get_port_by_name(comp0_ref.in(), port0_name);
+        RTC::PortService_var port0_var = cache.get_port_by_name(comp0_ref.in(), port0_name);
         if (CORBA::is_nil(port0_var))
           {
             RTC_DEBUG(("port %s found: ", port0_str.c_str()));
@@ -2644,10 +2686,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
                 prop["dataport." + key] = value;
               }
 
-            if (RTC::RTC_OK != CORBA_RTCUtil::connect(connector, prop, port0_var.in(), RTC::PortService::_nil()))
-              {
-                RTC_ERROR(("Connection error: %s", connector.c_str()));
-              }
+            addConnection(connector, prop, port0_var.in(),
+                          RTC::PortService::_nil());
           }
 
         for (auto const& port : ports)
@@ -2682,7 +2722,7 @@ std::vector<coil::Properties> Manager::getLoadableModules()
                 port_name = tmp_port_name.back();
               }
 
-            RTC::PortService_var port_var = CORBA_RTCUtil::get_port_by_name(comp_ref.in(), port_name);
+            RTC::PortService_var port_var = cache.get_port_by_name(comp_ref.in(), port_name);
 
             if (CORBA::is_nil(port_var))
               {
@@ -2698,10 +2738,18 @@ std::vector<coil::Properties> Manager::getLoadableModules()
                 prop["dataport." + key] = std::move(value);
               }
 
-            if (RTC::RTC_OK != CORBA_RTCUtil::connect(connector, prop, port0_var.in(), port_var.in()))
-              {
-                RTC_ERROR(("Connection error: %s", connector.c_str()));
-              }
+            addConnection(connector, prop, port0_var.in(), port_var.in());
+          }
+      }
+
+    size_t jobs(0);
+    coil::stringTo(jobs, m_config["manager.components.preconnect_jobs"].c_str());
+    cache.connect_all(connections, jobs);
+    for (auto const& connection : connections)
+      {
+        if (connection.result != RTC::RTC_OK)
+          {
+            RTC_ERROR(("Connection error: %s", connection.name.c_str()));
           }
       }
   }
@@ -2725,6 +2773,10 @@ std::vector<coil::Properties> Manager::getLoadableModules()
     RTC_TRACE(("Components pre-activation: %s",
                m_config["manager.components.preactivation"].c_str()));
 
+    // Activated at once, so that the components sharing an EC do not
+    // wait for the transitions one after another
+    coil::vstring names;
+    RTC::RTCList comps;
     for (auto&& c : coil::split(m_config["manager.components.preactivation"], ","))
       {
         c = coil::eraseBothEndsBlank(std::move(c));
@@ -2750,15 +2802,22 @@ std::vector<coil::Properties> Manager::getLoadableModules()
                   }
                 comp_ref = RTObject::_duplicate(rtcs[0]);
               }
-            RTC::ReturnCode_t ret = CORBA_RTCUtil::activate(comp_ref.in());
-            if (ret != RTC::RTC_OK)
-              {
-                RTC_ERROR(("%s activation filed.", c.c_str()));
-              }
-            else
-            {
-              RTC_INFO(("%s activated.", c.c_str()));
-            }
+            names.emplace_back(std::move(c));
+            CORBA_SeqUtil::push_back(comps, comp_ref._retn());
+          }
+      }
+
+    std::vector<RTC::ReturnCode_t> ret =
+      CORBA_RTCUtil::activate_components(comps);
+    for (size_t i(0); i < names.size(); ++i)
+      {
+        if (ret[i] != RTC::RTC_OK)
+          {
+            RTC_ERROR(("%s activation filed.", names[i].c_str()));
+          }
+        else
+          {
+            RTC_INFO(("%s activated.", names[i].c_str()));
           }
       }
   }
@@ -2966,22 +3025,24 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   void Manager::connectDataPorts(PortService_ptr port,
                                  PortServiceList_var& target_ports)
   {
+    CORBA_RTCUtil::PortCache cache;
+    std::string name0(cache.get_port_name(port));
+    std::vector<CORBA_RTCUtil::PortCache::Connection> connections;
     for (CORBA::ULong i(0); i < target_ports->length(); ++i)
       {
         if (port->_is_equivalent(target_ports[i])) { continue; }
-        if (CORBA_RTCUtil::already_connected(port, target_ports[i]))
-          {
-              continue;
-          }
-        std::string con_name;
-        PortProfile_var p0 = port->get_port_profile();
-        PortProfile_var p1 = target_ports[i]->get_port_profile();
-        con_name += p0->name;
-        con_name += ":";
-        con_name += p1->name;
-        coil::Properties prop;
-        if (RTC::RTC_OK !=
-            CORBA_RTCUtil::connect(con_name, prop, port, target_ports[i]))
+        if (cache.already_connected(port, target_ports[i])) { continue; }
+        connections.emplace_back();
+        CORBA_RTCUtil::PortCache::Connection& connection(connections.back());
+        connection.name = name0 + ":" + cache.get_port_name(target_ports[i]);
+        connection.port0 = RTC::PortService::_duplicate(port);
+        connection.port1 = RTC::PortService::_duplicate(target_ports[i]);
+      }
+    // all share the port, so they are made one by one
+    cache.connect_all(connections, 1);
+    for (auto const& connection : connections)
+      {
+        if (connection.result != RTC::RTC_OK)
           {
             RTC_ERROR(("Connection error in topic connection."));
           }
@@ -2991,20 +3052,24 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   void Manager::connectServicePorts(PortService_ptr port,
                                     PortServiceList_var& target_ports)
   {
+    CORBA_RTCUtil::PortCache cache;
+    std::string name0(cache.get_port_name(port));
+    std::vector<CORBA_RTCUtil::PortCache::Connection> connections;
     for (CORBA::ULong i(0); i < target_ports->length(); ++i)
       {
         if (port->_is_equivalent(target_ports[i])) { continue; }
-        if (CORBA_RTCUtil::already_connected(port, target_ports[i]))
-          { continue; }
-        std::string con_name;
-        PortProfile_var p0 = port->get_port_profile();
-        PortProfile_var p1 = target_ports[i]->get_port_profile();
-        con_name += p0->name;
-        con_name += ":";
-        con_name += p1->name;
-        coil::Properties prop;
-        if (RTC::RTC_OK !=
-            CORBA_RTCUtil::connect(con_name, prop, port, target_ports[i]))
+        if (cache.already_connected(port, target_ports[i])) { continue; }
+        connections.emplace_back();
+        CORBA_RTCUtil::PortCache::Connection& connection(connections.back());
+        connection.name = name0 + ":" + cache.get_port_name(target_ports[i]);
+        connection.port0 = RTC::PortService::_duplicate(port);
+        connection.port1 = RTC::PortService::_duplicate(target_ports[i]);
+      }
+    // all share the port, so they are made one by one
+    cache.connect_all(connections, 1);
+    for (auto const& connection : connections)
+      {
+        if (connection.result != RTC::RTC_OK)
           {
             RTC_ERROR(("Connection error in topic connection."));
           }
@@ -26,19 +26,33 @@
 #include <rtm/CORBA_SeqUtil.h>
 #include <rtm/CORBA_IORUtil.h>
 
+#include <algorithm>
+#include <memory>
+#include <system_error>
 #include <vector>
 #include <string>
 
 namespace RTM
 {
+  struct ManagerServant::SlaveCalls
+  {
+    std::mutex mutex;
+    std::vector<const void*> running;
+  };
+
   //
   // Example implementational code for IDL interface RTM::Manager
   //
   ManagerServant::ManagerServant()
-    : m_masters(0), m_slaves(0)
+    : m_masters(0), m_slaves(0),
+      m_slaveCalls(std::make_shared<SlaveCalls>())
   {
     rtclog.setName("ManagerServant");
     coil::Properties config(m_mgr.getConfig());    
+    coil::stringTo(m_queryTimeout,
+                   config["manager.slave_query.timeout"].c_str());
+    coil::stringTo(m_cacheTtl, config["manager.slave_query.cache_ttl"].c_str());
+    coil::stringTo(m_queryJobs, config["manager.slave_query.jobs"].c_str());
 
     if (!createINSManager())
       {
@@ -52,6 +66,7 @@ namespace RTM
         RTC_TRACE(("This manager is master."));
         m_isMaster = true;
         RTC_INFO(("Master manager servant was successfully created."));
+        startSlavePool(config);
         return;
       }
     else
@@ -84,6 +99,7 @@ namespace RTM
 
   ManagerServant::~ManagerServant()
   {
+    stopSlavePool();
     std::lock_guard<std::mutex> guardm(m_masterMutex);
     for (CORBA::ULong i(0); i < m_masters.length(); ++i)
       {
@@ -422,6 +438,7 @@ namespace RTM
   {
     RTC_TRACE(("create_component(%s)", module_name));
     RTC_TRACE(("This manager is master: %s", m_isMaster ? "YES" : "NO"));
+    invalidateSlaveCache();
     std::string create_arg(module_name);
     if (create_arg.empty()) // invalid arg
       {
@@ -463,6 +480,8 @@ namespace RTM
             std::lock_guard<std::mutex> guard(m_slaveMutex);
             for (CORBA::ULong i(0); i < m_slaves.length(); ++i)
               {
+                // idle pool managers are only handed out for manager_%p
+                if (isPooledSlave(m_slaves[i])) { continue; }
                 try
                   {
                     RTM::NVList* prof = m_slaves[i]->get_configuration();
@@ -537,9 +556,255 @@ namespace RTM
         RTC_ERROR(("Unknown exception was raised, when RTC was finalized."));
         return RTC::RTC_ERROR;
       }
+    invalidateSlaveCache();
     return ::RTC::RTC_OK;
   }
 
+  namespace
+  {
+    /*!
+     * @if jp
+     * @brief スレーブマネージャへの並行問い合わせの状態
+     *
+     * 応答しないスレーブマネージャを待つスレッドは問い合わせの終了後
+     * も残るため、スレッドと共有する。
+     *
+     * @else
+     * @brief State of a concurrent query to the slave managers
+     *
+     * Shared with the threads, as those waiting for a slave manager not
+     * responding outlive the query.
+     *
+     * @endif
+     */
+    template <class List>
+    struct SlaveQuery
+    {
+      enum Status { QUEUED, RUNNING, DONE, FAILED, BUSY };
+      struct Slot
+      {
+        RTM::Manager_var mgr;
+        std::unique_ptr<List> list;
+        Status status{QUEUED};
+        std::chrono::steady_clock::time_point start;
+        // called when the slave manager may be called again
+        std::function<void()> finished;
+      };
+      std::mutex mutex;
+      std::condition_variable cond;
+      std::vector<Slot> slots;
+      size_t next{0};
+      size_t threads{0};
+      bool abandoned{false};
+    };
+
+    template <class List>
+    void runSlaveQuery(std::shared_ptr<SlaveQuery<List> > state,
+                       std::function<List*(RTM::Manager_ptr)> query)
+    {
+      using Query = SlaveQuery<List>;
+      std::unique_lock<std::mutex> guard(state->mutex);
+      while (!state->abandoned && state->next < state->slots.size())
+        {
+          typename Query::Slot& slot(state->slots[state->next++]);
+          if (slot.status != Query::QUEUED) { continue; }
+          slot.status = Query::RUNNING;
+          slot.start = std::chrono::steady_clock::now();
+          RTM::Manager_var mgr = slot.mgr;
+          state->cond.notify_all();
+          guard.unlock();
+          std::unique_ptr<List> list;
+          bool failed(CORBA::is_nil(mgr));
+          try
+            {
+              if (!failed) { list.reset(query(mgr.in())); }
+            }
+          catch (...)
+            {
+              failed = true;
+            }
+          guard.lock();
+          slot.list = std::move(list);
+          slot.status = failed ? Query::FAILED : Query::DONE;
+          slot.finished();
+          state->cond.notify_all();
+        }
+    }
+  } // namespace
+
+  template <class List>
+  List* ManagerServant::
+  querySlaves(const char* name, SlaveCache<List>& cache,
+              const std::function<List*(RTM::Manager_ptr)>& query)
+  {
+    using Query = SlaveQuery<List>;
+    std::uint64_t generation;
+    {
+      std::lock_guard<std::mutex> guard(m_cacheMutex);
+      if (cache.list && std::chrono::steady_clock::now() < cache.expiry)
+        {
+          RTC_DEBUG(("%s: cached results of slave managers are used.", name));
+          return new List(*cache.list);
+        }
+      generation = m_cacheGeneration;
+    }
+
+    auto state = std::make_shared<Query>();
+    size_t runnable(0);
+    {
+      std::lock_guard<std::mutex> guard(m_slaveMutex);
+      RTC_DEBUG(("%d slave managers exists.", m_slaves.length()));
+      state->slots.resize(m_slaves.length());
+      std::shared_ptr<SlaveCalls> calls(m_slaveCalls);
+      std::lock_guard<std::mutex> guardc(calls->mutex);
+      for (CORBA::ULong i(0); i < m_slaves.length(); ++i)
+        {
+          typename Query::Slot& slot(state->slots[i]);
+          slot.mgr = RTM::Manager::_duplicate(m_slaves[i]);
+          // The reference is held until the call returns, so the
+          // address is not reused by another slave manager meanwhile.
+          const void* key(static_cast<const void*>(slot.mgr.in()));
+          if (std::find(calls->running.begin(), calls->running.end(), key)
+              != calls->running.end())
+            {
+              slot.status = Query::BUSY;
+              continue;
+            }
+          calls->running.push_back(key);
+          slot.finished = [calls, key]() {
+            std::lock_guard<std::mutex> guard(calls->mutex);
+            calls->running.erase(std::find(calls->running.begin(),
+                                           calls->running.end(), key));
+          };
+          ++runnable;
+        }
+    }
+
+    size_t jobs(m_queryJobs);
+    if (jobs == 0)
+      {
+        jobs = std::max(std::thread::hardware_concurrency(), 1u);
+      }
+    jobs = std::min(jobs, runnable);
+    for (size_t i(0); i < jobs; ++i)
+      {
+        try
+          {
+            std::thread(runSlaveQuery<List>, state, query).detach();
+            ++state->threads;
+          }
+        catch (std::system_error&)
+          {
+            break;
+          }
+      }
+    if (jobs != 0 && state->threads == 0)
+      {
+        RTC_WARN(("%s: no thread available. Slaves are queried in turn.",
+                  name));
+        runSlaveQuery<List>(state, query);
+      }
+
+    // Waiting until each slave manager responds or its call has run
+    // for m_queryTimeout. Queued ones are given up when every thread
+    // is stuck in a call that timed out.
+    std::unique_lock<std::mutex> guard(state->mutex);
+    while (true)
+      {
+        auto now = std::chrono::steady_clock::now();
+        auto until = now + m_queryTimeout;
+        size_t queued(0), running(0);
+        bool waiting(false);
+        for (auto & slot : state->slots)
+          {
+            if (slot.status == Query::QUEUED) { ++queued; }
+            if (slot.status != Query::RUNNING) { continue; }
+            ++running;
+            if (slot.start + m_queryTimeout > now)
+              {
+                waiting = true;
+                until = std::min(until, slot.start + m_queryTimeout);
+              }
+          }
+        if (queued != 0 && running < state->threads) { waiting = true; }
+        if (!waiting) { break; }
+        state->cond.wait_until(guard, until);
+      }
+    state->abandoned = true;
+    for (auto & slot : state->slots)
+      {
+        // no thread will start these any more
+        if (slot.status == Query::QUEUED) { slot.finished(); }
+      }
+
+    std::unique_ptr<List> result(new List());
+    std::vector<RTM::Manager_var> failed;
+    bool complete(true);
+    for (auto & slot : state->slots)
+      {
+        if (slot.status == Query::DONE)
+          {
+            CORBA_SeqUtil::push_back_list(*result, *slot.list);
+          }
+        else if (slot.status == Query::FAILED)
+          {
+            failed.emplace_back(slot.mgr);
+          }
+        else if (slot.status == Query::BUSY)
+          {
+            RTC_WARN(("%s: a slave manager has not returned from an "
+                      "earlier call.", name));
+            complete = false;
+          }
+        else
+          {
+            RTC_WARN(("%s: a slave manager did not respond in time.", name));
+            complete = false;
+          }
+      }
+    guard.unlock();
+
+    if (!failed.empty())
+      {
+        std::lock_guard<std::mutex> guards(m_slaveMutex);
+        for (auto & mgr : failed)
+          {
+            for (CORBA::ULong i(0); i < m_slaves.length(); ++i)
+              {
+                bool nil(CORBA::is_nil(m_slaves[i]));
+                if (CORBA::is_nil(mgr) ? nil
+                    : (!nil && m_slaves[i]->_is_equivalent(mgr.in())))
+                  {
+                    RTC_INFO(("slave (%d) has disappeared.", i));
+                    CORBA_SeqUtil::erase(m_slaves, i);
+                    break;
+                  }
+              }
+          }
+        ++m_slaveGeneration;
+        m_slaveCond.notify_all();
+        invalidateSlaveCache();
+      }
+    else if (complete && m_cacheTtl > std::chrono::nanoseconds::zero())
+      {
+        std::lock_guard<std::mutex> guardc(m_cacheMutex);
+        if (generation == m_cacheGeneration)
+          {
+            cache.list.reset(new List(*result));
+            cache.expiry = std::chrono::steady_clock::now() + m_cacheTtl;
+          }
+      }
+    return result.release();
+  }
+
+  void ManagerServant::invalidateSlaveCache()
+  {
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+    ++m_cacheGeneration;
+    m_componentsCache.list.reset();
+    m_profilesCache.list.reset();
+  }
+
   /*!
    * @if jp
    * @brief 起動中のコンポーネントのリストを取得する
@@ -566,31 +831,14 @@ namespace RTM
       }
 
     // get slaves' component references
-    std::lock_guard<std::mutex> guard(m_slaveMutex);
-    RTC_DEBUG(("%d slave managers exists.", m_slaves.length()));
-    for (int i(0), len(m_slaves.length()); i < len; ++i)
-      {
-        try
-          {
-            if (!CORBA::is_nil(m_slaves[i]))
-              {
-                ::RTC::RTCList_var srtcs;
-                srtcs = m_slaves[i]->get_components();
+    ::RTC::RTCList_var srtcs = querySlaves<RTC::RTCList>(
+      "get_components()", m_componentsCache,
+      [](RTM::Manager_ptr mgr) { return mgr->get_components(); });
 #ifndef ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(crtcs.inout(), srtcs.in());
+    CORBA_SeqUtil::push_back_list(crtcs.inout(), srtcs.in());
 #else  // ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(srtcs, crtcs);
+    CORBA_SeqUtil::push_back_list(crtcs, srtcs);
 #endif  // ORB_IS_RTORB
-                continue;
-              }
-          }
-        catch (...)
-          {
-            RTC_INFO(("slave (%d) has disappeared.", i));
-            m_slaves[i] = RTM::Manager::_nil();
-          }
-        CORBA_SeqUtil::erase(m_slaves, i); --i;
-      }
     return crtcs._retn();
   }
 
@@ -620,31 +868,15 @@ namespace RTM
       }
 
     // copy slaves' component profiles
-    std::lock_guard<std::mutex> guard(m_slaveMutex);
-    RTC_DEBUG(("%d slave managers exists.", m_slaves.length()));
-    for (int i(0), len(m_slaves.length()); i < len; ++i)
-      {
-        try
-          {
-            if (!CORBA::is_nil(m_slaves[i]))
-              {
-                ::RTC::ComponentProfileList_var sprofs;
-                sprofs = m_slaves[i]->get_component_profiles();
+    ::RTC::ComponentProfileList_var sprofs =
+      querySlaves<RTC::ComponentProfileList>(
+        "get_component_profiles()", m_profilesCache,
+        [](RTM::Manager_ptr mgr) { return mgr->get_component_profiles(); });
 #ifndef ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(cprofs.inout(), sprofs.in());
+    CORBA_SeqUtil::push_back_list(cprofs.inout(), sprofs.in());
 #else  // ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(cprofs, sprofs);
+    CORBA_SeqUtil::push_back_list(cprofs, sprofs);
 #endif  // ORB_IS_RTORB
-                continue;
-              }
-          }
-        catch (...)
-          {
-            RTC_INFO(("slave (%d) has disappeared.", i));
-            m_slaves[i] = RTM::Manager::_nil();
-          }
-        CORBA_SeqUtil::erase(m_slaves, i); --i;
-      }
     return cprofs._retn();
   }
 
@@ -817,6 +1049,13 @@ namespace RTM
       }
 
     CORBA_SeqUtil::push_back(m_slaves, RTM::Manager::_duplicate(mgr));
+    if (m_poolSize > 0)
+      {
+        m_poolRegistered.emplace_back(RTM::Manager::_duplicate(mgr));
+      }
+    ++m_slaveGeneration;
+    m_slaveCond.notify_all();
+    invalidateSlaveCache();
     RTC_TRACE(("add_slave_manager() done, %d slaves", m_slaves.length()));
     return RTC::RTC_OK;
   }
@@ -842,6 +1081,18 @@ namespace RTM
       }
 
     CORBA_SeqUtil::erase(m_slaves, index);
+    auto it = std::find_if(m_pool.begin(), m_pool.end(),
+                           [mgr](const PooledSlave& slave)
+                           { return slave.mgr->_is_equivalent(mgr); });
+    if (it != m_pool.end())
+      {
+        // an idle manager shut down by itself
+        m_pool.erase(it);
+        m_poolRefill = true;
+      }
+    ++m_slaveGeneration;
+    m_slaveCond.notify_all();
+    invalidateSlaveCache();
     RTC_TRACE(("remove_slave_manager() done, %d slaves", m_slaves.length()));
     return RTC::RTC_OK;
   }
@@ -888,6 +1139,7 @@ namespace RTM
       }
     else
       {
+        stopSlavePool();
         std::lock_guard<std::mutex> guards(m_slaveMutex);
         for (CORBA::ULong i(0); i < m_slaves.length(); ++i)
           {
@@ -1236,29 +1488,20 @@ namespace RTM
     RTC_INFO(("Specified manager's language: %s", lang.c_str()));
 
     RTM::Manager_var mgrobj = findManagerByName(mgrstr);
+    if (CORBA::is_nil(mgrobj) && mgrstr == "manager_%p")
+      {
+        mgrobj = takePooledSlave(lang);
+        if (!CORBA::is_nil(mgrobj))
+          {
+            RTC_INFO(("A pooled slave manager is used."));
+          }
+      }
     if (CORBA::is_nil(mgrobj))
       {
         RTC_INFO(("Manager: %s not found.", mgrstr.c_str()));
         RTC_INFO(("Creating new manager named %s", mgrstr.c_str()));
 
-        std::string rtcd_cmd_key("manager.modules.");
-        rtcd_cmd_key += lang + ".manager_cmd";
-        coil::Properties& prop = m_mgr.getConfig();
-        std::string rtcd_cmd = prop[rtcd_cmd_key];
-
-        if (rtcd_cmd.empty())
-          {
-            RTC_WARN(("rtcd command name not found. Default rtcd is used"));
-            rtcd_cmd = "rtcd";
-          }
-        rtcd_cmd += " -o manager.is_master:NO";
-        rtcd_cmd += " -o manager.corba_servant:YES";
-        rtcd_cmd += " -o corba.master_manager:" + prop["corba.master_manager"];
-        rtcd_cmd += " -o manager.name:" + prop["manger.name"];
-        rtcd_cmd += " -o manager.instance_name:" + mgrstr;
-        rtcd_cmd += " -o shutdown_auto:NO";
-        rtcd_cmd += " -o manager.auto_shutdown_duration:50";
-
+        std::string rtcd_cmd = getSlaveCommand(lang, mgrstr);
 
         coil::vstring slaves_names;
         if (mgrstr == "manager_%p")
@@ -1295,39 +1538,46 @@ namespace RTM
             return RTC::RTObject::_nil();
           }
 
-        for (size_t i(0); i < 1000; ++i) // Timeout: 1000 x 10ms
+        mgrobj = waitForSlaveManager([&]() -> RTM::Manager_ptr
           {
             RTC_DEBUG(("Detecting new slave manager (%s).", mgrstr.c_str()));
-            if (mgrstr == "manager_%p")
+            if (mgrstr != "manager_%p")
+              {
+                return findManagerByName(mgrstr);
+              }
+            std::lock_guard<std::mutex> guard(m_slaveMutex);
+            for (CORBA::ULong j(0); j < m_slaves.length(); ++j)
               {
-                std::lock_guard<std::mutex> guard(m_slaveMutex);
-                for (CORBA::ULong j(0); j < m_slaves.length(); ++j)
+                try
                   {
                     RTM::NVList_var nvlist = m_slaves[j]->get_configuration();
                     coil::Properties sleave_prop;
                     NVUtil::copyToProperties(sleave_prop, nvlist);
                     std::string name = sleave_prop["manager.instance_name"];
 
-                    if (isProcessIDManager(name))
+                    // managers launched by the pool are not the one
+                    if (coil::toBool(sleave_prop["manager.slave_pool.member"],
+                                     "YES", "NO", false))
+                      {
+                        continue;
+                      }
+                    if (isProcessIDManager(name) &&
+                        std::count(slaves_names.begin(), slaves_names.end(),
+                                   name) == 0)
                       {
-                        if (std::count(slaves_names.begin(), slaves_names.end(), name) == 0)
-                          {
-                            mgrobj = m_slaves[j];
-                          }
+                        return RTM::Manager::_duplicate(m_slaves[j]);
                       }
                   }
+                catch (...)
+                  {
+                    RTC_DEBUG(("A slave manager thrown exception."));
+                  }
               }
-            else
-              {
-                mgrobj = findManagerByName(mgrstr);
-              }
-            if (!CORBA::is_nil(mgrobj))
-              {
-                RTC_INFO(("New slave manager (%s) launched.", mgrstr.c_str()));
-                break;
-              }
-            RTC_DEBUG(("Waiting for slave manager started."));
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return RTM::Manager::_nil();
+          }, m_isMaster);
+        if (!CORBA::is_nil(mgrobj))
+          {
+            RTC_INFO(("New slave manager (%s) launched.", mgrstr.c_str()));
           }
       }
 
@@ -1424,17 +1674,15 @@ namespace RTM
             return RTC::RTObject::_nil();
           }
 
-        for (size_t i(0); i < 1000; ++i) // Timeout: 1000 x 10ms
+        // The new manager registers to the manager at the address.
+        mgrobj = waitForSlaveManager([&]() -> RTM::Manager_ptr
           {
             RTC_DEBUG(("Detecting new slave manager (%s).", mgrstr.c_str()));
-            mgrobj = findManagerByName(mgrstr);
-            if (!CORBA::is_nil(mgrobj))
-              {
-                RTC_INFO(("New slave manager (%s) launched.", mgrstr.c_str()));
-                break;
-              }
-            RTC_DEBUG(("Waiting for slave manager started."));
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return findManagerByName(mgrstr);
+          }, false);
+        if (!CORBA::is_nil(mgrobj))
+          {
+            RTC_INFO(("New slave manager (%s) launched.", mgrstr.c_str()));
           }
 
         if (CORBA::is_nil(mgrobj))
@@ -1542,6 +1790,295 @@ namespace RTM
       return false;
     }
 
+  /*!
+   * @if jp
+   * @brief スレーブマネージャの起動コマンドを生成する
+   * @else
+   * @brief Build the command launching a slave manager
+   * @endif
+   */
+  std::string ManagerServant::getSlaveCommand(const std::string& lang,
+                                              const std::string& mgr_name)
+  {
+    std::string rtcd_cmd_key("manager.modules.");
+    rtcd_cmd_key += lang + ".manager_cmd";
+    coil::Properties& prop = m_mgr.getConfig();
+    std::string rtcd_cmd = prop[rtcd_cmd_key];
+
+    if (rtcd_cmd.empty())
+      {
+        RTC_WARN(("rtcd command name not found. Default rtcd is used"));
+        rtcd_cmd = "rtcd";
+      }
+    rtcd_cmd += " -o manager.is_master:NO";
+    rtcd_cmd += " -o manager.corba_servant:YES";
+    rtcd_cmd += " -o corba.master_manager:" + prop["corba.master_manager"];
+    rtcd_cmd += " -o manager.name:" + prop["manger.name"];
+    rtcd_cmd += " -o manager.instance_name:" + mgr_name;
+    rtcd_cmd += " -o shutdown_auto:NO";
+    rtcd_cmd += " -o manager.auto_shutdown_duration:50";
+    return rtcd_cmd;
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブマネージャの登録を待つ
+   * @else
+   * @brief Wait for a slave manager to register
+   * @endif
+   */
+  RTM::Manager_ptr ManagerServant::
+  waitForSlaveManager(const std::function<RTM::Manager_ptr()>& find,
+                      bool registers_here)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (true)
+      {
+        std::uint64_t generation;
+        {
+          std::lock_guard<std::mutex> guard(m_slaveMutex);
+          generation = m_slaveGeneration;
+        }
+        RTM::Manager_var mgr = find();
+        if (!CORBA::is_nil(mgr)) { return mgr._retn(); }
+
+        RTC_DEBUG(("Waiting for slave manager started."));
+        auto until = deadline;
+        if (!registers_here)
+          {
+            until = std::min(deadline, std::chrono::steady_clock::now() +
+                                       std::chrono::milliseconds(10));
+          }
+        std::unique_lock<std::mutex> guard(m_slaveMutex);
+        m_slaveCond.wait_until(guard, until, [this, generation]
+                               { return m_slaveGeneration != generation; });
+        if (m_slaveGeneration == generation &&
+            std::chrono::steady_clock::now() >= deadline)
+          {
+            return RTM::Manager::_nil();
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブマネージャプールを開始する
+   * @else
+   * @brief Start the slave manager pool
+   * @endif
+   */
+  void ManagerServant::startSlavePool(coil::Properties& config)
+  {
+    size_t size(0);
+    if (!coil::stringTo(size, config["manager.slave_pool.size"].c_str())
+        || size == 0)
+      {
+        return;
+      }
+    for (auto&& lang : coil::split(config["manager.slave_pool.languages"], ","))
+      {
+        lang = coil::eraseBothEndsBlank(std::move(lang));
+        if (!lang.empty()) { m_poolLanguages.emplace_back(std::move(lang)); }
+      }
+    if (m_poolLanguages.empty()) { return; }
+    m_poolIdleTimeout = config["manager.slave_pool.idle_timeout"];
+    RTC_INFO(("Keeping %d idle slave managers for each of %s.",
+              static_cast<int>(size),
+              config["manager.slave_pool.languages"].c_str()));
+    {
+      std::lock_guard<std::mutex> guard(m_slaveMutex);
+      m_poolSize = size;
+      m_poolRefill = true;
+    }
+    m_poolThread = std::thread([this] { runSlavePool(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブマネージャプールを停止する
+   * @else
+   * @brief Stop the slave manager pool
+   * @endif
+   */
+  void ManagerServant::stopSlavePool()
+  {
+    std::vector<PooledSlave> idle;
+    {
+      std::lock_guard<std::mutex> guard(m_slaveMutex);
+      m_poolExit = true;
+      m_slaveCond.notify_all();
+      idle.swap(m_pool);
+    }
+    if (m_poolThread.joinable()) { m_poolThread.join(); }
+    // Shut down without the lock: they call remove_slave_manager().
+    for (auto & slave : idle)
+      {
+        try
+          {
+            slave.mgr->shutdown();
+          }
+        catch (...)
+          {
+            RTC_DEBUG(("An idle slave manager has already gone."));
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブマネージャプールのスレッド
+   * @else
+   * @brief Thread of the slave manager pool
+   * @endif
+   */
+  void ManagerServant::runSlavePool()
+  {
+    std::unique_lock<std::mutex> guard(m_slaveMutex);
+    while (!m_poolExit)
+      {
+        // Registered managers launched by the pool become idle.
+        while (!m_poolRegistered.empty())
+          {
+            RTM::Manager_var mgr = m_poolRegistered.back();
+            m_poolRegistered.pop_back();
+            guard.unlock();
+            coil::Properties prop;
+            try
+              {
+                RTM::NVList_var nvlist = mgr->get_configuration();
+                NVUtil::copyToProperties(prop, nvlist);
+              }
+            catch (...)
+              {
+                RTC_DEBUG(("A registered slave manager is not responding."));
+              }
+            guard.lock();
+            if (!coil::toBool(prop["manager.slave_pool.member"],
+                              "YES", "NO", false))
+              {
+                continue;
+              }
+            std::string lang = prop["manager.language"];
+            auto it = std::find_if(m_poolLaunching.begin(),
+                                   m_poolLaunching.end(),
+                                   [&lang](const LaunchingSlave& launching)
+                                   { return launching.first == lang; });
+            if (it != m_poolLaunching.end()) { m_poolLaunching.erase(it); }
+            RTC_INFO(("Idle slave manager %s (%s) is ready.",
+                      prop["manager.instance_name"].c_str(), lang.c_str()));
+            m_pool.emplace_back(PooledSlave{lang, mgr});
+            m_slaveCond.notify_all();
+          }
+
+        // Launches not registered in time are given up.
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = m_poolLaunching.begin(); it != m_poolLaunching.end();)
+          {
+            if (it->second > now) { ++it; continue; }
+            RTC_WARN(("A pooled %s slave manager did not register.",
+                      it->first.c_str()));
+            it = m_poolLaunching.erase(it);
+            m_poolRefill = true;
+          }
+
+        if (m_poolRefill)
+          {
+            m_poolRefill = false;
+            for (auto & lang : m_poolLanguages)
+              {
+                auto same_lang = [&lang](const std::string& l)
+                  { return l == lang; };
+                size_t n(0);
+                for (auto & slave : m_pool)
+                  {
+                    if (same_lang(slave.language)) { ++n; }
+                  }
+                for (auto & launching : m_poolLaunching)
+                  {
+                    if (same_lang(launching.first)) { ++n; }
+                  }
+                for (; n < m_poolSize && !m_poolExit; ++n)
+                  {
+                    std::string rtcd_cmd = getSlaveCommand(lang, "manager_%p");
+                    rtcd_cmd += " -o manager.slave_pool.member:YES";
+                    if (!m_poolIdleTimeout.empty())
+                      {
+                        rtcd_cmd += " -o manager.auto_shutdown_duration:"
+                                  + m_poolIdleTimeout;
+                      }
+                    RTC_DEBUG(("Invoking command: %s.", rtcd_cmd.c_str()));
+                    guard.unlock();
+                    int ret(coil::launch_shell(rtcd_cmd));
+                    guard.lock();
+                    if (ret == -1)
+                      {
+                        RTC_ERROR(("%s: failed", rtcd_cmd.c_str()));
+                        break;
+                      }
+                    m_poolLaunching.emplace_back(lang,
+                      std::chrono::steady_clock::now() + std::chrono::seconds(10));
+                  }
+              }
+          }
+
+        auto wake = [this]
+          {
+            return m_poolExit || m_poolRefill || !m_poolRegistered.empty();
+          };
+        if (m_poolLaunching.empty())
+          {
+            m_slaveCond.wait(guard, wake);
+            continue;
+          }
+        auto deadline = m_poolLaunching.front().second;
+        for (auto & launching : m_poolLaunching)
+          {
+            deadline = std::min(deadline, launching.second);
+          }
+        m_slaveCond.wait_until(guard, deadline, wake);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定言語の空きスレーブマネージャをプールから取り出す
+   * @else
+   * @brief Take an idle slave manager of the language from the pool
+   * @endif
+   */
+  RTM::Manager_ptr ManagerServant::takePooledSlave(const std::string& lang)
+  {
+    std::unique_lock<std::mutex> guard(m_slaveMutex);
+    while (true)
+      {
+        auto it = std::find_if(m_pool.begin(), m_pool.end(),
+                               [&lang](const PooledSlave& slave)
+                               { return slave.language == lang; });
+        if (it == m_pool.end()) { return RTM::Manager::_nil(); }
+        RTM::Manager_var mgr = it->mgr;
+        m_pool.erase(it);
+        m_poolRefill = true;
+        m_slaveCond.notify_all();
+        guard.unlock();
+        try
+          {
+            if (!mgr->_non_existent()) { return mgr._retn(); }
+          }
+        catch (...)
+          {
+          }
+        RTC_DEBUG(("An idle slave manager has gone."));
+        guard.lock();
+      }
+  }
+
+  bool ManagerServant::isPooledSlave(RTM::Manager_ptr mgr)
+  {
+    return std::any_of(m_pool.begin(), m_pool.end(),
+                       [mgr](const PooledSlave& slave)
+                       { return slave.mgr->_is_equivalent(mgr); });
+  }
+
   const char* CompParam::prof_list[prof_list_size] = { "RTC", "vendor", "category", "implementation_id", "language", "version" };
 
   CompParam::CompParam(std::string module_name)
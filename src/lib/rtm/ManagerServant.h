@@ -20,7 +20,13 @@
 #ifndef RTM_MANAGERSERVANT_H
 #define RTM_MANAGERSERVANT_H
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <rtm/idl/ManagerSkel.h>
 #include <rtm/Manager.h>
 #include <rtm/SystemLogger.h>
@@ -707,6 +713,177 @@ namespace RTM
 	static bool isProcessIDManager(const std::string& mgrname);
 
   private:
+    /*!
+     * @if jp
+     * @brief スレーブマネージャの起動コマンドを生成する
+     * @else
+     * @brief Build the command launching a slave manager
+     * @endif
+     */
+    std::string getSlaveCommand(const std::string& lang,
+                                const std::string& mgr_name);
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャの登録を待つ
+     *
+     * find が nil 以外を返すかタイムアウト (10秒) まで、このマネージャ
+     * にスレーブマネージャが登録されるたびに find を呼び出す。
+     * registers_here が false の場合は他のマネージャへの登録を見るた
+     * め、10ms ごとにも呼び出す。
+     *
+     * @param find 起動したマネージャを探す関数
+     * @param registers_here 起動したマネージャがこのマネージャに登録
+     *                       される場合 true
+     * @return 見つかったマネージャ。タイムアウトした場合は nil
+     *
+     * @else
+     * @brief Wait for a slave manager to register
+     *
+     * find is called each time a slave manager registers to this
+     * manager until it returns non-nil or the timeout (10 s) expires.
+     * If registers_here is false, it is also called every 10 ms to see
+     * registrations to other managers.
+     *
+     * @param find The function finding the launched manager
+     * @param registers_here True if the launched manager registers to
+     *                       this manager
+     * @return The manager found. nil on timeout
+     *
+     * @endif
+     */
+    RTM::Manager_ptr
+    waitForSlaveManager(const std::function<RTM::Manager_ptr()>& find,
+                        bool registers_here);
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャプールを開始する
+     *
+     * manager.slave_pool.size が1以上の場合、
+     * manager.slave_pool.languages の言語ごとに、その数の空きスレーブ
+     * マネージャ (manager_%p) をあらかじめ起動しておく。
+     *
+     * @else
+     * @brief Start the slave manager pool
+     *
+     * If manager.slave_pool.size is one or more, that many idle slave
+     * managers (manager_%p) are kept started in advance for each
+     * language of manager.slave_pool.languages.
+     *
+     * @endif
+     */
+    void startSlavePool(coil::Properties& config);
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャプールを停止し、空きスレーブマネージャ
+     *        を終了させる
+     * @else
+     * @brief Stop the slave manager pool and shut down the idle slave
+     *        managers
+     * @endif
+     */
+    void stopSlavePool();
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャプールのスレッド
+     *
+     * 登録されたプールのマネージャを空きとし、不足分を起動する。
+     *
+     * @else
+     * @brief Thread of the slave manager pool
+     *
+     * Makes the registered pool managers idle and launches the missing
+     * ones.
+     *
+     * @endif
+     */
+    void runSlavePool();
+
+    /*!
+     * @if jp
+     * @brief 指定言語の空きスレーブマネージャをプールから取り出す
+     * @else
+     * @brief Take an idle slave manager of the language from the pool
+     * @endif
+     */
+    RTM::Manager_ptr takePooledSlave(const std::string& lang);
+
+    /*!
+     * @if jp
+     * @brief 空きスレーブマネージャかどうか (m_slaveMutex を保持して呼ぶ)
+     * @else
+     * @brief Whether it is an idle slave manager (m_slaveMutex held)
+     * @endif
+     */
+    bool isPooledSlave(RTM::Manager_ptr mgr);
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャへの問い合わせ結果のキャッシュ
+     * @else
+     * @brief Cache of the results of a query to the slave managers
+     * @endif
+     */
+    template <class List>
+    struct SlaveCache
+    {
+      std::unique_ptr<List> list;
+      std::chrono::steady_clock::time_point expiry;
+    };
+
+    /*!
+     * @if jp
+     * @brief すべてのスレーブマネージャに並行して問い合わせる
+     *
+     * manager.slave_query.jobs 個までのスレッドで query を呼び出し、
+     * 結果を連結して返す。manager.slave_query.timeout を過ぎても応答
+     * しないスレーブマネージャは待たずに、それ以外の結果を返す。以前
+     * の問い合わせにまだ応答していないスレーブマネージャには問い合わ
+     * せず、応答しなかったものとして扱う。例外を返したスレーブマネー
+     * ジャはリストから削除する。すべて応答した
+     * 場合の結果は manager.slave_query.cache_ttl の間、またはスレーブ
+     * マネージャの追加・削除まで cache に保持する。
+     *
+     * @param name ログ用の問い合わせ名
+     * @param cache 結果のキャッシュ
+     * @param query 1つのスレーブマネージャへの問い合わせ
+     * @return 連結した結果
+     *
+     * @else
+     * @brief Query all the slave managers concurrently
+     *
+     * query is called by up to manager.slave_query.jobs threads and the
+     * results are concatenated. Slave managers not responding within
+     * manager.slave_query.timeout are not waited for, and the other
+     * results are returned. Slave managers still in a call of an earlier
+     * query are not called again and count as not responding. Slave
+     * managers raising an exception are removed from the list. A result all the slave managers responded
+     * to is kept in cache for manager.slave_query.cache_ttl or until a
+     * slave manager is added or removed.
+     *
+     * @param name The name of the query for logging
+     * @param cache The cache of the results
+     * @param query The query to one slave manager
+     * @return The concatenated results
+     *
+     * @endif
+     */
+    template <class List>
+    List* querySlaves(const char* name, SlaveCache<List>& cache,
+                      const std::function<List*(RTM::Manager_ptr)>& query);
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャへの問い合わせ結果のキャッシュを破棄する
+     * @else
+     * @brief Drop the cached results of the queries to the slave managers
+     * @endif
+     */
+    void invalidateSlaveCache();
+
     /*!
      * @if jp
      * @brief ロガーオブジェクト
@@ -770,6 +947,79 @@ namespace RTM
      */
     ::std::mutex m_slaveMutex;
 
+    /*!
+     * @if jp
+     * @brief スレーブマネージャの登録・削除の通知
+     * @else
+     * @brief Notification of registered and removed slave managers
+     * @endif
+     */
+    ::std::condition_variable m_slaveCond;
+    ::std::uint64_t m_slaveGeneration{0};
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャプール (m_slaveMutex で保護)
+     * @else
+     * @brief Slave manager pool (guarded by m_slaveMutex)
+     * @endif
+     */
+    struct PooledSlave
+    {
+      std::string language;
+      RTM::Manager_var mgr;
+    };
+    using LaunchingSlave =
+      std::pair<std::string, std::chrono::steady_clock::time_point>;
+    // idle managers
+    ::std::vector<PooledSlave> m_pool;
+    // launched managers not registered yet, with the deadline
+    ::std::vector<LaunchingSlave> m_poolLaunching;
+    // registered managers not yet checked for pool membership
+    ::std::vector<RTM::Manager_var> m_poolRegistered;
+    ::std::vector<std::string> m_poolLanguages;
+    size_t m_poolSize{0};
+    std::string m_poolIdleTimeout;
+    bool m_poolRefill{false};
+    bool m_poolExit{false};
+    ::std::thread m_poolThread;
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャへの問い合わせの設定とキャッシュ
+     * @else
+     * @brief Settings and caches of the queries to the slave managers
+     * @endif
+     */
+    std::chrono::nanoseconds m_queryTimeout{std::chrono::seconds(3)};
+    std::chrono::nanoseconds m_cacheTtl{std::chrono::seconds(1)};
+    size_t m_queryJobs{0};
+    // guards the caches and m_cacheGeneration
+    ::std::mutex m_cacheMutex;
+    ::std::uint64_t m_cacheGeneration{0};
+    SlaveCache<RTC::RTCList> m_componentsCache;
+    SlaveCache<RTC::ComponentProfileList> m_profilesCache;
+
+    /*!
+     * @if jp
+     * @brief 呼び出し中のスレーブマネージャ
+     *
+     * 応答しないスレーブマネージャを待つスレッドと共有する。呼び出し
+     * が終わるまで同じスレーブマネージャには問い合わせないため、待ち続
+     * けるスレッドはスレーブマネージャごとに高々1つである。
+     *
+     * @else
+     * @brief Slave managers being called
+     *
+     * Shared with the threads waiting for slave managers not
+     * responding. A slave manager is not queried again until its call
+     * returns, so at most one thread per slave manager keeps waiting.
+     *
+     * @endif
+     */
+    struct SlaveCalls;
+    std::shared_ptr<SlaveCalls> m_slaveCalls;
+
     /*!
      * @if jp
      * @brief マスタかどうかのフラグ
@@ -27,6 +27,14 @@
 #include <rtm/ModuleManager.h>
 #include <coil/stringutil.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
 #ifdef __QNX__
 using std::FILE;
 using std::fgets;
@@ -556,42 +564,169 @@ namespace RTC
                                         vProperties& modprops)
   {
 #if !defined(VXWORKS_69) && !defined(VXWORKS_66)
-    std::string l = "manager.modules." + lang;
-    coil::Properties& lprop(Manager::instance().getConfig().getNode(l));
+    std::string cachefile(getProfileCacheFile());
+    if (!cachefile.empty() && !m_profileCacheLoaded)
+      {
+        m_profileCacheLoaded = true;
+        if (!m_profileCache.load(cachefile))
+          {
+            RTC_DEBUG(("No module profile cache: %s", cachefile.c_str()));
+          }
+      }
 
-    for (const auto & module : modules)
+    // 1. taking profiles of unchanged modules from the cache
+    std::vector<ModuleProfileCache::Stamp> stamps(modules.size());
+    vProperties profs(modules.size());
+    std::vector<size_t> targets;
+    for (size_t i(0); i < modules.size(); ++i)
       {
-        std::string cmd(lprop["profile_cmd"]);
-        cmd += " \"" + module + "\"";
+        ModuleProfileCache::getStamp(modules[i], stamps[i]);
+        if (!m_profileCache.find(lang, modules[i], stamps[i], profs[i]) ||
+            profs[i]["implementation_id"].empty())
+          {
+            targets.emplace_back(i);
+          }
+      }
+    RTC_DEBUG(("%d modules found in cache, %d modules to be probed.",
+               modules.size() - targets.size(), targets.size()));
+
+    // 2. probing the others with profile_cmd
+    // Failed probes are not cached so that they are retried next time.
+    // A profile without implementation_id is a failed probe, including
+    // a failure of create_process().
+    probeModuleProfiles(lang, modules, targets, profs);
+    for (auto i : targets)
+      {
+        if (profs[i]["implementation_id"].empty()) { continue; }
+        m_profileCache.update(lang, modules[i], stamps[i], profs[i]);
+      }
+    if (!cachefile.empty() && m_profileCache.isModified() &&
+        !m_profileCache.save(cachefile))
+      {
+        RTC_WARN(("Writing module profile cache failed: %s",
+                  cachefile.c_str()));
+      }
 
-        coil::vstring outlist;
-        if (coil::create_process(cmd, outlist) == -1)
+    for (size_t i(0); i < modules.size(); ++i)
+      {
+        if (profs[i]["implementation_id"].empty())
           {
-              std::cerr << "create_process faild" << std::endl;
-              continue;
+            m_loadfailmods[lang].emplace_back(modules[i]);
+            continue;
           }
+        profs[i]["module_file_name"] = coil::basename(modules[i].c_str());
+        profs[i]["module_file_path"] = modules[i];
+        modprops.emplace_back(std::move(profs[i]));
+      }
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @brief profile_cmd でモジュールのプロファイルを取得する
+   * @else
+   * @brief Probing module profiles with profile_cmd
+   * @endif
+   */
+  void ModuleManager::probeModuleProfiles(const std::string& lang,
+                                          const coil::vstring& modules,
+                                          const std::vector<size_t>& targets,
+                                          vProperties& profs)
+  {
+#if !defined(VXWORKS_69) && !defined(VXWORKS_66)
+    if (targets.empty()) { return; }
+    std::string l = "manager.modules." + lang;
+    coil::Properties& lprop(Manager::instance().getConfig().getNode(l));
+    const std::string profile_cmd(lprop["profile_cmd"]);
 
-        coil::Properties props;
-        for (auto & out : outlist)
+    size_t jobs(0);
+    coil::stringTo(jobs, m_properties["manager.modules.profile_jobs"].c_str());
+    if (jobs == 0) { jobs = std::thread::hardware_concurrency(); }
+    jobs = std::max<size_t>(1, std::min(jobs, targets.size()));
+    RTC_DEBUG(("Probing %d modules with %d processes.",
+               targets.size(), jobs));
+
+    std::atomic<size_t> next(0);
+    auto probe = [&]()
+      {
+        for (size_t n(next++); n < targets.size(); n = next++)
           {
-            std::string::size_type pos(out.find(':'));
-            if (pos != std::string::npos)
+            const std::string& module(modules[targets[n]]);
+            std::string cmd(profile_cmd);
+            cmd += " \"" + module + "\"";
+
+            coil::vstring outlist;
+            if (coil::create_process(cmd, outlist) == -1)
               {
-                  std::string key{coil::eraseBothEndsBlank(out.substr(0, pos))};
-                  props[key] = coil::eraseBothEndsBlank(out.substr(pos + 1));
+                std::cerr << "create_process faild" << std::endl;
+                continue;
               }
-          }
 
-        RTC_DEBUG(("rtcprof cmd sub process done."));
-        if (props["implementation_id"].empty())
-          {
-            m_loadfailmods[lang].emplace_back(module);
-            continue;
+            coil::Properties& props(profs[targets[n]]);
+            for (auto & out : outlist)
+              {
+                std::string::size_type pos(out.find(':'));
+                if (pos != std::string::npos)
+                  {
+                    std::string key{coil::eraseBothEndsBlank(out.substr(0, pos))};
+                    props[key] = coil::eraseBothEndsBlank(out.substr(pos + 1));
+                  }
+              }
           }
-        props["module_file_name"] = coil::basename(module.c_str());
-        props["module_file_path"] = module;
-        modprops.emplace_back(std::move(props));
+      };
+    std::vector<std::thread> threads;
+    for (size_t i(1); i < jobs; ++i)
+      {
+        threads.emplace_back(probe);
+      }
+    probe();
+    for (auto & thread : threads)
+      {
+        thread.join();
+      }
+    RTC_DEBUG(("rtcprof cmd sub process done."));
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @brief モジュールプロファイルのキャッシュファイル名を取得する
+   * @else
+   * @brief Getting the file name of the module profile cache
+   * @endif
+   */
+  std::string ModuleManager::getProfileCacheFile()
+  {
+    if (!coil::toBool(m_properties["manager.modules.profile_cache.enable"],
+                      "YES", "NO", true))
+      {
+        return "";
+      }
+    std::string file(m_properties["manager.modules.profile_cache.file"]);
+    if (!file.empty()) { return file; }
+
+#ifdef WIN32
+    const char* dir(std::getenv("LOCALAPPDATA"));
+    if (dir == nullptr || dir[0] == '\0') { return ""; }
+    return std::string(dir) + "\\openrtm_module_profiles.cache";
+#else
+    std::string dir;
+    const char* xdg(std::getenv("XDG_CACHE_HOME"));
+    const char* home(std::getenv("HOME"));
+    if (xdg != nullptr && xdg[0] != '\0')
+      {
+        dir = xdg;
+      }
+    else if (home != nullptr && home[0] != '\0')
+      {
+        dir = std::string(home) + "/.cache";
+        ::mkdir(dir.c_str(), 0755);
+      }
+    else
+      {
+        return "";
       }
+    return dir + "/openrtm_module_profiles.cache";
 #endif
   }
 
@@ -28,6 +28,7 @@
 #include <rtm/Manager.h>
 #include <coil/Properties.h>
 #include <rtm/ObjectManager.h>
+#include <rtm/ModuleProfileCache.h>
 
 // STL includes
 #include <string>
@@ -633,6 +634,47 @@ namespace RTC
     void getModuleProfiles(const std::string& lang,
                            const coil::vstring& modules, vProperties& modprops);
 
+    /*!
+     * @if jp
+     * @brief profile_cmd でモジュールのプロファイルを取得する
+     *
+     * modules のうち targets で指定したモジュールについて profile_cmd
+     * を実行し、結果を profs の同じ位置に格納する。
+     * manager.modules.profile_jobs 個 (0 の場合はハードウェアスレッド
+     * 数) のプロセスを並列に実行する。
+     *
+     * @else
+     * @brief Probing module profiles with profile_cmd
+     *
+     * Runs profile_cmd for the modules in modules selected by targets
+     * and stores the results at the same positions of profs. Up to
+     * manager.modules.profile_jobs processes (the number of hardware
+     * threads if 0) run in parallel.
+     *
+     * @endif
+     */
+    void probeModuleProfiles(const std::string& lang,
+                             const coil::vstring& modules,
+                             const std::vector<size_t>& targets,
+                             vProperties& profs);
+
+    /*!
+     * @if jp
+     * @brief モジュールプロファイルのキャッシュファイル名を取得する
+     *
+     * manager.modules.profile_cache.enable が NO の場合、またはファイル
+     * 名を決められない場合は空文字列を返す。
+     *
+     * @else
+     * @brief Getting the file name of the module profile cache
+     *
+     * Returns an empty string if manager.modules.profile_cache.enable
+     * is NO or no file name can be determined.
+     *
+     * @endif
+     */
+    std::string getProfileCacheFile();
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -773,6 +815,16 @@ namespace RTC
     vProperties m_modprofs;
 	std::map<std::string, coil::vstring> m_loadfailmods;
 
+    /*!
+     * @if jp
+     * @brief モジュールプロファイルのキャッシュ
+     * @else
+     * @brief Module profile cache
+     * @endif
+     */
+    ModuleProfileCache m_profileCache;
+    bool m_profileCacheLoaded{false};
+
   };   // class ModuleManager
 } // namespace RTC
 
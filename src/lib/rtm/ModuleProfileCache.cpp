@@ -0,0 +1,263 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ModuleProfileCache.cpp
+ * @brief On-disk cache of loadable module profiles
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ModuleProfileCache.h>
+#include <coil/OS.h>
+#include <coil/stringutil.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace RTC
+{
+  namespace
+  {
+    const char cache_header[] = "# OpenRTM-aist module profile cache";
+
+    std::uint64_t getValue(const unsigned char* buf, size_t length, bool le)
+    {
+      std::uint64_t value(0);
+      for (size_t i(0); i < length; ++i)
+        {
+          size_t pos(le ? length - 1 - i : i);
+          value = (value << 8) | buf[pos];
+        }
+      return value;
+    }
+
+    bool readAt(std::ifstream& ifs, std::uint64_t offset,
+                unsigned char* buf, size_t length)
+    {
+      ifs.seekg(static_cast<std::streamoff>(offset));
+      ifs.read(reinterpret_cast<char*>(buf),
+               static_cast<std::streamsize>(length));
+      return static_cast<size_t>(ifs.gcount()) == length;
+    }
+
+    std::string findBuildIdNote(const std::vector<unsigned char>& notes,
+                                bool le)
+    {
+      const char hex[] = "0123456789abcdef";
+      size_t pos(0);
+      while (pos + 12 <= notes.size())
+        {
+          std::uint64_t namesz(getValue(&notes[pos], 4, le));
+          std::uint64_t descsz(getValue(&notes[pos + 4], 4, le));
+          std::uint64_t type(getValue(&notes[pos + 8], 4, le));
+          size_t name(pos + 12);
+          size_t desc(name + ((namesz + 3) & ~std::uint64_t(3)));
+          size_t next(desc + ((descsz + 3) & ~std::uint64_t(3)));
+          if (next > notes.size() || next <= pos) { break; }
+          // NT_GNU_BUILD_ID
+          if (type == 3 && namesz == 4 &&
+              std::string(reinterpret_cast<const char*>(&notes[name]), 3)
+              == "GNU")
+            {
+              std::string id;
+              for (size_t i(0); i < descsz; ++i)
+                {
+                  id += hex[notes[desc + i] >> 4];
+                  id += hex[notes[desc + i] & 0x0f];
+                }
+              return id;
+            }
+          pos = next;
+        }
+      return "";
+    }
+  } // namespace
+
+  bool ModuleProfileCache::getStamp(const std::string& path, Stamp& stamp)
+  {
+#ifdef WIN32
+    struct _stat64 st;
+    if (::_stat64(path.c_str(), &st) != 0) { return false; }
+#else
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) { return false; }
+#endif
+    stamp.mtime = static_cast<long long>(st.st_mtime);
+    stamp.size = static_cast<unsigned long long>(st.st_size);
+    stamp.buildId = readBuildId(path);
+    return true;
+  }
+
+  std::string ModuleProfileCache::readBuildId(const std::string& path)
+  {
+    std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+    unsigned char ident[64];
+    if (!ifs || !readAt(ifs, 0, ident, sizeof(ident))) { return ""; }
+    if (ident[0] != 0x7f || ident[1] != 'E' ||
+        ident[2] != 'L' || ident[3] != 'F')
+      {
+        return "";
+      }
+    bool is64(ident[4] == 2);
+    bool le(ident[5] == 1);
+
+    std::uint64_t phoff(is64 ? getValue(&ident[32], 8, le)
+                             : getValue(&ident[28], 4, le));
+    std::uint64_t phentsize(is64 ? getValue(&ident[54], 2, le)
+                                 : getValue(&ident[42], 2, le));
+    std::uint64_t phnum(is64 ? getValue(&ident[56], 2, le)
+                             : getValue(&ident[44], 2, le));
+    if (phentsize < (is64 ? 56u : 32u)) { return ""; }
+
+    for (std::uint64_t i(0); i < phnum; ++i)
+      {
+        unsigned char ph[56];
+        if (!readAt(ifs, phoff + i * phentsize, ph, is64 ? 56 : 32))
+          {
+            return "";
+          }
+        // PT_NOTE
+        if (getValue(&ph[0], 4, le) != 4) { continue; }
+        std::uint64_t offset(is64 ? getValue(&ph[8], 8, le)
+                                  : getValue(&ph[4], 4, le));
+        std::uint64_t size(is64 ? getValue(&ph[32], 8, le)
+                                : getValue(&ph[16], 4, le));
+        if (size == 0 || size > 65536) { continue; }
+        std::vector<unsigned char> notes(static_cast<size_t>(size));
+        if (!readAt(ifs, offset, notes.data(), notes.size())) { continue; }
+        std::string id(findBuildIdNote(notes, le));
+        if (!id.empty()) { return id; }
+      }
+    return "";
+  }
+
+  bool ModuleProfileCache::load(const std::string& filename)
+  {
+    std::ifstream ifs(filename.c_str());
+    if (!ifs) { return false; }
+    m_entries.clear();
+    m_modified = false;
+
+    std::string line;
+    Entry* entry(nullptr);
+    while (std::getline(ifs, line))
+      {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+          {
+            line.erase(line.size() - 1);
+          }
+        if (line.empty() || line[0] == '#') { continue; }
+        if (line[0] == '[')
+          {
+            // [<lang> <mtime> <size> <build id>] <path>
+            entry = nullptr;
+            std::string::size_type end(line.find("] "));
+            if (end == std::string::npos) { continue; }
+            std::istringstream iss(line.substr(1, end - 1));
+            std::string lang, buildid;
+            Stamp stamp;
+            if (!(iss >> lang >> stamp.mtime >> stamp.size >> buildid))
+              {
+                continue;
+              }
+            stamp.buildId = (buildid == "-") ? "" : buildid;
+            entry = &m_entries[Key(lang, line.substr(end + 2))];
+            entry->stamp = stamp;
+            entry->profile.clear();
+            continue;
+          }
+        std::string::size_type pos(line.find(':'));
+        if (entry == nullptr || pos == std::string::npos) { continue; }
+        entry->profile.emplace_back(
+          coil::eraseBothEndsBlank(line.substr(0, pos)),
+          coil::eraseBothEndsBlank(line.substr(pos + 1)));
+      }
+    return true;
+  }
+
+  bool ModuleProfileCache::save(const std::string& filename)
+  {
+    std::string tmpname(filename + "." + coil::otos(coil::getpid()) + ".tmp");
+    {
+      std::ofstream ofs(tmpname.c_str());
+      if (!ofs) { return false; }
+      ofs << cache_header << std::endl;
+      for (auto & entry : m_entries)
+        {
+          Stamp current;
+          if (!getStamp(entry.first.second, current)) { continue; }
+          ofs << std::endl
+              << "[" << entry.first.first << " "
+              << entry.second.stamp.mtime << " "
+              << entry.second.stamp.size << " "
+              << (entry.second.stamp.buildId.empty()
+                  ? "-" : entry.second.stamp.buildId)
+              << "] " << entry.first.second << std::endl;
+          for (auto & kv : entry.second.profile)
+            {
+              ofs << kv.first << ": " << kv.second << std::endl;
+            }
+        }
+      if (!ofs)
+        {
+          ofs.close();
+          std::remove(tmpname.c_str());
+          return false;
+        }
+    }
+#ifdef WIN32
+    std::remove(filename.c_str());
+#endif
+    if (std::rename(tmpname.c_str(), filename.c_str()) != 0)
+      {
+        std::remove(tmpname.c_str());
+        return false;
+      }
+    m_modified = false;
+    return true;
+  }
+
+  bool ModuleProfileCache::find(const std::string& lang,
+                                const std::string& path,
+                                const Stamp& stamp,
+                                coil::Properties& profile) const
+  {
+    auto it = m_entries.find(Key(lang, path));
+    if (it == m_entries.end() || !(it->second.stamp == stamp))
+      {
+        return false;
+      }
+    for (auto & kv : it->second.profile)
+      {
+        profile[kv.first] = kv.second;
+      }
+    return true;
+  }
+
+  void ModuleProfileCache::update(const std::string& lang,
+                                  const std::string& path,
+                                  const Stamp& stamp,
+                                  const coil::Properties& profile)
+  {
+    Entry& entry(m_entries[Key(lang, path)]);
+    entry.stamp = stamp;
+    entry.profile.clear();
+    for (auto & key : profile.propertyNames())
+      {
+        entry.profile.emplace_back(key, profile.getProperty(key));
+      }
+    m_modified = true;
+  }
+} // namespace RTC
@@ -0,0 +1,213 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ModuleProfileCache.h
+ * @brief On-disk cache of loadable module profiles
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_MODULEPROFILECACHE_H
+#define RTC_MODULEPROFILECACHE_H
+
+#include <coil/Properties.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class ModuleProfileCache
+   * @brief ロード可能モジュールのプロファイルキャッシュ
+   *
+   * profile_cmd (rtcprof 等) で取得したモジュールのプロファイルを、
+   * (言語, パス) ごとにファイルの更新時刻、サイズ、ビルドIDとともに
+   * 保持する。これらが一致する限りキャッシュの内容を使い、モジュール
+   * ごとにプロセスを起動しない。
+   *
+   * プロファイルの取得に失敗したモジュールは空のプロファイルとして
+   * 記録し、ファイルが変わるまで再取得しない。
+   *
+   * ビルドIDは ELF の NT_GNU_BUILD_ID ノートから取得する。ELF 以外の
+   * ファイルでは空文字列になる。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class ModuleProfileCache
+   * @brief Profile cache of loadable modules
+   *
+   * Keeps the module profiles obtained by profile_cmd (rtcprof etc.)
+   * per (language, path) together with the modification time, size and
+   * build ID of the file. As long as they match, the cached profile is
+   * used and no process is started for the module.
+   *
+   * Modules whose profile could not be obtained are recorded with an
+   * empty profile and are not probed again until the file changes.
+   *
+   * The build ID is taken from the ELF NT_GNU_BUILD_ID note. It is an
+   * empty string for files other than ELF.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class ModuleProfileCache
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief ファイルの識別情報
+     * @else
+     * @brief Identity of a file
+     * @endif
+     */
+    struct Stamp
+    {
+      long long mtime{0};
+      unsigned long long size{0};
+      std::string buildId;
+      bool operator==(const Stamp& rhs) const
+      {
+        return mtime == rhs.mtime && size == rhs.size &&
+               buildId == rhs.buildId;
+      }
+    };
+
+    /*!
+     * @if jp
+     * @brief ファイルの識別情報を取得する
+     *
+     * @param path ファイルのパス
+     * @param stamp 識別情報
+     * @return ファイルが存在しない場合 false
+     *
+     * @else
+     * @brief Get the identity of a file
+     *
+     * @param path Path of the file
+     * @param stamp Identity
+     * @return false if the file does not exist
+     *
+     * @endif
+     */
+    static bool getStamp(const std::string& path, Stamp& stamp);
+
+    /*!
+     * @if jp
+     * @brief ELF ファイルのビルドIDを16進文字列で取得する
+     * @else
+     * @brief Get the build ID of an ELF file as a hex string
+     * @endif
+     */
+    static std::string readBuildId(const std::string& path);
+
+    /*!
+     * @if jp
+     * @brief キャッシュファイルを読み込む
+     *
+     * @param filename キャッシュファイル名
+     * @return ファイルを読めなかった場合 false
+     *
+     * @else
+     * @brief Read a cache file
+     *
+     * @param filename Name of the cache file
+     * @return false if the file could not be read
+     *
+     * @endif
+     */
+    bool load(const std::string& filename);
+
+    /*!
+     * @if jp
+     * @brief キャッシュファイルを書き出す
+     *
+     * 一時ファイルに書いてから置き換えるため、同じファイルを使う他の
+     * プロセスが書きかけの内容を読むことはない。存在しなくなったモ
+     * ジュールのエントリは書き出さない。
+     *
+     * @param filename キャッシュファイル名
+     * @return 書き出しに失敗した場合 false
+     *
+     * @else
+     * @brief Write the cache file
+     *
+     * The file is written to a temporary file and then replaced, so
+     * other processes sharing the file never read partial content.
+     * Entries of modules which no longer exist are not written.
+     *
+     * @param filename Name of the cache file
+     * @return false if writing failed
+     *
+     * @endif
+     */
+    bool save(const std::string& filename);
+
+    /*!
+     * @if jp
+     * @brief キャッシュされたプロファイルを取得する
+     *
+     * @param lang 言語
+     * @param path モジュールのパス
+     * @param stamp モジュールの現在の識別情報
+     * @param profile プロファイル。取得に失敗したモジュールでは空
+     * @return 識別情報が一致するエントリがあれば true
+     *
+     * @else
+     * @brief Get a cached profile
+     *
+     * @param lang Language
+     * @param path Path of the module
+     * @param stamp Current identity of the module
+     * @param profile Profile. Empty for modules which failed to probe
+     * @return true if an entry with the same identity exists
+     *
+     * @endif
+     */
+    bool find(const std::string& lang, const std::string& path,
+              const Stamp& stamp, coil::Properties& profile) const;
+
+    /*!
+     * @if jp
+     * @brief プロファイルを登録する
+     * @else
+     * @brief Register a profile
+     * @endif
+     */
+    void update(const std::string& lang, const std::string& path,
+                const Stamp& stamp, const coil::Properties& profile);
+
+    /*!
+     * @if jp
+     * @brief 最後の load() または save() 以降に更新されたか
+     * @else
+     * @brief Whether updated since the last load() or save()
+     * @endif
+     */
+    bool isModified() const { return m_modified; }
+
+  private:
+    using Key = std::pair<std::string, std::string>;
+    struct Entry
+    {
+      Stamp stamp;
+      std::vector<std::pair<std::string, std::string> > profile;
+    };
+    std::map<Key, Entry> m_entries;
+    bool m_modified{false};
+  };
+} // namespace RTC
+
+#endif // RTC_MODULEPROFILECACHE_H
@@ -0,0 +1,131 @@
+﻿// -*- C++ -*-
+/*!
+ * @file NativeSerializer.cpp
+ * @brief Native memory layout serializer for Timed*Seq data types
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/NativeSerializer.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+  (defined(__x86_64__) || defined(__i386__))
+#define RTC_NATIVE_SWAP_SSSE3
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define RTC_NATIVE_SWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace RTC
+{
+  namespace
+  {
+    void swapScalar(unsigned char* dst, const unsigned char* src,
+                    size_t count, size_t size)
+    {
+      for (size_t i(0); i < count; ++i)
+        {
+          for (size_t j(0); j < size; ++j)
+            {
+              dst[j] = src[size - 1 - j];
+            }
+          dst += size;
+          src += size;
+        }
+    }
+
+#ifdef RTC_NATIVE_SWAP_SSSE3
+    // The library is built for the baseline x86 ISA, so the SSSE3 path
+    // is compiled with a target attribute and chosen at run time.
+    __attribute__((target("ssse3")))
+    size_t swapSSSE3(unsigned char* dst, const unsigned char* src,
+                     size_t count, size_t size)
+    {
+      __m128i mask;
+      if (size == 2)
+        {
+          mask = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9,
+                              6, 7, 4, 5, 2, 3, 0, 1);
+        }
+      else if (size == 4)
+        {
+          mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11,
+                              4, 5, 6, 7, 0, 1, 2, 3);
+        }
+      else
+        {
+          mask = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15,
+                              0, 1, 2, 3, 4, 5, 6, 7);
+        }
+      size_t per(16 / size);
+      size_t done(0);
+      for (; done + per <= count; done += per)
+        {
+          // unaligned loads and stores: cast through void* to keep
+          // -Wcast-align=strict quiet
+          __m128i v(_mm_loadu_si128(
+            static_cast<const __m128i*>(static_cast<const void*>(src))));
+          _mm_storeu_si128(static_cast<__m128i*>(static_cast<void*>(dst)),
+                           _mm_shuffle_epi8(v, mask));
+          dst += 16;
+          src += 16;
+        }
+      return done;
+    }
+
+    bool hasSSSE3()
+    {
+      static const bool supported(__builtin_cpu_supports("ssse3") != 0);
+      return supported;
+    }
+#endif
+
+#ifdef RTC_NATIVE_SWAP_NEON
+    size_t swapNEON(unsigned char* dst, const unsigned char* src,
+                    size_t count, size_t size)
+    {
+      size_t per(16 / size);
+      size_t done(0);
+      for (; done + per <= count; done += per)
+        {
+          uint8x16_t v(vld1q_u8(src));
+          if (size == 2)      { v = vrev16q_u8(v); }
+          else if (size == 4) { v = vrev32q_u8(v); }
+          else                { v = vrev64q_u8(v); }
+          vst1q_u8(dst, v);
+          dst += 16;
+          src += 16;
+        }
+      return done;
+    }
+#endif
+  } // namespace
+
+  void nativeByteSwap(void* dst, const void* src, size_t count, size_t size)
+  {
+    unsigned char* d(static_cast<unsigned char*>(dst));
+    const unsigned char* s(static_cast<const unsigned char*>(src));
+    size_t done(0);
+    if (size == 2 || size == 4 || size == 8)
+      {
+#if defined(RTC_NATIVE_SWAP_SSSE3)
+        if (hasSSSE3())
+          {
+            done = swapSSSE3(d, s, count, size);
+          }
+#elif defined(RTC_NATIVE_SWAP_NEON)
+        done = swapNEON(d, s, count, size);
+#endif
+      }
+    swapScalar(d + done * size, s + done * size, count - done, size);
+  }
+} // namespace RTC
@@ -0,0 +1,418 @@
+﻿// -*- C++ -*-
+/*!
+ * @file NativeSerializer.h
+ * @brief Native memory layout serializer for Timed*Seq data types
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_NATIVESERIALIZER_H
+#define RTC_NATIVESERIALIZER_H
+
+#include <rtm/RTC.h>
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <rtm/ByteDataStreamBase.h>
+#include <rtm/ByteData.h>
+#include <rtm/CORBA_CdrMemoryStream.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief native マーシャリングで扱う型の特性
+   *
+   * tm と固定長要素のシーケンス data のみを持つ型について、要素型を
+   * value_type に定義し supported を true とする。
+   *
+   * @else
+   * @brief Traits of the data types handled by the native marshaling
+   *
+   * For types consisting only of tm and a sequence data of fixed size
+   * elements, value_type is the element type and supported is true.
+   *
+   * @endif
+   */
+  template <class DataType>
+  struct NativeSequenceTraits
+  {
+    static const bool supported = false;
+  };
+
+#define RTC_NATIVE_SEQUENCE_TRAITS(DataType, ElementType)       \
+  template <>                                                   \
+  struct NativeSequenceTraits<DataType>                         \
+  {                                                             \
+    static const bool supported = true;                         \
+    using value_type = ElementType;                             \
+  };
+
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedShortSeq, CORBA::Short)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedLongSeq, CORBA::Long)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedUShortSeq, CORBA::UShort)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedULongSeq, CORBA::ULong)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedFloatSeq, CORBA::Float)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedDoubleSeq, CORBA::Double)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedCharSeq, CORBA::Char)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedBooleanSeq, CORBA::Boolean)
+  RTC_NATIVE_SEQUENCE_TRAITS(TimedOctetSeq, CORBA::Octet)
+
+#undef RTC_NATIVE_SEQUENCE_TRAITS
+
+  /*!
+   * @if jp
+   * @brief 要素ごとにバイト順を反転してコピーする
+   *
+   * SSSE3 (x86) または NEON (ARM) が使用できる場合はそれを用いる。
+   * src と dst のアラインメントは問わない。
+   *
+   * @param dst コピー先
+   * @param src コピー元
+   * @param count 要素数
+   * @param size 要素のサイズ (1, 2, 4, 8)
+   *
+   * @else
+   * @brief Copy elements reversing the byte order of each
+   *
+   * SSSE3 (x86) or NEON (ARM) is used when available. src and dst need
+   * not be aligned.
+   *
+   * @param dst Destination
+   * @param src Source
+   * @param count Number of elements
+   * @param size Size of an element (1, 2, 4, 8)
+   *
+   * @endif
+   */
+  void nativeByteSwap(void* dst, const void* src, size_t count, size_t size);
+
+  /*!
+   * @if jp
+   * @class NativeSequenceSerializer
+   * @brief Timed*Seq 型の native シリアライザ
+   *
+   * CDR の要素ごとのマーシャリングの代わりに、以下のヘッダに続けて
+   * 要素の配列をメモリ上の表現のまま書き込む。
+   *
+   * | オフセット | サイズ | 内容                              |
+   * |-----------:|-------:|-----------------------------------|
+   * |          0 |      4 | "RTNS"                            |
+   * |          4 |      1 | エンディアン (1: little, 0: big)  |
+   * |          5 |      1 | 要素のサイズ                      |
+   * |          6 |      2 | 予約 (0)                          |
+   * |          8 |      4 | tm.sec                            |
+   * |         12 |      4 | tm.nsec                           |
+   * |         16 |      8 | 要素数                            |
+   * |         24 |        | 要素の配列                        |
+   *
+   * ヘッダの数値と要素は送信側のバイト順で書き込み、受信側のバイト順
+   * と異なる場合は受信側で反転する。このためコネクタのエンディアン設
+   * 定は使用しない。
+   *
+   * @param DataType データ型
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class NativeSequenceSerializer
+   * @brief Native serializer of Timed*Seq types
+   *
+   * Instead of marshaling every element as CDR, writes the element
+   * array as it is in memory after the following header.
+   *
+   * | Offset | Size | Content                          |
+   * |-------:|-----:|----------------------------------|
+   * |      0 |    4 | "RTNS"                           |
+   * |      4 |    1 | Endian (1: little, 0: big)       |
+   * |      5 |    1 | Size of an element               |
+   * |      6 |    2 | Reserved (0)                     |
+   * |      8 |    4 | tm.sec                           |
+   * |     12 |    4 | tm.nsec                          |
+   * |     16 |    8 | Number of elements               |
+   * |     24 |      | Element array                    |
+   *
+   * The numbers in the header and the elements are written in the
+   * sender's byte order and reversed by the receiver if its byte order
+   * differs. The endian setting of the connector is therefore not used.
+   *
+   * @param DataType Data type
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  template <class DataType>
+  class NativeSequenceSerializer : public ByteDataStream<DataType>
+  {
+    using value_type = typename NativeSequenceTraits<DataType>::value_type;
+    static const size_t header_size = 24;
+
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    NativeSequenceSerializer() = default;
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~NativeSequenceSerializer() override = default;
+
+    /*!
+     * @if jp
+     * @brief 符号化済みのデータを設定する
+     * @else
+     * @brief Set the serialized data
+     * @endif
+     */
+    void writeData(const unsigned char* buffer, unsigned long length) override
+    {
+      reserve(length);
+      std::memcpy(m_buffer.get(), buffer, length);
+      ByteData::countCopy(length);
+      m_data = m_buffer.get();
+      m_length = length;
+      m_shared = ByteData();
+    }
+
+    /*!
+     * @if jp
+     * @brief ByteData のバッファを参照して符号化済みのデータを設定する
+     * @else
+     * @brief Set the serialized data referring to the buffer of ByteData
+     * @endif
+     */
+    void shareData(const ByteData& data) override
+    {
+      m_shared = data;
+      m_data = m_shared.getBuffer();
+      m_length = m_shared.getDataLength();
+    }
+
+    /*!
+     * @if jp
+     * @brief 符号化済みのデータを引数のバッファに書き込む
+     * @else
+     * @brief Copy the serialized data into the given buffer
+     * @endif
+     */
+    void readData(unsigned char* buffer, unsigned long length) const override
+    {
+      std::memcpy(buffer, m_data, length < m_length ? length : m_length);
+    }
+
+    /*!
+     * @if jp
+     * @brief 符号化済みのデータの長さを取得する
+     * @else
+     * @brief Get the length of the serialized data
+     * @endif
+     */
+    unsigned long getDataLength() const override
+    {
+      return m_length;
+    }
+
+    /*!
+     * @if jp
+     * @brief データを符号化する
+     * @else
+     * @brief Serialize the data
+     * @endif
+     */
+    bool serialize(const DataType& data) override
+    {
+      std::uint64_t count(data.data.length());
+      size_t bytes(static_cast<size_t>(count) * sizeof(value_type));
+      reserve(header_size + bytes);
+
+      unsigned char* p(m_buffer.get());
+      std::memcpy(p, "RTNS", 4);
+      p[4] = hostIsLittleEndian() ? 1 : 0;
+      p[5] = static_cast<unsigned char>(sizeof(value_type));
+      p[6] = 0;
+      p[7] = 0;
+      std::uint32_t sec(data.tm.sec), nsec(data.tm.nsec);
+      std::memcpy(p + 8, &sec, 4);
+      std::memcpy(p + 12, &nsec, 4);
+      std::memcpy(p + 16, &count, 8);
+      if (bytes != 0)
+        {
+          std::memcpy(p + header_size, data.data.get_buffer(), bytes);
+        }
+      m_data = m_buffer.get();
+      m_length = static_cast<unsigned long>(header_size + bytes);
+      m_shared = ByteData();
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief データを復号する
+     *
+     * ヘッダが不正な場合、または要素のサイズが一致しない場合は false
+     * を返す。
+     *
+     * @else
+     * @brief Deserialize the data
+     *
+     * Returns false if the header is invalid or the element size does
+     * not match.
+     *
+     * @endif
+     */
+    bool deserialize(DataType& data) override
+    {
+      const unsigned char* p(m_data);
+      if (m_length < header_size || std::memcmp(p, "RTNS", 4) != 0 ||
+          p[5] != sizeof(value_type))
+        {
+          return false;
+        }
+      bool swap((p[4] != 0) != hostIsLittleEndian());
+
+      std::uint32_t sec, nsec;
+      std::uint64_t count;
+      copy(&sec, p + 8, 1, 4, swap);
+      copy(&nsec, p + 12, 1, 4, swap);
+      copy(&count, p + 16, 1, 8, swap);
+      if (count > (m_length - header_size) / sizeof(value_type))
+        {
+          return false;
+        }
+
+      data.tm.sec = sec;
+      data.tm.nsec = nsec;
+      data.data.length(static_cast<CORBA::ULong>(count));
+      if (count != 0)
+        {
+          copy(data.data.get_buffer(), p + header_size,
+               static_cast<size_t>(count), sizeof(value_type), swap);
+        }
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief エンディアンの設定
+     *
+     * 送信側のバイト順で符号化するため使用しない。
+     *
+     * @else
+     * @brief Set the endian
+     *
+     * Not used, since the data is encoded in the sender's byte order.
+     *
+     * @endif
+     */
+    void isLittleEndian(bool /*little_endian*/) override
+    {
+    }
+
+  private:
+    static bool hostIsLittleEndian()
+    {
+      const std::uint16_t one(1);
+      return *reinterpret_cast<const unsigned char*>(&one) == 1;
+    }
+
+    static void copy(void* dst, const unsigned char* src,
+                     size_t count, size_t size, bool swap)
+    {
+      if (swap && size > 1)
+        {
+          nativeByteSwap(dst, src, count, size);
+        }
+      else
+        {
+          std::memcpy(dst, src, count * size);
+        }
+    }
+
+    void reserve(size_t length)
+    {
+      // no value initialization: the buffer may be hundreds of MB
+      if (length > m_capacity)
+        {
+          m_buffer.reset(new unsigned char[length]);
+          m_capacity = length;
+        }
+    }
+
+    std::unique_ptr<unsigned char[]> m_buffer;
+    size_t m_capacity{0};
+    // m_buffer or the buffer of m_shared
+    const unsigned char* m_data{nullptr};
+    unsigned long m_length{0};
+    ByteData m_shared;
+  };
+
+  /*!
+   * @if jp
+   * @brief native マーシャリングで使用するシリアライザの型
+   *
+   * NativeSequenceTraits で扱えない型では CORBA_CdrSerializer を使用
+   * する。
+   *
+   * @else
+   * @brief Serializer type used for the native marshaling
+   *
+   * CORBA_CdrSerializer is used for types NativeSequenceTraits cannot
+   * handle.
+   *
+   * @endif
+   */
+  template <class DataType,
+            bool = NativeSequenceTraits<DataType>::supported>
+  struct NativeSerializerType
+  {
+    using type = CORBA_CdrSerializer<DataType>;
+  };
+
+  template <class DataType>
+  struct NativeSerializerType<DataType, true>
+  {
+    using type = NativeSequenceSerializer<DataType>;
+  };
+} // namespace RTC
+
+/*!
+ * @if jp
+ * @brief native シリアライザの初期化関数
+ *
+ * marshaling_type "native" としてシリアライザを登録する。
+ *
+ * @else
+ * @brief Initialization function of the native serializer
+ *
+ * Registers the serializer as marshaling_type "native".
+ *
+ * @endif
+ */
+template <class DataType>
+void NativeSerializerInit()
+{
+  ::RTC::addSerializer<DataType,
+                       typename ::RTC::NativeSerializerType<DataType>::type>("native");
+}
+
+#endif  // RTC_NATIVESERIALIZER_H
@@ -32,8 +32,11 @@
 #include <rtm/Timestamp.h>
 #include <rtm/DirectOutPortBase.h>
 #include <rtm/DataTypeUtil.h>
+#include <rtm/NativeSerializer.h>
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -116,6 +119,7 @@ namespace RTC
 	  m_directport = this;
 
       CdrMemoryStreamInit<DataType>();
+      NativeSerializerInit<DataType>();
 
       std::string serializer_types{coil::eraseBlank(coil::flatten(
         getSerializerList<DataType>()))};
@@ -193,72 +197,13 @@ namespace RTC
           RTC_TRACE(("OnWrite called"));
         }
 
-
-      bool result(true);
-      std::vector<const char *> disconnect_ids;
-      {
-        std::lock_guard<std::mutex> con_guard(m_connectorsMutex);
-        // check number of connectors
-        size_t conn_size(m_connectors.size());
-        if (!(conn_size > 0)) { return false; }
-
-        m_status.resize(conn_size);
-
-        for (size_t i(0), len(conn_size); i < len; ++i)
-          {
-
-            DataPortStatus ret;
-            if (!m_connectors[i]->pullDirectMode())
-              {
-                if (m_onWriteConvert != nullptr)
-                  {
-                    RTC_DEBUG(("m_connectors.OnWriteConvert called"));
-                    DataType tmp = (*m_onWriteConvert)(value);
-                    ret = m_connectors[i]->write(tmp);
-                  }
-                else
-                  {
-                    RTC_DEBUG(("m_connectors.write called"));
-                    ret = m_connectors[i]->write(value);
-                  }
-              }
-            else
-              {
-                std::lock_guard<std::mutex> value_guard(m_valueMutex);
-                if (m_onWriteConvert != nullptr)
-                  {
-                    RTC_DEBUG(("m_connectors.OnWriteConvert called"));
-                    m_directValue = ((*m_onWriteConvert)(value));
-                  }
-                else
-                  {
-                    CORBA_Util::copyData<DataType>(m_directValue, value);
-                  }
-                m_directNewData = true;
-                ret = DataPortStatus::PORT_OK;
-              }
-            m_status[i] = ret;
-
-            if (ret == DataPortStatus::PORT_OK) { continue; }
-
-            result = false;
-
-            if (ret == DataPortStatus::CONNECTION_LOST)
-              {
-                const char* id(m_connectors[i]->profile().id.c_str());
-                RTC_WARN(("connection_lost id: %s", id));
-                if (m_onConnectionLost != nullptr)
-                  {
-                    RTC::ConnectorProfile prof(findConnProfile(id));
-                    (*m_onConnectionLost)(prof);
-                  }
-                disconnect_ids.emplace_back(id);
-              }
-          }
-      }
-      std::for_each(disconnect_ids.begin(), disconnect_ids.end(),
-                    std::bind1st(std::mem_fun(&PortBase::disconnect), this));
-      return result;
+      if (m_onWriteConvert != nullptr)
+        {
+          RTC_DEBUG(("m_connectors.OnWriteConvert called"));
+          DataType tmp = (*m_onWriteConvert)(value);
+          return writeConnectors(tmp);
+        }
+      return writeConnectors(value);
     }
 
     /*!
@@ -514,6 +459,185 @@ namespace RTC
         m_listeners = new ConnectorListenersT<DataType>();
     }
   private:
+    /*!
+     * @if jp
+     *
+     * @brief 全コネクタへのデータ書き込み
+     *
+     * データを全てのコネクタへ書き込む。シリアライズは同じマーシャリング
+     * 方式とエンディアンを持つコネクタの組ごとに一度だけ行い、
+     * シリアライズ結果を組内の全コネクタで共有する。
+     *
+     * @param data 書き込み対象データ
+     *
+     * @return 書き込み処理結果(書き込み成功:true、書き込み失敗:false)
+     *
+     * @else
+     *
+     * @brief Write data to all connectors
+     *
+     * Write data to all connectors. Data is serialized only once for
+     * each group of connectors which have the same marshaling type and
+     * endian, and the serialized stream is shared within the group.
+     *
+     * @param data The target data for writing
+     *
+     * @return Writing result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool writeConnectors(DataType& data)
+    {
+      bool result(true);
+      std::vector<const char *> disconnect_ids;
+      {
+        std::lock_guard<std::mutex> con_guard(m_connectorsMutex);
+        // check number of connectors
+        size_t conn_size(m_connectors.size());
+        if (!(conn_size > 0)) { return false; }
+
+        m_status.resize(conn_size);
+        for (auto& serializer : m_serializers)
+          {
+            serializer.serialized = false;
+          }
+
+        for (size_t i(0), len(conn_size); i < len; ++i)
+          {
+
+            DataPortStatus ret;
+            if (!m_connectors[i]->pullDirectMode())
+              {
+                RTC_DEBUG(("m_connectors.write called"));
+                if (m_connectors[i]->writeDirect(data))
+                  {
+                    ret = DataPortStatus::PORT_OK;
+                  }
+                else
+                  {
+                    ByteDataStreamBase* cdr(serialize(m_connectors[i], data));
+                    ret = cdr != nullptr ? m_connectors[i]->write(cdr)
+                                         : DataPortStatus::PORT_ERROR;
+                  }
+              }
+            else
+              {
+                std::lock_guard<std::mutex> value_guard(m_valueMutex);
+                CORBA_Util::copyData<DataType>(m_directValue, data);
+                m_directNewData = true;
+                ret = DataPortStatus::PORT_OK;
+              }
+            m_status[i] = ret;
+
+            if (ret == DataPortStatus::PORT_OK) { continue; }
+
+            result = false;
+
+            if (ret == DataPortStatus::CONNECTION_LOST)
+              {
+                const char* id(m_connectors[i]->profile().id.c_str());
+                RTC_WARN(("connection_lost id: %s", id));
+                if (m_onConnectionLost != nullptr)
+                  {
+                    RTC::ConnectorProfile prof(findConnProfile(id));
+                    (*m_onConnectionLost)(prof);
+                  }
+                disconnect_ids.emplace_back(id);
+              }
+          }
+      }
+      std::for_each(disconnect_ids.begin(), disconnect_ids.end(),
+                    std::bind1st(std::mem_fun(&PortBase::disconnect), this));
+      return result;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief コネクタ用のシリアライズ済みストリームを取得
+     *
+     * コネクタのマーシャリング方式とエンディアンに対応するシリアライザを
+     * 取得し、今回の write() でまだシリアライズしていなければ
+     * データをシリアライズする。
+     *
+     * @param connector 書き込み先のコネクタ
+     * @param data 書き込み対象データ
+     *
+     * @return シリアライズ済みストリーム。シリアライザが存在しない場合は
+     *         nullptr
+     *
+     * @else
+     *
+     * @brief Get the serialized stream for a connector
+     *
+     * Look up the serializer for the connector's marshaling type and
+     * endian, and serialize the data if it has not been serialized yet
+     * in this write().
+     *
+     * @param connector The target connector
+     * @param data The target data for writing
+     *
+     * @return The serialized stream, or nullptr if no serializer is
+     *         available
+     *
+     * @endif
+     */
+    ByteDataStreamBase* serialize(OutPortConnector* connector, DataType& data)
+    {
+      const std::string& marshaling_type(connector->getMarshalingType());
+      bool little_endian(connector->isLittleEndian());
+      auto it = std::find_if(m_serializers.begin(), m_serializers.end(),
+                             [&](const SerializerEntry& entry)
+                             {
+                               return entry.little_endian == little_endian &&
+                                 entry.marshaling_type == marshaling_type;
+                             });
+      if (it == m_serializers.end())
+        {
+          ByteDataStreamBase* stream(createSerializer<DataType>(marshaling_type));
+          if (stream == nullptr)
+            {
+              RTC_ERROR(("Can not find Marshalizer: %s",
+                         marshaling_type.c_str()));
+              return nullptr;
+            }
+          m_serializers.push_back({marshaling_type, little_endian,
+                                   stream, false});
+          it = std::prev(m_serializers.end());
+        }
+      ByteDataStream<DataType>* cdr =
+        dynamic_cast<ByteDataStream<DataType>*>(it->cdr);
+      if (cdr == nullptr)
+        {
+          RTC_ERROR(("Can not find Marshalizer: %s", marshaling_type.c_str()));
+          return nullptr;
+        }
+      if (!it->serialized)
+        {
+          cdr->isLittleEndian(little_endian);
+          cdr->serialize(data);
+          it->serialized = true;
+          RTC_TRACE(("serialized: %s, %s", marshaling_type.c_str(),
+                     little_endian ? "little" : "big"));
+        }
+      return cdr;
+    }
+
+    /*!
+     * @if jp
+     * @brief マーシャリング方式・エンディアンごとのシリアライザ
+     * @else
+     * @brief Serializer for each marshaling type and endian
+     * @endif
+     */
+    struct SerializerEntry
+    {
+      std::string marshaling_type;
+      bool little_endian;
+      ByteDataStreamBase* cdr;
+      bool serialized;
+    };
+
     std::string m_typename;
     /*!
      * @if jp
@@ -551,9 +675,24 @@ namespace RTC
     std::mutex m_valueMutex;
     bool m_directNewData;
     DataType m_directValue;
+
+    /*!
+     * @if jp
+     * @brief コネクタ間で共有するシリアライザのリスト
+     * @else
+     * @brief The list of serializers shared between connectors
+     * @endif
+     */
+    std::vector<SerializerEntry> m_serializers;
   };
 
-  template <class T> OutPort<T>::~OutPort() = default; // No inline for gcc warning, too big
+  template <class T> OutPort<T>::~OutPort() // No inline for gcc warning, too big
+  {
+    for (auto& serializer : m_serializers)
+      {
+        delete serializer.cdr;
+      }
+  }
 } // namespace RTC
 
 #endif  // RTC_OUTPORT_H
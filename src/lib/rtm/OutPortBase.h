@@ -140,8 +140,22 @@ namespace RTC
    *      publisher.skip_count = n<br>
    *      n: n要素毎にひとつ送信
    *
+   * - publisher.max_batch_count: <br>
+   *      push_policy = all の場合に1回の送信にまとめる最大データ数。
+   *      1 (デフォルト) ではまとめずに1つずつ送信する。接続先が対応し
+   *      ていない場合は無視される。
+   *
+   * - publisher.max_batch_bytes: <br>
+   *      1回の送信にまとめるデータの最大バイト数 (デフォルト 65536)。
+   *      これを超えるデータは単独で送信する。
+   *
    * - publisher.push_rate:
    *
+   * - publisher.overrun_policy: [catchup, skip] <br>
+   *      periodic Publisher の送信が周期を超過した場合の動作
+   *      - catchup: 遅れた周期を待機せずに続けて送信する
+   *      - skip: 遅れた周期を取りやめ、次の周期まで待機する (デフォルト)
+   *
    * - publisher.thread.type: <br>
    *       Publisher のスレッドのタイプ <br>
    * - publisher.thread.measurement.exec_time: yes/no
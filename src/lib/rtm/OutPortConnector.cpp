@@ -32,7 +32,8 @@ namespace RTC
   OutPortConnector::OutPortConnector(ConnectorInfo& info,
                                      ConnectorListenersBase* listeners)
     : rtclog("OutPortConnector"), m_profile(info), m_littleEndian(true),
-	m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("corba"), m_cdr(nullptr)
+	m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("corba"), m_cdr(nullptr),
+        m_pool(ByteDataPool::create(info.properties.getNode("buffer")))
   {
   }
 
@@ -47,6 +48,18 @@ namespace RTC
   {
     delete m_cdr;
   }
+
+  /*!
+   * @if jp
+   * @brief バッファ用のメモリプールを取得する
+   * @else
+   * @brief Get the memory pool for buffers
+   * @endif
+   */
+  const std::shared_ptr<ByteDataPool>& OutPortConnector::getMemoryPool() const
+  {
+    return m_pool;
+  }
   /*!
    * @if jp
    * @brief ConnectorInfo 取得
@@ -135,6 +148,18 @@ namespace RTC
     return m_littleEndian;
   }
 
+  /*!
+   * @if jp
+   * @brief シリアライザの名前を取得
+   * @else
+   * @brief Get the marshaling type
+   * @endif
+   */
+  const std::string& OutPortConnector::getMarshalingType() const
+  {
+    return m_marshaling_type;
+  }
+
   /*!
   * @if jp
   * @brief ダイレクト接続モードに設定
@@ -184,6 +209,19 @@ namespace RTC
       return BufferStatus::OK;
   }
 
+  BufferStatus OutPortConnector::readMany(std::vector<ByteData>& data,
+                                          size_t /*max_count*/,
+                                          size_t /*max_bytes*/,
+                                          std::chrono::nanoseconds /*timeout*/)
+  {
+      ByteData cdr;
+      BufferStatus ret(read(cdr));
+      if (ret != BufferStatus::OK) { return ret; }
+      if (cdr.getDataLength() == 0) { return BufferStatus::EMPTY; }
+      data.emplace_back(std::move(cdr));
+      return BufferStatus::OK;
+  }
+
   void OutPortConnector::unsubscribeInterface(const coil::Properties& /*prop*/)
   {
 
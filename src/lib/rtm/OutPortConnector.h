@@ -27,7 +27,10 @@
 #include <rtm/PortBase.h>
 #include <rtm/CORBA_CdrMemoryStream.h>
 #include <rtm/ByteData.h>
+#include <rtm/ByteDataPool.h>
 
+#include <chrono>
+#include <vector>
 
 
 namespace RTC
@@ -150,6 +153,30 @@ namespace RTC
      */
     CdrBufferBase* getBuffer() override = 0;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプールを取得する
+     *
+     * コネクタのデータのバッファを確保するメモリプールを返す。
+     * getStatistics() で確保の回数を確認できる。バッファ設定の
+     * memory_pool が NO の場合は nullptr。
+     *
+     * @return メモリプール
+     *
+     * @else
+     * @brief Get the memory pool for buffers
+     *
+     * Returns the memory pool allocating the buffers of the data of
+     * this connector. The number of allocations can be checked with
+     * getStatistics(). nullptr if memory_pool of the buffer settings is
+     * NO.
+     *
+     * @return The memory pool
+     *
+     * @endif
+     */
+    const std::shared_ptr<ByteDataPool>& getMemoryPool() const;
+
     /*!
      * @if jp
      * @brief write 関数
@@ -199,6 +226,65 @@ namespace RTC
      */
     virtual bool isLittleEndian();
 
+    /*!
+     * @if jp
+     * @brief 同一プロセス上の InPort への直接書き込み
+     *
+     * ピア InPort が同一プロセス上に存在し、データ型が一致する場合に
+     * シリアライズを行わずに InPort の変数へ直接書き込む。
+     *
+     * @param data 書き込むデータ
+     * @return 直接書き込みを行った場合 true、それ以外 false
+     *
+     * @else
+     * @brief Write data directly to the InPort in the same process
+     *
+     * If the peer InPort exists in the same process and has the same
+     * data type, data is written into the InPort variable without
+     * serialization.
+     *
+     * @param data The data to be written
+     * @return true if data was written directly, otherwise false
+     *
+     * @endif
+     */
+    template <class DataType>
+    bool writeDirect(DataType& data)
+    {
+      if (m_directInPort == nullptr)
+        {
+          return false;
+        }
+      DirectInPortBase<DataType>* inport = dynamic_cast<DirectInPortBase<DataType>*>(m_directInPort->getDirectPort());
+      if (inport == nullptr)
+        {
+          return false;
+        }
+      if (inport->isNew())
+        {
+          // ON_BUFFER_OVERWRITE(In,Out), ON_RECEIVER_FULL(In,Out) callback
+          m_listeners->notifyOut(ON_BUFFER_OVERWRITE, m_profile, data);
+          m_inPortListeners->notifyIn(ON_BUFFER_OVERWRITE, m_profile, data);
+          m_listeners->notifyOut(ON_RECEIVER_FULL, m_profile, data);
+          m_inPortListeners->notifyIn(ON_RECEIVER_FULL, m_profile, data);
+          RTC_PARANOID(("ON_BUFFER_OVERWRITE(InPort,OutPort), "
+                        "ON_RECEIVER_FULL(InPort,OutPort) "
+                        "callback called in direct mode."));
+        }
+      // ON_BUFFER_WRITE(In,Out) callback
+      m_listeners->notifyOut(ON_BUFFER_WRITE, m_profile, data);
+      m_inPortListeners->notifyIn(ON_BUFFER_WRITE, m_profile, data);
+      RTC_PARANOID(("ON_BUFFER_WRITE(InPort,OutPort), "
+                    "callback called in direct mode."));
+      inport->write(data);  // write to InPort variable!!
+      // ON_RECEIVED(In,Out) callback
+      m_listeners->notifyOut(ON_RECEIVED, m_profile, data);
+      m_inPortListeners->notifyIn(ON_RECEIVED, m_profile, data);
+      RTC_PARANOID(("ON_RECEIVED(InPort,OutPort), "
+                    "callback called in direct mode."));
+      return true;
+    }
+
     /*!
      * @if jp
      * @brief データ型の変換テンプレート
@@ -215,37 +301,9 @@ namespace RTC
     template <class DataType>
     DataPortStatus write(DataType& data)
     {
-
-      if (m_directInPort != nullptr)
+      if (writeDirect(data))
         {
-          DirectInPortBase<DataType>* inport = dynamic_cast<DirectInPortBase<DataType>*>(m_directInPort->getDirectPort());
-          if(inport)
-            {
-              if (inport->isNew())
-                {
-                  // ON_BUFFER_OVERWRITE(In,Out), ON_RECEIVER_FULL(In,Out) callback
-                  m_listeners->notifyOut(ON_BUFFER_OVERWRITE, m_profile, data);
-                  m_inPortListeners->notifyIn(ON_BUFFER_OVERWRITE, m_profile, data);
-                  m_listeners->notifyOut(ON_RECEIVER_FULL, m_profile, data);
-                  m_inPortListeners->notifyIn(ON_RECEIVER_FULL, m_profile, data);
-                  RTC_PARANOID(("ON_BUFFER_OVERWRITE(InPort,OutPort), "
-                                "ON_RECEIVER_FULL(InPort,OutPort) "
-                                "callback called in direct mode."));
-                }
-              // ON_BUFFER_WRITE(In,Out) callback
-              m_listeners->notifyOut(ON_BUFFER_WRITE, m_profile, data);
-              m_inPortListeners->notifyIn(ON_BUFFER_WRITE, m_profile, data);
-              RTC_PARANOID(("ON_BUFFER_WRITE(InPort,OutPort), "
-                                "callback called in direct mode."));
-              inport->write(data);  // write to InPort variable!!
-              // ON_RECEIVED(In,Out) callback
-              m_listeners->notifyOut(ON_RECEIVED, m_profile, data);
-              m_inPortListeners->notifyIn(ON_RECEIVED, m_profile, data);
-              RTC_PARANOID(("ON_RECEIVED(InPort,OutPort), "
-                            "callback called in direct mode."));
-              
-              return DataPortStatus::PORT_OK;
-            }
+          return DataPortStatus::PORT_OK;
         }
       // normal case
       if(m_cdr == nullptr)
@@ -267,8 +325,66 @@ namespace RTC
       return ret;
     }
 
+    /*!
+     * @if jp
+     * @brief シリアライザの名前を取得
+     *
+     * OutPort 側で使用するマーシャリング方式の名前を返す。
+     * 同じマーシャリング方式とエンディアンのコネクタ間では
+     * シリアライズ結果を共有できる。
+     *
+     * @return マーシャリング方式の名前
+     *
+     * @else
+     * @brief Get the marshaling type
+     *
+     * Return the name of the marshaling type used on the OutPort
+     * side. Connectors with the same marshaling type and endian can
+     * share one serialized stream.
+     *
+     * @return The name of the marshaling type
+     *
+     * @endif
+     */
+    const std::string& getMarshalingType() const;
+
     virtual BufferStatus read(ByteData &data);
 
+    /*!
+     * @if jp
+     * @brief バッファから複数のデータを読み出す
+     *
+     * バッファにあるデータを最大 max_count 個、合計 max_bytes バイト
+     * まで読み出して data の末尾に追加する。max_bytes より大きいデー
+     * タは単独で読み出す。バッファが空の場合は timeout の間データの書
+     * き込みを待つ。デフォルトでは read() で1個読み出す。
+     *
+     * @param data 読み出したデータの追加先
+     * @param max_count 最大個数。0 の場合は制限しない
+     * @param max_bytes 最大バイト数
+     * @param timeout バッファが空の場合の待ち時間
+     * @return OK: 1個以上読み出した, EMPTY: データがない
+     *
+     * @else
+     * @brief Read several data from the buffer
+     *
+     * Reads up to max_count data of max_bytes in total from the buffer
+     * and appends them to data. Data larger than max_bytes is read by
+     * itself. If the buffer is empty, waits up to timeout for data to
+     * be written. By default one datum is read with read().
+     *
+     * @param data The data read are appended to this
+     * @param max_count Maximum count. 0 means no limit
+     * @param max_bytes Maximum bytes
+     * @param timeout Time to wait if the buffer is empty
+     * @return OK: one or more read, EMPTY: no data
+     *
+     * @endif
+     */
+    virtual BufferStatus readMany(std::vector<ByteData>& data,
+                                  size_t max_count, size_t max_bytes,
+                                  std::chrono::nanoseconds timeout);
+
     bool setInPort(InPortBase* directInPort);
     /*!
      * @if jp
@@ -384,6 +500,15 @@ namespace RTC
     std::string m_marshaling_type;
     ByteDataStreamBase* m_cdr;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプール
+     * @else
+     * @brief Memory pool for buffers
+     * @endif
+     */
+    std::shared_ptr<ByteDataPool> m_pool;
+
   };
 } // namespace RTC
 
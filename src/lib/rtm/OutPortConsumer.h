@@ -24,6 +24,9 @@
 #include <rtm/DataPortStatus.h>
 #include <rtm/CdrBufferBase.h>
 
+#include <chrono>
+#include <vector>
+
 // Why RtORB does not allow the following foward declaration?
 #if !defined(ORB_IS_RTORB) && !defined(ORB_IS_ORBEXPRESS)
 namespace SDOPackage
@@ -305,6 +308,56 @@ namespace RTC
      */
     virtual DataPortStatus get(ByteData& data) = 0;
 
+    /*!
+     * @if jp
+     *
+     * @brief 複数のデータを受信する
+     *
+     * 接続先の OutPort のバッファにあるデータを最大 max_count 個、合計
+     * max_bytes バイトまで受信して data の末尾に追加する。接続先のバッ
+     * ファが空の場合は、接続先で最大 timeout の間データを待つ。受信し
+     * たデータはそれぞれ get() と同様にバッファに書き込まれ、リスナに
+     * 通知される。デフォルトでは get() で1個受信する。
+     *
+     * @param data 受信データの追加先
+     * @param max_count 最大個数。0 の場合は制限しない
+     * @param max_bytes 最大バイト数
+     * @param timeout 接続先のバッファが空の場合の待ち時間
+     * @return get() と同じリターンコード
+     *
+     * @else
+     *
+     * @brief Receive several data
+     *
+     * Receives up to max_count data of max_bytes in total from the
+     * buffer of the OutPort and appends them to data. If that buffer
+     * is empty, the OutPort side waits up to timeout for data. Each
+     * datum received is written to the buffer and notified to the
+     * listeners as by get(). By default one datum is received with
+     * get().
+     *
+     * @param data The data received are appended to this
+     * @param max_count Maximum count. 0 means no limit
+     * @param max_bytes Maximum bytes
+     * @param timeout Time to wait if the buffer of the OutPort is empty
+     * @return The return codes of get()
+     *
+     * @endif
+     */
+    virtual DataPortStatus getMany(std::vector<ByteData>& data,
+                                   size_t /*max_count*/,
+                                   size_t /*max_bytes*/,
+                                   std::chrono::nanoseconds /*timeout*/)
+    {
+      ByteData cdr;
+      DataPortStatus ret(get(cdr));
+      if (ret == DataPortStatus::PORT_OK)
+        {
+          data.emplace_back(std::move(cdr));
+        }
+      return ret;
+    }
+
     /*!
      * @if jp
      *
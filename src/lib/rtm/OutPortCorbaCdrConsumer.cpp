@@ -20,6 +20,7 @@
 #include <rtm/Manager.h>
 #include <rtm/OutPortCorbaCdrConsumer.h>
 #include <rtm/NVUtil.h>
+#include <rtm/CdrBatch.h>
 
 namespace RTC
 {
@@ -116,18 +117,7 @@ namespace RTC
 #endif
             RTC_PARANOID(("CDR data length: %d", cdr_data->length()));
 
-            onReceived(data);
-            onBufferWrite(data);
-
-            if (m_buffer->full())
-              {
-                RTC_INFO(("InPort buffer is full."));
-                onBufferFull(data);
-                onReceiverFull(data);
-              }
-            m_buffer->put(data);
-            m_buffer->advanceWptr();
-            m_buffer->advanceRptr();
+            writeSample(data);
 
             return DataPortStatus::PORT_OK;
           }
@@ -140,6 +130,79 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief 複数のデータを受信する
+   * @else
+   * @brief Receive several data
+   * @endif
+   */
+  DataPortStatus
+  OutPortCorbaCdrConsumer::getMany(std::vector<ByteData>& data,
+                                   size_t max_count, size_t max_bytes,
+                                   std::chrono::nanoseconds timeout)
+  {
+    RTC_TRACE(("OutPortCorbaCdrConsumer::getMany()"));
+    if (CORBA::is_nil(m_batchRef.in()))
+      {
+        // the OutPort does not implement get_many()
+        return OutPortConsumer::getMany(data, max_count, max_bytes, timeout);
+      }
+
+    ::OpenRTM::CdrData_var cdr_data;
+    try
+      {
+        ::OpenRTM::PortStatus ret(m_batchRef->get_many(
+          static_cast<CORBA::ULong>(max_count),
+          static_cast<CORBA::ULong>(max_bytes),
+          std::chrono::duration<double>(timeout).count(),
+          cdr_data.out()));
+
+        if (ret != ::OpenRTM::PORT_OK)
+          {
+            ByteData empty;
+            return convertReturn(ret, empty);
+          }
+
+#ifdef ORB_IS_ORBEXPRESS
+        const unsigned char* buffer(cdr_data.get_buffer());
+#elif defined(ORB_IS_TAO)
+        const unsigned char* buffer(cdr_data->get_buffer());
+#elif defined(ORB_IS_RTORB)
+        const unsigned char* buffer(reinterpret_cast<const unsigned char*>(&(cdr_data[0])));
+#else
+        const unsigned char* buffer(&(cdr_data[0]));
+#endif
+        unsigned long length(static_cast<CORBA::ULong>(cdr_data->length()));
+        RTC_PARANOID(("CDR data length: %d", length));
+
+        CdrBatch::Reader reader(buffer, length);
+        if (!reader.isValid())
+          {
+            RTC_ERROR(("get_many: malformed frame of %d bytes", length));
+            onSenderError();
+            return DataPortStatus::UNKNOWN_ERROR;
+          }
+
+        RTC_PARANOID(("received batch: %d samples", reader.count()));
+        const unsigned char* sample(nullptr);
+        unsigned long sample_length(0);
+        while (reader.next(sample, sample_length))
+          {
+            ByteData cdr;
+            cdr.writeData(sample, sample_length);
+            writeSample(cdr);
+            data.emplace_back(std::move(cdr));
+          }
+        return DataPortStatus::PORT_OK;
+      }
+    catch (...)
+      {
+        RTC_WARN(("Exception caought from OutPort::get_many()."));
+        return DataPortStatus::CONNECTION_LOST;
+      }
+  }
+
   /*!
    * @if jp
    * @brief データ受信通知への登録
@@ -173,6 +236,12 @@ namespace RTC
         if (ret)
           {
             RTC_DEBUG(("CorbaConsumer was set successfully."));
+            // get_many() is used only if the provider implements it
+            if (NVUtil::find_index(properties,
+                                   "dataport.corba_cdr.outport_batch") >= 0)
+              {
+                m_batchRef = ::OpenRTM::OutPortCdrBatch::_narrow(var.in());
+              }
           }
         else
           {
@@ -213,6 +282,7 @@ namespace RTC
         if (_ptr()->_is_equivalent(var))
           {
             releaseObject();
+            m_batchRef = ::OpenRTM::OutPortCdrBatch::_nil();
             RTC_DEBUG(("CorbaConsumer's reference was released."));
             return;
           }
@@ -227,6 +297,29 @@ namespace RTC
    * @brief Return codes conversion
    * @endif
    */
+  /*!
+   * @if jp
+   * @brief 受信したデータをバッファに書き込む
+   * @else
+   * @brief Write received data into the buffer
+   * @endif
+   */
+  void OutPortCorbaCdrConsumer::writeSample(ByteData& data)
+  {
+    onReceived(data);
+    onBufferWrite(data);
+
+    if (m_buffer->full())
+      {
+        RTC_INFO(("InPort buffer is full."));
+        onBufferFull(data);
+        onReceiverFull(data);
+      }
+    m_buffer->put(data);
+    m_buffer->advanceWptr();
+    m_buffer->advanceRptr();
+  }
+
   DataPortStatus
   OutPortCorbaCdrConsumer::convertReturn(::OpenRTM::PortStatus status,
                                          ByteData&  /*data*/)
@@ -214,6 +214,28 @@ namespace RTC
      */
     DataPortStatus get(ByteData& data) override;
 
+    /*!
+     * @if jp
+     * @brief 複数のデータを受信する
+     *
+     * 接続先の OutPort が "dataport.corba_cdr.outport_batch" を公開して
+     * いる場合は OpenRTM::OutPortCdrBatch::get_many() を1回呼び出して
+     * 受信する。公開していない場合は get() で1個受信する。
+     *
+     * @else
+     * @brief Receive several data
+     *
+     * If the OutPort published "dataport.corba_cdr.outport_batch", the
+     * data are received with a single call of
+     * OpenRTM::OutPortCdrBatch::get_many(). Otherwise one datum is
+     * received with get().
+     *
+     * @endif
+     */
+    DataPortStatus getMany(std::vector<ByteData>& data,
+                           size_t max_count, size_t max_bytes,
+                           std::chrono::nanoseconds timeout) override;
+
     /*!
      * @if jp
      * @brief データ受信通知への登録
@@ -268,6 +290,15 @@ namespace RTC
     DataPortStatus convertReturn(::OpenRTM::PortStatus status,
                                               ByteData& data);
 
+    /*!
+     * @if jp
+     * @brief 受信したデータをバッファに書き込む
+     * @else
+     * @brief Write received data into the buffer
+     * @endif
+     */
+    void writeSample(ByteData& data);
+
     /*!
      * @if jp
      * @brief ON_BUFFER_WRITE のリスナへ通知する。
@@ -362,6 +393,7 @@ namespace RTC
     CdrBufferBase* m_buffer;
     ConnectorListenersBase* m_listeners;
     ConnectorInfo m_profile;
+    ::OpenRTM::OutPortCdrBatch_var m_batchRef;
   };
 } // namespace RTC
 
@@ -18,6 +18,10 @@
  */
 
 #include <rtm/OutPortCorbaCdrProvider.h>
+#include <rtm/CdrBatch.h>
+
+#include <chrono>
+#include <vector>
 
 namespace RTC
 {
@@ -54,6 +58,10 @@ namespace RTC
     CORBA_SeqUtil::
       push_back(m_properties,
                 NVUtil::newNV("dataport.corba_cdr.outport_ref", m_objref));
+    // implements OutPortCdrBatch (see get_many())
+    CORBA_SeqUtil::
+      push_back(m_properties,
+                NVUtil::newNV("dataport.corba_cdr.outport_batch", "YES"));
   }
 
   /*!
@@ -193,6 +201,67 @@ namespace RTC
     return convertReturn(ret, m_cdr);
   }
 
+  /*!
+   * @if jp
+   * @brief [CORBA interface] バッファから複数のデータを取得する
+   * @else
+   * @brief [CORBA interface] Get several data from the buffer
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  OutPortCorbaCdrProvider::get_many(::CORBA::ULong max_count,
+                                    ::CORBA::ULong max_bytes,
+                                    ::CORBA::Double timeout,
+                                    ::OpenRTM::CdrData_out data)
+  {
+    RTC_PARANOID(("OutPortCorbaCdrProvider::get_many(%d, %d, %f)",
+                  max_count, max_bytes, timeout));
+    // at least the output "data" area should be allocated
+    data = new ::OpenRTM::CdrData();
+
+    if (m_connector == nullptr)
+      {
+        onSenderError();
+        return ::OpenRTM::UNKNOWN_ERROR;
+      }
+
+    // a negative or NaN timeout does not wait; a day is long enough
+    std::chrono::nanoseconds wait(std::chrono::nanoseconds::zero());
+    if (timeout > 0.0)
+      {
+        wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(timeout < 86400.0 ? timeout
+                                                          : 86400.0));
+      }
+
+    std::vector<ByteData> samples;
+    BufferStatus ret(m_connector->readMany(samples, max_count, max_bytes,
+                                           wait));
+    if (ret != BufferStatus::OK)
+      {
+        return convertReturn(ret, m_cdr);
+      }
+
+    std::vector<ByteData*> frame;
+    frame.reserve(samples.size());
+    for (auto & sample : samples)
+      {
+        onBufferRead(sample);
+        onSend(sample);
+        frame.push_back(&sample);
+      }
+    RTC_PARANOID(("get_many: %d samples", static_cast<int>(frame.size())));
+
+    CORBA::ULong len(static_cast<CORBA::ULong>(CdrBatch::length(frame)));
+    data->length(len);
+#ifndef ORB_IS_RTORB
+    CdrBatch::pack(frame, static_cast<unsigned char*>(data->get_buffer()));
+#else
+    CdrBatch::pack(frame, reinterpret_cast<unsigned char*>(&(*data)[0]));
+#endif  // ORB_IS_RTORB
+    return ::OpenRTM::PORT_OK;
+  }
+
   /*!
    * @if jp
    * @brief リターンコード変換
@@ -39,6 +39,8 @@ namespace RTC
    *
    * データ転送に CORBA の OpenRTM::OutPortCdr インターフェースを利用し
    * た、pull 型データフロー型を実現する OutPort プロバイダクラス。
+   * OpenRTM::OutPortCdrBatch の get_many() により、複数のデータを1回
+   * の呼び出しで取得することもできる。
    *
    * @since 0.4.0
    *
@@ -48,7 +50,8 @@ namespace RTC
    *
    * The OutPort provider class which uses the OpenRTM::OutPortCdr
    * interface in CORBA for data transfer and realizes a pull-type
-   * dataflow.
+   * dataflow. Several data can also be got with a single call by
+   * get_many() of OpenRTM::OutPortCdrBatch.
    *
    * @since 0.4.0
    *
@@ -56,7 +59,7 @@ namespace RTC
    */
   class OutPortCorbaCdrProvider
     : public OutPortProvider,
-      public virtual ::POA_OpenRTM::OutPortCdr,
+      public virtual ::POA_OpenRTM::OutPortCdrBatch,
       public virtual PortableServer::RefCountServantBase
   {
   public:
@@ -238,6 +241,40 @@ namespace RTC
      */
     ::OpenRTM::PortStatus get(::OpenRTM::CdrData_out data) override;
 
+    /*!
+     * @if jp
+     * @brief [CORBA interface] バッファから複数のデータを取得する
+     *
+     * バッファにあるデータを最大 max_count 個、max_bytes バイトまで取
+     * り出し、CdrBatch の形式でフレーム化して返す。バッファが空の場合
+     * は最大 timeout 秒の間、データの書き込みを待つ。
+     *
+     * @param max_count 最大個数。0 の場合は制限しない
+     * @param max_bytes 最大バイト数
+     * @param timeout バッファが空の場合の待ち時間 [s]
+     * @param data 取得データ
+     * @return リターンコード
+     *
+     * @else
+     * @brief [CORBA interface] Get several data from the buffer
+     *
+     * Takes up to max_count data of max_bytes from the buffer and
+     * returns them framed in the CdrBatch format. If the buffer is
+     * empty, waits up to timeout seconds for data to be written.
+     *
+     * @param max_count Maximum count. 0 means no limit
+     * @param max_bytes Maximum bytes
+     * @param timeout Time to wait if the buffer is empty [s]
+     * @param data Data got from the buffer
+     * @return Return code
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus get_many(::CORBA::ULong max_count,
+                                   ::CORBA::ULong max_bytes,
+                                   ::CORBA::Double timeout,
+                                   ::OpenRTM::CdrData_out data) override;
+
 
   private:
     /*!
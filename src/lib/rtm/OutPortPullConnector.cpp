@@ -50,6 +50,7 @@ namespace RTC
     if (m_provider == nullptr || m_buffer == nullptr) { throw std::bad_alloc(); }
 
     m_buffer->init(info.properties.getNode("buffer"));
+    m_data.setPool(m_pool);
     m_provider->setBuffer(m_buffer);
     m_provider->setConnector(this);
     m_provider->setListener(info, m_listeners);
@@ -59,9 +60,7 @@ namespace RTC
         m_sync_readwrite = true;
     }
 
-    std::string type{info.properties.getProperty("marshaling_type", "corba")};
-    m_marshaling_type = coil::eraseBothEndsBlank(
-      info.properties.getProperty("out.marshaling_type", type));
+    m_marshaling_type = m_profile.settings().outMarshalingType;
 
     onConnect();
   }
@@ -106,7 +105,15 @@ namespace RTC
         }
     }
 
-    m_buffer->write(*data);
+    m_data = *data;
+    m_buffer->write(m_data);
+
+    // readMany() waiting on an empty buffer
+    if (m_readwait.waiting_ != 0)
+      {
+        std::lock_guard<std::mutex> guard(m_readwait.mutex_);
+        m_readwait.cond_.notify_all();
+      }
 
     if (m_sync_readwrite)
     {
@@ -183,6 +190,75 @@ namespace RTC
       return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief バッファから複数のデータを読み出す
+   * @else
+   * @brief Read several data from the buffer
+   * @endif
+   */
+  BufferStatus
+  OutPortPullConnector::readMany(std::vector<ByteData>& data,
+                                 size_t max_count, size_t max_bytes,
+                                 std::chrono::nanoseconds timeout)
+  {
+      if (m_buffer == nullptr)
+      {
+          return BufferStatus::PRECONDITION_NOT_MET;
+      }
+      if (m_sync_readwrite)
+      {
+          return OutPortConnector::readMany(data, max_count, max_bytes,
+                                            timeout);
+      }
+
+      {
+        std::unique_lock<std::mutex> guard(m_readwait.mutex_);
+        if (m_readwait.closing_)
+          {
+            return BufferStatus::PRECONDITION_NOT_MET;
+          }
+        ++m_readwait.readers_;
+        if (timeout > std::chrono::nanoseconds::zero() &&
+            m_buffer->readable() == 0)
+          {
+            ++m_readwait.waiting_;
+            m_readwait.cond_.wait_for(guard, timeout, [this] {
+                return m_readwait.closing_ || m_buffer->readable() > 0;
+              });
+            --m_readwait.waiting_;
+          }
+      }
+
+      // The samples are taken in place and the read pointer is advanced
+      // once. The copies share the data of the buffer.
+      std::unique_lock<std::mutex> read_guard(m_readwait.read_);
+      size_t readable(m_buffer->readable());
+      size_t bytes(0);
+      size_t count(0);
+      for (; count < readable && (max_count == 0 || count < max_count);
+           ++count)
+        {
+          ByteData* cdr(m_buffer->rptr(static_cast<long int>(count)));
+          size_t len(cdr->getDataLength());
+          if (count != 0 && bytes + len > max_bytes) { break; }
+          bytes += len;
+          data.push_back(*cdr);
+        }
+      if (count != 0)
+        {
+          m_buffer->advanceRptr(static_cast<long int>(count));
+        }
+      read_guard.unlock();
+
+      {
+        std::lock_guard<std::mutex> guard(m_readwait.mutex_);
+        --m_readwait.readers_;
+        if (m_readwait.closing_) { m_readwait.cond_.notify_all(); }
+      }
+      return count != 0 ? BufferStatus::OK : BufferStatus::EMPTY;
+  }
+
   /*!
    * @if jp
    * @brief 接続解除関数
@@ -193,6 +269,16 @@ namespace RTC
   DataPortStatus OutPortPullConnector::disconnect()
   {
     RTC_TRACE(("disconnect()"));
+    // wake up and wait for readMany() calls before the buffer goes away
+    {
+      std::unique_lock<std::mutex> guard(m_readwait.mutex_);
+      m_readwait.closing_ = true;
+      m_readwait.cond_.notify_all();
+      m_readwait.cond_.wait(guard, [this] {
+          return m_readwait.readers_ == 0;
+        });
+    }
+
     // delete provider
     if (m_provider != nullptr)
       {
@@ -23,6 +23,10 @@
 #include <rtm/OutPortConnector.h>
 #include <rtm/ConnectorListener.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 namespace RTC
 {
   class OutPortProvider;
@@ -165,6 +169,27 @@ namespace RTC
 
     BufferStatus read(ByteData &data) override;
 
+    /*!
+     * @if jp
+     * @brief バッファから複数のデータを読み出す
+     *
+     * バッファが空の場合は write() によるデータの書き込み、または接続
+     * 解除まで最大 timeout の間待つ。sync_readwrite が有効な場合は、
+     * 1回の書き込みに対して1回の読み出しを行うため1個ずつ読み出す。
+     *
+     * @else
+     * @brief Read several data from the buffer
+     *
+     * If the buffer is empty, waits up to timeout until data is written
+     * by write() or the connector is disconnected. With sync_readwrite,
+     * where each write is handed to one read, data is read one by one.
+     *
+     * @endif
+     */
+    BufferStatus readMany(std::vector<ByteData>& data,
+                          size_t max_count, size_t max_bytes,
+                          std::chrono::nanoseconds timeout) override;
+
     /*!
      * @if jp
      * @brief 接続解除
@@ -283,6 +308,14 @@ namespace RTC
      * @endif
      */
     CdrBufferBase* m_buffer;
+    /*!
+     * @if jp
+     * @brief バッファに書き込むデータ
+     * @else
+     * @brief The data written to the buffer
+     * @endif
+     */
+    ByteData m_data;
   private:
       bool m_sync_readwrite;
 
@@ -297,6 +330,20 @@ namespace RTC
       WorkerThreadCtrl m_readcompleted_worker;
       WorkerThreadCtrl m_readready_worker;
 
+      // readMany() waiting for write() or disconnect()
+      struct ReadWaitCtrl
+      {
+          ReadWaitCtrl() {}
+          std::mutex mutex_;
+          std::condition_variable cond_;
+          std::atomic<int> waiting_{0};
+          int readers_{0};
+          bool closing_{false};
+          // serializes the peek and advance of concurrent readMany()
+          std::mutex read_;
+      };
+      ReadWaitCtrl m_readwait;
+
   };
 } // namespace RTC
 
@@ -58,10 +58,10 @@ namespace RTC
 
     m_publisher->setConsumer(m_consumer);
     m_publisher->setBuffer(m_buffer);
+    m_publisher->setMemoryPool(m_pool);
     m_publisher->setListener(m_profile, m_listeners);
 
-    std::string type{info.properties.getProperty("marshaling_type", "corba")};
-    m_marshaling_type = coil::eraseBothEndsBlank(info.properties.getProperty("out.marshaling_type", type));
+    m_marshaling_type = m_profile.settings().outMarshalingType;
 
     onConnect();
   }
@@ -105,6 +105,14 @@ namespace RTC
   DataPortStatus OutPortPushConnector::disconnect()
   {
     RTC_TRACE(("disconnect()"));
+    if (m_pool && m_publisher != nullptr)
+      {
+        ByteDataPool::Statistics stats(m_pool->getStatistics());
+        RTC_DEBUG(("memory pool: allocated %llu, reused %llu, peak %llu bytes",
+                   static_cast<unsigned long long>(stats.allocations),
+                   static_cast<unsigned long long>(stats.reuses),
+                   static_cast<unsigned long long>(stats.peakUsedBytes)));
+      }
     // delete publisher
     if (m_publisher != nullptr)
       {
@@ -0,0 +1,724 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ParallelPeriodicEC.cpp
+ * @brief Periodic ExecutionContext running RTCs in parallel
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ParallelPeriodicEC.h>
+#include <rtm/RTObjectStateMachine.h>
+#include <rtm/RTObject.h>
+#include <rtm/Manager.h>
+#include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
+
+#include <algorithm>
+#include <string>
+
+namespace RTC_exp
+{
+  namespace
+  {
+    /*!
+     * @if jp
+     * @brief 依存グラフの作成を依頼する接続リスナ
+     * @else
+     * @brief Connection listener requesting the dependency graph
+     * @endif
+     */
+    template <class Request>
+    class GraphListener
+      : public RTC::PortConnectRetListener
+    {
+    public:
+      explicit GraphListener(std::shared_ptr<Request> request)
+        : m_request(std::move(request))
+      {
+      }
+      void operator()(const char* /*portname*/,
+                      RTC::ConnectorProfile& /*profile*/,
+                      RTC::ReturnCode_t /*ret*/) override
+      {
+        std::lock_guard<std::mutex> guard(m_request->mutex);
+        m_request->dirty = true;
+        m_request->cond.notify_all();
+      }
+    private:
+      std::shared_ptr<Request> m_request;
+    };
+
+    RTC::RTObject_impl* getServant(RTC::LightweightRTObject_ptr rtobj)
+    {
+#ifndef ORB_IS_RTORB
+      try
+        {
+          PortableServer::POA_var poa = ::RTC::Manager::instance().getPOA();
+          return dynamic_cast<RTC::RTObject_impl*>(
+                   poa->reference_to_servant(rtobj));
+        }
+      catch (...)
+        {
+        }
+#endif
+      return nullptr;
+    }
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief デフォルトコンストラクタ
+   * @else
+   * @brief Default constructor
+   * @endif
+   */
+  ParallelPeriodicEC::ParallelPeriodicEC()
+    : PeriodicExecutionContext(),
+      m_request(std::make_shared<GraphRequest>())
+  {
+    RTC_TRACE(("ParallelPeriodicEC()"));
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  ParallelPeriodicEC::~ParallelPeriodicEC()
+  {
+    RTC_TRACE(("~ParallelPeriodicEC()"));
+  }
+
+  void ParallelPeriodicEC::init(coil::Properties& props)
+  {
+    RTC_TRACE(("init()"));
+    PeriodicExecutionContext::init(props);
+
+    getProperty(props, "parallel.threads", m_threadCount);
+    std::string dependency(coil::normalize(
+                             props.getProperty("parallel.dependency",
+                                               "dataport")));
+    m_dependency = (dependency != "none");
+    double interval(0.0);
+    if (coil::stringTo(interval,
+                       props.getProperty("parallel.dependency_update").c_str())
+        && interval > 0.0)
+      {
+        m_updateInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::duration<double>(interval));
+      }
+    RTC_DEBUG(("threads: %d, dependency: %s",
+               m_threadCount, m_dependency ? "dataport" : "none"));
+  }
+
+  /*!
+   * @if jp
+   * @brief onAddedComponent() テンプレート関数
+   * @else
+   * @brief onAddedComponent() template function
+   * @endif
+   */
+  RTC::ReturnCode_t ParallelPeriodicEC::
+  onAddedComponent(RTC::LightweightRTObject_ptr rtobj)
+  {
+    RTC::ReturnCode_t ret(PeriodicExecutionContext::onAddedComponent(rtobj));
+    if (ret != RTC::RTC_OK || !m_dependency) { return ret; }
+
+    RTC::RTObject_impl* servant(getServant(rtobj));
+    if (servant == nullptr)
+      {
+        RTC_DEBUG(("RTC is not in this process. Its connection changes are "
+                   "followed only by parallel.dependency_update."));
+        return ret;
+      }
+    Listeners listeners;
+    listeners.rtobj = servant;
+    listeners.connected = new GraphListener<GraphRequest>(m_request);
+    listeners.disconnected = new GraphListener<GraphRequest>(m_request);
+    servant->addPortConnectRetListener(RTC::ON_CONNECTED,
+                                       listeners.connected);
+    servant->addPortConnectRetListener(RTC::ON_DISCONNECTED,
+                                       listeners.disconnected);
+    std::lock_guard<std::mutex> guard(m_listenerMutex);
+    m_listeners.emplace_back(listeners);
+    return ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief onRemovedComponent() テンプレート関数
+   * @else
+   * @brief onRemovedComponent() template function
+   * @endif
+   */
+  RTC::ReturnCode_t ParallelPeriodicEC::
+  onRemovedComponent(RTC::LightweightRTObject_ptr rtobj)
+  {
+    RTC::RTObject_impl* servant(getServant(rtobj));
+    if (servant != nullptr)
+      {
+        std::lock_guard<std::mutex> guard(m_listenerMutex);
+        auto it = std::find_if(m_listeners.begin(), m_listeners.end(),
+                               [servant](const Listeners& l) {
+                                 return l.rtobj == servant;
+                               });
+        if (it != m_listeners.end())
+          {
+            servant->removePortConnectRetListener(RTC::ON_CONNECTED,
+                                                  it->connected);
+            servant->removePortConnectRetListener(RTC::ON_DISCONNECTED,
+                                                  it->disconnected);
+            m_listeners.erase(it);
+          }
+      }
+    return PeriodicExecutionContext::onRemovedComponent(rtobj);
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext 用のスレッド実行関数
+   * @else
+   * @brief Thread execution function for ExecutionContext
+   * @endif
+   */
+  int ParallelPeriodicEC::svc()
+  {
+    RTC_TRACE(("svc()"));
+
+    // pool threads are created here and inherit the CPU affinity
+    if (!m_cpu.empty() && !coil::setThreadCpuAffinity(m_cpu))
+      {
+        RTC_ERROR(("setThreadCpuAffinity():"
+                   "CPU affinity mask setting failed"));
+      }
+    startWorkers();
+
+    const RTC_impl::ExecutionContextWorker::Dispatcher dispatcher(
+      [this](const std::vector<RTC_impl::RTObjectStateMachine*>& comps)
+      {
+        dispatch(comps);
+      });
+    do
+      {
+        ExecutionContextBase::invokeWorkerPreDo();
+        // Thread will stopped when all RTCs are INACTIVE.
+        // Therefore WorkerPreDo(updating state) have to be invoked
+        // before stopping thread.
+        {
+          std::unique_lock<std::mutex> guard(m_workerthread.mutex_);
+          while (!m_workerthread.running_)
+            {
+              m_workerthread.cond_.wait(guard);
+            }
+        }
+        auto t0 = std::chrono::high_resolution_clock::now();
+        ExecutionContextBase::invokeWorkerDo(dispatcher);
+        ExecutionContextBase::invokeWorkerPostDo();
+        if (!m_nowait)
+          {
+            std::this_thread::sleep_until(t0 + getPeriod());
+          }
+      } while (threadRunning());
+
+    stopWorkers();
+    RTC_DEBUG(("Thread terminated."));
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief スレッドプールを起動する
+   * @else
+   * @brief Start the thread pool
+   * @endif
+   */
+  void ParallelPeriodicEC::startWorkers()
+  {
+    size_t count(m_threadCount);
+    if (count == 0)
+      {
+        unsigned int hw(std::thread::hardware_concurrency());
+        count = hw > 1 ? hw - 1 : 0;
+      }
+    m_terminate = false;
+    m_queues.clear();
+    // queue 0 belongs to the EC thread itself
+    for (size_t i(0); i <= count; ++i)
+      {
+        m_queues.emplace_back(new TaskQueue());
+      }
+    for (size_t i(1); i <= count; ++i)
+      {
+        m_threads.emplace_back([this, i] { workerLoop(i); });
+      }
+    RTC_DEBUG(("%d worker threads started.", count));
+
+    if (m_dependency)
+      {
+        {
+          std::lock_guard<std::mutex> guard(m_request->mutex);
+          m_request->terminate = false;
+        }
+        m_graphThread = std::thread([this] { graphLoop(); });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief スレッドプールを停止する
+   * @else
+   * @brief Stop the thread pool
+   * @endif
+   */
+  void ParallelPeriodicEC::stopWorkers()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_poolMutex);
+      m_terminate = true;
+      m_poolCond.notify_all();
+    }
+    for (auto & thread : m_threads)
+      {
+        thread.join();
+      }
+    m_threads.clear();
+
+    if (m_graphThread.joinable())
+      {
+        {
+          std::lock_guard<std::mutex> guard(m_request->mutex);
+          m_request->terminate = true;
+          m_request->cond.notify_all();
+        }
+        m_graphThread.join();
+      }
+  }
+
+  void ParallelPeriodicEC::workerLoop(size_t self)
+  {
+    size_t task(0);
+    for (;;)
+      {
+        if (popTask(self, task))
+          {
+            runTask(self, task);
+            continue;
+          }
+        std::unique_lock<std::mutex> guard(m_poolMutex);
+        ++m_sleepers;
+        m_poolCond.wait(guard, [this] {
+            return m_terminate || m_queued.load() > 0;
+          });
+        --m_sleepers;
+        if (m_terminate) { return; }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 1周期分の on_execute を並列に実行する
+   *
+   * 依存のない RTC を各スレッドのキューに振り分け、EC のスレッド自
+   * 身も実行に加わる。全ての RTC の実行が完了するまで戻らない。
+   *
+   * @else
+   * @brief Run on_execute of one period in parallel
+   *
+   * RTCs without dependencies are distributed over the queues of the
+   * threads and the EC thread takes part in the execution itself.
+   * Returns only after all RTCs have been executed.
+   *
+   * @endif
+   */
+  void ParallelPeriodicEC::
+  dispatch(const std::vector<RTC_impl::RTObjectStateMachine*>& comps)
+  {
+    if (comps.empty()) { return; }
+    updateGraph(comps);
+
+    const std::vector<Node>& nodes(m_current->nodes);
+    m_remaining.store(nodes.size());
+    for (size_t i(0); i < nodes.size(); ++i)
+      {
+        m_pending[i].store(nodes[i].indegree, std::memory_order_relaxed);
+      }
+    size_t next(0);
+    for (size_t i(0); i < nodes.size(); ++i)
+      {
+        if (nodes[i].indegree != 0) { continue; }
+        pushTask(next % m_queues.size(), i);
+        ++next;
+      }
+    if (m_sleepers.load() > 0)
+      {
+        std::lock_guard<std::mutex> guard(m_poolMutex);
+        m_poolCond.notify_all();
+      }
+
+    size_t task(0);
+    while (m_remaining.load() > 0)
+      {
+        if (popTask(0, task))
+          {
+            runTask(0, task);
+            continue;
+          }
+        std::unique_lock<std::mutex> guard(m_poolMutex);
+        ++m_sleepers;
+        m_poolCond.wait(guard, [this] {
+            return m_queued.load() > 0 || m_remaining.load() == 0;
+          });
+        --m_sleepers;
+      }
+  }
+
+  void ParallelPeriodicEC::pushTask(size_t self, size_t task)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_queues[self]->mutex);
+      m_queues[self]->tasks.push_back(task);
+    }
+    ++m_queued;
+  }
+
+  bool ParallelPeriodicEC::popTask(size_t self, size_t& task)
+  {
+    {
+      TaskQueue& own(*m_queues[self]);
+      std::lock_guard<std::mutex> guard(own.mutex);
+      if (!own.tasks.empty())
+        {
+          task = own.tasks.back();
+          own.tasks.pop_back();
+          --m_queued;
+          return true;
+        }
+    }
+    for (size_t i(1); i < m_queues.size(); ++i)
+      {
+        TaskQueue& victim(*m_queues[(self + i) % m_queues.size()]);
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (!victim.tasks.empty())
+          {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            --m_queued;
+            return true;
+          }
+      }
+    return false;
+  }
+
+  void ParallelPeriodicEC::runTask(size_t self, size_t task)
+  {
+    const Node& node(m_current->nodes[task]);
+    ExecutionContextBase::invokeWorkerDo(node.comp);
+
+    bool pushed(false);
+    for (auto succ : node.successors)
+      {
+        if (m_pending[succ].fetch_sub(1) == 1)
+          {
+            pushTask(self, succ);
+            pushed = true;
+          }
+      }
+    if (pushed && m_sleepers.load() > 0)
+      {
+        std::lock_guard<std::mutex> guard(m_poolMutex);
+        m_poolCond.notify_all();
+      }
+    if (m_remaining.fetch_sub(1) == 1)
+      {
+        std::lock_guard<std::mutex> guard(m_poolMutex);
+        m_poolCond.notify_all();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 現在の参加者リストに合う依存グラフを選ぶ
+   *
+   * グラフスレッドが作ったグラフが参加者リストと一致すればそれに切
+   * り替える。参加者が変わった場合は作成を依頼し、それまでは依存関
+   * 係のないグラフを使う。リモート呼び出しは行わない。
+   *
+   * @else
+   * @brief Select the dependency graph matching the participants
+   *
+   * Switches to the graph built by the graph thread if it matches the
+   * participant list. When the participants have changed, a new graph
+   * is requested and one without dependencies is used meanwhile. No
+   * remote calls are made.
+   *
+   * @endif
+   */
+  void ParallelPeriodicEC::
+  updateGraph(const std::vector<RTC_impl::RTObjectStateMachine*>& comps)
+  {
+    std::shared_ptr<const Graph> graph(std::atomic_load(&m_graph));
+    if (graph && graph->comps == comps)
+      {
+        m_current = std::move(graph);
+      }
+    else if (!m_current || m_current->comps != comps)
+      {
+        m_current = requestGraph(comps);
+      }
+    if (m_current->nodes.size() != m_pendingSize)
+      {
+        m_pendingSize = m_current->nodes.size();
+        m_pending.reset(new std::atomic<size_t>[m_pendingSize]);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 依存グラフの作成を依頼する
+   *
+   * 依存関係のないグラフを返す。
+   *
+   * @else
+   * @brief Request the dependency graph to be built
+   *
+   * Returns a graph without dependencies.
+   *
+   * @endif
+   */
+  std::shared_ptr<const ParallelPeriodicEC::Graph> ParallelPeriodicEC::
+  requestGraph(const std::vector<RTC_impl::RTObjectStateMachine*>& comps)
+  {
+    RTC_TRACE(("requestGraph()"));
+    std::shared_ptr<Graph> graph(std::make_shared<Graph>());
+    graph->comps = comps;
+    graph->nodes.resize(comps.size());
+    for (size_t i(0); i < comps.size(); ++i)
+      {
+        graph->nodes[i].comp = comps[i];
+      }
+    if (!m_dependency) { return graph; }
+
+    // the graph thread must not touch the state machines, which are
+    // deleted by the EC thread
+    std::vector<RTC::LightweightRTObject_var> objs;
+    for (auto comp : comps)
+      {
+        objs.emplace_back(comp->getRTObject());
+      }
+    std::lock_guard<std::mutex> guard(m_request->mutex);
+    m_request->comps = comps;
+    m_request->objs = std::move(objs);
+    m_request->dirty = true;
+    m_request->cond.notify_all();
+    return graph;
+  }
+
+  /*!
+   * @if jp
+   * @brief 依存グラフを作るスレッドの実行関数
+   *
+   * 作成を依頼されるか parallel.dependency_update 秒経過するごとに、
+   * 最後に依頼された参加者リストの依存グラフを作って差し替える。
+   *
+   * @else
+   * @brief Thread function building the dependency graph
+   *
+   * Whenever a graph is requested or parallel.dependency_update
+   * seconds have passed, the graph for the participant list requested
+   * last is built and swapped in.
+   *
+   * @endif
+   */
+  void ParallelPeriodicEC::graphLoop()
+  {
+    std::unique_lock<std::mutex> guard(m_request->mutex);
+    while (!m_request->terminate)
+      {
+        if (!m_request->dirty)
+          {
+            if (m_updateInterval.count() == 0)
+              {
+                m_request->cond.wait(guard);
+              }
+            else if (m_request->cond.wait_for(guard, m_updateInterval)
+                     == std::cv_status::timeout)
+              {
+                m_request->dirty = !m_request->objs.empty();
+              }
+            continue;
+          }
+        m_request->dirty = false;
+        std::shared_ptr<Graph> graph(std::make_shared<Graph>());
+        graph->comps = m_request->comps;
+        std::vector<RTC::LightweightRTObject_var> objs(m_request->objs);
+        guard.unlock();
+
+        RTC_TRACE(("Building the dependency graph."));
+        graph->nodes.resize(graph->comps.size());
+        for (size_t i(0); i < graph->comps.size(); ++i)
+          {
+            graph->nodes[i].comp = graph->comps[i];
+          }
+        addDataPortEdges(*graph, objs);
+        breakCycles(*graph);
+        std::atomic_store(&m_graph, std::shared_ptr<const Graph>(graph));
+
+        guard.lock();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief データポート接続から依存関係を追加する
+   *
+   * 各 RTC の OutPort の接続先ポートの所有者がこの EC の参加者であ
+   * れば、OutPort 側から InPort 側への辺を追加する。
+   *
+   * @else
+   * @brief Add dependencies from data port connections
+   *
+   * For each OutPort of each RTC, an edge to the owner of each peer
+   * port is added if that owner participates in this EC.
+   *
+   * @endif
+   */
+  void ParallelPeriodicEC::
+  addDataPortEdges(Graph& graph,
+                   const std::vector<RTC::LightweightRTObject_var>& objs)
+  {
+    std::vector<Node>& nodes(graph.nodes);
+    for (size_t i(0); i < nodes.size(); ++i)
+      {
+        RTC::RTObject_var rtobj = RTC::RTObject::_narrow(objs[i].in());
+        if (CORBA::is_nil(rtobj)) { continue; }
+        try
+          {
+            RTC::PortServiceList_var ports = rtobj->get_ports();
+            for (CORBA::ULong p(0); p < ports->length(); ++p)
+              {
+                RTC::PortProfile_var prof = ports[p]->get_port_profile();
+                if (NVUtil::toString(prof->properties, "port.port_type")
+                    != "DataOutPort")
+                  {
+                    continue;
+                  }
+                for (CORBA::ULong c(0); c < prof->connector_profiles.length(); ++c)
+                  {
+                    const RTC::PortServiceList&
+                      peers(prof->connector_profiles[c].ports);
+                    for (CORBA::ULong k(0); k < peers.length(); ++k)
+                      {
+                        if (peers[k]->_is_equivalent(ports[p])) { continue; }
+                        RTC::PortProfile_var peer = peers[k]->get_port_profile();
+                        for (size_t j(0); j < nodes.size(); ++j)
+                          {
+                            if (j == i ||
+                                !objs[j]->_is_equivalent(peer->owner))
+                              {
+                                continue;
+                              }
+                            std::vector<size_t>& succ(nodes[i].successors);
+                            if (std::find(succ.begin(), succ.end(), j)
+                                == succ.end())
+                              {
+                                succ.emplace_back(j);
+                                ++nodes[j].indegree;
+                              }
+                          }
+                      }
+                  }
+              }
+          }
+        catch (CORBA::SystemException&)
+          {
+            RTC_WARN(("Getting port profiles failed."));
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 依存グラフの循環を取り除く
+   *
+   * トポロジカルソートで残った RTC の間では、参加者リストで後ろにあ
+   * る RTC から前にある RTC への辺を削除する。
+   *
+   * @else
+   * @brief Remove cycles from the dependency graph
+   *
+   * Among the RTCs left over by the topological sort, edges from an RTC
+   * to one earlier in the participant list are removed.
+   *
+   * @endif
+   */
+  void ParallelPeriodicEC::breakCycles(Graph& graph)
+  {
+    std::vector<Node>& nodes(graph.nodes);
+    std::vector<size_t> indegree(nodes.size());
+    std::vector<size_t> ready;
+    for (size_t i(0); i < nodes.size(); ++i)
+      {
+        indegree[i] = nodes[i].indegree;
+        if (indegree[i] == 0) { ready.emplace_back(i); }
+      }
+    std::vector<bool> sorted(nodes.size(), false);
+    size_t count(0);
+    while (!ready.empty())
+      {
+        size_t i(ready.back());
+        ready.pop_back();
+        sorted[i] = true;
+        ++count;
+        for (auto succ : nodes[i].successors)
+          {
+            if (--indegree[succ] == 0) { ready.emplace_back(succ); }
+          }
+      }
+    if (count == nodes.size()) { return; }
+
+    RTC_DEBUG(("Data port connections form a cycle. "
+               "The participant order is used within the cycle."));
+    for (size_t i(0); i < nodes.size(); ++i)
+      {
+        if (sorted[i]) { continue; }
+        std::vector<size_t>& succ(nodes[i].successors);
+        auto last = std::remove_if(succ.begin(), succ.end(),
+                                   [&](size_t j) {
+                                     if (sorted[j] || j > i) { return false; }
+                                     --nodes[j].indegree;
+                                     return true;
+                                   });
+        succ.erase(last, succ.end());
+      }
+  }
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void ParallelPeriodicECInit(RTC::Manager*  /*manager*/)
+  {
+    RTC::ExecutionContextFactory::
+      instance().addFactory("ParallelPeriodicEC",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::ParallelPeriodicEC>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::ParallelPeriodicEC>);
+  }
+}
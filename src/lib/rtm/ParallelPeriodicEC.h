@@ -0,0 +1,313 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ParallelPeriodicEC.h
+ * @brief Periodic ExecutionContext running RTCs in parallel
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_PARALLELPERIODICEC_H
+#define RTC_PARALLELPERIODICEC_H
+
+#include <rtm/PeriodicExecutionContext.h>
+#include <rtm/PortConnectListener.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @class ParallelPeriodicEC
+   * @brief 参加 RTC を並列に実行する周期実行 ExecutionContext
+   *
+   * PeriodicExecutionContext と同じ周期で動作し、1周期内で参加して
+   * いる全 RTC の on_execute をワークスティーリング型のスレッドプー
+   * ルで並列に実行する。全 RTC の実行が完了するまで周期の終わりで待
+   * 機し (バリア)、その後 on_state_update を逐次実行する。
+   *
+   * parallel.dependency が dataport の場合、同じ EC に参加している
+   * RTC 間のデータポート接続から依存グラフを作り、OutPort 側の RTC
+   * の on_execute が完了してから InPort 側の RTC を実行する。接続が
+   * 循環している場合、循環内では参加者リストの順序に従う。依存グラフ
+   * は参加者が変わったときと、同じプロセス内の参加 RTC のポートが接
+   * 続・切断されたときに、EC とは別のスレッドで作り直して差し替える。
+   * 新しいグラフができるまでの周期は依存関係なしで実行する。
+   *
+   * プロパティ:
+   * - parallel.threads: EC のスレッドに加えて使うスレッド数。0 の場
+   *   合はハードウェアスレッド数 - 1 (デフォルト: 0)
+   * - parallel.dependency: dataport, none (デフォルト: dataport)
+   * - parallel.dependency_update: 他のプロセスの RTC の接続変更を反
+   *   映するための依存グラフの更新間隔 [s]。0 の場合は定期的には更新
+   *   しない (デフォルト: 0)
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class ParallelPeriodicEC
+   * @brief Periodic ExecutionContext running RTCs in parallel
+   *
+   * Runs at the same period as PeriodicExecutionContext, but executes
+   * on_execute of all participating RTCs in parallel within one period
+   * on a work-stealing thread pool. The EC waits at the end of the
+   * period until all RTCs have finished (a barrier) and then runs
+   * on_state_update sequentially.
+   *
+   * With parallel.dependency set to dataport, a dependency graph is
+   * built from the data port connections between RTCs participating in
+   * this EC, and an RTC on the InPort side runs only after on_execute
+   * of the RTC on the OutPort side has completed. Within a cycle of
+   * connections, the order of the participant list is used. The graph
+   * is rebuilt on a thread other than the EC thread and swapped in when
+   * the participants change and when a port of a participating RTC in
+   * this process is connected or disconnected. Periods until the new
+   * graph is ready run without dependencies.
+   *
+   * Properties:
+   * - parallel.threads: Number of threads used in addition to the EC
+   *   thread. 0 means the number of hardware threads - 1 (default: 0)
+   * - parallel.dependency: dataport, none (default: dataport)
+   * - parallel.dependency_update: Update interval of the dependency
+   *   graph [s] to follow connection changes of RTCs in other
+   *   processes. 0 disables periodic updates (default: 0)
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class ParallelPeriodicEC
+    : public virtual RTC_exp::PeriodicExecutionContext
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief デフォルトコンストラクタ
+     * @else
+     * @brief Default Constructor
+     * @endif
+     */
+    ParallelPeriodicEC();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~ParallelPeriodicEC() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextの初期化を行う
+     * @else
+     * @brief Initialize the ExecutionContext
+     * @endif
+     */
+    void init(coil::Properties& props) override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext 用のスレッド実行関数
+     *
+     * スレッドプールを起動し、周期ごとに全 RTC の on_execute を並列
+     * に実行する。スレッドプールはこの関数の終了時に停止する。
+     *
+     * @else
+     * @brief Thread execution function for ExecutionContext
+     *
+     * Starts the thread pool and runs on_execute of all RTCs in
+     * parallel every period. The pool is stopped when this function
+     * returns.
+     *
+     * @endif
+     */
+    int svc() override;
+
+  protected:
+    /*!
+     * @if jp
+     * @brief onAddedComponent() テンプレート関数
+     *
+     * RTC が同じプロセス内にあれば、ポートの接続・切断で依存グラフを
+     * 作り直すためのリスナを登録する。
+     *
+     * @else
+     * @brief onAddedComponent() template function
+     *
+     * If the RTC is in this process, listeners are added to rebuild
+     * the dependency graph when its ports are connected or
+     * disconnected.
+     *
+     * @endif
+     */
+    RTC::ReturnCode_t
+    onAddedComponent(RTC::LightweightRTObject_ptr rtobj) override;
+
+    /*!
+     * @if jp
+     * @brief onRemovedComponent() テンプレート関数
+     * @else
+     * @brief onRemovedComponent() template function
+     * @endif
+     */
+    RTC::ReturnCode_t
+    onRemovedComponent(RTC::LightweightRTObject_ptr rtobj) override;
+
+    /*!
+     * @if jp
+     * @brief 依存グラフのノード
+     * @else
+     * @brief Node of the dependency graph
+     * @endif
+     */
+    struct Node
+    {
+      RTC_impl::RTObjectStateMachine* comp{nullptr};
+      std::vector<size_t> successors;
+      size_t indegree{0};
+    };
+
+    /*!
+     * @if jp
+     * @brief 依存グラフ
+     *
+     * 作成後は変更しない。comps は作成を依頼したときの参加者リストで
+     * あり、EC のスレッドは現在の参加者リストと一致する場合だけ使う。
+     *
+     * @else
+     * @brief Dependency graph
+     *
+     * Not modified once built. comps is the participant list the graph
+     * was requested for, and the EC thread uses the graph only while
+     * it matches the current participant list.
+     *
+     * @endif
+     */
+    struct Graph
+    {
+      std::vector<RTC_impl::RTObjectStateMachine*> comps;
+      std::vector<Node> nodes;
+    };
+
+    /*!
+     * @if jp
+     * @brief 依存グラフの作成依頼
+     *
+     * ポートの接続リスナと共有する。
+     *
+     * @else
+     * @brief Request to build the dependency graph
+     *
+     * Shared with the port connection listeners.
+     *
+     * @endif
+     */
+    struct GraphRequest
+    {
+      std::mutex mutex;
+      std::condition_variable cond;
+      std::vector<RTC_impl::RTObjectStateMachine*> comps;
+      std::vector<RTC::LightweightRTObject_var> objs;
+      bool dirty{false};
+      bool terminate{false};
+    };
+
+    /*!
+     * @if jp
+     * @brief スレッドごとの実行可能タスクのキュー
+     *
+     * 所有スレッドは末尾から、他のスレッドは先頭から取り出す。
+     *
+     * @else
+     * @brief Per-thread queue of runnable tasks
+     *
+     * The owner takes from the back and other threads steal from the
+     * front.
+     *
+     * @endif
+     */
+    struct TaskQueue
+    {
+      std::mutex mutex;
+      std::deque<size_t> tasks;
+    };
+
+    void startWorkers();
+    void stopWorkers();
+    void workerLoop(size_t self);
+    void dispatch(const std::vector<RTC_impl::RTObjectStateMachine*>& comps);
+    void pushTask(size_t self, size_t task);
+    bool popTask(size_t self, size_t& task);
+    void runTask(size_t self, size_t task);
+
+    void updateGraph(const std::vector<RTC_impl::RTObjectStateMachine*>& comps);
+    std::shared_ptr<const Graph>
+    requestGraph(const std::vector<RTC_impl::RTObjectStateMachine*>& comps);
+    void graphLoop();
+    void addDataPortEdges(Graph& graph,
+                          const std::vector<RTC::LightweightRTObject_var>& objs);
+    void breakCycles(Graph& graph);
+
+    size_t m_threadCount{0};
+    bool m_dependency{true};
+    std::chrono::nanoseconds m_updateInterval{0};
+
+    // m_graph is swapped by the graph thread, the others are used by
+    // the EC thread and the pool threads only
+    std::shared_ptr<const Graph> m_graph;
+    std::shared_ptr<const Graph> m_current;
+    std::unique_ptr<std::atomic<size_t>[]> m_pending;
+    size_t m_pendingSize{0};
+
+    std::shared_ptr<GraphRequest> m_request;
+    std::thread m_graphThread;
+    std::mutex m_listenerMutex;
+    struct Listeners
+    {
+      RTC::RTObject_impl* rtobj;
+      RTC::PortConnectRetListener* connected;
+      RTC::PortConnectRetListener* disconnected;
+    };
+    std::vector<Listeners> m_listeners;
+
+    std::vector<std::unique_ptr<TaskQueue> > m_queues;
+    std::vector<std::thread> m_threads;
+    std::mutex m_poolMutex;
+    std::condition_variable m_poolCond;
+    std::atomic<size_t> m_queued{0};
+    std::atomic<size_t> m_remaining{0};
+    std::atomic<size_t> m_sleepers{0};
+    bool m_terminate{false};
+  };  // class ParallelPeriodicEC
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void ParallelPeriodicECInit(RTC::Manager* manager);
+}
+
+#endif  // RTC_PARALLELPERIODICEC_H
@@ -27,6 +27,8 @@
 #include <rtm/DataPortStatus.h>
 #include <rtm/ByteDataStreamBase.h>
 
+#include <memory>
+
 
 namespace coil
 {
@@ -37,6 +39,7 @@ namespace RTC
   class InPortConsumer;
   class ConnectorListenersBase;
   class ConnectorInfo;
+  class ByteDataPool;
 
   /*!
    * @if jp
@@ -161,6 +164,27 @@ namespace RTC
      */
     virtual DataPortStatus setBuffer(BufferBase<ByteData>* buffer) = 0;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプールを設定する
+     *
+     * write() で受け取ったデータを保持するバッファをこのメモリプール
+     * から確保する。デフォルトの実装は何もしない。
+     *
+     * @param pool メモリプール
+     *
+     * @else
+     * @brief Set the memory pool for buffers
+     *
+     * The buffers keeping the data given to write() are allocated from
+     * this memory pool. The default implementation does nothing.
+     *
+     * @param pool The memory pool
+     *
+     * @endif
+     */
+    virtual void setMemoryPool(const std::shared_ptr<ByteDataPool>& /*pool*/) {}
+
     /*!
      * @if jp
      * @brief リスナを設定する。
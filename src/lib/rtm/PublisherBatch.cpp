@@ -0,0 +1,82 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PublisherBatch.cpp
+ * @brief Batching of push_policy "all" shared by the publishers
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/PublisherBatch.h>
+#include <rtm/CdrBatch.h>
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief 一括送信の設定
+   * @else
+   * @brief Set up batching
+   * @endif
+   */
+  void PublisherBatch::setPolicy(const coil::Properties& prop)
+  {
+    // max_batch_count default: 1 (no batching)
+    std::string count_str(prop.getProperty("publisher.max_batch_count", "1"));
+    RTC_DEBUG(("max_batch_count: %s", count_str.c_str()));
+
+    long int count(1);
+    if (!coil::stringTo(count, count_str.c_str()) || count < 1)
+      {
+        RTC_ERROR(("invalid max_batch_count value: %s", count_str.c_str()));
+        count = 1;
+      }
+    m_maxCount = static_cast<size_t>(count);
+
+    // max_batch_bytes default: 65536
+    std::string bytes_str(prop.getProperty("publisher.max_batch_bytes",
+                                           "65536"));
+    RTC_DEBUG(("max_batch_bytes: %s", bytes_str.c_str()));
+
+    long int bytes(65536);
+    if (!coil::stringTo(bytes, bytes_str.c_str()) || bytes < 1)
+      {
+        RTC_ERROR(("invalid max_batch_bytes value: %s", bytes_str.c_str()));
+        bytes = 65536;
+      }
+    m_maxBytes = static_cast<size_t>(bytes);
+  }
+
+  /*!
+   * @if jp
+   * @brief 次に送るサンプルを m_samples に集める
+   * @else
+   * @brief Collect the samples to send next into m_samples
+   * @endif
+   */
+  void PublisherBatch::collect(CdrBufferBase& buffer)
+  {
+    size_t readable(buffer.readable());
+    size_t bytes(CdrBatch::headerLength());
+    m_samples.clear();
+    for (size_t i(0); i < readable && m_samples.size() < m_maxCount; ++i)
+      {
+        ByteData* cdr(buffer.rptr(static_cast<long int>(i)));
+        size_t len(CdrBatch::sampleOverhead() + cdr->getDataLength());
+        if (!m_samples.empty() && bytes + len > m_maxBytes) { break; }
+        bytes += len;
+        m_samples.push_back(cdr);
+      }
+  }
+} // namespace RTC
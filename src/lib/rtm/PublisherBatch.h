@@ -0,0 +1,201 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PublisherBatch.h
+ * @brief Batching of push_policy "all" shared by the publishers
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_PUBLISHERBATCH_H
+#define RTC_PUBLISHERBATCH_H
+
+#include <rtm/CdrBufferBase.h>
+#include <rtm/DataPortStatus.h>
+#include <rtm/InPortConsumer.h>
+#include <rtm/SystemLogger.h>
+#include <rtm/ByteData.h>
+
+#include <vector>
+
+namespace coil
+{
+  class Properties;
+} // namespace coil
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class PublisherBatch
+   * @brief push_policy "all" の一括送信
+   *
+   * PublisherNew と PublisherPeriodic が共有する、バッファ内の複数
+   * サンプルを InPortConsumer::putBatch() でまとめて送る処理。
+   * Publisher はこのクラスを friend とし、リスナ通知用の
+   * onBufferRead(), onSend(), onReceived(), invokeListener() を提供す
+   * る。
+   *
+   * プロパティ:
+   * - publisher.max_batch_count: 1回で送るサンプル数の上限。1 の場
+   *   合は一括送信しない (デフォルト: 1)
+   * - publisher.max_batch_bytes: 1回で送るバイト数の上限。これを超
+   *   えるサンプルは単独で送る (デフォルト: 65536)
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class PublisherBatch
+   * @brief Batching of push_policy "all"
+   *
+   * Sends several buffered samples at once with
+   * InPortConsumer::putBatch(), shared by PublisherNew and
+   * PublisherPeriodic. A publisher makes this class a friend and
+   * provides onBufferRead(), onSend(), onReceived() and
+   * invokeListener() for the listener notifications.
+   *
+   * Properties:
+   * - publisher.max_batch_count: Maximum number of samples per send.
+   *   1 disables batching (default: 1)
+   * - publisher.max_batch_bytes: Maximum number of bytes per send. A
+   *   sample larger than this is sent by itself (default: 65536)
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class PublisherBatch
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 一括送信の設定
+     * @param prop コネクタのプロパティ
+     * @else
+     * @brief Set up batching
+     * @param prop Connector properties
+     * @endif
+     */
+    void setPolicy(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 一括送信を使うかどうか
+     * @param consumer 送信先のコンシューマ
+     * @else
+     * @brief Whether batching is used
+     * @param consumer Consumer to send to
+     * @endif
+     */
+    bool isEnabled(const InPortConsumer& consumer) const
+    {
+      return m_maxCount > 1 && consumer.batchSupported();
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファ内の全サンプルをまとめて送る
+     *
+     * 一括送信に失敗した場合、InPort 側が格納したサンプルの分だけ読
+     * み出し位置を進め、失敗したサンプルについてリスナへ通知する。失
+     * 敗したサンプル以降は単独で送る場合と同様にバッファに残し、次回
+     * 再送する。
+     *
+     * @param publisher リスナへ通知する Publisher
+     * @param consumer 送信先のコンシューマ
+     * @param buffer 送信するサンプルのバッファ
+     * @return リターンコード
+     *
+     * @else
+     * @brief Send all buffered samples in batches
+     *
+     * If a batched send fails, the read position is advanced only past
+     * the samples the InPort stored, and the listeners are notified of
+     * the sample that failed. That sample and the ones after it stay in
+     * the buffer to be resent, as a sample sent by itself does.
+     *
+     * @param publisher Publisher notifying the listeners
+     * @param consumer Consumer to send to
+     * @param buffer Buffer of the samples to send
+     * @return Return code
+     *
+     * @endif
+     */
+    template <class Publisher>
+    DataPortStatus pushAll(Publisher& publisher, InPortConsumer& consumer,
+                           CdrBufferBase& buffer)
+    {
+      RTC_TRACE(("pushAll()"));
+      while (buffer.readable() > 0)
+        {
+          collect(buffer);
+          for (auto const& cdr : m_samples) { publisher.onBufferRead(*cdr); }
+          for (auto const& cdr : m_samples) { publisher.onSend(*cdr); }
+          if (m_samples.size() == 1)
+            {
+              // nothing to coalesce: plain put, retried on failure
+              DataPortStatus ret(consumer.put(*m_samples.front()));
+              if (ret != DataPortStatus::PORT_OK)
+                {
+                  RTC_DEBUG(("%s = consumer.put()", toString(ret)));
+                  return publisher.invokeListener(ret, *m_samples.front());
+                }
+              publisher.onReceived(*m_samples.front());
+              buffer.advanceRptr();
+              continue;
+            }
+
+          size_t count(0);
+          DataPortStatus ret(consumer.putBatch(m_samples, count));
+          if (count > m_samples.size()) { count = m_samples.size(); }
+          for (size_t i(0); i < count; ++i)
+            {
+              publisher.onReceived(*m_samples[i]);
+            }
+          buffer.advanceRptr(static_cast<long int>(count));
+          if (ret != DataPortStatus::PORT_OK)
+            {
+              RTC_DEBUG(("%s = consumer.putBatch(): %d of %d stored",
+                         toString(ret), static_cast<int>(count),
+                         static_cast<int>(m_samples.size())));
+              if (count == m_samples.size()) { --count; }
+              return publisher.invokeListener(ret, *m_samples[count]);
+            }
+        }
+      return DataPortStatus::PORT_OK;
+    }
+
+  private:
+    /*!
+     * @if jp
+     * @brief 次に送るサンプルを m_samples に集める
+     *
+     * 読み出し位置から max_batch_count 個まで、max_batch_bytes に収ま
+     * る範囲で集める。最初のサンプルは大きさによらず含める。
+     *
+     * @else
+     * @brief Collect the samples to send next into m_samples
+     *
+     * Collects up to max_batch_count samples from the read position
+     * within max_batch_bytes. The first sample is always included
+     * whatever its size.
+     *
+     * @endif
+     */
+    void collect(CdrBufferBase& buffer);
+
+    Logger rtclog{"PublisherBatch"};
+    size_t m_maxCount{1};
+    size_t m_maxBytes{65536};
+    std::vector<ByteData*> m_samples;
+  };
+} // namespace RTC
+
+#endif  // RTC_PUBLISHERBATCH_H
@@ -98,6 +98,18 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief バッファ用のメモリプールを設定する
+   * @else
+   * @brief Set the memory pool for buffers
+   * @endif
+   */
+  void PublisherFlush::setMemoryPool(const std::shared_ptr<ByteDataPool>& pool)
+  {
+    m_data.setPool(pool);
+  }
+
   /*!
    * @if jp
    * @brief リスナのセット
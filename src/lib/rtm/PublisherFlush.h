@@ -166,6 +166,15 @@ namespace RTC
      */
     DataPortStatus setBuffer(CdrBufferBase* buffer) override;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプールを設定する
+     * @else
+     * @brief Set the memory pool for buffers
+     * @endif
+     */
+    void setMemoryPool(const std::shared_ptr<ByteDataPool>& pool) override;
+
     /*!
      * @if jp
      * @brief リスナを設定する。
@@ -82,6 +82,7 @@ namespace RTC
     RTC_DEBUG_STR((prop));
 
     setPushPolicy(prop);
+    m_batch.setPolicy(prop);
     if (!createTask(prop))
       {
         return DataPortStatus::INVALID_ARGS;
@@ -129,6 +130,18 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief バッファ用のメモリプールを設定する
+   * @else
+   * @brief Set the memory pool for buffers
+   * @endif
+   */
+  void PublisherNew::setMemoryPool(const std::shared_ptr<ByteDataPool>& pool)
+  {
+    m_data.setPool(pool);
+  }
+
   /*!
    * @if jp
    * @brief リスナのセット
@@ -362,6 +375,10 @@ namespace RTC
   DataPortStatus PublisherNew::pushAll()
   {
     RTC_TRACE(("pushAll()"));
+    if (m_batch.isEnabled(*m_consumer))
+      {
+        return m_batch.pushAll(*this, *m_consumer, *m_buffer);
+      }
 
     while (m_buffer->readable() > 0)
       {
@@ -32,6 +32,9 @@
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
 #include <rtm/ByteData.h>
+#include <rtm/PublisherBatch.h>
+
+#include <vector>
 
 namespace coil
 {
@@ -208,6 +211,15 @@ namespace RTC
      */
     DataPortStatus setBuffer(CdrBufferBase* buffer) override;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプールを設定する
+     * @else
+     * @brief Set the memory pool for buffers
+     * @endif
+     */
+    void setMemoryPool(const std::shared_ptr<ByteDataPool>& pool) override;
+
     /*!
      * @if jp
      * @brief リスナを設定する。
@@ -698,6 +710,8 @@ namespace RTC
       m_listeners->notify(ON_SENDER_ERROR, m_profile);
     }
 
+    // pushes "all" in batches with the listener notifications above
+    friend class PublisherBatch;
 
   private:
     Logger rtclog{"PublisherNew"};
@@ -712,6 +726,7 @@ namespace RTC
     int m_skipn{0};
     bool m_active{false};
     int m_leftskip{0};
+    PublisherBatch m_batch;
     ByteData m_data;
   };
 } // namespace RTC
@@ -81,6 +81,7 @@ namespace RTC
     RTC_DEBUG_STR((prop));
 
     setPushPolicy(prop);
+    m_batch.setPolicy(prop);
     if (!createTask(prop))
       {
         return DataPortStatus::INVALID_ARGS;
@@ -129,6 +130,18 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief バッファ用のメモリプールを設定する
+   * @else
+   * @brief Set the memory pool for buffers
+   * @endif
+   */
+  void PublisherPeriodic::setMemoryPool(const std::shared_ptr<ByteDataPool>& pool)
+  {
+    m_data.setPool(pool);
+  }
+
   /*!
    * @if jp
    * @brief リスナのセット
@@ -272,6 +285,10 @@ namespace RTC
   {
     RTC_TRACE(("pushAll()"));
     if (bufferIsEmpty()) { return DataPortStatus::BUFFER_EMPTY; }
+    if (m_batch.isEnabled(*m_consumer))
+      {
+        return m_batch.pushAll(*this, *m_consumer, *m_buffer);
+      }
 
     while (m_buffer->readable() > 0)
       {
@@ -475,6 +492,24 @@ namespace RTC
     auto period = std::chrono::duration<double>(1.0/hz);
     m_task->setPeriod(std::chrono::duration_cast<std::chrono::nanoseconds>(period));
 
+    // overrun_policy default: SKIP
+    std::string overrun{coil::normalize(
+      prop.getProperty("publisher.overrun_policy", "skip"))};
+    RTC_DEBUG(("overrun_policy: %s", overrun.c_str()));
+    if (overrun == "catchup")
+      {
+        m_task->setOverrunPolicy(
+          coil::PeriodicTaskBase::OverrunPolicy::CATCHUP);
+      }
+    else
+      {
+        if (overrun != "skip")
+          {
+            RTC_ERROR(("invalid overrun_policy value: %s", overrun.c_str()));
+          }
+        m_task->setOverrunPolicy(coil::PeriodicTaskBase::OverrunPolicy::SKIP);
+      }
+
     // Setting task measurement function
     m_task->executionMeasure(coil::toBool(prop["measurement.exec_time"],
                                           "enable", "disable", true));
@@ -30,6 +30,9 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/PublisherBatch.h>
+
+#include <vector>
 
 namespace coil
 {
@@ -208,6 +211,15 @@ namespace RTC
      */
     DataPortStatus setBuffer(CdrBufferBase* buffer) override;
 
+    /*!
+     * @if jp
+     * @brief バッファ用のメモリプールを設定する
+     * @else
+     * @brief Set the memory pool for buffers
+     * @endif
+     */
+    void setMemoryPool(const std::shared_ptr<ByteDataPool>& pool) override;
+
     /*!
      * @if jp
      * @brief リスナを設定する。
@@ -704,6 +716,8 @@ namespace RTC
       m_listeners->notify(ON_SENDER_ERROR, m_profile);
     }
 
+    // pushes "all" in batches with the listener notifications above
+    friend class PublisherBatch;
 
   private:
     bool bufferIsEmpty()
@@ -731,6 +745,7 @@ namespace RTC
     bool m_active{false};
     bool m_readback{false};
     int m_leftskip{0};
+    PublisherBatch m_batch;
     ByteData m_data;
   };
 } // namespace RTC
@@ -31,7 +31,7 @@ namespace RTC_impl
       m_sm(NUM_OF_LIFECYCLESTATE),
       m_ca(false), m_dfc(false), m_fsm(false), m_mode(false),
       m_rtobjPtr(nullptr), m_measure(false), m_activation(false),
-      m_deactivation(false), m_reset(false)
+      m_deactivation(false), m_reset(false), m_waiters(0)
   {
     m_caVar   = RTC::ComponentAction::_nil();
     m_dfcVar  = RTC::DataFlowComponentAction::_nil();
@@ -413,11 +413,29 @@ namespace RTC_impl
     m_sm.goTo(state);
   }
 
+  bool RTObjectStateMachine::
+  waitForStateChange(ExecContextState state, std::chrono::nanoseconds timeout)
+  {
+    std::unique_lock<std::mutex> guard(m_waitMutex);
+    // Counted before the state is checked, so that workerPreDo() either
+    // sees the waiter or has already changed the state.
+    ++m_waiters;
+    bool changed = m_waitCond.wait_for(guard, timeout, [this, state]
+                                       { return !isCurrentState(state); });
+    --m_waiters;
+    return changed;
+  }
+
   // Workers
   void RTObjectStateMachine::workerPreDo()
   {
     updateState();
-    return m_sm.worker_pre();
+    m_sm.worker_pre();
+    if (m_waiters.load() != 0)
+      {
+        std::lock_guard<std::mutex> guard(m_waitMutex);
+        m_waitCond.notify_all();
+      }
   }
 
   void RTObjectStateMachine::workerDo()
@@ -430,6 +448,14 @@ namespace RTC_impl
     return m_sm.worker_post();
   }
 
+#ifndef NO_EC_PROFILE
+  std::string RTObjectStateMachine::getInstanceName()
+  {
+    if (m_rtobjPtr == nullptr) { return ""; }
+    return m_rtobjPtr->getInstanceName();
+  }
+#endif
+
   bool RTObjectStateMachine::activate()
   {
       if (isCurrentState(RTC::INACTIVE_STATE))
@@ -24,9 +24,15 @@
 #include <coil/TimeMeasure.h>
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/StateMachine.h>
+#ifndef NO_EC_PROFILE
+#include <rtm/ExecutionStatistics.h>
+#endif
 #include <cassert>
 #include <iostream>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #define NUM_OF_LIFECYCLESTATE 4
 namespace RTC
@@ -80,6 +86,9 @@ namespace RTC_impl
     bool isCurrentState(ExecContextState state);
     bool isNextState(ExecContextState state);
     void goTo(ExecContextState state);
+    // Waiting until workerPreDo() leaves the state (false on timeout)
+    bool waitForStateChange(ExecContextState state,
+                            std::chrono::nanoseconds timeout);
 
     // Workers
     void workerPreDo();
@@ -90,6 +99,12 @@ namespace RTC_impl
     bool deactivate();
     bool reset();
 
+#ifndef NO_EC_PROFILE
+    // Execution statistics of workerDo()
+    ExecutionStatistics& getStatistics() { return m_statistics; }
+    std::string getInstanceName();
+#endif
+
   protected:
     void setComponentAction(RTC::LightweightRTObject_ptr comp);
     void setDataFlowComponentAction(RTC::LightweightRTObject_ptr comp);
@@ -122,6 +137,13 @@ namespace RTC_impl
     std::atomic<bool> m_activation;
     std::atomic<bool> m_deactivation;
     std::atomic<bool> m_reset;
+    // Notification of the transitions applied by workerPreDo()
+    std::mutex m_waitMutex;
+    std::condition_variable m_waitCond;
+    std::atomic<int> m_waiters;
+#ifndef NO_EC_PROFILE
+    ExecutionStatistics m_statistics;
+#endif
   };
 } // namespace RTC_impl
 
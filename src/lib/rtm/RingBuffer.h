@@ -471,7 +471,7 @@ namespace RTC
                 {
                   timeout = m_wtimeout;
                 }
-              if (std::cv_status::timeout == m_empty.cond.wait_for(guard, timeout))
+              if (std::cv_status::timeout == m_full.cond.wait_for(guard, timeout))
                 {
                   return BufferStatus::TIMEOUT;
                 }
@@ -0,0 +1,1223 @@
+﻿// -*- C++ -*-
+/*!
+ * @file SPSCRingBuffer.h
+ * @brief Single-producer/single-consumer lock-free ring buffer
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_SPSCRINGBUFFER_H
+#define RTC_SPSCRINGBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <coil/stringutil.h>
+
+#include <rtm/BufferBase.h>
+#include <rtm/BufferStatus.h>
+
+#include <string>
+
+#define SPSCRINGBUFFER_DEFAULT_LENGTH 8
+#define SPSCRINGBUFFER_CACHELINE_SIZE 64
+
+/*!
+ * @if jp
+ * @namespace RTC
+ *
+ * @brief RTコンポーネント
+ *
+ * @else
+ *
+ * @namespace RTC
+ *
+ * @brief RT-Component
+ *
+ * @endif
+ */
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class SPSCRingBuffer
+   * @brief 単一書き込み/単一読み出し用ロックフリーリングバッファ
+   *
+   * 書き込みスレッドと読み出しスレッドがそれぞれ1つだけの場合に使用す
+   * るリングバッファ。書き込み位置と読み出し位置は単調増加するアトミッ
+   * クなカウンタで管理され、通常の書き込み・読み出しではミューテック
+   * スを一切取得しない。
+   *
+   * MPSCRingBuffer と同じく各要素はシーケンス番号を持つ。読み出し側は
+   * 読み出し位置を CAS で確保してから要素をコピーし、シーケンス番号を
+   * 更新して要素を解放する。書き込み側は解放済みの要素にのみ書き込む
+   * ため、読み出し中の要素が上書きされることはない。長さ 1 の場合は
+   * 予備の要素を1つ持ち、読み出し中でも書き込み側はもう一方の要素に
+   * 書き込む。
+   *
+   * バッファポリシー (overwrite, do_nothing, block, readback) および
+   * タイムアウトの意味は RingBuffer と同じである。block ポリシーで実
+   * 際に待ちが発生した場合のみ条件変数により待機し、相手側は待機者が
+   * いる場合にのみ通知を行う。
+   *
+   * overwrite ポリシーでバッファフルの場合、書き込み側は最も古い要素
+   * を読み出し側と同じ手順で取り出して破棄する。長さ 2 以上で、書き
+   * 込む要素を読み出し側がコピー中の場合は、その解放を待つ。
+   *
+   * readback ポリシーでは read() で最後に読み出したデータを返す。
+   * rptr(), get() で参照した要素は解放を伴わないため、overwrite ポリ
+   * シーでは書き込み側に破棄・上書きされることがある。advanceWptr()
+   * に負の値は指定できない。
+   *
+   * 書き込み側・読み出し側をそれぞれ複数のスレッドから呼び出してはな
+   * らない。
+   *
+   * @param DataType バッファに格納するデータ型
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class SPSCRingBuffer
+   * @brief Lock-free single-producer/single-consumer ring buffer
+   *
+   * Ring buffer for connectors with exactly one writer thread and one
+   * reader thread. The write and read positions are monotonically
+   * increasing atomic counters, so that ordinary writes and reads never
+   * take a mutex.
+   *
+   * As in MPSCRingBuffer, each slot carries a sequence number. The
+   * reader claims the read position with a CAS, copies the element and
+   * then releases the slot by updating its sequence number. The writer
+   * stores only into released slots, so an element is never overwritten
+   * while it is being copied. With length 1 there is a spare slot, and
+   * the writer stores into the other slot while the reader copies.
+   *
+   * The buffer policies (overwrite, do_nothing, block, readback) and
+   * timeouts have the same meaning as in RingBuffer. A thread parks on
+   * a condition variable only when it actually has to block under the
+   * block policy, and the other side notifies only when a waiter is
+   * registered.
+   *
+   * When the buffer is full under the overwrite policy, the writer
+   * takes the oldest element out the same way the reader does and drops
+   * it. With length 2 or more, if the slot it has to store into is
+   * still being copied by the reader, it waits for that slot to be
+   * released.
+   *
+   * Under the readback policy, the data read last by read() is
+   * returned. Elements referenced with rptr() or get() are not claimed,
+   * so under the overwrite policy the writer may drop and overwrite
+   * them. advanceWptr() does not accept a negative value.
+   *
+   * The writer side and the reader side must each be called from a
+   * single thread.
+   *
+   * @param DataType Data type to store in the buffer
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  template <class DataType>
+  class SPSCRingBuffer
+    : public BufferBase<DataType>
+  {
+  public:
+    /*!
+     * @if jp
+     *
+     * @brief コンストラクタ
+     *
+     * 指定されたバッファ長でバッファを初期化する。
+     *
+     * @param length バッファ長
+     *
+     * @else
+     *
+     * @brief Constructor
+     *
+     * Initialize the buffer by specified buffer length.
+     *
+     * @param length Buffer length
+     *
+     * @endif
+     */
+    explicit SPSCRingBuffer(long int length = SPSCRINGBUFFER_DEFAULT_LENGTH)
+      : m_length(length > 0 ? static_cast<size_t>(length) : 1),
+        m_slotCount(slotCount(m_length)),
+        m_slots(new Slot[m_slotCount])
+    {
+      this->reset();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 仮想デストラクタ
+     *
+     * @else
+     *
+     * @brief Virtual destractor
+     *
+     * @endif
+     */
+    ~SPSCRingBuffer() override;
+
+    /*!
+     * @if jp
+     * @brief バッファの設定
+     *
+     * coil::Properties で与えられるプロパティにより、バッファの設定を
+     * 初期化する。使用できるオプションは RingBuffer と同じく、
+     * length, write.full_policy, write.timeout, read.empty_policy,
+     * read.timeout である。
+     *
+     * @else
+     * @brief Set the buffer
+     *
+     * Initialize the buffer by the given coil::Properties. Available
+     * options are the same as RingBuffer: length, write.full_policy,
+     * write.timeout, read.empty_policy and read.timeout.
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop) override
+    {
+      initLength(prop);
+      initWritePolicy(prop);
+      initReadPolicy(prop);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファ長を取得する
+     *
+     * @return バッファ長
+     *
+     * @else
+     *
+     * @brief Get the buffer length
+     *
+     * @return Buffer length
+     *
+     * @endif
+     */
+    size_t length() const override
+    {
+      return m_length;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファの長さをセットする
+     *
+     * バッファ長を設定し、書き込み・読み出し位置をリセットする。
+     * 読み書き中のスレッドが存在しない状態で呼び出すこと。
+     *
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Set the buffer length
+     *
+     * Set the buffer length and reset the read/write positions. This
+     * must not be called while the buffer is in use.
+     *
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus length(size_t n) override
+    {
+      if (n == 0)
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      m_slots.reset(new Slot[slotCount(n)]);
+      m_length = n;
+      m_slotCount = slotCount(n);
+      this->reset();
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファの状態をリセットする
+     *
+     * バッファの読み出し位置と書き込み位置をリセットする。
+     *
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Reset the buffer status
+     *
+     * Reset the read and write positions of the buffer.
+     *
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus reset() override
+    {
+      for (size_t i(0); i < m_slotCount; ++i)
+        {
+          m_slots[i].sequence.store(i);
+        }
+      m_tail.store(0);
+      m_head.store(0);
+      m_hasLast = false;
+      return BufferStatus::OK;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     *
+     * @brief バッファの現在の書込み要素のポインタ
+     *
+     * @param  n 書込みポインタ + n の位置のポインタ
+     * @return 書込み位置のポインタ
+     *
+     * @else
+     *
+     * @brief Get the writing pointer
+     *
+     * @param  n Writing pointer + n
+     * @return Pointer to the writing position
+     *
+     * @endif
+     */
+    DataType* wptr(long int n = 0) override
+    {
+      return &m_slots[index(m_head.load(std::memory_order_relaxed), n)].data;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 書込みポインタを進める
+     *
+     * wptr() または put() で書き込んだ n 個の要素を公開する。書き込み
+     * 可能な要素数以上の数値または負の値を指定した場合、
+     * PRECONDITION_NOT_MET を返す。書き込み側スレッドから呼び出すこと。
+     *
+     * @param  n 書込みポインタ + n の位置のポインタ
+     * @param  unlock_enable trueの場合にバッファエンプティのブロックを解除する
+     * @return OK:            正常終了
+     *         PRECONDITION_NOT_MET: n > writable() または n < 0
+     *
+     * @else
+     *
+     * @brief Forward the writing pointer
+     *
+     * Publish n elements written by wptr() or put().
+     * PRECONDITION_NOT_MET is returned if n exceeds the writable elements
+     * or is negative. This must be called from the writer thread.
+     *
+     * @param  n Writing pointer + n
+     * @param  unlock_enable Wake up a reader blocked on empty if true
+     * @return OK:            Successful
+     *         PRECONDITION_NOT_MET: n > writable() or n < 0
+     *
+     * @endif
+     */
+    BufferStatus advanceWptr(long int n = 1, bool unlock_enable = true) override
+    {
+      if (n < 0 || static_cast<size_t>(n) > writable())
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      std::uint64_t head(m_head.load(std::memory_order_relaxed));
+      for (long int i(0); i < n; ++i)
+        {
+          std::uint64_t pos(head + static_cast<std::uint64_t>(i));
+          m_slots[index(pos, 0)].sequence.store(pos + 1,
+                                                std::memory_order_release);
+        }
+      m_head.store(head + static_cast<std::uint64_t>(n));
+      if (unlock_enable && n > 0)
+        {
+          wakeup(m_empty);
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファにデータを書き込む
+     *
+     * バッファにデータを書き込む。書き込みポインタの位置は変更されない。
+     *
+     * @param value 書き込み対象データ
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Write data into the buffer
+     *
+     * Write data into the buffer without moving the writing pointer.
+     *
+     * @param value Target data to write.
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus put(const DataType& value) override
+    {
+      *wptr() = value;
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書き込む
+     *
+     * 引数で与えられたデータをバッファに書き込む。バッファフル時の動作
+     * は RingBuffer::write() と同じである。block モードで実際にバッファ
+     * がフルの場合にのみ条件変数で待機する。長さ 2 以上で、書き込む要
+     * 素を読み出し側がコピー中の場合は、その解放を待つ。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (default -1: 無効)
+     * @return OK            正常終了
+     *         FULL          バッファがフル状態
+     *         TIMEOUT              書込みがタイムアウトした
+     *         PRECONDITION_NOT_MET 設定異常
+     *
+     * @else
+     *
+     * @brief Write data into the buffer
+     *
+     * Write the given data into the buffer. The behavior on a full
+     * buffer is the same as RingBuffer::write(). The writer parks on a
+     * condition variable only when the buffer is actually full in block
+     * mode. With length 2 or more, if the reader is still copying the
+     * slot to store into, the writer waits for it to be released.
+     *
+     * @param value Target data for writing
+     * @param timeout Timeout in nsec (default -1: disabled)
+     * @return OK            Successful
+     *         FULL          The buffer is full
+     *         TIMEOUT              Writing timed out
+     *         PRECONDITION_NOT_MET Invalid configuration
+     *
+     * @endif
+     */
+    BufferStatus write(const DataType& value,
+                       std::chrono::nanoseconds timeout
+                       = std::chrono::nanoseconds(-1)) override
+    {
+      std::uint64_t pos(m_head.load(std::memory_order_relaxed));
+      if (!claim(pos))
+        {
+          bool timedwrite(m_timedwrite);
+          bool overwrite(m_overwrite);
+
+          if (timeout >= std::chrono::seconds::zero())  // block mode
+            {
+              timedwrite = true;
+              overwrite  = false;
+            }
+
+          if (overwrite && !timedwrite)  // "overwrite" mode
+            {
+              // drop the oldest element ourselves until the slot is free
+              while (!claim(pos))
+                {
+                  if (full())
+                    {
+                      drop();
+                    }
+                  else
+                    {
+                      // the reader is still copying the slot
+                      std::this_thread::yield();
+                    }
+                }
+            }
+          else if (!overwrite && !timedwrite)  // "do_nothing" mode
+            {
+              while (!claim(pos))
+                {
+                  if (full())
+                    {
+                      return BufferStatus::FULL;
+                    }
+                  // the reader is still copying the slot
+                  std::this_thread::yield();
+                }
+            }
+          else if (!overwrite && timedwrite)  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = m_wtimeout;
+                }
+              auto deadline = std::chrono::steady_clock::now() + timeout;
+              while (!claim(pos))
+                {
+                  auto rest = deadline - std::chrono::steady_clock::now();
+                  if (rest <= std::chrono::steady_clock::duration::zero() ||
+                      !park(m_full, rest, [this] { return !full(); }))
+                    {
+                      return BufferStatus::TIMEOUT;
+                    }
+                  // the reader has taken the slot but not released it yet
+                  std::this_thread::yield();
+                }
+            }
+          else                                    // unknown condition
+            {
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+        }
+
+      Slot& slot(m_slots[index(pos, 0)]);
+      slot.data = value;
+      slot.sequence.store(pos + 1, std::memory_order_release);
+      m_head.store(pos + 1);
+      wakeup(m_empty);
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファに書込み可能な要素数
+     *
+     * @return 書き込み可能な要素数
+     *
+     * @else
+     *
+     * @brief Get a writable number
+     *
+     * @return Writable number
+     *
+     * @endif
+     */
+    size_t writable() const override
+    {
+      return m_length - fillCount();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファfullチェック
+     *
+     * @return fullチェック結果(true:バッファfull，false:バッファ空きあり)
+     *
+     * @else
+     *
+     * @brief Check on whether the buffer is full.
+     *
+     * @return True if the buffer is full, else false.
+     *
+     * @endif
+     */
+    bool full() const override
+    {
+      return fillCount() >= m_length;
+    }
+
+    //----------------------------------------------------------------------
+    /*!
+     * @if jp
+     *
+     * @brief バッファの現在の読み出し要素のポインタ
+     *
+     * @param  n 読み出しポインタ + n の位置のポインタ
+     * @return 読み出し位置のポインタ
+     *
+     * @else
+     *
+     * @brief Get the reading pointer
+     *
+     * @param  n Reading pointer + n
+     * @return Pointer to the reading position
+     *
+     * @endif
+     */
+    DataType* rptr(long int n = 0) override
+    {
+      return &m_slots[index(m_tail.load(), n)].data;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 読み出しポインタを進める
+     *
+     * 現在の読み出し位置を n 個進める。読み出し側スレッドから呼び出す
+     * こと。n が負の場合、書き込み側がまだ再利用していない要素の範囲
+     * でのみ読み出し位置を戻すことができる。
+     *
+     * @param  n 読み出しポインタ + n の位置のポインタ
+     * @param  unlock_enable trueの場合にバッファフルのブロックを解除する
+     * @return OK: 正常終了
+     *         PRECONDITION_NOT_MET: n が範囲外
+     *
+     * @else
+     *
+     * @brief Forward the reading pointer
+     *
+     * Forward the reading position by n. This must be called from the
+     * reader thread. A negative n may rewind the position only over
+     * slots that the writer has not reused yet.
+     *
+     * @param  n Reading pointer + n
+     * @param  unlock_enable Wake up a writer blocked on full if true
+     * @return OK: Successful
+     *         PRECONDITION_NOT_MET: n is out of range
+     *
+     * @endif
+     */
+    BufferStatus advanceRptr(long int n = 1, bool unlock_enable = true) override
+    {
+      if (n < 0)
+        {
+          return rewind(static_cast<size_t>(-n));
+        }
+      if (static_cast<size_t>(n) > readable())
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      for (long int i(0); i < n; ++i)
+        {
+          std::uint64_t pos;
+          if (!take(pos)) { return BufferStatus::PRECONDITION_NOT_MET; }
+          release(pos);
+        }
+      if (unlock_enable && n > 0)
+        {
+          wakeup(m_full);
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファからデータを読み出す
+     *
+     * バッファからデータを読みだす。読み出しポインタの位置は変更されない。
+     *
+     * @param value 読み出しデータ
+     * @return OK: 正常終了
+     *
+     * @else
+     *
+     * @brief Read data from the buffer
+     *
+     * Read data from the buffer without moving the reading pointer.
+     *
+     * @param value Read data
+     * @return OK: Successful
+     *
+     * @endif
+     */
+    BufferStatus get(DataType& value) override
+    {
+      value = *rptr();
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファからデータを読み出す
+     *
+     * @return 読み出しデータ
+     *
+     * @else
+     *
+     * @brief Reading data from the buffer
+     *
+     * @return Read data
+     *
+     * @endif
+     */
+    DataType& get() override
+    {
+      return *rptr();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファから読み出す
+     *
+     * バッファに格納されたデータを読み出す。バッファ空時の動作は
+     * RingBuffer::read() と同じである。block モードで実際にバッファが
+     * 空の場合にのみ条件変数で待機する。readback ポリシーでは最後に読
+     * み出したデータを返す。
+     *
+     * @param value 読み出し対象データ
+     * @param timeout タイムアウト時間 (default -1: 無効)
+     * @return OK            正常終了
+     *         EMPTY         バッファが空状態
+     *         TIMEOUT              読み出しがタイムアウトした
+     *         PRECONDITION_NOT_MET 設定異常
+     *
+     * @else
+     *
+     * @brief Readout data from the buffer
+     *
+     * Read the data stored in the buffer. The behavior on an empty
+     * buffer is the same as RingBuffer::read(). The reader parks on a
+     * condition variable only when the buffer is actually empty in
+     * block mode. Under the readback policy the data read last is
+     * returned.
+     *
+     * @param value Readout data
+     * @param timeout Timeout (default -1: disabled)
+     * @return OK            Successful
+     *         EMPTY         The buffer is empty
+     *         TIMEOUT              Reading timed out
+     *         PRECONDITION_NOT_MET Invalid configuration
+     *
+     * @endif
+     */
+    BufferStatus read(DataType& value,
+                      std::chrono::nanoseconds timeout
+                      = std::chrono::nanoseconds(-1)) override
+    {
+      bool readback(m_readback);
+      std::uint64_t pos;
+      if (!take(pos))
+        {
+          bool timedread(m_timedread);
+
+          if (timeout >= std::chrono::seconds::zero()) // block mode
+            {
+              timedread = true;
+              readback  = false;
+            }
+
+          if (readback && !timedread)       // "readback" mode
+            {
+              if (!m_hasLast)
+                {
+                  return BufferStatus::EMPTY;
+                }
+              value = m_last;
+              return BufferStatus::OK;
+            }
+          else if (!readback && !timedread)  // "do_nothing" mode
+            {
+              return BufferStatus::EMPTY;
+            }
+          else if (!readback && timedread)  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = m_rtimeout;
+                }
+              auto deadline = std::chrono::steady_clock::now() + timeout;
+              while (!take(pos))
+                {
+                  auto rest = deadline - std::chrono::steady_clock::now();
+                  if (rest <= std::chrono::steady_clock::duration::zero() ||
+                      !park(m_empty, rest, [this] { return !empty(); }))
+                    {
+                      return BufferStatus::TIMEOUT;
+                    }
+                  // the writer has advanced but not published the slot yet
+                  std::this_thread::yield();
+                }
+            }
+          else                                    // unknown condition
+            {
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+        }
+
+      // the slot is ours until it is released; the writer cannot claim
+      // it before that
+      value = m_slots[index(pos, 0)].data;
+      release(pos);
+      wakeup(m_full);
+
+      if (readback)
+        {
+          m_last = value;
+          m_hasLast = true;
+        }
+      return BufferStatus::OK;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファから読み出し可能な要素数
+     *
+     * @return 読み出し可能な要素数
+     *
+     * @else
+     *
+     * @brief Get a readable number
+     *
+     * @return Readable number
+     *
+     * @endif
+     */
+    size_t readable() const override
+    {
+      return fillCount();
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファemptyチェック
+     *
+     * @return emptyチェック結果(true:バッファempty，false:バッファデータあり)
+     *
+     * @else
+     *
+     * @brief Check on whether the buffer is empty.
+     *
+     * @return True if the buffer is empty, else false.
+     *
+     * @endif
+     */
+    bool empty() const override
+    {
+      return fillCount() == 0;
+    }
+
+  private:
+    /*!
+     * @if jp
+     * @brief 待機用条件変数構造体
+     *
+     * waiting は待機者の有無を示し、相手側は waiting が true の場合
+     * のみミューテックスを取得して通知する。
+     *
+     * @else
+     * @brief struct for parking a blocked thread
+     *
+     * waiting tells whether a thread is parked, so that the other side
+     * takes the mutex and notifies only when it is true.
+     *
+     * @endif
+     */
+    struct condition
+    {
+      condition() {}
+      std::condition_variable cond;
+      std::mutex mutex;
+      std::atomic<bool> waiting{false};
+    };
+
+    /*!
+     * @if jp
+     * @brief バッファの要素
+     *
+     * sequence が位置 pos と等しければ書き込み可能、pos + 1 であれば
+     * 読み出し可能である。読み出し後は pos + 要素数 (m_slotCount) とな
+     * り、次の周回の書き込みを待つ。書き込み中は WRITING ビットが立つ。
+     * 取り出されて解放前の要素は pos + 1 のままであり、要素数が2以上で
+     * あるため次の周回の書き込み位置とは一致しない。
+     *
+     * @else
+     * @brief Slot of the buffer
+     *
+     * The slot is writable when sequence equals its position pos, and
+     * readable when it is pos + 1. After reading it becomes pos +
+     * m_slotCount and waits for the write of the next round. The WRITING
+     * bit is set while the slot is being written. A slot taken but not
+     * yet released keeps pos + 1, which never equals the position of the
+     * next round because there are at least two slots.
+     *
+     * @endif
+     */
+    struct Slot
+    {
+      std::atomic<std::uint64_t> sequence{0};
+      DataType data;
+    };
+
+    static inline std::uint64_t writing(std::uint64_t pos)
+    {
+      return pos | (static_cast<std::uint64_t>(1) << 63);
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファ長 length に対する内部の要素数
+     *
+     * 長さ 1 でも要素を2つ確保する。要素が1つでは「pos - 1 に公開済み」
+     * または「pos - 1 を取り出し中」と「pos に書き込み可能」を
+     * sequence で区別できない。格納できる要素数は length のままとする。
+     *
+     * @else
+     * @brief Number of internal slots for the buffer length length
+     *
+     * Two slots are allocated even for length 1. With a single slot,
+     * "published at pos - 1" or "pos - 1 being taken out" could not be
+     * told from "writable for pos" by the sequence. At most length
+     * elements are still stored.
+     *
+     * @endif
+     */
+    static inline size_t slotCount(size_t length)
+    {
+      return length > 1 ? length : 2;
+    }
+
+    inline size_t index(std::uint64_t pos, long int n) const
+    {
+      std::uint64_t len(m_slotCount);
+      if (n < 0)
+        {
+          pos += len - static_cast<std::uint64_t>(-n) % len;
+        }
+      else
+        {
+          pos += static_cast<std::uint64_t>(n);
+        }
+      return static_cast<size_t>(pos % len);
+    }
+
+    inline size_t fillCount() const
+    {
+      std::uint64_t tail(m_tail.load());
+      std::uint64_t head(m_head.load());
+      return head > tail ? static_cast<size_t>(head - tail) : 0;
+    }
+
+    /*!
+     * @if jp
+     * @brief 書き込み位置 pos の要素を確保する
+     *
+     * バッファフルまたは要素が解放されていない場合 false。確保した要
+     * 素には WRITING ビットが立ち、rewind() で読み出し側に戻されること
+     * はない。
+     *
+     * @else
+     * @brief Claim the slot of write position pos
+     *
+     * false if the buffer is full or the slot has not been released.
+     * The claimed slot has the WRITING bit set, so that rewind() cannot
+     * give it back to the reader.
+     *
+     * @endif
+     */
+    bool claim(std::uint64_t pos)
+    {
+      Slot& slot(m_slots[index(pos, 0)]);
+      std::uint64_t seq(pos);
+      if (!slot.sequence.compare_exchange_strong(seq, writing(pos)))
+        {
+          return false;
+        }
+      // with length 1 the spare slot is free while the buffer may still
+      // hold its element. The read position is checked after the claim,
+      // so that rewind() either sees the claim or is seen here.
+      if (pos - m_tail.load() >= m_length)
+        {
+          slot.sequence.store(pos);
+          return false;
+        }
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief 公開済みの最も古い要素の位置を確保する。空の場合 false
+     * @else
+     * @brief Claim the oldest published element. false if empty
+     * @endif
+     */
+    bool take(std::uint64_t& pos)
+    {
+      pos = m_tail.load(std::memory_order_relaxed);
+      for (;;)
+        {
+          std::uint64_t seq(m_slots[index(pos, 0)].sequence.
+                            load(std::memory_order_acquire));
+          if (seq == pos + 1)
+            {
+              // the reader and a dropping writer race for the element
+              if (m_tail.compare_exchange_weak(pos, pos + 1))
+                {
+                  return true;
+                }
+            }
+          else if (seq < pos + 1 || seq == writing(pos))
+            {
+              return false;
+            }
+          else
+            {
+              pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline void release(std::uint64_t pos)
+    {
+      m_slots[index(pos, 0)].sequence.store(pos + m_slotCount,
+                                            std::memory_order_release);
+    }
+
+    /*!
+     * @if jp
+     * @brief overwrite ポリシーで最も古い要素を破棄する
+     * @else
+     * @brief Drop the oldest element under the overwrite policy
+     * @endif
+     */
+    void drop()
+    {
+      std::uint64_t pos;
+      if (!take(pos))
+        {
+          // the reader has taken the oldest element meanwhile
+          std::this_thread::yield();
+          return;
+        }
+      release(pos);
+    }
+
+    /*!
+     * @if jp
+     * @brief 読み出し位置を n 個戻す
+     *
+     * 解放済みで、まだ書き込み側に確保されていない要素のみ読み出し可能
+     * に戻す。戻した後の要素数はバッファ長を超えない。1つでも戻せない
+     * 場合は何も変更しない。
+     *
+     * @else
+     * @brief Rewind the read position by n
+     *
+     * Only released slots not yet claimed by the writer are made
+     * readable again, and the buffer does not end up holding more than
+     * its length. Nothing is changed if any of them cannot be.
+     *
+     * @endif
+     */
+    BufferStatus rewind(size_t n)
+    {
+      std::uint64_t tail(m_tail.load());
+      std::uint64_t head(m_head.load());
+      size_t fill(head > tail ? static_cast<size_t>(head - tail) : 0);
+      if (n > tail || fill + n > m_length)
+        {
+          return BufferStatus::PRECONDITION_NOT_MET;
+        }
+      size_t done(0);
+      for (; done < n; ++done)
+        {
+          std::uint64_t pos(tail - 1 - done);
+          std::uint64_t seq(pos + m_slotCount);
+          if (!m_slots[index(pos, 0)].sequence.
+              compare_exchange_strong(seq, pos + 1))
+            {
+              break;
+            }
+        }
+      std::uint64_t rewound(tail - static_cast<std::uint64_t>(n));
+      std::uint64_t expected(tail);
+      if (done == n && m_tail.compare_exchange_strong(expected, rewound))
+        {
+          // With length 1 the writer stores into the spare slot, which
+          // the slots above do not cover. The buffer was empty, so a
+          // claim of the old read position made against it would leave
+          // two elements: undo.
+          if (m_slotCount == m_length ||
+              m_slots[index(tail, 0)].sequence.load() == tail)
+            {
+              return BufferStatus::OK;
+            }
+          if (!m_tail.compare_exchange_strong(rewound, tail))
+            {
+              // the writer has dropped the element again
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+        }
+      // the writer has claimed a slot or dropped an element: undo
+      for (size_t i(0); i < done; ++i)
+        {
+          std::uint64_t pos(tail - 1 - i);
+          m_slots[index(pos, 0)].sequence.store(pos + m_slotCount);
+        }
+      return BufferStatus::PRECONDITION_NOT_MET;
+    }
+
+    template <class Predicate, class Rep, class Period>
+    bool park(condition& cond, std::chrono::duration<Rep, Period> timeout,
+              Predicate ready)
+    {
+      std::unique_lock<std::mutex> guard(cond.mutex);
+      // seq_cst store pairs with the seq_cst position update of the
+      // other side, so that either it sees the waiter or we see the data
+      cond.waiting.store(true);
+      bool ret(cond.cond.wait_for(guard, timeout, ready));
+      cond.waiting.store(false);
+      return ret;
+    }
+
+    static inline void wakeup(condition& cond)
+    {
+      if (cond.waiting.load())
+        {
+          std::lock_guard<std::mutex> guard(cond.mutex);
+          cond.cond.notify_one();
+        }
+    }
+
+    inline void initLength(const coil::Properties& prop)
+    {
+      if (!prop["length"].empty())
+        {
+          size_t n;
+          if (coil::stringTo(n, prop["length"].c_str()))
+            {
+              if (n > 0)
+                {
+                  this->length(n);
+                }
+            }
+        }
+    }
+
+    inline void initWritePolicy(const coil::Properties& prop)
+    {
+      std::string policy(coil::normalize(prop["write.full_policy"]));
+      if (policy == "overwrite")
+        {
+          m_overwrite = true;
+          m_timedwrite = false;
+        }
+      else if (policy == "do_nothing")
+        {
+          m_overwrite = false;
+          m_timedwrite = false;
+        }
+      else if (policy == "block")
+        {
+          m_overwrite = false;
+          m_timedwrite = true;
+
+          std::chrono::nanoseconds tm;
+          if (coil::stringTo(tm, prop["write.timeout"].c_str())
+              && !(tm < std::chrono::seconds::zero()))
+            {
+              m_wtimeout = tm;
+            }
+        }
+    }
+
+    inline void initReadPolicy(const coil::Properties& prop)
+    {
+      std::string policy(coil::normalize(prop["read.empty_policy"]));
+      if (policy == "readback")
+        {
+          m_readback = true;
+          m_timedread = false;
+        }
+      else if (policy == "do_nothing")
+        {
+          m_readback = false;
+          m_timedread = false;
+        }
+      else if (policy == "block")
+        {
+          m_readback = false;
+          m_timedread = true;
+
+          std::chrono::nanoseconds tm;
+          if (coil::stringTo(tm, prop["read.timeout"].c_str())
+              && !(tm < std::chrono::seconds::zero()))
+            {
+              m_rtimeout = tm;
+            }
+        }
+    }
+
+  private:
+    bool m_overwrite{true};
+    bool m_readback{true};
+    bool m_timedwrite{false};
+    bool m_timedread{false};
+    std::chrono::nanoseconds m_wtimeout{std::chrono::seconds(1)};
+    std::chrono::nanoseconds m_rtimeout{std::chrono::seconds(1)};
+
+    size_t m_length;
+    size_t m_slotCount;
+    std::unique_ptr<Slot[]> m_slots;
+
+    /*!
+     * @if jp
+     * @brief 書き込み位置 (書き込み側のみ更新する)
+     *
+     * 書き込み位置と読み出し位置は偽共有を避けるため別のキャッシュライン
+     * に配置する。
+     *
+     * @else
+     * @brief Write position, updated by the writer only
+     *
+     * The write and read positions live on separate cache lines to avoid
+     * false sharing.
+     *
+     * @endif
+     */
+    char m_pad0[SPSCRINGBUFFER_CACHELINE_SIZE];
+    std::atomic<std::uint64_t> m_head{0};
+    char m_pad1[SPSCRINGBUFFER_CACHELINE_SIZE - sizeof(std::uint64_t)];
+
+    /*!
+     * @if jp
+     * @brief 読み出し位置
+     *
+     * 読み出し側、および overwrite ポリシーの書き込み側が更新する。
+     *
+     * @else
+     * @brief Read position
+     *
+     * Updated by the reader, and by the writer under the overwrite
+     * policy.
+     *
+     * @endif
+     */
+    std::atomic<std::uint64_t> m_tail{0};
+    char m_pad2[SPSCRINGBUFFER_CACHELINE_SIZE - sizeof(std::uint64_t)];
+
+    /*!
+     * @if jp
+     * @brief readback ポリシーで返す最後に読み出したデータ
+     * @else
+     * @brief Data read last, returned under the readback policy
+     * @endif
+     */
+    DataType m_last;
+    bool m_hasLast{false};
+
+    condition m_empty;
+    condition m_full;
+  };
+
+  template <class T> SPSCRingBuffer<T>::~SPSCRingBuffer() = default; // no-inline because of its size.
+} // namespace RTC
+
+#endif  // RTC_SPSCRINGBUFFER_H
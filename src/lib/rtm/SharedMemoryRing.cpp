@@ -0,0 +1,405 @@
+﻿// -*- C++ -*-
+/*!
+ * @file SharedMemoryRing.cpp
+ * @brief Multi-slot shared memory ring
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/SharedMemoryRing.h>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#define SHAREDMEMORYRING_MAGIC 0x524d5452  // "RTMR"
+#define SHAREDMEMORYRING_CACHELINE_SIZE 64
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief 共有メモリ先頭のヘッダ
+   * @else
+   * @brief Header at the top of the segment
+   * @endif
+   */
+  struct SharedMemoryRing::Header
+  {
+    std::uint32_t magic;
+    std::uint32_t slot_count;
+    std::uint64_t slot_size;
+    // next position to write, updated by the writer
+    alignas(SHAREDMEMORYRING_CACHELINE_SIZE) std::atomic<std::uint64_t> head;
+    // next position to read, updated by the reader
+    alignas(SHAREDMEMORYRING_CACHELINE_SIZE) std::atomic<std::uint64_t> tail;
+    // reader parking: waiting flag and futex word
+    alignas(SHAREDMEMORYRING_CACHELINE_SIZE) std::atomic<std::uint32_t> waiting;
+    std::atomic<std::uint32_t> wake;
+  };
+
+  /*!
+   * @if jp
+   * @brief スロットヘッダ。直後にスロット長分のデータ領域が続く
+   * @else
+   * @brief Slot header, followed by slot_size bytes of payload
+   * @endif
+   */
+  struct alignas(SHAREDMEMORYRING_CACHELINE_SIZE) SharedMemoryRing::Slot
+  {
+    // position + 1 once the payload of position is published
+    std::atomic<std::uint64_t> seq;
+    std::uint64_t length;
+    // size of the out-of-band segment, 0 for inline payload
+    std::uint64_t oob_size;
+  };
+
+  namespace
+  {
+    inline std::uint64_t alignUp(std::uint64_t n)
+    {
+      return (n + SHAREDMEMORYRING_CACHELINE_SIZE - 1)
+        / SHAREDMEMORYRING_CACHELINE_SIZE * SHAREDMEMORYRING_CACHELINE_SIZE;
+    }
+
+    inline bool mapped(coil::SharedMemory& shmem)
+    {
+      char* data(shmem.get_data());
+#ifdef MAP_FAILED
+      if (data == reinterpret_cast<char*>(MAP_FAILED)) { return false; }
+#endif
+      return data != nullptr;
+    }
+
+    void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t value,
+                   std::chrono::nanoseconds timeout)
+    {
+#ifdef __linux__
+      struct timespec ts;
+      ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+      ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+      // not FUTEX_PRIVATE_FLAG: the word is shared between processes
+      ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAIT, value, &ts, nullptr, 0);
+#else
+      const std::chrono::nanoseconds interval(std::chrono::microseconds(200));
+      if (word.load() == value)
+        {
+          std::this_thread::sleep_for(timeout < interval ? timeout : interval);
+        }
+#endif
+    }
+
+    void futexWake(std::atomic<std::uint32_t>& word)
+    {
+      word.fetch_add(1);
+#ifdef __linux__
+      ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#endif
+    }
+  } // namespace
+
+  SharedMemoryRing::SharedMemoryRing() = default;
+
+  SharedMemoryRing::~SharedMemoryRing()
+  {
+    close(false);
+  }
+
+  std::uint64_t SharedMemoryRing::headerSize()
+  {
+    return alignUp(sizeof(Header));
+  }
+
+  std::uint64_t SharedMemoryRing::memorySize(std::uint32_t slot_count,
+                                             std::uint64_t slot_size)
+  {
+    return headerSize()
+      + slot_count * (sizeof(Slot) + alignUp(slot_size));
+  }
+
+  int SharedMemoryRing::create(const std::string& shm_address,
+                               std::uint32_t slot_count,
+                               std::uint64_t slot_size)
+  {
+    if (isOpen() || slot_count == 0 || slot_size == 0)
+      {
+        return -1;
+      }
+    std::uint64_t memory_size(memorySize(slot_count, slot_size));
+    if (m_shmem.create(shm_address, memory_size) != 0 || !mapped(m_shmem))
+      {
+        m_shmem.close();
+        return -1;
+      }
+
+    m_address = shm_address;
+    m_memory_size = memory_size;
+    m_slot_count = slot_count;
+    m_slot_size = alignUp(slot_size);
+    m_slot_stride = sizeof(Slot) + m_slot_size;
+    m_writer = true;
+
+    char* base(m_shmem.get_data());
+    m_header = new (base) Header();
+    m_header->slot_count = m_slot_count;
+    m_header->slot_size = m_slot_size;
+    m_header->head.store(0);
+    m_header->tail.store(0);
+    m_header->waiting.store(0);
+    m_header->wake.store(0);
+    for (std::uint32_t i(0); i < m_slot_count; ++i)
+      {
+        Slot* slot = new (base + headerSize() + i * m_slot_stride) Slot();
+        slot->seq.store(0);
+        slot->length = 0;
+        slot->oob_size = 0;
+      }
+    m_oob.resize(m_slot_count);
+    // publish the header last
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = SHAREDMEMORYRING_MAGIC;
+    return 0;
+  }
+
+  int SharedMemoryRing::open(const std::string& shm_address,
+                             std::uint64_t memory_size)
+  {
+    if (isOpen() || memory_size < headerSize())
+      {
+        return -1;
+      }
+    if (m_shmem.open(shm_address, memory_size) != 0 || !mapped(m_shmem))
+      {
+        m_shmem.close();
+        return -1;
+      }
+
+    Header* header = reinterpret_cast<Header*>(m_shmem.get_data());
+    if (header->magic != SHAREDMEMORYRING_MAGIC ||
+        header->slot_count == 0 ||
+        memorySize(header->slot_count, header->slot_size) > memory_size)
+      {
+        m_shmem.close();
+        return -1;
+      }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    m_address = shm_address;
+    m_memory_size = memory_size;
+    m_slot_count = header->slot_count;
+    m_slot_size = header->slot_size;
+    m_slot_stride = sizeof(Slot) + m_slot_size;
+    m_writer = false;
+    m_header = header;
+    m_oob.resize(m_slot_count);
+    return 0;
+  }
+
+  void SharedMemoryRing::close(bool unlink)
+  {
+    if (!isOpen())
+      {
+        return;
+      }
+    for (auto& oob : m_oob)
+      {
+        if (oob && oob->created())
+          {
+            oob->close();
+            if (unlink && m_writer) { oob->unlink(); }
+          }
+      }
+    m_oob.clear();
+    m_header = nullptr;
+    m_shmem.close();
+    if (unlink && m_writer)
+      {
+        m_shmem.unlink();
+      }
+    m_memory_size = 0;
+  }
+
+  bool SharedMemoryRing::isOpen() const
+  {
+    return m_header != nullptr;
+  }
+
+  std::uint64_t SharedMemoryRing::getMemorySize() const
+  {
+    return m_memory_size;
+  }
+
+  const std::string& SharedMemoryRing::getAddress() const
+  {
+    return m_address;
+  }
+
+  BufferStatus SharedMemoryRing::write(const ByteData& data)
+  {
+    if (!isOpen() || !m_writer)
+      {
+        return BufferStatus::PRECONDITION_NOT_MET;
+      }
+    std::uint64_t pos(m_header->head.load(std::memory_order_relaxed));
+    if (pos - m_header->tail.load(std::memory_order_acquire) >= m_slot_count)
+      {
+        return BufferStatus::FULL;
+      }
+
+    Slot* slot(slotAt(pos));
+    std::uint64_t length(data.getDataLength());
+    if (length <= m_slot_size)
+      {
+        std::memcpy(payloadOf(slot), data.getBuffer(),
+                    static_cast<size_t>(length));
+        slot->oob_size = 0;
+      }
+    else
+      {
+        // the slot is free, so is its out-of-band segment
+        size_t index(static_cast<size_t>(pos % m_slot_count));
+        std::unique_ptr<coil::SharedMemory>& oob(m_oob[index]);
+        if (!oob)
+          {
+            oob.reset(new coil::SharedMemory());
+          }
+        if (!oob->created() || oob->get_size() < length)
+          {
+            std::uint64_t size(m_slot_size);
+            while (size < length) { size *= 2; }
+            if (oob->created())
+              {
+                oob->close();
+                oob->unlink();
+              }
+            if (oob->create(oobAddress(index), size) != 0 || !mapped(*oob))
+              {
+                oob->close();
+                return BufferStatus::BUFFER_ERROR;
+              }
+          }
+        std::memcpy(oob->get_data(), data.getBuffer(),
+                    static_cast<size_t>(length));
+        slot->oob_size = oob->get_size();
+      }
+    slot->length = length;
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    // seq_cst store/load pair with the reader's waiting/head handshake
+    m_header->head.store(pos + 1);
+    if (m_header->waiting.load() != 0)
+      {
+        futexWake(m_header->wake);
+      }
+    return BufferStatus::OK;
+  }
+
+  BufferStatus SharedMemoryRing::read(ByteData& data,
+                                      std::chrono::nanoseconds timeout)
+  {
+    if (!isOpen() || m_writer)
+      {
+        return BufferStatus::PRECONDITION_NOT_MET;
+      }
+    std::uint64_t pos(m_header->tail.load(std::memory_order_relaxed));
+    Slot* slot(slotAt(pos));
+    if (slot->seq.load(std::memory_order_acquire) != pos + 1 &&
+        !waitReadable(pos, timeout))
+      {
+        return BufferStatus::TIMEOUT;
+      }
+
+    std::uint64_t length(slot->length);
+    if (slot->oob_size == 0)
+      {
+        data.writeData(reinterpret_cast<unsigned char*>(payloadOf(slot)),
+                       static_cast<unsigned long>(length));
+      }
+    else
+      {
+        size_t index(static_cast<size_t>(pos % m_slot_count));
+        std::unique_ptr<coil::SharedMemory>& oob(m_oob[index]);
+        if (!oob)
+          {
+            oob.reset(new coil::SharedMemory());
+          }
+        // the writer recreates the segment whenever it grows
+        if (!oob->created() || oob->get_size() != slot->oob_size)
+          {
+            if (oob->created()) { oob->close(); }
+            if (oob->open(oobAddress(index), slot->oob_size) != 0 ||
+                !mapped(*oob))
+              {
+                oob->close();
+                m_header->tail.store(pos + 1, std::memory_order_release);
+                return BufferStatus::BUFFER_ERROR;
+              }
+          }
+        data.writeData(reinterpret_cast<unsigned char*>(oob->get_data()),
+                       static_cast<unsigned long>(length));
+      }
+    m_header->tail.store(pos + 1, std::memory_order_release);
+    return BufferStatus::OK;
+  }
+
+  void SharedMemoryRing::wakeup()
+  {
+    if (isOpen())
+      {
+        futexWake(m_header->wake);
+      }
+  }
+
+  SharedMemoryRing::Slot* SharedMemoryRing::slotAt(std::uint64_t pos) const
+  {
+    return reinterpret_cast<Slot*>(reinterpret_cast<char*>(m_header)
+                                   + headerSize()
+                                   + (pos % m_slot_count) * m_slot_stride);
+  }
+
+  char* SharedMemoryRing::payloadOf(Slot* slot) const
+  {
+    return reinterpret_cast<char*>(slot) + sizeof(Slot);
+  }
+
+  std::string SharedMemoryRing::oobAddress(size_t index) const
+  {
+    return m_address + "_" + std::to_string(index);
+  }
+
+  bool SharedMemoryRing::waitReadable(std::uint64_t pos,
+                                      std::chrono::nanoseconds timeout)
+  {
+    if (timeout <= std::chrono::nanoseconds::zero())
+      {
+        return false;
+      }
+    std::uint32_t wake(m_header->wake.load());
+    // seq_cst: either the writer sees the flag or we see its head
+    m_header->waiting.store(1);
+    if (m_header->head.load() <= pos)
+      {
+        futexWait(m_header->wake, wake, timeout);
+      }
+    m_header->waiting.store(0);
+    return m_header->head.load() > pos;
+  }
+} // namespace RTC
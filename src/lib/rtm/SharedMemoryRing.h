@@ -0,0 +1,297 @@
+﻿// -*- C++ -*-
+/*!
+ * @file SharedMemoryRing.h
+ * @brief Multi-slot shared memory ring
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_SHAREDMEMORYRING_H
+#define RTC_SHAREDMEMORYRING_H
+
+#include <coil/SharedMemory.h>
+#include <rtm/BufferStatus.h>
+#include <rtm/ByteData.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define SHAREDMEMORYRING_DEFAULT_SLOT_COUNT 16
+#define SHAREDMEMORYRING_DEFAULT_SLOT_SIZE 65536
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class SharedMemoryRing
+   * @brief 共有メモリ上の複数スロットリング
+   *
+   * 1つの書き込みプロセスと1つの読み出しプロセスの間で、共有メモリ上
+   * の固定長 N スロットのリングを介してデータを受け渡すクラス。
+   *
+   * 共有メモリの先頭にはヘッダ (スロット数、スロット長、書き込み位置、
+   * 読み出し位置、待機フラグ) を置き、その後にキャッシュライン境界に
+   * 揃えたスロットを並べる。各スロットはアトミックなシーケンス番号を
+   * 持ち、書き込み側はデータを書き終えてからシーケンス番号を公開する。
+   *
+   * 読み出し側はデータがない場合のみ待機し、Linux では futex、その他
+   * の環境では短い間隔のポーリングで待つ。書き込み側は読み出し側が待
+   * 機している場合のみ起床させるため、1サンプルごとの CORBA 呼び出
+   * しは不要である。
+   *
+   * スロット長を超えるデータは、スロットごとに用意する別の共有メモリ
+   * 領域 (<アドレス>_<スロット番号>) に書き込む。この領域は必要に応じ
+   * て書き込み側が拡張し、読み出し側はサイズの変化を検出して再マップ
+   * する。
+   *
+   * @since 2.0.0
+   *
+   * @else
+   * @class SharedMemoryRing
+   * @brief Multi-slot ring on shared memory
+   *
+   * Passes data from one writer process to one reader process through
+   * a fixed N-slot ring in shared memory.
+   *
+   * The segment starts with a header (slot count, slot size, write and
+   * read positions, waiter flag) followed by cache-line-aligned slots.
+   * Each slot carries an atomic sequence number which the writer
+   * publishes after the payload has been written.
+   *
+   * The reader waits only when no data is available, with a futex on
+   * Linux and a short polling interval elsewhere. The writer wakes the
+   * reader only when it is waiting, so no CORBA call per sample is
+   * needed.
+   *
+   * Samples larger than the slot size go out of band to a separate
+   * segment per slot (<address>_<slot index>). The writer grows that
+   * segment on demand and the reader remaps it when its size changes.
+   *
+   * @since 2.0.0
+   *
+   * @endif
+   */
+  class SharedMemoryRing
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    SharedMemoryRing();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * マップした領域を閉じる。作成した領域の unlink は行わない。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * Closes the mapped segments. Created segments are not unlinked.
+     *
+     * @endif
+     */
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    /*!
+     * @if jp
+     * @brief リングを作成する (書き込み側)
+     *
+     * @param shm_address 共有メモリの空間名
+     * @param slot_count スロット数
+     * @param slot_size スロット長 (キャッシュライン境界に切り上げる)
+     * @return 0: 成功, -1: 失敗
+     *
+     * @else
+     * @brief Create the ring (writer side)
+     *
+     * @param shm_address Name of the shared memory
+     * @param slot_count Number of slots
+     * @param slot_size Slot size, rounded up to the cache line size
+     * @return 0: successful, -1: failed
+     *
+     * @endif
+     */
+    int create(const std::string& shm_address,
+               std::uint32_t slot_count, std::uint64_t slot_size);
+
+    /*!
+     * @if jp
+     * @brief リングを開く (読み出し側)
+     *
+     * スロット数とスロット長はヘッダから取得する。
+     *
+     * @param shm_address 共有メモリの空間名
+     * @param memory_size 共有メモリのサイズ
+     * @return 0: 成功, -1: 失敗
+     *
+     * @else
+     * @brief Open the ring (reader side)
+     *
+     * The slot count and slot size are taken from the header.
+     *
+     * @param shm_address Name of the shared memory
+     * @param memory_size Size of the shared memory
+     * @return 0: successful, -1: failed
+     *
+     * @endif
+     */
+    int open(const std::string& shm_address, std::uint64_t memory_size);
+
+    /*!
+     * @if jp
+     * @brief リングを閉じる
+     *
+     * @param unlink true の場合、作成した領域を unlink する
+     *
+     * @else
+     * @brief Close the ring
+     *
+     * @param unlink Unlink the created segments if true
+     *
+     * @endif
+     */
+    void close(bool unlink = false);
+
+    /*!
+     * @if jp
+     * @brief リングが作成済み、またはオープン済みかどうか
+     * @else
+     * @brief Whether the ring has been created or opened
+     * @endif
+     */
+    bool isOpen() const;
+
+    /*!
+     * @if jp
+     * @brief 共有メモリのサイズを取得する
+     * @else
+     * @brief Get the size of the shared memory
+     * @endif
+     */
+    std::uint64_t getMemorySize() const;
+
+    /*!
+     * @if jp
+     * @brief 共有メモリの空間名を取得する
+     * @else
+     * @brief Get the name of the shared memory
+     * @endif
+     */
+    const std::string& getAddress() const;
+
+    /*!
+     * @if jp
+     * @brief 1サンプルを書き込む (書き込み側)
+     *
+     * @param data 書き込むデータ
+     * @return OK: 成功
+     *         FULL: 空きスロットがない
+     *         BUFFER_ERROR: 帯域外領域の作成に失敗した
+     *         PRECONDITION_NOT_MET: リングが作成されていない
+     *
+     * @else
+     * @brief Write a sample (writer side)
+     *
+     * @param data Data to write
+     * @return OK: successful
+     *         FULL: no free slot
+     *         BUFFER_ERROR: failed to create the out-of-band segment
+     *         PRECONDITION_NOT_MET: the ring has not been created
+     *
+     * @endif
+     */
+    BufferStatus write(const ByteData& data);
+
+    /*!
+     * @if jp
+     * @brief 1サンプルを読み出す (読み出し側)
+     *
+     * データがない場合、最大 timeout だけ待機する。wakeup() により待
+     * 機は途中で解除されることがある。
+     *
+     * @param data 読み出したデータ
+     * @param timeout 待機時間
+     * @return OK: 成功
+     *         TIMEOUT: データがない
+     *         BUFFER_ERROR: 帯域外領域のマップに失敗した
+     *         PRECONDITION_NOT_MET: リングがオープンされていない
+     *
+     * @else
+     * @brief Read a sample (reader side)
+     *
+     * Waits up to timeout when no data is available. wakeup() may end
+     * the wait early.
+     *
+     * @param data Data read
+     * @param timeout Time to wait
+     * @return OK: successful
+     *         TIMEOUT: no data
+     *         BUFFER_ERROR: failed to map the out-of-band segment
+     *         PRECONDITION_NOT_MET: the ring has not been opened
+     *
+     * @endif
+     */
+    BufferStatus read(ByteData& data, std::chrono::nanoseconds timeout);
+
+    /*!
+     * @if jp
+     * @brief read() で待機中のスレッドを起床させる
+     * @else
+     * @brief Wake up a thread waiting in read()
+     * @endif
+     */
+    void wakeup();
+
+    /*!
+     * @if jp
+     * @brief 指定したスロット構成に必要な共有メモリのサイズ
+     * @else
+     * @brief Shared memory size needed for the given slot layout
+     * @endif
+     */
+    static std::uint64_t memorySize(std::uint32_t slot_count,
+                                    std::uint64_t slot_size);
+
+  private:
+    struct Header;
+    struct Slot;
+
+    static std::uint64_t headerSize();
+    Slot* slotAt(std::uint64_t pos) const;
+    char* payloadOf(Slot* slot) const;
+    std::string oobAddress(size_t index) const;
+    bool waitReadable(std::uint64_t pos, std::chrono::nanoseconds timeout);
+
+    coil::SharedMemory m_shmem;
+    std::vector<std::unique_ptr<coil::SharedMemory> > m_oob;
+    std::string m_address;
+    std::uint64_t m_memory_size{0};
+    Header* m_header{nullptr};
+    std::uint32_t m_slot_count{0};
+    std::uint64_t m_slot_size{0};
+    std::uint64_t m_slot_stride{0};
+    bool m_writer{false};
+  };
+} // namespace RTC
+
+#endif // RTC_SHAREDMEMORYRING_H
@@ -128,7 +128,7 @@ namespace RTC
             EventBase* ebt = m_buffer.get();
             (*ebt)();
             m_buffer.advanceRptr();
-            delete ebt;
+            ebt->release();
         }
     }
 
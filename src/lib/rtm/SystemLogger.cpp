@@ -16,6 +16,7 @@
  *
  */
 #include <rtm/SystemLogger.h>
+#include <rtm/AsyncLogger.h>
 #include <rtm/Manager.h>
 
 #include <sstream>
@@ -145,9 +146,23 @@ namespace RTC
    * @endif
    */
   std::string Logger::getDate()
+  {
+    return formatDate(m_dateFormat, m_msEnable, m_usEnable,
+                      m_clock->gettime());
+  }
+
+  /*!
+   * @if jp
+   * @brief 日時文字列を生成する
+   * @else
+   * @brief Render a date string
+   * @endif
+   */
+  std::string Logger::formatDate(const std::string& format,
+                                 bool msEnable, bool usEnable,
+                                 std::chrono::nanoseconds tm)
   {
     char buf[MAXSIZE];
-    auto tm = m_clock->gettime();
     auto sec = std::chrono::duration_cast<std::chrono::seconds>(tm);
 
     time_t timer = sec.count();
@@ -158,27 +173,27 @@ namespace RTC
     {
         return std::string();
     }
-    strftime(buf, sizeof(buf), m_dateFormat.c_str(), &date);
+    strftime(buf, sizeof(buf), format.c_str(), &date);
 #else
-    struct tm* date;
-    date = gmtime(&timer);
+    struct tm date;
+    gmtime_r(&timer, &date);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wformat-nonliteral"
     // The format parameter is not literal, as it allows the user to change the format.
     // Therefore, we have controlled -Wformat-nonliteral with pragma.
-    strftime(buf, sizeof(buf), m_dateFormat.c_str(), date);
+    strftime(buf, sizeof(buf), format.c_str(), &date);
 #pragma GCC diagnostic pop
 #endif
 
     std::string fmt(buf);
-    if (m_msEnable)
+    if (msEnable)
       {
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(tm - sec);
         std::stringstream msec("");
         msec << std::setfill('0') << std::setw(3) << ms.count();
         fmt = coil::replaceString(std::move(fmt), "#m#", msec.str());
       }
-    if (m_usEnable)
+    if (usEnable)
       {
         auto us = std::chrono::duration_cast<std::chrono::microseconds>(tm - sec);
         std::stringstream usec("");
@@ -249,6 +264,14 @@ namespace RTC
   {
       if (ostream_type != nullptr)
       {
+          // the date is rendered by the output thread in async mode
+          if (AsyncLogger::instance().push(level, m_clock->gettime(),
+                                           m_name, m_dateFormat,
+                                           m_msEnable, m_usEnable,
+                                           ostream_type, mes))
+          {
+              return;
+          }
           std::string date = getDate();
           ostream_type->write(level, m_name, date, mes);
       }
@@ -282,7 +305,7 @@ namespace RTC
           std::vector<std::string> vec(prop);
           for (auto & str : vec)
           {
-              ostream_type->write(level, m_name, getDate(), str);
+              write(level, str);
           }
       }
   }
@@ -450,6 +450,42 @@ namespace RTC
     {
         return m_levelColor[level];
     }
+
+    /*!
+     * @if jp
+     *
+     * @brief 日時文字列を生成する
+     *
+     * setDateFormat() で変換済みの書式に従い、指定した時刻の日時文字
+     * 列を生成する。非同期出力では出力スレッドから呼ばれる。
+     *
+     * @param format 変換済みの日時書式
+     * @param msEnable ミリ秒を出力するかどうか
+     * @param usEnable マイクロ秒を出力するかどうか
+     * @param tm 時刻
+     *
+     * @return 日時文字列
+     *
+     * @else
+     *
+     * @brief Render a date string
+     *
+     * Renders the date string of the given time in a format already
+     * converted by setDateFormat(). The asynchronous backend calls this
+     * from its output thread.
+     *
+     * @param format Converted date format
+     * @param msEnable Whether milliseconds are rendered
+     * @param usEnable Whether microseconds are rendered
+     * @param tm Time
+     *
+     * @return Date string
+     *
+     * @endif
+     */
+    static std::string formatDate(const std::string& format,
+                                  bool msEnable, bool usEnable,
+                                  std::chrono::nanoseconds tm);
     
 
   protected:
@@ -63,9 +63,13 @@ namespace RTC
   public:
     Timestamp(const char* ts_type) : m_tstype(ts_type) {}
     ~Timestamp() override = default;
+    bool isEnabled(const ConnectorInfo& info) override
+    {
+      return info.settings().timestampPolicy == m_tstype;
+    }
     ReturnCode operator()(ConnectorInfo& info, DataType& data) override
     {
-      if (info.properties["timestamp_policy"] != m_tstype)
+      if (info.settings().timestampPolicy != m_tstype)
         {
           return NO_CHANGE;
         }
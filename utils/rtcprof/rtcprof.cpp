@@ -58,6 +58,8 @@ int main(int argc, char* argv[])
   opts.emplace_back("logger.enable:NO");
   opts.emplace_back("-o");
   opts.emplace_back("manager.corba_servant:NO");
+  opts.emplace_back("-o");
+  opts.emplace_back("manager.profile_only:YES");
 
   // Manager initialization
   RTC::Manager::init(static_cast<int>(opts.size()), coil::Argv(opts).get());
@@ -0,0 +1,436 @@
+﻿// -*- C++ -*-
+/*!
+ * @file BufferBench.cpp
+ * @brief CdrBuffer microbenchmark
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <coil/OS.h>
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+
+#include <rtm/CdrBufferBase.h>
+#include <rtm/CdrRingBuffer.h>
+#include <rtm/CdrSPSCRingBuffer.h>
+#include <rtm/CdrMPSCRingBuffer.h>
+#include <rtm/RingBuffer.h>
+#include <rtm/SPSCRingBuffer.h>
+#include <rtm/MPSCRingBuffer.h>
+
+namespace
+{
+  struct BenchResult
+  {
+    double ns_per_sample{0.0};
+    size_t received{0};
+    size_t corrupted{0};
+  };
+
+  double nsPerOp(std::chrono::steady_clock::duration d, size_t count)
+  {
+    if (count == 0) { return 0.0; }
+    return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(d).count())
+      / static_cast<double>(count);
+  }
+
+  /*!
+   * "single": write and read alternately in one thread (uncontended cost).
+   * "block", "overwrite": one writer thread and one reader thread, as
+   * OutPort and the publisher (or InPortProvider and the EC) use a
+   * connector buffer. With writers > 1 the samples are written by that
+   * many threads, as the providers of several connectors write into the
+   * single buffer of an InPort. "block" reports the elapsed time per
+   * delivered sample, "overwrite" the writers' time per write.
+   */
+  BenchResult run(const std::string& type, const std::string& mode,
+                  size_t count, size_t length, size_t size, size_t writers)
+  {
+    BenchResult result;
+    RTC::CdrBufferBase* buffer =
+      RTC::CdrBufferFactory::instance().createObject(type);
+    if (buffer == nullptr)
+      {
+        std::cerr << "unknown buffer type: " << type << std::endl;
+        return result;
+      }
+
+    coil::Properties prop;
+    prop["length"] = coil::otos(length);
+    prop["write.full_policy"] = mode == "block" ? "block" : "overwrite";
+    prop["read.empty_policy"] = mode == "block" ? "block" : "do_nothing";
+    buffer->init(prop);
+
+    RTC::ByteData data;
+    data.setDataLength(static_cast<unsigned long>(size));
+    RTC::ByteData value;
+
+    if (mode == "single")
+      {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i(0); i < count; ++i)
+          {
+            buffer->write(data);
+            if (buffer->read(value) == RTC::BufferStatus::OK)
+              {
+                ++result.received;
+              }
+          }
+        result.ns_per_sample =
+          nsPerOp(std::chrono::steady_clock::now() - start, count);
+        RTC::CdrBufferFactory::instance().deleteObject(buffer);
+        return result;
+      }
+
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        while (result.received < count)
+          {
+            if (buffer->read(value) == RTC::BufferStatus::OK)
+              {
+                ++result.received;
+              }
+            else if (done && buffer->empty())
+              {
+                // the rest was dropped by overwriting
+                break;
+              }
+            else
+              {
+                std::this_thread::yield();
+              }
+          }
+      });
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t w(0); w < writers; ++w)
+      {
+        size_t n(count / writers + (w < count % writers ? 1 : 0));
+        threads.emplace_back([&, n]() {
+            for (size_t i(0); i < n; ++i)
+              {
+                buffer->write(data);
+              }
+          });
+      }
+    for (auto& thread : threads)
+      {
+        thread.join();
+      }
+    auto wtime = std::chrono::steady_clock::now() - start;
+    done = true;
+    reader.join();
+
+    if (mode == "block")
+      {
+        wtime = std::chrono::steady_clock::now() - start;
+      }
+    result.ns_per_sample = nsPerOp(wtime, count);
+    RTC::CdrBufferFactory::instance().deleteObject(buffer);
+    return result;
+  }
+
+  /*!
+   * "stress": one writer thread overwrites a full buffer while one
+   * reader thread reads it under the readback policy. Every sample is
+   * filled with its sequence number, and the reader counts samples that
+   * are torn or out of order. A reader copying a slot that the writer
+   * reuses shows up here (and with -fsanitize=thread).
+   */
+  BenchResult stress(const std::string& type, size_t count, size_t length,
+                     size_t size)
+  {
+    BenchResult result;
+    RTC::CdrBufferBase* buffer =
+      RTC::CdrBufferFactory::instance().createObject(type);
+    if (buffer == nullptr)
+      {
+        std::cerr << "unknown buffer type: " << type << std::endl;
+        return result;
+      }
+
+    coil::Properties prop;
+    prop["length"] = coil::otos(length);
+    prop["write.full_policy"] = "overwrite";
+    prop["read.empty_policy"] = "readback";
+    buffer->init(prop);
+
+    size_t words(size < sizeof(std::uint64_t) ?
+                 1 : size / sizeof(std::uint64_t));
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        RTC::ByteData value;
+        std::uint64_t last(0);
+        while (!(done && buffer->empty()))
+          {
+            if (buffer->read(value) != RTC::BufferStatus::OK)
+              {
+                std::this_thread::yield();
+                continue;
+              }
+            if (value.getDataLength() != words * sizeof(std::uint64_t))
+              {
+                if (value.getDataLength() != 0) { ++result.corrupted; }
+                continue;
+              }
+            std::uint64_t first(0);
+            bool torn(false);
+            for (size_t w(0); w < words; ++w)
+              {
+                std::uint64_t n;
+                std::memcpy(&n, value.getBuffer() + w * sizeof(n), sizeof(n));
+                if (w == 0) { first = n; }
+                else if (n != first) { torn = true; }
+              }
+            if (torn || first < last)
+              {
+                ++result.corrupted;
+              }
+            else if (first != last)
+              {
+                // the readback policy returns the last sample again
+                ++result.received;
+              }
+            last = first;
+          }
+      });
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i(1); i <= count; ++i)
+      {
+        RTC::ByteData data;
+        data.setDataLength(static_cast<unsigned long>(words * sizeof(i)));
+        for (size_t w(0); w < words; ++w)
+          {
+            std::memcpy(data.getBuffer() + w * sizeof(i), &i, sizeof(i));
+          }
+        buffer->write(data);
+      }
+    auto wtime = std::chrono::steady_clock::now() - start;
+    done = true;
+    reader.join();
+
+    result.ns_per_sample = nsPerOp(wtime, count);
+    RTC::CdrBufferFactory::instance().deleteObject(buffer);
+    return result;
+  }
+
+  /*!
+   * Sample whose assignment sleeps, so that the reader spends a while
+   * between taking a slot out and releasing it, even on a single CPU.
+   */
+  struct SlowSample
+  {
+    SlowSample() = default;
+    SlowSample(const SlowSample& other) : number(other.number) {}
+    SlowSample& operator=(const SlowSample& other)
+    {
+      number = other.number;
+      std::this_thread::sleep_for(std::chrono::microseconds(1));
+      return *this;
+    }
+    std::uint64_t number{0};
+  };
+
+  /*!
+   * "lockstep": one writer thread and one reader thread pass SlowSample
+   * through a buffer of length 1 under the do_nothing policies, the
+   * writer retrying while the buffer is full. Every sample has to arrive
+   * once and in order. A writer storing into the slot the reader is
+   * still copying shows up as a wrong sample, usually followed by no
+   * progress at all, which is reported after a second. At most
+   * lockstep_count samples are passed, since each one sleeps.
+   */
+  const size_t lockstep_count(10000);
+
+  template <class Buffer>
+  BenchResult lockstep(size_t count)
+  {
+    BenchResult result;
+    Buffer buffer(1);
+    coil::Properties prop;
+    prop["write.full_policy"] = "do_nothing";
+    prop["read.empty_policy"] = "do_nothing";
+    buffer.init(prop);
+
+    std::atomic<bool> stop{false};
+    std::thread reader([&]() {
+        SlowSample value;
+        std::uint64_t last(0);
+        auto idle = std::chrono::steady_clock::now();
+        while (result.received < count)
+          {
+            if (buffer.read(value) != RTC::BufferStatus::OK)
+              {
+                if (std::chrono::steady_clock::now() - idle >
+                    std::chrono::seconds(1))
+                  {
+                    ++result.corrupted;  // stuck
+                    break;
+                  }
+                std::this_thread::yield();
+                continue;
+              }
+            idle = std::chrono::steady_clock::now();
+            if (value.number != last + 1)
+              {
+                ++result.corrupted;
+              }
+            last = value.number;
+            ++result.received;
+          }
+        stop = true;
+      });
+
+    auto start = std::chrono::steady_clock::now();
+    SlowSample data;
+    for (std::uint64_t i(1); i <= count && !stop; ++i)
+      {
+        data.number = i;
+        while (buffer.write(data) != RTC::BufferStatus::OK && !stop)
+          {
+            std::this_thread::yield();
+          }
+      }
+    reader.join();
+
+    result.ns_per_sample =
+      nsPerOp(std::chrono::steady_clock::now() - start, count);
+    return result;
+  }
+
+  BenchResult lockstep(const std::string& type, size_t count)
+  {
+    if (type == "ring_buffer")
+      {
+        return lockstep<RTC::RingBuffer<SlowSample> >(count);
+      }
+    if (type == "spsc_ring")
+      {
+        return lockstep<RTC::SPSCRingBuffer<SlowSample> >(count);
+      }
+    if (type == "mpsc_ring")
+      {
+        return lockstep<RTC::MPSCRingBuffer<SlowSample> >(count);
+      }
+    std::cerr << "unknown buffer type: " << type << std::endl;
+    return BenchResult();
+  }
+
+  void usage(const char* argv0)
+  {
+    std::cerr << "usage: " << argv0
+              << " [-n count] [-l length] [-s size] [-w writers]"
+              << " [-t type,...]"
+              << std::endl;
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  size_t count(1000000);
+  size_t length(8);
+  size_t size(64);
+  size_t writers(1);
+  coil::vstring types{"ring_buffer", "spsc_ring", "mpsc_ring"};
+
+  coil::GetOpt get_opts(argc, argv, "n:l:s:w:t:h", 0);
+  int opt;
+  while ((opt = get_opts()) > 0)
+    {
+      switch (opt)
+        {
+        case 'n':
+          coil::stringTo(count, get_opts.optarg);
+          break;
+        case 'l':
+          coil::stringTo(length, get_opts.optarg);
+          break;
+        case 's':
+          coil::stringTo(size, get_opts.optarg);
+          break;
+        case 'w':
+          coil::stringTo(writers, get_opts.optarg);
+          if (writers == 0) { writers = 1; }
+          break;
+        case 't':
+          types = coil::split(get_opts.optarg, ",");
+          break;
+        default:
+          usage(argv[0]);
+          return 1;
+        }
+    }
+
+  CdrRingBufferInit();
+  CdrSPSCRingBufferInit();
+  CdrMPSCRingBufferInit();
+
+  std::cout << "count: " << count << ", length: " << length
+            << ", size: " << size << ", writers: " << writers << std::endl;
+  std::cout << std::setw(12) << "type" << std::setw(11) << "mode"
+            << std::setw(16) << "ns/sample"
+            << std::setw(10) << "received" << std::setw(10) << "lost"
+            << std::endl;
+
+  size_t corrupted(0);
+  for (auto& type : types)
+    {
+      for (const char* mode :
+             {"single", "block", "overwrite", "stress", "lockstep"})
+        {
+          if (writers > 1 && type == "spsc_ring" &&
+              std::string(mode) != "single")
+            {
+              // not safe with several writers
+              continue;
+            }
+          BenchResult r;
+          size_t n(count);
+          if (std::string(mode) == "stress")
+            {
+              r = stress(type, count, length, size);
+            }
+          else if (std::string(mode) == "lockstep")
+            {
+              n = std::min(count, lockstep_count);
+              r = lockstep(type, n);
+            }
+          else
+            {
+              r = run(type, mode, count, length, size, writers);
+            }
+          corrupted += r.corrupted;
+          std::cout << std::setw(12) << type << std::setw(11) << mode
+                    << std::fixed << std::setprecision(1)
+                    << std::setw(16) << r.ns_per_sample
+                    << std::setw(10) << r.received
+                    << std::setw(10) << n - r.received
+                    << (r.corrupted != 0 ?
+                        "  (corrupted: " + coil::otos(r.corrupted) + ")" : "")
+                    << std::endl;
+        }
+    }
+  return corrupted != 0 ? 1 : 0;
+}
@@ -0,0 +1,312 @@
+﻿// -*- C++ -*-
+/*!
+ * @file EventBench.cpp
+ * @brief EventInPort event dispatch microbenchmark
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <coil/OS.h>
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <rtm/ConnectorBase.h>
+#include <rtm/EventPort.h>
+#include <rtm/StaticFSM.h>
+
+namespace BenchFsm
+{
+  // The microwave oven of examples/StaticFsm without the console output
+  FSM_TOPSTATE(Top)
+  {
+    struct Box
+    {
+      long time{0};
+      long minutes{0};
+      long cooked{0};
+    };
+
+    FSM_STATE(Top);
+
+    virtual void open() {}
+    virtual void close() {}
+    virtual void minute(RTC::TimedLong /* time */) {}
+    virtual void start() {}
+    virtual void stop() {}
+    virtual void tick() {}
+
+  private:
+    RTC::ReturnCode_t onInit() override;
+  };
+
+  FSM_SUBSTATE(Operational, Top)
+  {
+    FSM_STATE(Operational);
+    DEEPHISTORY();
+  private:
+    RTC::ReturnCode_t onInit() override;
+  };
+
+  FSM_SUBSTATE(Idle, Operational)
+  {
+    FSM_STATE(Idle);
+    void minute(RTC::TimedLong time) override;
+  };
+
+  FSM_SUBSTATE(Programmed, Operational)
+  {
+    FSM_STATE(Programmed);
+    void minute(RTC::TimedLong time) override;
+    void start() override;
+  };
+
+  FSM_SUBSTATE(Cooking, Programmed)
+  {
+    FSM_STATE(Cooking);
+    void tick() override;
+  };
+
+  RTC::ReturnCode_t Top::onInit()
+  {
+    setState<Operational>();
+    return RTC::RTC_OK;
+  }
+
+  RTC::ReturnCode_t Operational::onInit()
+  {
+    setState<Idle>();
+    return RTC::RTC_OK;
+  }
+
+  void Idle::minute(RTC::TimedLong time)
+  {
+    TOP::box().time += time.data;
+    TOP::box().minutes += time.data;
+    setState<Programmed>();
+  }
+
+  void Programmed::minute(RTC::TimedLong time)
+  {
+    TOP::box().time += time.data;
+    TOP::box().minutes += time.data;
+  }
+
+  void Programmed::start()
+  {
+    setState<Cooking>();
+  }
+
+  void Cooking::tick()
+  {
+    if (--TOP::box().time <= 0)
+      {
+        ++TOP::box().cooked;
+        setState<Idle>();
+      }
+  }
+} // namespace BenchFsm
+
+namespace
+{
+  using Fsm = RTC::Machine<BenchFsm::Top>;
+
+  /*!
+   * The binders as they were before the event pool: an event object
+   * allocated for every received data, the event name looked up in
+   * the properties, and a Macho event allocated for every dispatch.
+   */
+  template <class R>
+  class HeapBinder0
+    : public RTC::ConnectorDataListener, RTC::EventBinderBase0
+  {
+    USE_CONNLISTENER_STATUS;
+  public:
+    HeapBinder0(Fsm& fsm, const char* event_name,
+                R (BenchFsm::Top::*handler)(),
+                RTC::RingBuffer<RTC::EventBase*>& buffer)
+      : m_fsm(fsm), m_eventName(event_name), m_handler(handler),
+        m_buffer(buffer) {}
+    ReturnCode operator()(RTC::ConnectorInfo& info, RTC::ByteData& /*data*/,
+                          const std::string& /*marshalingtype*/) override
+    {
+      if (info.properties["fsm_event_name"] == m_eventName ||
+          info.name == m_eventName)
+        {
+          m_buffer.write(new RTC::Event0(this));
+        }
+      return NO_CHANGE;
+    }
+    void run() override
+    {
+      m_fsm.dispatch(Macho::Event(m_handler));
+    }
+    Fsm& m_fsm;
+    std::string m_eventName;
+    R (BenchFsm::Top::*m_handler)();
+    RTC::RingBuffer<RTC::EventBase*>& m_buffer;
+  };
+
+  template <class R, class P0>
+  class HeapBinder1
+    : public RTC::ConnectorDataListenerT<P0>, RTC::EventBinderBase1<P0>
+  {
+    USE_CONNLISTENER_STATUS;
+  public:
+    HeapBinder1(Fsm& fsm, const char* event_name,
+                R (BenchFsm::Top::*handler)(P0),
+                RTC::RingBuffer<RTC::EventBase*>& buffer)
+      : m_fsm(fsm), m_eventName(event_name), m_handler(handler),
+        m_buffer(buffer) {}
+    ReturnCode operator()(RTC::ConnectorInfo& info, P0& data) override
+    {
+      if (info.properties["fsm_event_name"] == m_eventName ||
+          info.name == m_eventName)
+        {
+          m_buffer.write(new RTC::Event1<P0>(this, data));
+        }
+      return NO_CHANGE;
+    }
+    void run(P0& data) override
+    {
+      m_fsm.dispatch(Macho::Event(m_handler, data));
+    }
+    Fsm& m_fsm;
+    std::string m_eventName;
+    R (BenchFsm::Top::*m_handler)(P0);
+    RTC::RingBuffer<RTC::EventBase*>& m_buffer;
+  };
+
+  coil::Properties connectorProperties(const char* event_name, size_t extra)
+  {
+    coil::Properties prop;
+    prop["interface_type"] = "corba_cdr";
+    prop["dataflow_type"] = "push";
+    prop["subscription_type"] = "flush";
+    prop["fsm_event_name"] = event_name;
+    // the rest of a connector profile, as copied from the port
+    for (size_t i(0); i < extra; ++i)
+      {
+        prop["dataport.property" + coil::otos(i)] = coil::otos(i);
+      }
+    return prop;
+  }
+
+  struct BenchResult
+  {
+    double events_per_sec{0.0};
+    bool ok{false};
+  };
+
+  /*!
+   * One cooking cycle of the microwave per iteration: minute (with a
+   * TimedLong), start and tick events arrive on the EventInPort and
+   * the EC thread runs them with run_event().
+   */
+  template <class Binder0, class Binder1>
+  BenchResult run(size_t count, size_t extra)
+  {
+    BenchResult result;
+    Fsm fsm(nullptr);
+    coil::Properties bufprop;
+    bufprop["length"] = "8";
+    fsm.getBuffer().init(bufprop);
+
+    Binder1 minute(fsm, "minute", &BenchFsm::Top::minute, fsm.getBuffer());
+    Binder0 start(fsm, "start", &BenchFsm::Top::start, fsm.getBuffer());
+    Binder0 tick(fsm, "tick", &BenchFsm::Top::tick, fsm.getBuffer());
+    RTC::ConnectorDataListenerT<RTC::TimedLong>& minuteListener(minute);
+
+    RTC::ConnectorInfo minuteInfo("con0", "id0", coil::vstring(),
+                                  connectorProperties("minute", extra));
+    RTC::ConnectorInfo startInfo("con1", "id1", coil::vstring(),
+                                 connectorProperties("start", extra));
+    RTC::ConnectorInfo tickInfo("con2", "id2", coil::vstring(),
+                                connectorProperties("tick", extra));
+    RTC::TimedLong time;
+    time.data = 1;
+    RTC::ByteData data;
+    std::string type("corba");
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i(0); i < count; ++i)
+      {
+        minuteListener(minuteInfo, time);
+        start(startInfo, data, type);
+        tick(tickInfo, data, type);
+        fsm.run_event();
+      }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    double events(static_cast<double>(count == 0 ? 1 : count) * 3);
+    double sec(std::chrono::duration<double>(elapsed).count());
+    result.events_per_sec = events / (sec > 0.0 ? sec : 1e-9);
+    result.ok = fsm.box().cooked == static_cast<long>(count) &&
+      fsm.box().minutes == static_cast<long>(count);
+    return result;
+  }
+
+  void usage(const char* argv0)
+  {
+    std::cerr << "usage: " << argv0 << " [-n count] [-p extra_properties]"
+              << std::endl;
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  size_t count(1000000);
+  size_t extra(40);
+
+  coil::GetOpt get_opts(argc, argv, "n:p:h", 0);
+  int opt;
+  while ((opt = get_opts()) > 0)
+    {
+      switch (opt)
+        {
+        case 'n':
+          coil::stringTo(count, get_opts.optarg);
+          break;
+        case 'p':
+          coil::stringTo(extra, get_opts.optarg);
+          break;
+        default:
+          usage(argv[0]);
+          return 1;
+        }
+    }
+
+  std::cout << "count: " << count << " cycles of 3 events, properties: "
+            << connectorProperties("", extra).size() << std::endl;
+  std::cout << std::setw(12) << "mode" << std::setw(16) << "events/s"
+            << std::setw(16) << "ns/event" << std::endl;
+
+  BenchResult heap(run<HeapBinder0<void>,
+                   HeapBinder1<void, RTC::TimedLong> >(count, extra));
+  BenchResult pool(run<RTC::EventBinder0<Fsm, BenchFsm::Top, void>,
+                   RTC::EventBinder1<Fsm, BenchFsm::Top, void,
+                                     RTC::TimedLong> >(count, extra));
+  for (const auto& r : {std::make_pair("heap", heap),
+                        std::make_pair("pool", pool)})
+    {
+      std::cout << std::setw(12) << r.first
+                << std::fixed << std::setprecision(1)
+                << std::setw(16) << r.second.events_per_sec
+                << std::setw(16) << 1e9 / r.second.events_per_sec
+                << (r.second.ok ? "" : "  (wrong result)") << std::endl;
+    }
+  return heap.ok && pool.ok ? 0 : 1;
+}
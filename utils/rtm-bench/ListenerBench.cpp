@@ -0,0 +1,208 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ListenerBench.cpp
+ * @brief Connector data listener microbenchmark
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <coil/OS.h>
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <rtm/ConnectorBase.h>
+#include <rtm/ConnectorListener.h>
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/Timestamp.h>
+
+namespace
+{
+  class Receiver
+    : public RTC::ConnectorDataListenerT<RTC::TimedLong>
+  {
+  public:
+    ReturnCode operator()(RTC::ConnectorInfo& /*info*/,
+                          RTC::TimedLong& data) override
+    {
+      m_sum += data.data;
+      m_stamped += (data.tm.sec != 0) ? 1 : 0;
+      return NO_CHANGE;
+    }
+    long long m_sum{0};
+    size_t m_stamped{0};
+  };
+
+  /*!
+   * The string keyed lookups the listener path did for every write
+   * before ConnectorInfo::settings(): the marshaling type in
+   * notifyOut() and notifyIn(), timestamp_policy twice in Timestamp,
+   * and the endian in the typed listener.
+   */
+  size_t propertyLookups(const coil::Properties& prop)
+  {
+    size_t n(0);
+    for (const char* key : {"out.marshaling_type", "in.marshaling_type"})
+      {
+        std::string type(prop.getProperty("marshaling_type", "corba"));
+        coil::eraseBothEndsBlank(prop.getProperty(key, type));
+        n += 2;
+      }
+    n += prop.getProperty("timestamp_policy").empty() ? 1 : 2;
+    coil::split(coil::normalize(
+      prop.getProperty("serializer.cdr.endian", "little")), ",");
+    n += 1;
+    return n;
+  }
+
+  coil::Properties connectorProperties(size_t extra)
+  {
+    coil::Properties prop;
+    prop["interface_type"] = "corba_cdr";
+    prop["dataflow_type"] = "push";
+    prop["subscription_type"] = "flush";
+    prop["marshaling_type"] = "corba";
+    prop["serializer.cdr.endian"] = "big,little";
+    prop["timestamp_policy"] = "on_write";
+    prop["publisher.push_policy"] = "all";
+    prop["buffer.length"] = "8";
+    prop["buffer.write.full_policy"] = "overwrite";
+    prop["buffer.read.empty_policy"] = "readback";
+    // the rest of a connector profile, as copied from the port
+    for (size_t i(0); i < extra; ++i)
+      {
+        prop["dataport.property" + coil::otos(i)] = coil::otos(i);
+      }
+    return prop;
+  }
+
+  struct BenchResult
+  {
+    double ns_per_write{0.0};
+    double lookups_per_write{0.0};
+    bool ok{false};
+  };
+
+  /*!
+   * One write through a connector: ON_BUFFER_WRITE on the OutPort side
+   * with the timestamp listener, then ON_RECEIVED on the InPort side
+   * with a typed listener that deserializes the data.
+   */
+  BenchResult run(RTC::ConnectorInfo& info, size_t count, bool lookups)
+  {
+    BenchResult result;
+    RTC::ConnectorListeners outPort;
+    RTC::ConnectorListeners inPort;
+    // the typed notifyIn/notifyOut are those of the base, as connectors
+    // call them
+    RTC::ConnectorListenersBase& outListeners(outPort);
+    RTC::ConnectorListenersBase& inListeners(inPort);
+    outListeners.addListener(RTC::ON_BUFFER_WRITE,
+                             new RTC::Timestamp<RTC::TimedLong>("on_write"));
+    Receiver* receiver(new Receiver());  // owned by inListeners
+    inListeners.addListener(RTC::ON_RECEIVED, receiver);
+
+    std::unique_ptr<RTC::ByteDataStreamBase> base(
+      RTC::createSerializer<RTC::TimedLong>("corba"));
+    auto* stream(dynamic_cast<RTC::ByteDataStream<RTC::TimedLong>*>(base.get()));
+    stream->isLittleEndian(info.settings().littleEndian);
+
+    RTC::TimedLong value;
+    RTC::ByteData data;
+    size_t lookup_count(0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i(0); i < count; ++i)
+      {
+        if (lookups) { lookup_count += propertyLookups(info.properties); }
+        value.data = static_cast<CORBA::Long>(i);
+        value.tm.sec = 0;
+        outListeners.notifyOut(RTC::ON_BUFFER_WRITE, info, value);
+        stream->serialize(value);
+        data.setDataLength(stream->getDataLength());
+        stream->readData(data.getBuffer(), data.getDataLength());
+        inListeners.notifyIn(RTC::ON_RECEIVED, info, data);
+      }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double n(static_cast<double>(count == 0 ? 1 : count));
+    result.ns_per_write = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+      / n;
+    result.lookups_per_write = static_cast<double>(lookup_count) / n;
+    long long expected(static_cast<long long>(count) *
+                       (static_cast<long long>(count) - 1) / 2);
+    result.ok = receiver->m_sum == expected && receiver->m_stamped == count;
+    return result;
+  }
+
+  void usage(const char* argv0)
+  {
+    std::cerr << "usage: " << argv0 << " [-n count] [-p extra_properties]"
+              << std::endl;
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  size_t count(1000000);
+  size_t extra(40);
+
+  coil::GetOpt get_opts(argc, argv, "n:p:h", 0);
+  int opt;
+  while ((opt = get_opts()) > 0)
+    {
+      switch (opt)
+        {
+        case 'n':
+          coil::stringTo(count, get_opts.optarg);
+          break;
+        case 'p':
+          coil::stringTo(extra, get_opts.optarg);
+          break;
+        default:
+          usage(argv[0]);
+          return 1;
+        }
+    }
+
+  CdrMemoryStreamInit<RTC::TimedLong>();
+
+  std::cout << "count: " << count << ", properties: "
+            << connectorProperties(extra).size() << std::endl;
+  std::cout << std::setw(12) << "mode" << std::setw(16) << "ns/write"
+            << std::setw(16) << "lookups/write" << std::endl;
+
+  for (bool lookups : {true, false})
+    {
+      RTC::ConnectorInfo info("bench", "id", coil::vstring(),
+                              connectorProperties(extra));
+      if (!lookups)
+        {
+          // A lookup left on the per-write path would now see the
+          // defaults: no timestamp and little endian.
+          info.properties = coil::Properties();
+        }
+      BenchResult r(run(info, count, lookups));
+      std::cout << std::setw(12) << (lookups ? "properties" : "settings")
+                << std::fixed << std::setprecision(1)
+                << std::setw(16) << r.ns_per_write
+                << std::setw(16) << r.lookups_per_write
+                << (r.ok ? "" : "  (wrong result)") << std::endl;
+      if (!r.ok) { return 1; }
+    }
+  return 0;
+}
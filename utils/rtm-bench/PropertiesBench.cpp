@@ -0,0 +1,200 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PropertiesBench.cpp
+ * @brief coil::Properties microbenchmark over a large rtc.conf
+ * @date $Date$
+ *
+ * Copyright (C) 2024
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <coil/OS.h>
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+
+namespace
+{
+  /*!
+   * An rtc.conf with the manager settings and, for each component,
+   * the keys Manager::configureComponent() and the configuration sets
+   * look up.
+   */
+  std::string generateConf(size_t components, size_t params)
+  {
+    std::ostringstream conf;
+    conf << "corba.nameservers: localhost:2809\n"
+         << "naming.formats: %h.host_cxt/%n.rtc\n"
+         << "logger.enable: YES\n"
+         << "logger.log_level: INFO\n"
+         << "exec_cxt.periodic.type: PeriodicExecutionContext\n"
+         << "exec_cxt.periodic.rate: 1000\n"
+         << "manager.components.preload: \n";
+    for (size_t i(0); i < components; ++i)
+      {
+        std::string comp("Category.Comp" + coil::otos(i));
+        conf << comp << ".exec_cxt.periodic.rate: " << (i % 100 + 1) << "\n"
+             << comp << ".naming.names: " << "comp" << i << ".rtc\n"
+             << comp << ".conf.__widget__.param0: text\n"
+             << comp << ".port.in" << i << ".buffer.length: 8\n";
+        for (size_t j(0); j < params; ++j)
+          {
+            conf << comp << ".conf.default.param" << j << ": " << i * j
+                 << "\n";
+          }
+      }
+    return conf.str();
+  }
+
+  std::vector<std::string> lookupKeys(size_t components, size_t params)
+  {
+    std::vector<std::string> keys;
+    for (size_t i(0); i < components; ++i)
+      {
+        std::string comp("Category.Comp" + coil::otos(i));
+        for (size_t j(0); j < params; ++j)
+          {
+            keys.emplace_back(comp + ".conf.default.param" + coil::otos(j));
+          }
+      }
+    return keys;
+  }
+
+  double elapsedNs(std::chrono::steady_clock::time_point start)
+  {
+    return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+  }
+
+  void report(const char* name, double ns, size_t count, const char* unit)
+  {
+    std::cout << std::setw(12) << name << std::fixed << std::setprecision(1)
+              << std::setw(16) << ns / static_cast<double>(count ? count : 1)
+              << "  ns/" << unit << std::endl;
+  }
+
+  void usage(const char* argv0)
+  {
+    std::cerr << "usage: " << argv0
+              << " [-c components] [-k params_per_component] [-n repeat]"
+              << std::endl;
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  size_t components(500);
+  size_t params(20);
+  size_t repeat(10);
+
+  coil::GetOpt get_opts(argc, argv, "c:k:n:h", 0);
+  int opt;
+  while ((opt = get_opts()) > 0)
+    {
+      switch (opt)
+        {
+        case 'c':
+          coil::stringTo(components, get_opts.optarg);
+          break;
+        case 'k':
+          coil::stringTo(params, get_opts.optarg);
+          break;
+        case 'n':
+          coil::stringTo(repeat, get_opts.optarg);
+          break;
+        default:
+          usage(argv[0]);
+          return 1;
+        }
+    }
+  if (repeat == 0) { repeat = 1; }
+
+  std::string conf(generateConf(components, params));
+  std::vector<std::string> keys(lookupKeys(components, params));
+  bool ok(true);
+
+  // load
+  coil::Properties prop;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t n(0); n < repeat; ++n)
+    {
+      std::istringstream is(conf);
+      coil::Properties loaded;
+      loaded.load(is);
+      if (n + 1 == repeat) { prop = loaded; }
+    }
+  double load_ns(elapsedNs(start));
+  std::cout << "keys: " << prop.size() << ", lookups: " << keys.size()
+            << ", repeat: " << repeat << std::endl;
+  report("load", load_ns, repeat * prop.size(), "key");
+
+  // getProperty of existing keys
+  size_t found(0);
+  start = std::chrono::steady_clock::now();
+  for (size_t n(0); n < repeat; ++n)
+    {
+      for (const auto& key : keys)
+        {
+          found += prop.getProperty(key).empty() ? 0 : 1;
+        }
+    }
+  report("getProperty", elapsedNs(start), repeat * keys.size(), "lookup");
+  ok = ok && found == repeat * keys.size();
+
+  // findNode of missing keys, as the defaults of configureComponent()
+  size_t missing(0);
+  start = std::chrono::steady_clock::now();
+  for (size_t n(0); n < repeat; ++n)
+    {
+      for (const auto& key : keys)
+        {
+          missing += prop.findNode(key + "x") == nullptr ? 1 : 0;
+        }
+    }
+  report("findNode", elapsedNs(start), repeat * keys.size(), "lookup");
+  ok = ok && missing == repeat * keys.size();
+
+  // getNode of each component and its size, as createComponent() does
+  size_t subtree(0);
+  start = std::chrono::steady_clock::now();
+  for (size_t n(0); n < repeat; ++n)
+    {
+      for (size_t i(0); i < components; ++i)
+        {
+          subtree += prop.getNode("Category.Comp" + coil::otos(i)).size();
+        }
+    }
+  report("getNode", elapsedNs(start), repeat * components, "node");
+  ok = ok && subtree == repeat * components * (params + 4);
+
+  // copy, as the manager and the components do with their profiles
+  size_t copied(0);
+  start = std::chrono::steady_clock::now();
+  for (size_t n(0); n < repeat; ++n)
+    {
+      coil::Properties copy(prop);
+      copied += copy.size();
+    }
+  report("copy", elapsedNs(start), repeat * prop.size(), "key");
+  ok = ok && copied == repeat * prop.size();
+
+  if (!ok)
+    {
+      std::cout << "wrong result" << std::endl;
+      return 1;
+    }
+  return 0;
+}